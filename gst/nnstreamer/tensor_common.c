@@ -23,10 +23,37 @@
  *
  */
 
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE             /* CPU_SET and pthread_setaffinity_np */
+#endif
+
 #include <tensor_common.h>
 #include <string.h>
+#include <errno.h>
 #include <glib.h>
 
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#endif
+
+/**
+ * @brief The CPU affinity and the priority of a thread before gst_tensor_thread_pin, to be restored.
+ */
+typedef struct
+{
+#ifdef __linux__
+  pid_t tid; /**< The id of the pinned thread */
+  cpu_set_t cpus; /**< The CPU affinity */
+#endif
+  gboolean cpus_saved; /**< TRUE if the CPU affinity is changed */
+  gint priority; /**< The nice value */
+  gboolean priority_saved; /**< TRUE if the priority is changed */
+} GstTensorThreadSaved;
+
 /**
  * @brief String representations for each tensor element type.
  */
@@ -1303,3 +1330,146 @@ gst_gen_tensors_from_collectpad (GstCollectPads * collect,
   GST_BUFFER_PTS (tensors_buf) = current_time;
   return isEOS;
 }
+
+#ifdef __linux__
+/**
+ * @brief Parse the list of CPUs (e.g., 0,2-3)
+ * @return TRUE if the list is valid and not empty
+ * @param str The list of CPU indices and ranges, comma-separated
+ * @param set The CPU set to be filled
+ */
+static gboolean
+gst_tensor_thread_parse_cpus (const gchar * str, cpu_set_t * set)
+{
+  gchar **items;
+  gchar *item, *end;
+  guint64 first, last;
+  gboolean ret = TRUE;
+  guint i;
+
+  CPU_ZERO (set);
+  items = g_strsplit (str, ",", -1);
+
+  for (i = 0; items[i] != NULL && ret; i++) {
+    item = g_strstrip (items[i]);
+    first = g_ascii_strtoull (item, &end, 10);
+    last = first;
+
+    if (end == item) {
+      ret = FALSE;
+      break;
+    }
+
+    if (*end == '-') {
+      item = end + 1;
+      last = g_ascii_strtoull (item, &end, 10);
+      if (end == item)
+        ret = FALSE;
+    }
+
+    if (*end != '\0' || last < first || last >= CPU_SETSIZE)
+      ret = FALSE;
+
+    for (; ret && first <= last; first++)
+      CPU_SET ((int) first, set);
+  }
+
+  g_strfreev (items);
+  return ret && CPU_COUNT (set) > 0;
+}
+#endif
+
+/**
+ * @brief Pin the calling thread to the CPUs and set its priority.
+ * @return TRUE if all given attributes are applied
+ * @param cpus The list of CPUs (e.g., 0,2-3). NULL or empty to keep the CPU affinity.
+ * @param priority The nice value (-20 to 19, lower runs first). 0 to keep the priority.
+ * @param saved The attributes before pinning, to be given to gst_tensor_thread_restore. NULL if not restored.
+ * @note The threads created by the calling thread inherit the attributes.
+ */
+gboolean
+gst_tensor_thread_pin (const gchar * cpus, gint priority, gpointer * saved)
+{
+  GstTensorThreadSaved *prev;
+  gboolean ret = TRUE;
+#ifdef __linux__
+  cpu_set_t set;
+  pid_t tid;
+
+  prev = g_new0 (GstTensorThreadSaved, 1);
+  tid = (pid_t) syscall (SYS_gettid);
+  prev->tid = tid;
+
+  if (cpus != NULL && cpus[0] != '\0') {
+    if (!gst_tensor_thread_parse_cpus (cpus, &set)) {
+      GST_WARNING ("Invalid CPU list '%s'", cpus);
+      ret = FALSE;
+    } else if (pthread_getaffinity_np (pthread_self (), sizeof (cpu_set_t),
+            &prev->cpus) != 0 ||
+        pthread_setaffinity_np (pthread_self (), sizeof (cpu_set_t),
+            &set) != 0) {
+      GST_WARNING ("Failed to set the CPU affinity to '%s'", cpus);
+      ret = FALSE;
+    } else {
+      prev->cpus_saved = TRUE;
+    }
+  }
+
+  if (priority != 0) {
+    /* with the thread id, setpriority applies to the calling thread only */
+    errno = 0;
+    prev->priority = getpriority (PRIO_PROCESS, tid);
+
+    if (errno != 0 || setpriority (PRIO_PROCESS, tid, priority) != 0) {
+      GST_WARNING ("Failed to set the nice value %d: %s", priority,
+          g_strerror (errno));
+      ret = FALSE;
+    } else {
+      prev->priority_saved = TRUE;
+    }
+  }
+#else
+  prev = g_new0 (GstTensorThreadSaved, 1);
+
+  if ((cpus != NULL && cpus[0] != '\0') || priority != 0) {
+    GST_WARNING ("The CPU affinity and the priority are not supported.");
+    ret = FALSE;
+  }
+#endif
+
+  if (saved)
+    *saved = prev;
+  else
+    g_free (prev);
+
+  return ret;
+}
+
+/**
+ * @brief Restore the CPU affinity and the priority of the thread pinned by gst_tensor_thread_pin.
+ * @param saved The attributes given by gst_tensor_thread_pin. This is freed.
+ * @note This may be called by another thread while the pinned thread is alive.
+ *       Raising the priority back may fail without the privilege (CAP_SYS_NICE).
+ */
+void
+gst_tensor_thread_restore (gpointer saved)
+{
+  GstTensorThreadSaved *prev;
+
+  prev = (GstTensorThreadSaved *) saved;
+  if (prev == NULL)
+    return;
+
+#ifdef __linux__
+  if (prev->cpus_saved &&
+      sched_setaffinity (prev->tid, sizeof (cpu_set_t), &prev->cpus) != 0)
+    GST_INFO ("Cannot restore the CPU affinity of the thread %d",
+        (gint) prev->tid);
+
+  if (prev->priority_saved &&
+      setpriority (PRIO_PROCESS, prev->tid, prev->priority) != 0)
+    GST_INFO ("Cannot restore the nice value %d", prev->priority);
+#endif
+
+  g_free (prev);
+}
@@ -448,5 +448,21 @@ extern gboolean gst_tensor_set_current_time(GstCollectPads *collect, GstClockTim
  */
 extern gboolean gst_gen_tensors_from_collectpad (GstCollectPads * collect, tensor_time_sync_data sync, GstClockTime current_time, gboolean *need_buffer, GstBuffer *tensors_buf, GstTensorsConfig *configs);
 
+/**
+ * @brief Pin the calling thread to the CPUs and set its priority (nice value).
+ * @return TRUE if all given attributes are applied
+ * @param cpus The list of CPUs (e.g., 0,2-3). NULL or empty to keep the CPU affinity.
+ * @param priority The nice value (-20 to 19). 0 to keep the priority.
+ * @param saved The attributes before pinning, to be given to gst_tensor_thread_restore. NULL if not restored.
+ */
+extern gboolean gst_tensor_thread_pin (const gchar * cpus, gint priority, gpointer * saved);
+
+/**
+ * @brief Restore the CPU affinity and the priority of the thread pinned by gst_tensor_thread_pin.
+ * @param saved The saved attributes, freed by this. NULL to do nothing.
+ * @note This may be called by another thread while the pinned thread is alive.
+ */
+extern void gst_tensor_thread_restore (gpointer saved);
+
 G_END_DECLS
 #endif /* __GST_TENSOR_COMMON_H__ */
@@ -24,6 +24,7 @@
  * How To for NNdevelopers:
  *
  * 1. Define struct, "NNStreamer_custom", with the functions defined.
+ *    Define struct, "NNStreamer_custom_ext", as well for the optional callbacks (e.g., in_place_invoke).
  * 2. Compile as a shared object. (.so in Linux)
  * 3. Use NNStreamer (tensor_filter framework=custom, model=FILEPATH_OF_YOUR_SO.so, ...)
  *
@@ -108,6 +109,49 @@ typedef int (*NNS_custom_invoke) (void *private_data,
 typedef int (*NNS_custom_allocate_invoke) (void *private_data,
     const GstTensorFilterProperties * prop, const GstTensorMemory * input, GstTensorMemory * output);
 
+/**
+ * @brief Release the output tensor owned by the custom filter, returned by allocate_invoke_release.
+ * @param[in] user_data The user data given with the output tensor.
+ */
+typedef void (*NNS_custom_release_func) (void *user_data);
+
+/**
+ * @brief Invoke the "main function". The output tensors are the memory blocks owned by the custom filter (e.g., a ring buffer), which flow downstream without copy.
+ * @param[in] private_data The pointer returned by NNStreamer_custom_init.
+ * @param[in] prop GstTensorFilter's property values. Do not change its values.
+ * @param[in] input The array of input tensors, each tensor size = dim1 x dim2 x dim3 x dim4 x typesize, allocated by caller
+ * @param[out] output The array of output tensors, each tensor size = dim1 x dim2 x dim3 x dim4 x typesize, the memory block for output tensor should be given. (data in GstTensorMemory)
+ * @param[out] release The array of callbacks. release[i] is called with user_data[i] when the last buffer referring output[i] is released. If release[i] is NULL, output[i].data is freed with free().
+ * @param[out] user_data The array of user data for release. release may be called after exitfunc; user_data should hold everything release needs.
+ * @return 0 if success
+ */
+typedef int (*NNS_custom_allocate_invoke_release) (void *private_data,
+    const GstTensorFilterProperties * prop, const GstTensorMemory * input, GstTensorMemory * output,
+    NNS_custom_release_func * release, void **user_data);
+
+/**
+ * @brief Invoke the "main function" in-place. The output tensors overwrite the input tensors.
+ * @param[in] private_data The pointer returned by NNStreamer_custom_init.
+ * @param[in] prop GstTensorFilter's property values. Do not change its values.
+ * @param[in/out] data The array of tensors. Filled with the input tensors by caller, each output tensor is supposed to be written into the same memory block. The size of each output tensor is the same as the input tensor.
+ * @return 0 if success
+ */
+typedef int (*NNS_custom_in_place_invoke) (void *private_data,
+    const GstTensorFilterProperties * prop, GstTensorMemory * data);
+
+/**
+ * @brief Invoke the "main function" once with a batch of frames. Without allocating output buffer. (fill in the given output buffer)
+ * @param[in] private_data The pointer returned by NNStreamer_custom_init.
+ * @param[in] prop GstTensorFilter's property values. Do not change its values.
+ * @param[in] input The array of input tensors of all frames, allocated by caller. The i-th tensor of the b-th frame is input[b * prop->input_meta.num_tensors + i].
+ * @param[out] output The array of output tensors of all frames, allocated by caller. The i-th tensor of the b-th frame is output[b * prop->output_meta.num_tensors + i].
+ * @param[in] batch The number of frames.
+ * @return 0 if success. Otherwise, tensor_filter calls invoke for each frame.
+ */
+typedef int (*NNS_custom_invoke_batch) (void *private_data,
+    const GstTensorFilterProperties * prop, const GstTensorMemory * input, GstTensorMemory * output,
+    unsigned int batch);
+
 /**
  * @brief Custom Filter Class
  *
@@ -120,8 +164,8 @@ struct _NNStreamer_custom_class
   NNS_custom_get_input_dimension getInputDim; /**< a custom filter is required to provide input tensor dimension unless setInputdim is defined. */
   NNS_custom_get_output_dimension getOutputDim; /**< a custom filter is require dto provide output tensor dimension unless setInputDim is defined. */
   NNS_custom_set_input_dimension setInputDim; /**< without getI/O-Dim, this allows framework to set input dimension and get output dimension from the custom filter according to the input dimension */
-  NNS_custom_invoke invoke; /**< the main function, "invoke", that transforms input to output. invoke is supposed to fill in the given output buffer. (invoke) XOR (allocate_invoke) MUST hold. */
-  NNS_custom_allocate_invoke allocate_invoke; /**< the main function, "allocate & invoke", that transforms input to output. allocate_invoke is supposed to allocate output buffer by itself. (invoke) XOR (allocate_invoke) MUST hold. */
+  NNS_custom_invoke invoke; /**< the main function, "invoke", that transforms input to output. invoke is supposed to fill in the given output buffer. (invoke) XOR (allocate_invoke or allocate_invoke_release of NNStreamer_custom_ext) MUST hold. */
+  NNS_custom_allocate_invoke allocate_invoke; /**< the main function, "allocate & invoke", that transforms input to output. allocate_invoke is supposed to allocate output buffer by itself. (invoke) XOR (allocate_invoke or allocate_invoke_release of NNStreamer_custom_ext) MUST hold. */
 };
 typedef struct _NNStreamer_custom_class NNStreamer_custom_class;
 
@@ -130,4 +174,26 @@ typedef struct _NNStreamer_custom_class NNStreamer_custom_class;
  */
 extern NNStreamer_custom_class *NNStreamer_custom;
 
+/**
+ * @brief Optional callbacks of Custom Filter, added after NNStreamer_custom_class.
+ *
+ * The layout of NNStreamer_custom_class is fixed, the custom filters built before export it without new fields.
+ * The callbacks added later are given with another symbol, NNStreamer_custom_ext, which is optional.
+ * Set size to sizeof (NNStreamer_custom_ext_class). tensor_filter reads the fields within the given size only,
+ * and new fields are appended at the end; thus, a custom filter built with an older header keeps working.
+ */
+struct _NNStreamer_custom_ext_class
+{
+  unsigned int size; /**< sizeof (NNStreamer_custom_ext_class) of the header the custom filter is built with */
+  NNS_custom_in_place_invoke in_place_invoke; /**< optional. the main function, "invoke in-place", that overwrites input with output. tensor_filter calls this instead of invoke if each output tensor has the same size as the input tensor. This requires invoke as well, which is called if in-place mode is not available. */
+  NNS_custom_allocate_invoke_release allocate_invoke_release; /**< the main function, "allocate & invoke" with the memory blocks owned by the custom filter and the callbacks to release them. This may be given instead of allocate_invoke. */
+  NNS_custom_invoke_batch invoke_batch; /**< optional. the main function, "invoke a batch", that transforms the input tensors of multiple frames at once. tensor_filter calls this instead of invoke with the property batch-size. This requires invoke as well, which is called for each frame if this fails or in-place mode is used. */
+};
+typedef struct _NNStreamer_custom_ext_class NNStreamer_custom_ext_class;
+
+/**
+ * @brief A custom filter MAY define NNStreamer_custom_ext for the optional callbacks.
+ */
+extern NNStreamer_custom_ext_class *NNStreamer_custom_ext;
+
 #endif /*__NNS_TENSOR_FILTER_CUSTOM_H__*/
@@ -100,8 +100,9 @@ typedef enum _nnfw_type
 
   _T_F_CUSTOM, /**< Custom filter provided as a shared object (dysym) */
   _T_F_TENSORFLOW_LITE, /**< In Progress */
-  _T_F_TENSORFLOW, /**< NYI */
+  _T_F_TENSORFLOW, /**< In Progress */
   _T_F_CAFFE2, /**< NYI */
+  _T_F_NNSCPU, /**< Built-in CPU engine, without external libraries */
 
   _T_F_NNFW_END,
 } nnfw_type;
@@ -155,6 +156,9 @@ typedef struct _GstTensorFilterProperties
   GstTensorsInfo output_meta; /**< configured output tensor info */
 
   const char *custom_properties; /**< sub-plugin specific custom property values in string */
+
+  const char *cpu_affinity; /**< The CPUs (e.g., 0,2-3) for the threads invoking the model. NULL for all CPUs. Sub-plugins may pin their threads with it */
+  int thread_priority; /**< The nice value of the threads invoking the model. 0 to keep the priority */
 } GstTensorFilterProperties;
 
 #endif /*__GST_TENSOR_TYPEDEF_H__*/
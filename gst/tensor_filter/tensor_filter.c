@@ -55,6 +55,7 @@
 #include <gst/gstinfo.h>
 #include <gst/gst.h>
 #include <glib.h>
+#include <stdio.h>
 #include <string.h>
 
 #include "tensor_filter.h"
@@ -121,6 +122,7 @@ GstTensorFilterFramework *tensor_filter_supported[] = {
   [_T_F_TENSORFLOW] = NULL,
 #endif
   [_T_F_CAFFE2] = NULL,
+  [_T_F_NNSCPU] = &NNS_support_nnscpu,
 
   0,
 };
@@ -132,6 +134,7 @@ const char *nnfw_names[] = {
   [_T_F_TENSORFLOW_LITE] = "tensorflow-lite",
   [_T_F_TENSORFLOW] = "tensorflow",
   [_T_F_CAFFE2] = "caffe2",
+  [_T_F_NNSCPU] = "nnscpu",
 
   0,
 };
@@ -153,8 +156,123 @@ enum
   PROP_OUTPUT,
   PROP_OUTPUTTYPE,
   PROP_CUSTOM,
+  PROP_MIN_BUFFERS,
+  PROP_MAX_BUFFERS,
+  PROP_MAX_INFLIGHT,
+  PROP_BATCH_SIZE,
+  PROP_BATCH_TIMEOUT,
+  PROP_STATS_INTERVAL,
+  PROP_INVOKE_COUNT,
+  PROP_INVOKE_RATE,
+  PROP_LATENCY_LAST,
+  PROP_LATENCY_AVG,
+  PROP_LATENCY_MIN,
+  PROP_LATENCY_MAX,
+  PROP_LATENCY_P50,
+  PROP_LATENCY_P99,
+  PROP_THROTTLE,
+  PROP_SKIPPED_COUNT,
+  PROP_WARMUP,
+  PROP_WARMUP_TIME,
+  PROP_STATE_INPUTS,
+  PROP_STATE_OUTPUTS,
+  PROP_SWAP_LATENCY,
+  PROP_SWAP_DROPPED,
+  PROP_INPUT_COMBINATION,
+  PROP_OUTPUT_COMBINATION,
+  PROP_CPU_AFFINITY,
+  PROP_THREAD_PRIORITY,
 };
 
+/**
+ * @brief Default number of buffers to be pre-allocated in the pool.
+ */
+#define DEFAULT_MIN_BUFFERS 2
+
+/**
+ * @brief Default maximum number of buffers in the pool (0 for unlimited).
+ */
+#define DEFAULT_MAX_BUFFERS 0
+
+/**
+ * @brief Default maximum number of in-flight frames (0 for synchronous invoke).
+ */
+#define DEFAULT_MAX_INFLIGHT 0
+
+/**
+ * @brief Default number of frames invoked at once.
+ */
+#define DEFAULT_BATCH_SIZE 1
+
+/**
+ * @brief Maximum number of frames invoked at once.
+ */
+#define MAX_BATCH_SIZE 1024
+
+/**
+ * @brief Default timeout (ms) to invoke a partial batch (0 to wait for a full batch).
+ */
+#define DEFAULT_BATCH_TIMEOUT 0
+
+/**
+ * @brief Default interval (ms) to post the statistics message (0 to disable).
+ */
+#define DEFAULT_STATS_INTERVAL 0
+
+/**
+ * @brief Default throttle mode (FALSE to invoke every frame).
+ */
+#define DEFAULT_THROTTLE FALSE
+
+/**
+ * @brief Default number of dummy invokes to warm up the model (0 to open the model lazily).
+ */
+#define DEFAULT_WARMUP 0
+
+/**
+ * @brief Default nice value of the threads invoking the model (0 to keep the priority).
+ */
+#define DEFAULT_THREAD_PRIORITY 0
+
+/**
+ * @brief The last generation of cpu-affinity and thread-priority given to any element.
+ */
+static gint thread_conf_last = 0;
+
+/**
+ * @brief The generation of cpu-affinity and thread-priority applied to an invoke thread.
+ */
+typedef struct
+{
+  gint conf; /**< the generation of the properties applied to the thread */
+  gpointer saved; /**< the attributes before pinning, from gst_tensor_thread_pin */
+} GstTensorFilterThreadConf;
+
+/**
+ * @brief Free the generation applied to an invoke thread, without restoring the thread.
+ */
+static void
+gst_tensor_filter_thread_conf_free (gpointer data)
+{
+  GstTensorFilterThreadConf *applied;
+
+  applied = (GstTensorFilterThreadConf *) data;
+  g_free (applied->saved);
+  g_free (applied);
+}
+
+/**
+ * @brief The state of the hot model swap.
+ */
+typedef enum
+{
+  SWAP_NONE = 0, /**< no new model */
+  SWAP_LOADING, /**< the new model file is being read ahead */
+  SWAP_READY, /**< the new model is ready, opened and swapped before the next invoke */
+  SWAP_FAILED, /**< failed to load the new model, the old one is kept */
+  SWAP_DONE, /**< swapped or cancelled */
+} GstTensorFilterSwapState;
+
 /**
  * @brief Default caps string for both sink and source pad.
  */
@@ -176,6 +294,103 @@ static GstStaticPadTemplate src_factory = GST_STATIC_PAD_TEMPLATE ("src",
     GST_PAD_ALWAYS,
     GST_STATIC_CAPS (CAPS_STRING));
 
+/**
+ * @brief Buffer pool for tensor_filter.
+ *
+ * Each buffer in this pool has one memory block per tensor,
+ * which is the memory layout of other/tensor and other/tensors.
+ * Recycling these buffers avoids allocating memory blocks for every frame.
+ */
+typedef struct
+{
+  GstBufferPool parent; /**< parent object */
+  GstTensorsInfo info; /**< tensors info of the buffers in this pool */
+} GstTensorFilterPool;
+
+/**
+ * @brief GstTensorFilterPoolClass inherits GstBufferPoolClass.
+ */
+typedef struct
+{
+  GstBufferPoolClass parent_class; /**< parent class */
+} GstTensorFilterPoolClass;
+
+#define GST_TYPE_TENSOR_FILTER_POOL (gst_tensor_filter_pool_get_type ())
+#define GST_TENSOR_FILTER_POOL_CAST(obj) ((GstTensorFilterPool *)(obj))
+
+G_DEFINE_TYPE (GstTensorFilterPool, gst_tensor_filter_pool,
+    GST_TYPE_BUFFER_POOL);
+
+/**
+ * @brief Allocate a buffer with the memory blocks for all tensors.
+ */
+static GstFlowReturn
+gst_tensor_filter_pool_alloc_buffer (GstBufferPool * pool,
+    GstBuffer ** buffer, GstBufferPoolAcquireParams * params)
+{
+  GstTensorFilterPool *self;
+  GstBuffer *buf;
+  GstMemory *mem;
+  guint i;
+
+  self = GST_TENSOR_FILTER_POOL_CAST (pool);
+  buf = gst_buffer_new ();
+
+  for (i = 0; i < self->info.num_tensors; i++) {
+    mem = gst_allocator_alloc (NULL,
+        gst_tensor_info_get_size (&self->info.info[i]), NULL);
+
+    if (mem == NULL) {
+      GST_ERROR_OBJECT (pool, "Failed to allocate memory for tensor %u", i);
+      gst_buffer_unref (buf);
+      return GST_FLOW_ERROR;
+    }
+
+    gst_buffer_append_memory (buf, mem);
+  }
+
+  *buffer = buf;
+  return GST_FLOW_OK;
+}
+
+/**
+ * @brief initialize the class of tensor_filter buffer pool
+ */
+static void
+gst_tensor_filter_pool_class_init (GstTensorFilterPoolClass * klass)
+{
+  GstBufferPoolClass *pool_class;
+
+  pool_class = (GstBufferPoolClass *) klass;
+  pool_class->alloc_buffer = gst_tensor_filter_pool_alloc_buffer;
+}
+
+/**
+ * @brief initialize the new buffer pool
+ */
+static void
+gst_tensor_filter_pool_init (GstTensorFilterPool * pool)
+{
+  gst_tensors_info_init (&pool->info);
+}
+
+/**
+ * @brief Create a new buffer pool for the given tensors.
+ * @param info tensors info of the buffers in this pool
+ * @return newly created buffer pool (not configured yet)
+ */
+static GstBufferPool *
+gst_tensor_filter_pool_new (const GstTensorsInfo * info)
+{
+  GstTensorFilterPool *pool;
+
+  pool = g_object_new (GST_TYPE_TENSOR_FILTER_POOL, NULL);
+  gst_object_ref_sink (pool);
+
+  pool->info = *info;
+  return GST_BUFFER_POOL_CAST (pool);
+}
+
 #define gst_tensor_filter_parent_class parent_class
 G_DEFINE_TYPE (GstTensorFilter, gst_tensor_filter, GST_TYPE_BASE_TRANSFORM);
 
@@ -184,6 +399,11 @@ static void gst_tensor_filter_set_property (GObject * object, guint prop_id,
     const GValue * value, GParamSpec * pspec);
 static void gst_tensor_filter_get_property (GObject * object, guint prop_id,
     GValue * value, GParamSpec * pspec);
+static void gst_tensor_filter_finalize (GObject * object);
+
+/* GstElement vmethod implementations */
+static GstStateChangeReturn gst_tensor_filter_change_state (GstElement *
+    element, GstStateChange transition);
 
 /* GstBaseTransform vmethod implementations */
 static GstFlowReturn gst_tensor_filter_transform (GstBaseTransform * trans,
@@ -199,9 +419,38 @@ static gboolean gst_tensor_filter_set_caps (GstBaseTransform * trans,
 static gboolean gst_tensor_filter_transform_size (GstBaseTransform * trans,
     GstPadDirection direction, GstCaps * caps, gsize size,
     GstCaps * othercaps, gsize * othersize);
+static gboolean gst_tensor_filter_decide_allocation (GstBaseTransform * trans,
+    GstQuery * query);
+static gboolean gst_tensor_filter_propose_allocation (GstBaseTransform *
+    trans, GstQuery * decide_query, GstQuery * query);
 static gboolean gst_tensor_filter_start (GstBaseTransform * trans);
+static void gst_tensor_filter_stats_reset (GstTensorFilter * self);
 static gboolean gst_tensor_filter_stop (GstBaseTransform * trans);
 
+/* Asynchronous invoke */
+static GstFlowReturn gst_tensor_filter_generate_output (GstBaseTransform *
+    trans, GstBuffer ** outbuf);
+static gboolean gst_tensor_filter_sink_event (GstBaseTransform * trans,
+    GstEvent * event);
+
+/* QoS and throttle */
+static GstFlowReturn gst_tensor_filter_submit_input_buffer (GstBaseTransform *
+    trans, gboolean is_discont, GstBuffer * inbuf);
+
+/* Negotiation cache */
+static void gst_tensor_filter_dim_cache_clear (GstTensorFilter * self);
+
+/* Recurrent state tensors */
+static void gst_tensor_filter_state_reset (GstTensorFilter * self);
+
+/* Hot model swap */
+static void gst_tensor_filter_swap_start (GstTensorFilter * self,
+    gchar * model_file);
+static void gst_tensor_filter_swap_commit (GstTensorFilter * self);
+static void gst_tensor_filter_swap_join (GstTensorFilter * self,
+    gboolean commit);
+static void gst_tensor_filter_swap_post (GstTensorFilter * self);
+
 /**
  * @brief Open nn framework.
  */
@@ -224,6 +473,7 @@ static gboolean gst_tensor_filter_stop (GstBaseTransform * trans);
         if (filter->fw && filter->fw->close) \
           filter->fw->close (filter, &filter->privateData); \
         filter->prop.fw_opened = FALSE; \
+        gst_tensors_info_init (&filter->dim_applied); \
       } \
     } while (0)
 
@@ -254,6 +504,10 @@ gst_tensor_filter_class_init (GstTensorFilterClass * klass)
 
   gobject_class->set_property = gst_tensor_filter_set_property;
   gobject_class->get_property = gst_tensor_filter_get_property;
+  gobject_class->finalize = gst_tensor_filter_finalize;
+
+  gstelement_class->change_state =
+      GST_DEBUG_FUNCPTR (gst_tensor_filter_change_state);
 
   g_object_class_install_property (gobject_class, PROP_SILENT,
       g_param_spec_boolean ("silent", "Silent", "Produce verbose output",
@@ -286,6 +540,138 @@ gst_tensor_filter_class_init (GstTensorFilterClass * klass)
       g_param_spec_string ("custom", "Custom properties for subplugins",
           "Custom properties for subplugins ?", "",
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_MIN_BUFFERS,
+      g_param_spec_uint ("min-buffers", "Min buffers",
+          "The number of output buffers to be pre-allocated in the buffer pool",
+          0, G_MAXUINT, DEFAULT_MIN_BUFFERS,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_MAX_BUFFERS,
+      g_param_spec_uint ("max-buffers", "Max buffers",
+          "The maximum number of output buffers in the buffer pool (0 for unlimited)",
+          0, G_MAXUINT, DEFAULT_MAX_BUFFERS,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_MAX_INFLIGHT,
+      g_param_spec_uint ("max-inflight", "Max in-flight",
+          "The maximum number of frames being invoked asynchronously "
+          "(0 for synchronous invoke). Applied when the element starts",
+          0, G_MAXUINT, DEFAULT_MAX_INFLIGHT,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_BATCH_SIZE,
+      g_param_spec_uint ("batch-size", "Batch size",
+          "The number of frames invoked at once. "
+          "The sub-plugin invokes each frame if it does not support batch invoke",
+          1, MAX_BATCH_SIZE, DEFAULT_BATCH_SIZE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_BATCH_TIMEOUT,
+      g_param_spec_uint ("batch-timeout-ms", "Batch timeout",
+          "The time (ms) to wait for a full batch after the first frame of "
+          "the batch arrives (0 to wait for a full batch). With max-inflight, "
+          "the partial batch is invoked when the timeout expires; otherwise, "
+          "it is checked when the next frame arrives",
+          0, G_MAXUINT, DEFAULT_BATCH_TIMEOUT,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_STATS_INTERVAL,
+      g_param_spec_uint ("stats-interval", "Statistics interval",
+          "The interval (ms) to post the element message \"tensor_filter-stats\" "
+          "with the invoke statistics on the bus (0 to disable)",
+          0, G_MAXINT, DEFAULT_STATS_INTERVAL,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_INVOKE_COUNT,
+      g_param_spec_uint64 ("invoke-count", "Invoke count",
+          "The number of invokes since the element starts",
+          0, G_MAXUINT64, 0, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_INVOKE_RATE,
+      g_param_spec_double ("invoke-rate", "Invoke rate",
+          "The number of invoked frames per second since the first invoke",
+          0.0, G_MAXDOUBLE, 0.0, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_LATENCY_LAST,
+      g_param_spec_uint ("latency-last", "Last latency",
+          "The latency (us) of the last invoke",
+          0, G_MAXUINT, 0, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_LATENCY_AVG,
+      g_param_spec_uint ("latency-avg", "Average latency",
+          "The average latency (us) of invokes",
+          0, G_MAXUINT, 0, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_LATENCY_MIN,
+      g_param_spec_uint ("latency-min", "Minimum latency",
+          "The minimum latency (us) of invokes",
+          0, G_MAXUINT, 0, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_LATENCY_MAX,
+      g_param_spec_uint ("latency-max", "Maximum latency",
+          "The maximum latency (us) of invokes",
+          0, G_MAXUINT, 0, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_LATENCY_P50,
+      g_param_spec_uint ("latency-p50", "Median latency",
+          "The median latency (us) of invokes, estimated with a histogram",
+          0, G_MAXUINT, 0, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_LATENCY_P99,
+      g_param_spec_uint ("latency-p99", "99th percentile latency",
+          "The 99th percentile latency (us) of invokes, estimated with a histogram",
+          0, G_MAXUINT, 0, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_THROTTLE,
+      g_param_spec_boolean ("throttle", "Throttle",
+          "Skip frames if the model cannot keep up with the input rate. "
+          "This enables QoS and skips the frames arriving faster than the "
+          "measured invoke time", DEFAULT_THROTTLE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_SKIPPED_COUNT,
+      g_param_spec_uint64 ("skipped-count", "Skipped count",
+          "The number of frames skipped by QoS or throttle since the element starts",
+          0, G_MAXUINT64, 0, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_WARMUP,
+      g_param_spec_uint ("warmup", "Warm-up",
+          "The number of dummy invokes with zero-filled tensors to warm up "
+          "the model. If this is not 0, the model is opened when the element "
+          "goes to READY state", 0, G_MAXUINT, DEFAULT_WARMUP,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_WARMUP_TIME,
+      g_param_spec_uint64 ("warmup-time", "Warm-up time",
+          "The time (us) to open and warm up the model (0 if not warmed up)",
+          0, G_MAXUINT64, 0, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_STATE_INPUTS,
+      g_param_spec_string ("state-inputs", "State inputs",
+          "The indices of input tensors given by the element, which are the "
+          "state tensors fed back from state-outputs of the previous invoke "
+          "(e.g., 0,1). These are not in the input buffer",
+          "", G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_STATE_OUTPUTS,
+      g_param_spec_string ("state-outputs", "State outputs",
+          "The indices of output tensors fed back to state-inputs of the "
+          "next invoke, in the same order (e.g., 0,1)",
+          "", G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_SWAP_LATENCY,
+      g_param_spec_uint64 ("swap-latency", "Swap latency",
+          "The time (us) from the model given while streaming to the first "
+          "invoke with it (0 if not swapped)",
+          0, G_MAXUINT64, 0, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_SWAP_DROPPED,
+      g_param_spec_uint ("swap-dropped", "Swap dropped",
+          "The number of frames dropped by the last model swap, waiting for "
+          "the caps of the new model (0 if the tensors are not changed)",
+          0, G_MAXUINT, 0, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_INPUT_COMBINATION,
+      g_param_spec_string ("input-combination", "Input combination",
+          "The indices of tensors in the input buffer given to the model as "
+          "the input tensors, in order (e.g., 2,0). Empty for all tensors",
+          "", G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_OUTPUT_COMBINATION,
+      g_param_spec_string ("output-combination", "Output combination",
+          "The tensors in the output buffer, the input tensors passed through "
+          "(iN) and the output tensors of the model (oN), in order "
+          "(e.g., i0,o0,o1). Empty for the output tensors of the model",
+          "", G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_CPU_AFFINITY,
+      g_param_spec_string ("cpu-affinity", "CPU affinity",
+          "The CPUs to run the threads invoking the model: the streaming "
+          "thread, or the workers with max-inflight (e.g., 0,2-3). "
+          "The sub-plugin may pin its threads with it. Empty for all CPUs",
+          "", G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_THREAD_PRIORITY,
+      g_param_spec_int ("thread-priority", "Thread priority",
+          "The nice value of the threads invoking the model (lower runs "
+          "first, negative values need the privilege). 0 to keep the priority",
+          -20, 19, DEFAULT_THREAD_PRIORITY,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
   gst_element_class_set_details_simple (gstelement_class,
       "Tensor_Filter",
@@ -315,10 +701,23 @@ gst_tensor_filter_class_init (GstTensorFilterClass * klass)
   /* Allocation units */
   trans_class->transform_size =
       GST_DEBUG_FUNCPTR (gst_tensor_filter_transform_size);
+  trans_class->decide_allocation =
+      GST_DEBUG_FUNCPTR (gst_tensor_filter_decide_allocation);
+  trans_class->propose_allocation =
+      GST_DEBUG_FUNCPTR (gst_tensor_filter_propose_allocation);
 
   /* start/stop to call open/close */
   trans_class->start = GST_DEBUG_FUNCPTR (gst_tensor_filter_start);
   trans_class->stop = GST_DEBUG_FUNCPTR (gst_tensor_filter_stop);
+
+  /* Asynchronous invoke */
+  trans_class->generate_output =
+      GST_DEBUG_FUNCPTR (gst_tensor_filter_generate_output);
+  trans_class->sink_event = GST_DEBUG_FUNCPTR (gst_tensor_filter_sink_event);
+
+  /* QoS and throttle */
+  trans_class->submit_input_buffer =
+      GST_DEBUG_FUNCPTR (gst_tensor_filter_submit_input_buffer);
 }
 
 /**
@@ -341,6 +740,8 @@ gst_tensor_filter_init (GstTensorFilter * self)
   prop->output_configured = FALSE;
   prop->model_file = NULL;
   prop->custom_properties = NULL;
+  prop->cpu_affinity = NULL;
+  prop->thread_priority = DEFAULT_THREAD_PRIORITY;
   gst_tensors_info_init (&prop->input_meta);
   gst_tensors_info_init (&prop->output_meta);
 
@@ -351,6 +752,331 @@ gst_tensor_filter_init (GstTensorFilter * self)
   self->configured = FALSE;
   gst_tensors_config_init (&self->in_config);
   gst_tensors_config_init (&self->out_config);
+  self->min_buffers = DEFAULT_MIN_BUFFERS;
+  self->max_buffers = DEFAULT_MAX_BUFFERS;
+
+  self->max_inflight = DEFAULT_MAX_INFLIGHT;
+  self->workers = NULL;
+  g_queue_init (&self->inflight);
+  g_mutex_init (&self->inflight_lock);
+  g_cond_init (&self->inflight_cond);
+  self->flushing = FALSE;
+  self->pushing = FALSE;
+  self->last_ret = GST_FLOW_OK;
+
+  self->batch_size = DEFAULT_BATCH_SIZE;
+  self->batch_timeout = DEFAULT_BATCH_TIMEOUT;
+  self->batch = NULL;
+  self->batch_deadline = 0;
+  g_queue_init (&self->outbufs);
+
+  self->stats_interval = DEFAULT_STATS_INTERVAL;
+  self->throttle = DEFAULT_THROTTLE;
+  self->throttle_last_ts = GST_CLOCK_TIME_NONE;
+  self->num_threads = 1;
+  g_mutex_init (&self->stats.lock);
+  gst_tensor_filter_stats_reset (self);
+
+  self->warmup = DEFAULT_WARMUP;
+  self->warmup_time = 0;
+
+  g_mutex_init (&self->dim_lock);
+  g_queue_init (&self->dim_cache);
+  gst_tensors_info_init (&self->dim_applied);
+  self->dim_cache_hits = 0;
+  self->dim_cache_misses = 0;
+  self->dim_negotiated = FALSE;
+
+  self->num_state_in = 0;
+  self->num_state_out = 0;
+  memset (self->state_mem, 0, sizeof (self->state_mem));
+  memset (self->state_spare, 0, sizeof (self->state_spare));
+
+  self->num_combi_in = 0;
+  self->num_combi_out = 0;
+
+  self->thread_conf = 0;
+  self->thread_applied = g_hash_table_new_full (g_direct_hash, g_direct_equal,
+      NULL, gst_tensor_filter_thread_conf_free);
+
+  self->swap_thread = NULL;
+  g_mutex_init (&self->swap_lock);
+  g_cond_init (&self->swap_cond);
+  self->swap_state = SWAP_NONE;
+  self->swap_model = NULL;
+  self->swap_latency = 0;
+  self->swap_dropped = 0;
+  self->swap_wait_caps = FALSE;
+}
+
+/**
+ * @brief Reset the invoke statistics.
+ * @param self "this" pointer
+ */
+static void
+gst_tensor_filter_stats_reset (GstTensorFilter * self)
+{
+  GstTensorFilterStats *stats;
+  guint i;
+
+  stats = &self->stats;
+
+  g_mutex_lock (&stats->lock);
+  stats->first = -1;
+  stats->last_end = 0;
+  stats->next_post = 0;
+  stats->count = 0;
+  stats->frames = 0;
+  stats->skipped = 0;
+  stats->total = 0;
+  stats->last = 0;
+  stats->min = G_MAXUINT;
+  stats->max = 0;
+
+  for (i = 0; i < GST_TENSOR_FILTER_STATS_BUCKETS; i++)
+    stats->histogram[i] = 0;
+  g_mutex_unlock (&stats->lock);
+}
+
+/**
+ * @brief Get the histogram bucket of the latency.
+ * @param latency the latency (usec)
+ */
+static guint
+gst_tensor_filter_stats_bucket (guint latency)
+{
+  guint e;
+
+  if (latency < 8)
+    return latency;
+
+  /* floor (log2 (latency)) >= 3, then 8 buckets for each power of two */
+  e = g_bit_storage ((gulong) latency) - 1;
+  return (e - 2) * 8 + ((latency >> (e - 3)) & 7);
+}
+
+/**
+ * @brief Get the latency (usec) represented by the histogram bucket (the middle of the bucket).
+ */
+static guint
+gst_tensor_filter_stats_bucket_value (guint bucket)
+{
+  guint e, lower, width;
+
+  if (bucket < 8)
+    return bucket;
+
+  e = bucket / 8 + 2;
+  width = 1U << (e - 3);
+  lower = (8 + bucket % 8) * width;
+  return lower + width / 2;
+}
+
+/**
+ * @brief Estimate the percentile of the latency with the histogram.
+ * @param self "this" pointer
+ * @param percent the percentile (0 ~ 100)
+ * @return the latency (usec). 0 if not invoked.
+ * @note Called with the lock of the statistics.
+ */
+static guint
+gst_tensor_filter_stats_percentile (GstTensorFilter * self, guint percent)
+{
+  guint64 target, sum = 0;
+  guint i;
+
+  if (self->stats.count == 0)
+    return 0;
+
+  /* the rank of the percentile, rounded up */
+  target = (self->stats.count * percent + 99) / 100;
+  target = MAX (target, 1);
+
+  for (i = 0; i < GST_TENSOR_FILTER_STATS_BUCKETS; i++) {
+    sum += self->stats.histogram[i];
+    if (sum >= target)
+      break;
+  }
+
+  return gst_tensor_filter_stats_bucket_value (MIN (i,
+          GST_TENSOR_FILTER_STATS_BUCKETS - 1));
+}
+
+/**
+ * @brief Get the average latency (usec) of invokes.
+ * @note Called with the lock of the statistics.
+ */
+static guint
+gst_tensor_filter_stats_avg (GstTensorFilter * self)
+{
+  if (self->stats.count == 0)
+    return 0;
+
+  return (guint) (self->stats.total / self->stats.count);
+}
+
+/**
+ * @brief Get the minimum latency (usec) of invokes.
+ * @note Called with the lock of the statistics.
+ */
+static guint
+gst_tensor_filter_stats_min (GstTensorFilter * self)
+{
+  if (self->stats.count == 0)
+    return 0;
+
+  return self->stats.min;
+}
+
+/**
+ * @brief Get the number of invoked frames per second since the first invoke.
+ * @note Called with the lock of the statistics.
+ */
+static gdouble
+gst_tensor_filter_stats_rate (GstTensorFilter * self)
+{
+  gint64 first, last_end;
+
+  first = self->stats.first;
+  last_end = self->stats.last_end;
+
+  if (first < 0 || last_end <= first)
+    return 0.0;
+
+  return (gdouble) self->stats.frames * G_USEC_PER_SEC / (last_end - first);
+}
+
+/**
+ * @brief Get the invoke statistics for the element message "tensor_filter-stats".
+ * @param self "this" pointer
+ * @note Called with the lock of the statistics.
+ */
+static GstStructure *
+gst_tensor_filter_stats_structure (GstTensorFilter * self)
+{
+  return gst_structure_new ("tensor_filter-stats",
+      "invoke-count", G_TYPE_UINT64, self->stats.count,
+      "invoke-rate", G_TYPE_DOUBLE, gst_tensor_filter_stats_rate (self),
+      "latency-last", G_TYPE_UINT, self->stats.last,
+      "latency-avg", G_TYPE_UINT, gst_tensor_filter_stats_avg (self),
+      "latency-min", G_TYPE_UINT, gst_tensor_filter_stats_min (self),
+      "latency-max", G_TYPE_UINT, self->stats.max,
+      "latency-p50", G_TYPE_UINT, gst_tensor_filter_stats_percentile (self, 50),
+      "latency-p99", G_TYPE_UINT, gst_tensor_filter_stats_percentile (self, 99),
+      "skipped-count", G_TYPE_UINT64, self->stats.skipped, NULL);
+}
+
+/**
+ * @brief Record an invoke to the statistics. This may be called from multiple threads.
+ * @param self "this" pointer
+ * @param start the monotonic time (usec) when the invoke starts
+ * @param frames the number of invoked frames
+ */
+static void
+gst_tensor_filter_stats_record (GstTensorFilter * self, gint64 start,
+    guint frames)
+{
+  GstTensorFilterStats *stats;
+  GstStructure *s = NULL;
+  gint64 end;
+  guint latency, interval;
+
+  stats = &self->stats;
+  end = g_get_monotonic_time ();
+  latency = (guint) CLAMP (end - start, 0, G_MAXUINT);
+  interval = self->stats_interval;
+
+  g_mutex_lock (&stats->lock);
+  if (stats->first < 0)
+    stats->first = start;
+  stats->last_end = end;
+
+  stats->last = latency;
+  stats->total += latency;
+  stats->frames += frames;
+  stats->histogram[gst_tensor_filter_stats_bucket (latency)]++;
+  stats->min = MIN (stats->min, latency);
+  stats->max = MAX (stats->max, latency);
+  stats->count++;
+
+  if (interval > 0 && end >= stats->next_post) {
+    stats->next_post = end + (gint64) interval * 1000;
+    s = gst_tensor_filter_stats_structure (self);
+  }
+  g_mutex_unlock (&stats->lock);
+
+  /* post the message without the lock, the handler may read the properties */
+  if (s) {
+    gst_element_post_message (GST_ELEMENT_CAST (self),
+        gst_message_new_element (GST_OBJECT_CAST (self), s));
+  }
+}
+
+/**
+ * @brief Function to finalize instance.
+ */
+static void
+gst_tensor_filter_finalize (GObject * object)
+{
+  GstTensorFilter *self;
+
+  self = GST_TENSOR_FILTER (object);
+
+  gst_tensor_filter_swap_join (self, FALSE);
+  gst_tensor_filter_dim_cache_clear (self);
+  gst_tensor_filter_state_reset (self);
+
+  g_mutex_clear (&self->inflight_lock);
+  g_cond_clear (&self->inflight_cond);
+  g_mutex_clear (&self->swap_lock);
+  g_cond_clear (&self->swap_cond);
+  g_mutex_clear (&self->stats.lock);
+  g_mutex_clear (&self->dim_lock);
+  g_hash_table_destroy (self->thread_applied);
+
+  g_free ((gchar *) self->prop.cpu_affinity);
+
+  G_OBJECT_CLASS (parent_class)->finalize (object);
+}
+
+/**
+ * @brief Check whether the sub-plugin allocates the output tensors in invoke.
+ * @param self "this" pointer
+ * @return TRUE if the sub-plugin (for the opened model) allocates the output tensors
+ */
+static gboolean
+gst_tensor_filter_allocate_in_invoke (GstTensorFilter * self)
+{
+  g_assert (self->fw);
+
+  if (self->fw->allocateInInvoke == NULL)
+    return self->fw->allocate_in_invoke;
+
+  gst_tensor_filter_open_fw (self);
+  if (!self->prop.fw_opened)
+    return FALSE;
+
+  return self->fw->allocateInInvoke (self, &self->privateData);
+}
+
+/**
+ * @brief Check whether the sub-plugin may invoke in-place.
+ * @param self "this" pointer
+ * @return TRUE if the sub-plugin (for the opened model) allows in-place invoke
+ */
+static gboolean
+gst_tensor_filter_allow_in_place (GstTensorFilter * self)
+{
+  g_assert (self->fw);
+
+  if (self->fw->allowInPlace == NULL)
+    return self->fw->allow_in_place;
+
+  gst_tensor_filter_open_fw (self);
+  if (!self->prop.fw_opened)
+    return FALSE;
+
+  return self->fw->allowInPlace (self, &self->privateData);
 }
 
 /**
@@ -385,41 +1111,183 @@ gst_tensor_filter_out_size (GstTensorFilter * self, gint index)
 }
 
 /**
- * @brief Setter for tensor_filter properties.
+ * @brief Calculate input buffer size.
+ * @param self "this" pointer
+ * @return the size of all input tensors
  */
-static void
-gst_tensor_filter_set_property (GObject * object, guint prop_id,
-    const GValue * value, GParamSpec * pspec)
+static gsize
+gst_tensor_filter_in_size (GstTensorFilter * self)
 {
-  GstTensorFilter *self;
-  GstTensorFilterProperties *prop;
-  gchar *tmp;
+  GstTensorsInfo *info;
+  guint i;
+  gsize in_size = 0;
 
-  self = GST_TENSOR_FILTER (object);
-  prop = &self->prop;
+  info = &self->prop.input_meta;
 
-  silent_debug ("Setting property for prop %d.\n", prop_id);
+  for (i = 0; i < info->num_tensors; i++) {
+    in_size += gst_tensor_info_get_size (&info->info[i]);
+  }
 
-  switch (prop_id) {
-    case PROP_SILENT:
-      self->silent = g_value_get_boolean (value);
-      silent_debug ("Debug mode = %d", self->silent);
-      break;
-    case PROP_FRAMEWORK:
-      if (prop->nnfw != _T_F_UNDEFINED) {
-        gst_tensor_filter_close_fw (self);
-      }
-      prop->nnfw = find_key_strv (nnfw_names, g_value_get_string (value));
-      silent_debug ("Framework = %s\n", g_value_get_string (value));
-      if (prop->nnfw == -1 || prop->nnfw == _T_F_UNDEFINED) {
-        GST_WARNING ("Cannot identify the given neural network framework, %s\n",
-            g_value_get_string (value));
-        prop->nnfw = _T_F_UNDEFINED;
-        break;
-      }
-      if (tensor_filter_supported[prop->nnfw] == NULL) {
-        GST_WARNING
-            ("The given neural network framework is identified but not supported, %s\n",
+  return in_size;
+}
+
+/**
+ * @brief Parse the comma-separated indices of tensors.
+ * @param str the indices (e.g., "0,1")
+ * @param[out] indices the array of indices
+ * @return the number of indices
+ */
+static guint
+gst_tensor_filter_parse_indices (const gchar * str, guint * indices)
+{
+  gchar **str_idx;
+  guint i, num = 0;
+  gint64 val;
+
+  if (str == NULL)
+    return 0;
+
+  str_idx = g_strsplit (str, ",", -1);
+
+  for (i = 0; str_idx[i] != NULL && num < NNS_TENSOR_SIZE_LIMIT; i++) {
+    g_strstrip (str_idx[i]);
+    if (str_idx[i][0] == '\0')
+      continue;
+
+    val = g_ascii_strtoll (str_idx[i], NULL, 10);
+    if (val < 0 || val >= NNS_TENSOR_SIZE_LIMIT) {
+      GST_WARNING ("Invalid index of tensor: %s", str_idx[i]);
+      continue;
+    }
+
+    indices[num++] = (guint) val;
+  }
+
+  g_strfreev (str_idx);
+  return num;
+}
+
+/**
+ * @brief Get the comma-separated indices of tensors.
+ * @param indices the array of indices
+ * @param num the number of indices
+ * @return the newly allocated string
+ */
+static gchar *
+gst_tensor_filter_indices_string (const guint * indices, guint num)
+{
+  GString *str = g_string_new (NULL);
+  guint i;
+
+  for (i = 0; i < num; i++) {
+    g_string_append_printf (str, "%u", indices[i]);
+
+    if (i < num - 1)
+      g_string_append (str, ",");
+  }
+
+  return g_string_free (str, FALSE);
+}
+
+/**
+ * @brief Parse the tensors of the output buffer, the input tensors (iN) and the output tensors (oN) of the model.
+ * @param self "this" pointer
+ * @param str the comma-separated tensors (e.g., "i0,o0,o1")
+ * @return the number of tensors in the output buffer
+ */
+static guint
+gst_tensor_filter_parse_combination (GstTensorFilter * self, const gchar * str)
+{
+  gchar **str_idx;
+  gchar *end;
+  guint i, num = 0;
+  gint64 val;
+
+  if (str == NULL)
+    return 0;
+
+  str_idx = g_strsplit (str, ",", -1);
+
+  for (i = 0; str_idx[i] != NULL && num < NNS_TENSOR_SIZE_LIMIT; i++) {
+    g_strstrip (str_idx[i]);
+    if (str_idx[i][0] == '\0')
+      continue;
+
+    val = g_ascii_strtoll (str_idx[i] + 1, &end, 10);
+    if ((str_idx[i][0] != 'i' && str_idx[i][0] != 'o') ||
+        end == str_idx[i] + 1 || *end != '\0' ||
+        val < 0 || val >= NNS_TENSOR_SIZE_LIMIT) {
+      GST_WARNING ("Invalid tensor of the output buffer: %s", str_idx[i]);
+      continue;
+    }
+
+    self->combi_out_input[num] = (str_idx[i][0] == 'i');
+    self->combi_out[num++] = (guint) val;
+  }
+
+  g_strfreev (str_idx);
+  return num;
+}
+
+/**
+ * @brief Get the comma-separated tensors of the output buffer.
+ * @param self "this" pointer
+ * @return the newly allocated string
+ */
+static gchar *
+gst_tensor_filter_combination_string (GstTensorFilter * self)
+{
+  GString *str = g_string_new (NULL);
+  guint i;
+
+  for (i = 0; i < self->num_combi_out; i++) {
+    g_string_append_printf (str, "%c%u", self->combi_out_input[i] ? 'i' : 'o',
+        self->combi_out[i]);
+
+    if (i < self->num_combi_out - 1)
+      g_string_append (str, ",");
+  }
+
+  return g_string_free (str, FALSE);
+}
+
+/**
+ * @brief Setter for tensor_filter properties.
+ */
+static void
+gst_tensor_filter_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec)
+{
+  GstTensorFilter *self;
+  GstTensorFilterProperties *prop;
+  gchar *tmp;
+
+  self = GST_TENSOR_FILTER (object);
+  prop = &self->prop;
+
+  silent_debug ("Setting property for prop %d.\n", prop_id);
+
+  switch (prop_id) {
+    case PROP_SILENT:
+      self->silent = g_value_get_boolean (value);
+      silent_debug ("Debug mode = %d", self->silent);
+      break;
+    case PROP_FRAMEWORK:
+      if (prop->nnfw != _T_F_UNDEFINED) {
+        gst_tensor_filter_close_fw (self);
+      }
+      gst_tensor_filter_dim_cache_clear (self);
+      prop->nnfw = find_key_strv (nnfw_names, g_value_get_string (value));
+      silent_debug ("Framework = %s\n", g_value_get_string (value));
+      if (prop->nnfw == -1 || prop->nnfw == _T_F_UNDEFINED) {
+        GST_WARNING ("Cannot identify the given neural network framework, %s\n",
+            g_value_get_string (value));
+        prop->nnfw = _T_F_UNDEFINED;
+        break;
+      }
+      if (tensor_filter_supported[prop->nnfw] == NULL) {
+        GST_WARNING
+            ("The given neural network framework is identified but not supported, %s\n",
             g_value_get_string (value));
         prop->nnfw = _T_F_UNDEFINED;
         break;
@@ -433,14 +1301,30 @@ gst_tensor_filter_set_property (GObject * object, guint prop_id,
           || self->fw->setInputDimension);
       break;
     case PROP_MODEL:
+      /* while streaming, the new model is loaded in background and swapped between invokes */
+      if (value && prop->fw_opened && self->configured &&
+          GST_STATE (self) >= GST_STATE_PAUSED) {
+        tmp = g_value_dup_string (value);
+        silent_debug ("Model = %s (swap)\n", tmp);
+        if (!g_file_test (tmp, G_FILE_TEST_IS_REGULAR)) {
+          GST_ERROR ("Cannot find the model file: %s\n", tmp);
+          g_free (tmp);
+        } else {
+          gst_tensor_filter_swap_start (self, tmp);
+        }
+        break;
+      }
+
       if (prop->model_file) {
         gst_tensor_filter_close_fw (self);
         g_free ((char *) prop->model_file);     /* g_free cannot handle const * */
+        prop->model_file = NULL;
       }
+      gst_tensor_filter_dim_cache_clear (self);
       if (!value) {
         break;
       }
-      /* Once configures, it cannot be changed in runtime */
+      /* not streaming, the model is opened with the first call */
       tmp = g_value_dup_string (value);
       silent_debug ("Model = %s\n", tmp);
       if (!g_file_test (tmp, G_FILE_TEST_IS_REGULAR)) {
@@ -535,6 +1419,88 @@ gst_tensor_filter_set_property (GObject * object, guint prop_id,
       g_free ((char *) prop->custom_properties);        /* g_free cannot handle const char * */
       prop->custom_properties = g_value_dup_string (value);
       silent_debug ("Custom Option = %s\n", prop->custom_properties);
+      /* the custom option may change the model (e.g., the input dimension) */
+      gst_tensor_filter_dim_cache_clear (self);
+      break;
+    case PROP_MIN_BUFFERS:
+      self->min_buffers = g_value_get_uint (value);
+      break;
+    case PROP_MAX_BUFFERS:
+      self->max_buffers = g_value_get_uint (value);
+      break;
+    case PROP_MAX_INFLIGHT:
+      self->max_inflight = g_value_get_uint (value);
+      silent_debug ("Max in-flight frames = %u\n", self->max_inflight);
+      break;
+    case PROP_BATCH_SIZE:
+      self->batch_size = g_value_get_uint (value);
+      silent_debug ("Batch size = %u\n", self->batch_size);
+      break;
+    case PROP_BATCH_TIMEOUT:
+      self->batch_timeout = g_value_get_uint (value);
+      break;
+    case PROP_STATS_INTERVAL:
+      self->stats_interval = g_value_get_uint (value);
+      break;
+    case PROP_THROTTLE:
+      self->throttle = g_value_get_boolean (value);
+      silent_debug ("Throttle = %d\n", self->throttle);
+
+      /* QoS of the base class drops the frames late for the sink */
+      gst_base_transform_set_qos_enabled (GST_BASE_TRANSFORM (self),
+          self->throttle);
+      break;
+    case PROP_WARMUP:
+      self->warmup = g_value_get_uint (value);
+      break;
+    case PROP_STATE_INPUTS:
+      g_assert (!self->configured);
+      self->num_state_in =
+          gst_tensor_filter_parse_indices (g_value_get_string (value),
+          self->state_in);
+      silent_debug ("State inputs = %u\n", self->num_state_in);
+      break;
+    case PROP_STATE_OUTPUTS:
+      g_assert (!self->configured);
+      self->num_state_out =
+          gst_tensor_filter_parse_indices (g_value_get_string (value),
+          self->state_out);
+      silent_debug ("State outputs = %u\n", self->num_state_out);
+      break;
+    case PROP_INPUT_COMBINATION:
+      g_assert (!self->configured);
+      self->num_combi_in =
+          gst_tensor_filter_parse_indices (g_value_get_string (value),
+          self->combi_in);
+      silent_debug ("Input combination = %u\n", self->num_combi_in);
+      break;
+    case PROP_OUTPUT_COMBINATION:
+      g_assert (!self->configured);
+      self->num_combi_out =
+          gst_tensor_filter_parse_combination (self,
+          g_value_get_string (value));
+      silent_debug ("Output combination = %u\n", self->num_combi_out);
+      break;
+    case PROP_CPU_AFFINITY:
+    case PROP_THREAD_PRIORITY:
+      GST_OBJECT_LOCK (self);
+      if (prop_id == PROP_CPU_AFFINITY) {
+        g_free ((gchar *) prop->cpu_affinity);
+        prop->cpu_affinity = g_value_dup_string (value);
+      } else {
+        prop->thread_priority = g_value_get_int (value);
+      }
+
+      /* a new generation, applied to each invoke thread before the next invoke */
+      if ((prop->cpu_affinity && prop->cpu_affinity[0] != '\0') ||
+          prop->thread_priority != 0)
+        g_atomic_int_set (&self->thread_conf,
+            g_atomic_int_add (&thread_conf_last, 1) + 1);
+      else
+        g_atomic_int_set (&self->thread_conf, 0);
+      GST_OBJECT_UNLOCK (self);
+      silent_debug ("CPU affinity = %s, thread priority = %d\n",
+          prop->cpu_affinity, prop->thread_priority);
       break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
@@ -565,7 +1531,10 @@ gst_tensor_filter_get_property (GObject * object, guint prop_id,
       g_value_set_string (value, nnfw_names[prop->nnfw]);
       break;
     case PROP_MODEL:
+      /* the model may be swapped by the streaming thread */
+      g_mutex_lock (&self->swap_lock);
       g_value_set_string (value, prop->model_file);
+      g_mutex_unlock (&self->swap_lock);
       break;
     case PROP_INPUT:
       if (prop->input_meta.num_tensors > 0) {
@@ -658,12 +1627,240 @@ gst_tensor_filter_get_property (GObject * object, guint prop_id,
     case PROP_CUSTOM:
       g_value_set_string (value, prop->custom_properties);
       break;
+    case PROP_MIN_BUFFERS:
+      g_value_set_uint (value, self->min_buffers);
+      break;
+    case PROP_MAX_BUFFERS:
+      g_value_set_uint (value, self->max_buffers);
+      break;
+    case PROP_MAX_INFLIGHT:
+      g_value_set_uint (value, self->max_inflight);
+      break;
+    case PROP_BATCH_SIZE:
+      g_value_set_uint (value, self->batch_size);
+      break;
+    case PROP_BATCH_TIMEOUT:
+      g_value_set_uint (value, self->batch_timeout);
+      break;
+    case PROP_STATS_INTERVAL:
+      g_value_set_uint (value, self->stats_interval);
+      break;
+    case PROP_INVOKE_COUNT:
+      g_mutex_lock (&self->stats.lock);
+      g_value_set_uint64 (value, self->stats.count);
+      g_mutex_unlock (&self->stats.lock);
+      break;
+    case PROP_INVOKE_RATE:
+      g_mutex_lock (&self->stats.lock);
+      g_value_set_double (value, gst_tensor_filter_stats_rate (self));
+      g_mutex_unlock (&self->stats.lock);
+      break;
+    case PROP_LATENCY_LAST:
+      g_mutex_lock (&self->stats.lock);
+      g_value_set_uint (value, self->stats.last);
+      g_mutex_unlock (&self->stats.lock);
+      break;
+    case PROP_LATENCY_AVG:
+      g_mutex_lock (&self->stats.lock);
+      g_value_set_uint (value, gst_tensor_filter_stats_avg (self));
+      g_mutex_unlock (&self->stats.lock);
+      break;
+    case PROP_LATENCY_MIN:
+      g_mutex_lock (&self->stats.lock);
+      g_value_set_uint (value, gst_tensor_filter_stats_min (self));
+      g_mutex_unlock (&self->stats.lock);
+      break;
+    case PROP_LATENCY_MAX:
+      g_mutex_lock (&self->stats.lock);
+      g_value_set_uint (value, self->stats.max);
+      g_mutex_unlock (&self->stats.lock);
+      break;
+    case PROP_LATENCY_P50:
+      g_mutex_lock (&self->stats.lock);
+      g_value_set_uint (value, gst_tensor_filter_stats_percentile (self, 50));
+      g_mutex_unlock (&self->stats.lock);
+      break;
+    case PROP_LATENCY_P99:
+      g_mutex_lock (&self->stats.lock);
+      g_value_set_uint (value, gst_tensor_filter_stats_percentile (self, 99));
+      g_mutex_unlock (&self->stats.lock);
+      break;
+    case PROP_THROTTLE:
+      g_value_set_boolean (value, self->throttle);
+      break;
+    case PROP_SKIPPED_COUNT:
+      g_mutex_lock (&self->stats.lock);
+      g_value_set_uint64 (value, self->stats.skipped);
+      g_mutex_unlock (&self->stats.lock);
+      break;
+    case PROP_WARMUP:
+      g_value_set_uint (value, self->warmup);
+      break;
+    case PROP_STATE_INPUTS:
+      g_value_take_string (value,
+          gst_tensor_filter_indices_string (self->state_in,
+              self->num_state_in));
+      break;
+    case PROP_STATE_OUTPUTS:
+      g_value_take_string (value,
+          gst_tensor_filter_indices_string (self->state_out,
+              self->num_state_out));
+      break;
+    case PROP_WARMUP_TIME:
+      g_value_set_uint64 (value, self->warmup_time);
+      break;
+    case PROP_SWAP_LATENCY:
+      g_value_set_uint64 (value, self->swap_latency);
+      break;
+    case PROP_SWAP_DROPPED:
+      g_value_set_uint (value, self->swap_dropped);
+      break;
+    case PROP_INPUT_COMBINATION:
+      g_value_take_string (value,
+          gst_tensor_filter_indices_string (self->combi_in,
+              self->num_combi_in));
+      break;
+    case PROP_OUTPUT_COMBINATION:
+      g_value_take_string (value, gst_tensor_filter_combination_string (self));
+      break;
+    case PROP_CPU_AFFINITY:
+      GST_OBJECT_LOCK (self);
+      g_value_set_string (value, prop->cpu_affinity ? prop->cpu_affinity : "");
+      GST_OBJECT_UNLOCK (self);
+      break;
+    case PROP_THREAD_PRIORITY:
+      g_value_set_int (value, prop->thread_priority);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
   }
 }
 
+/**
+ * @brief Apply cpu-affinity and thread-priority to the calling thread, once for each generation of the properties.
+ * @param self "this" pointer
+ * @note Called by the thread invoking the model: the streaming thread, or the worker threads with max-inflight.
+ *       The attributes before the first generation are restored when the properties are cleared.
+ *       The streaming thread may be shared with the other elements before the next queue, the last one applied is kept.
+ */
+static void
+gst_tensor_filter_thread_apply (GstTensorFilter * self)
+{
+  GstTensorFilterThreadConf *applied;
+  GThread *thread;
+  gint conf;
+
+  conf = g_atomic_int_get (&self->thread_conf);
+  thread = g_thread_self ();
+
+  GST_OBJECT_LOCK (self);
+  applied = g_hash_table_lookup (self->thread_applied, thread);
+  if (G_LIKELY ((applied ? applied->conf : 0) == conf)) {
+    GST_OBJECT_UNLOCK (self);
+    return;
+  }
+
+  if (applied) {
+    gst_tensor_thread_restore (applied->saved);
+    applied->saved = NULL;
+    g_hash_table_remove (self->thread_applied, thread);
+  }
+
+  if (conf != 0) {
+    applied = g_new0 (GstTensorFilterThreadConf, 1);
+    applied->conf = conf;
+
+    if (!gst_tensor_thread_pin (self->prop.cpu_affinity,
+            self->prop.thread_priority, &applied->saved)) {
+      GST_WARNING_OBJECT (self, "Cannot apply cpu-affinity '%s' and "
+          "thread-priority %d to the invoke thread.",
+          GST_STR_NULL (self->prop.cpu_affinity), self->prop.thread_priority);
+    }
+
+    g_hash_table_insert (self->thread_applied, thread, applied);
+  }
+  GST_OBJECT_UNLOCK (self);
+}
+
+/**
+ * @brief Restore the attributes of the calling thread before cpu-affinity and thread-priority are applied.
+ * @param self "this" pointer
+ */
+static void
+gst_tensor_filter_thread_restore (GstTensorFilter * self)
+{
+  GstTensorFilterThreadConf *applied;
+  GThread *thread;
+
+  thread = g_thread_self ();
+
+  GST_OBJECT_LOCK (self);
+  applied = g_hash_table_lookup (self->thread_applied, thread);
+  if (applied) {
+    gst_tensor_thread_restore (applied->saved);
+    applied->saved = NULL;
+    g_hash_table_remove (self->thread_applied, thread);
+  }
+  GST_OBJECT_UNLOCK (self);
+}
+
+/**
+ * @brief Restore the attributes of all invoke threads before cpu-affinity and thread-priority are applied.
+ * @param self "this" pointer
+ * @note Called when the element stops, the streaming threads are alive and may be shared with other elements.
+ */
+static void
+gst_tensor_filter_thread_restore_all (GstTensorFilter * self)
+{
+  GstTensorFilterThreadConf *applied;
+  GHashTableIter iter;
+
+  GST_OBJECT_LOCK (self);
+  g_hash_table_iter_init (&iter, self->thread_applied);
+  while (g_hash_table_iter_next (&iter, NULL, (gpointer *) & applied)) {
+    gst_tensor_thread_restore (applied->saved);
+    applied->saved = NULL;
+    g_hash_table_iter_remove (&iter);
+  }
+  GST_OBJECT_UNLOCK (self);
+}
+
+/**
+ * @brief Check the properties before invoking the model.
+ * @param self "this" pointer
+ * @return GST_FLOW_OK if the sub-plugin is ready to invoke
+ */
+static GstFlowReturn
+gst_tensor_filter_check_invoke (GstTensorFilter * self)
+{
+  if (G_UNLIKELY (!self->configured))
+    goto unknown_format;
+  if (G_UNLIKELY (!self->fw))
+    goto unknown_framework;
+  if (G_UNLIKELY (!self->prop.model_file))
+    goto unknown_model;
+  if (G_UNLIKELY (!self->fw->invoke_NN))
+    goto unknown_invoke;
+
+  return GST_FLOW_OK;
+unknown_format:
+  GST_ELEMENT_ERROR (self, CORE, NOT_IMPLEMENTED, (NULL), ("unknown format"));
+  return GST_FLOW_NOT_NEGOTIATED;
+unknown_framework:
+  GST_ELEMENT_ERROR (self, CORE, NOT_IMPLEMENTED, (NULL),
+      ("framework not configured"));
+  return GST_FLOW_ERROR;
+unknown_model:
+  GST_ELEMENT_ERROR (self, CORE, NOT_IMPLEMENTED, (NULL),
+      ("model filepath not configured"));
+  return GST_FLOW_ERROR;
+unknown_invoke:
+  GST_ELEMENT_ERROR (self, CORE, NOT_IMPLEMENTED, (NULL),
+      ("invoke function is not defined"));
+  return GST_FLOW_ERROR;
+}
+
 /**
  * @brief non-ip transform. required vmethod of GstBaseTransform.
  */
@@ -679,29 +1876,42 @@ gst_tensor_filter_transform (GstBaseTransform * trans,
   GstMapInfo out_info[NNS_TENSOR_SIZE_LIMIT];
   GstTensorMemory in_tensors[NNS_TENSOR_SIZE_LIMIT];
   GstTensorMemory out_tensors[NNS_TENSOR_SIZE_LIMIT];
-  gint i, ret;
+  GDestroyNotify release[NNS_TENSOR_SIZE_LIMIT];
+  void *user_data[NNS_TENSOR_SIZE_LIMIT];
+  GstMemory *mem;
+  gboolean out_pooled, allocate_in_invoke;
+  GstFlowReturn res;
+  gint64 start;
+  gint i, k, n, ret;
 
   self = GST_TENSOR_FILTER_CAST (trans);
   prop = &self->prop;
 
-  if (G_UNLIKELY (!self->configured))
-    goto unknown_format;
-  if (G_UNLIKELY (!self->fw))
-    goto unknown_framework;
-  if (G_UNLIKELY (!prop->model_file))
-    goto unknown_model;
-  if (G_UNLIKELY (!self->fw->invoke_NN))
-    goto unknown_invoke;
-
   /* 0. Check all properties. */
+  res = gst_tensor_filter_check_invoke (self);
+  if (G_UNLIKELY (res != GST_FLOW_OK))
+    return res;
+
+  gst_tensor_filter_thread_apply (self);
+
+  allocate_in_invoke = gst_tensor_filter_allocate_in_invoke (self);
+
   silent_debug ("Invoking %s with %s model\n", self->fw->name,
       prop->model_file);
 
-  /* 1. Set input tensors from inbuf. */
-  g_assert (gst_buffer_n_memory (inbuf) == prop->input_meta.num_tensors);
+  /* 1. Set input tensors from inbuf (selected with input-combination), and the state tensors. */
+  g_assert (gst_buffer_n_memory (inbuf) == self->in_config.info.num_tensors);
+
+  for (i = 0, n = 0; i < prop->input_meta.num_tensors; i++) {
+    k = (self->num_state_in > 0) ? gst_tensor_filter_state_index (self, i) : -1;
+
+    if (self->num_combi_in > 0)
+      in_mem[i] = gst_buffer_peek_memory (inbuf, self->combi_in[i]);
+    else if (k < 0)
+      in_mem[i] = gst_buffer_peek_memory (inbuf, n++);
+    else
+      in_mem[i] = gst_tensor_filter_state_get (self, k);
 
-  for (i = 0; i < prop->input_meta.num_tensors; i++) {
-    in_mem[i] = gst_buffer_peek_memory (inbuf, i);
     g_assert (gst_memory_map (in_mem[i], &in_info[i], GST_MAP_READ));
 
     in_tensors[i].data = in_info[i].data;
@@ -711,16 +1921,41 @@ gst_tensor_filter_transform (GstBaseTransform * trans,
 
   /* 2. Prepare output tensors. */
   g_assert (outbuf);
-  g_assert (gst_buffer_get_size (outbuf) == 0);
+
+  /**
+   * The buffer from the pool already has the memory blocks for output tensors.
+   * Otherwise, outbuf is empty and the memory blocks are appended below.
+   */
+  out_pooled = (gst_buffer_n_memory (outbuf) > 0);
+  if (out_pooled) {
+    g_assert (self->num_combi_out == 0);
+    g_assert (gst_buffer_n_memory (outbuf) == prop->output_meta.num_tensors);
+  } else {
+    g_assert (gst_buffer_get_size (outbuf) == 0);
+  }
 
   for (i = 0; i < prop->output_meta.num_tensors; i++) {
     out_tensors[i].data = NULL;
     out_tensors[i].size = gst_tensor_filter_out_size (self, i);
     out_tensors[i].type = prop->output_meta.info[i].type;
+    release[i] = NULL;
+    user_data[i] = NULL;
 
     /* allocate memory if allocate_in_invoke is FALSE */
-    if (self->fw->allocate_in_invoke == FALSE) {
-      out_mem[i] = gst_allocator_alloc (NULL, out_tensors[i].size, NULL);
+    if (allocate_in_invoke == FALSE) {
+      k = gst_tensor_filter_state_out_index (self, i);
+
+      if (k >= 0) {
+        g_assert (!out_pooled);
+        out_mem[i] = gst_tensor_filter_state_alloc (self, k,
+            out_tensors[i].size);
+      } else if (out_pooled) {
+        out_mem[i] = gst_buffer_peek_memory (outbuf, i);
+        g_assert (gst_memory_get_sizes (out_mem[i], NULL,
+                NULL) == out_tensors[i].size);
+      } else {
+        out_mem[i] = gst_allocator_alloc (NULL, out_tensors[i].size, NULL);
+      }
       g_assert (gst_memory_map (out_mem[i], &out_info[i], GST_MAP_WRITE));
 
       out_tensors[i].data = out_info[i].data;
@@ -728,65 +1963,139 @@ gst_tensor_filter_transform (GstBaseTransform * trans,
   }
 
   /* 3. Call the filter-subplugin callback, "invoke" */
-  gst_tensor_filter_call (self, ret, invoke_NN, in_tensors, out_tensors);
+  start = g_get_monotonic_time ();
+  if (allocate_in_invoke && self->fw->invoke_with_release_NN) {
+    gst_tensor_filter_call (self, ret, invoke_with_release_NN, in_tensors,
+        out_tensors, release, user_data);
+  } else {
+    gst_tensor_filter_call (self, ret, invoke_NN, in_tensors, out_tensors);
+  }
   g_assert (ret == 0);
+  gst_tensor_filter_stats_record (self, start, 1);
 
   /* 4. Update result and free map info. */
+  for (i = 0; i < prop->input_meta.num_tensors; i++) {
+    gst_memory_unmap (in_mem[i], &in_info[i]);
+  }
+
   for (i = 0; i < prop->output_meta.num_tensors; i++) {
-    if (self->fw->allocate_in_invoke) {
+    if (allocate_in_invoke) {
       /* filter-subplugin allocated new memory, update this */
-      out_mem[i] =
-          gst_memory_new_wrapped (0, out_tensors[i].data, out_tensors[i].size,
-          0, out_tensors[i].size, out_tensors[i].data, g_free);
+      if (release[i]) {
+        /* the memory block owned by filter-subplugin, without copy */
+        out_mem[i] =
+            gst_memory_new_wrapped (0, out_tensors[i].data,
+            out_tensors[i].size, 0, out_tensors[i].size, user_data[i],
+            release[i]);
+      } else {
+        out_mem[i] =
+            gst_memory_new_wrapped (0, out_tensors[i].data,
+            out_tensors[i].size, 0, out_tensors[i].size, out_tensors[i].data,
+            g_free);
+      }
     } else {
       gst_memory_unmap (out_mem[i], &out_info[i]);
+
+      /* the memory block from the pool is already in outbuf */
+      if (out_pooled)
+        continue;
     }
 
+    /* keep the state tensor for the next invoke */
+    k = gst_tensor_filter_state_out_index (self, i);
+    if (k >= 0)
+      gst_tensor_filter_state_update (self, k, out_mem[i]);
+
     /* append the memory block to outbuf */
-    gst_buffer_append_memory (outbuf, out_mem[i]);
+    if (self->num_combi_out == 0)
+      gst_buffer_append_memory (outbuf, out_mem[i]);
   }
 
-  for (i = 0; i < prop->input_meta.num_tensors; i++) {
-    gst_memory_unmap (in_mem[i], &in_info[i]);
+  /* 5. Compose outbuf with the input tensors passed through by reference and the output tensors. */
+  if (self->num_combi_out > 0) {
+    for (i = 0; i < self->num_combi_out; i++) {
+      k = self->combi_out[i];
+      mem = (self->combi_out_input[i]) ?
+          gst_buffer_peek_memory (inbuf, k) : out_mem[k];
+
+      gst_buffer_append_memory (outbuf, gst_memory_ref (mem));
+    }
+
+    for (i = 0; i < prop->output_meta.num_tensors; i++)
+      gst_memory_unref (out_mem[i]);
   }
 
-  /* 5. Return result! */
+  /* 6. Return result! */
   return GST_FLOW_OK;
-unknown_format:
-  GST_ELEMENT_ERROR (self, CORE, NOT_IMPLEMENTED, (NULL), ("unknown format"));
-  return GST_FLOW_NOT_NEGOTIATED;
-unknown_framework:
-  GST_ELEMENT_ERROR (self, CORE, NOT_IMPLEMENTED, (NULL),
-      ("framework not configured"));
-  return GST_FLOW_ERROR;
-unknown_model:
-  GST_ELEMENT_ERROR (self, CORE, NOT_IMPLEMENTED, (NULL),
-      ("model filepath not configured"));
-  return GST_FLOW_ERROR;
-unknown_invoke:
-  GST_ELEMENT_ERROR (self, CORE, NOT_IMPLEMENTED, (NULL),
-      ("invoke function is not defined"));
-  return GST_FLOW_ERROR;
 }
 
 /**
  * @brief in-place transform. required vmethod of GstBaseTransform.
+ *
+ * This is called only if in-place mode is set with the negotiated caps.
+ * (See gst_tensor_filter_set_caps) The output tensors share the memory blocks of the input tensors.
  */
 static GstFlowReturn
 gst_tensor_filter_transform_ip (GstBaseTransform * trans, GstBuffer * buf)
 {
-  /** @todo 0. Check all properties and inbuf size. */
-  /** @todo 0-1. This shouldn't reach here if in-place mode if OFF with the subplugin */
-  /** @todo 0-1. , which could be done at *_caps with gst_base_transform_set_in_place() */
-  /** @todo 1. Resize buf if output is larger than input */
-  /** @todo 2. Call the filter-subplugin callback, "invoke" */
-  /** @todo 3. Return result! */
-  g_assert (0);
-  return GST_FLOW_ERROR;
-}
-
-/**
- * @brief Load tensor info from NN model.
+  GstTensorFilter *self;
+  GstTensorFilterProperties *prop;
+  GstMapInfo info[NNS_TENSOR_SIZE_LIMIT];
+  GstTensorMemory in_tensors[NNS_TENSOR_SIZE_LIMIT];
+  GstTensorMemory out_tensors[NNS_TENSOR_SIZE_LIMIT];
+  GstFlowReturn res;
+  gint64 start;
+  gint i, ret;
+
+  self = GST_TENSOR_FILTER_CAST (trans);
+  prop = &self->prop;
+
+  /* 0. Check all properties. */
+  res = gst_tensor_filter_check_invoke (self);
+  if (G_UNLIKELY (res != GST_FLOW_OK))
+    return res;
+
+  gst_tensor_filter_thread_apply (self);
+
+  silent_debug ("Invoking %s with %s model (in-place)\n", self->fw->name,
+      prop->model_file);
+
+  /* 1. Set input and output tensors from buf. */
+  g_assert (gst_buffer_n_memory (buf) == prop->input_meta.num_tensors);
+  g_assert (prop->input_meta.num_tensors == prop->output_meta.num_tensors);
+
+  for (i = 0; i < prop->input_meta.num_tensors; i++) {
+    /* this will copy the memory block if it is not writable */
+    g_assert (gst_buffer_map_range (buf, i, 1, &info[i], GST_MAP_READWRITE));
+
+    in_tensors[i].data = info[i].data;
+    in_tensors[i].size = info[i].size;
+    in_tensors[i].type = prop->input_meta.info[i].type;
+
+    out_tensors[i].data = info[i].data;
+    out_tensors[i].size = gst_tensor_filter_out_size (self, i);
+    out_tensors[i].type = prop->output_meta.info[i].type;
+
+    g_assert (in_tensors[i].size == out_tensors[i].size);
+  }
+
+  /* 2. Call the filter-subplugin callback, "invoke" */
+  start = g_get_monotonic_time ();
+  gst_tensor_filter_call (self, ret, invoke_NN, in_tensors, out_tensors);
+  g_assert (ret == 0);
+  gst_tensor_filter_stats_record (self, start, 1);
+
+  /* 3. Free map info. */
+  for (i = 0; i < prop->input_meta.num_tensors; i++) {
+    gst_buffer_unmap (buf, &info[i]);
+  }
+
+  /* 4. Return result! */
+  return GST_FLOW_OK;
+}
+
+/**
+ * @brief Load tensor info from NN model.
  * (both input and output tensor)
  */
 static void
@@ -904,6 +2213,427 @@ _compare_tensors (GstTensorsInfo * info1, GstTensorsInfo * info2)
   return result;
 }
 
+/**
+ * @brief The result of setInputDimension cached for negotiation.
+ */
+typedef struct
+{
+  GstTensorsInfo in_info; /**< the input tensors info given to setInputDimension */
+  GstTensorsInfo out_info; /**< the output tensors info returned by setInputDimension */
+} GstTensorFilterDimEntry;
+
+/**
+ * @brief Clear the results of setInputDimension, called when the model is changed.
+ * @param self "this" pointer
+ */
+static void
+gst_tensor_filter_dim_cache_clear (GstTensorFilter * self)
+{
+  g_mutex_lock (&self->dim_lock);
+  while (!g_queue_is_empty (&self->dim_cache))
+    g_free (g_queue_pop_head (&self->dim_cache));
+
+  gst_tensors_info_init (&self->dim_applied);
+  g_mutex_unlock (&self->dim_lock);
+}
+
+/**
+ * @brief Get the output tensors info for the input tensors info, with the results of setInputDimension cached.
+ * @param self "this" pointer
+ * @param in_info the input tensors info
+ * @param[out] out_info the output tensors info
+ * @param apply TRUE if the sub-plugin should be configured with in_info (e.g., set-caps). FALSE to query the output tensors info only.
+ * @return 0 if OK. non-zero if error.
+ *
+ * setInputDimension may be expensive (e.g., resizing the input tensors and allocating the arena of the interpreter),
+ * and it is called repeatedly while negotiating caps. The sub-plugin is called only if the result is not cached,
+ * or if it should be configured with the input tensors info other than the last one given.
+ */
+static gint
+gst_tensor_filter_set_input_dim (GstTensorFilter * self,
+    const GstTensorsInfo * in_info, GstTensorsInfo * out_info, gboolean apply)
+{
+  GstTensorFilterDimEntry *entry;
+  GList *link;
+  guint hits, misses;
+  gint ret;
+
+  /* the cache and the configured input of the sub-plugin are updated together */
+  g_mutex_lock (&self->dim_lock);
+  for (link = self->dim_cache.head; link; link = link->next) {
+    entry = link->data;
+
+    if (gst_tensors_info_is_equal (&entry->in_info, in_info))
+      break;
+  }
+
+  if (link && (!apply ||
+          gst_tensors_info_is_equal (&self->dim_applied, in_info))) {
+    /* the most recent first */
+    g_queue_unlink (&self->dim_cache, link);
+    g_queue_push_head_link (&self->dim_cache, link);
+
+    *out_info = entry->out_info;
+    hits = ++self->dim_cache_hits;
+    misses = self->dim_cache_misses;
+    g_mutex_unlock (&self->dim_lock);
+
+    silent_debug ("setInputDimension cache hit (hits %u, misses %u)\n", hits,
+        misses);
+    return 0;
+  }
+
+  gst_tensor_filter_call (self, ret, setInputDimension, in_info, out_info);
+
+  hits = self->dim_cache_hits;
+  misses = ++self->dim_cache_misses;
+
+  if (ret == 0) {
+    self->dim_applied = *in_info;
+
+    /* the entry found above, given to the sub-plugin again */
+    if (link) {
+      g_queue_unlink (&self->dim_cache, link);
+      g_queue_push_head_link (&self->dim_cache, link);
+    } else {
+      entry = g_new0 (GstTensorFilterDimEntry, 1);
+      entry->in_info = *in_info;
+      g_queue_push_head (&self->dim_cache, entry);
+
+      if (g_queue_get_length (&self->dim_cache) >
+          GST_TENSOR_FILTER_DIM_CACHE_SIZE)
+        g_free (g_queue_pop_tail (&self->dim_cache));
+    }
+
+    entry->out_info = *out_info;
+  } else {
+    /* unknown state of the sub-plugin */
+    gst_tensors_info_init (&self->dim_applied);
+  }
+  g_mutex_unlock (&self->dim_lock);
+
+  silent_debug ("setInputDimension cache miss (hits %u, misses %u)\n", hits,
+      misses);
+  return ret;
+}
+
+/**
+ * @brief Release the state tensors, the next invoke starts with zero-filled state tensors.
+ * @param self "this" pointer
+ */
+static void
+gst_tensor_filter_state_reset (GstTensorFilter * self)
+{
+  guint k;
+
+  for (k = 0; k < NNS_TENSOR_SIZE_LIMIT; k++) {
+    if (self->state_mem[k]) {
+      gst_memory_unref (self->state_mem[k]);
+      self->state_mem[k] = NULL;
+    }
+
+    if (self->state_spare[k]) {
+      gst_memory_unref (self->state_spare[k]);
+      self->state_spare[k] = NULL;
+    }
+  }
+}
+
+/**
+ * @brief Get the index of state for the input tensor.
+ * @param self "this" pointer
+ * @param index the index of input tensor of the model
+ * @return the index of state. -1 if the input tensor is not a state tensor.
+ */
+static gint
+gst_tensor_filter_state_index (GstTensorFilter * self, guint index)
+{
+  guint k;
+
+  for (k = 0; k < self->num_state_in; k++) {
+    if (self->state_in[k] == index)
+      return (gint) k;
+  }
+
+  return -1;
+}
+
+/**
+ * @brief Get the index of state for the output tensor.
+ * @param self "this" pointer
+ * @param index the index of output tensor of the model
+ * @return the index of state. -1 if the output tensor is not a state tensor.
+ */
+static gint
+gst_tensor_filter_state_out_index (GstTensorFilter * self, guint index)
+{
+  guint k;
+
+  for (k = 0; k < self->num_state_out; k++) {
+    if (self->state_out[k] == index)
+      return (gint) k;
+  }
+
+  return -1;
+}
+
+/**
+ * @brief Remove the state tensors from the input tensors info of the model, to get the tensors info of sink pad.
+ * @param self "this" pointer
+ * @param model the input tensors info of the model
+ * @param[out] pad the tensors info of sink pad
+ */
+static void
+gst_tensor_filter_state_strip (GstTensorFilter * self,
+    const GstTensorsInfo * model, GstTensorsInfo * pad)
+{
+  GstTensorsInfo info;
+  guint i;
+
+  gst_tensors_info_init (&info);
+
+  for (i = 0; i < model->num_tensors; i++) {
+    if (gst_tensor_filter_state_index (self, i) < 0)
+      info.info[info.num_tensors++] = model->info[i];
+  }
+
+  *pad = info;
+}
+
+/**
+ * @brief Insert the state tensors into the tensors info of sink pad, to get the input tensors info of the model.
+ * @param self "this" pointer
+ * @param pad the tensors info of sink pad
+ * @param[out] model the input tensors info of the model
+ * @return TRUE if OK. FALSE if the state tensors are unknown.
+ * @note The state tensors are given by the model (getInputDimension) or the properties.
+ */
+static gboolean
+gst_tensor_filter_state_merge (GstTensorFilter * self,
+    const GstTensorsInfo * pad, GstTensorsInfo * model)
+{
+  GstTensorFilterProperties *prop;
+  GstTensorsInfo info;
+  guint i, n;
+
+  prop = &self->prop;
+
+  if (prop->input_meta.num_tensors != pad->num_tensors + self->num_state_in)
+    return FALSE;
+
+  gst_tensors_info_init (&info);
+  info.num_tensors = prop->input_meta.num_tensors;
+
+  for (i = 0, n = 0; i < info.num_tensors; i++) {
+    if (gst_tensor_filter_state_index (self, i) < 0)
+      info.info[i] = pad->info[n++];
+    else
+      info.info[i] = prop->input_meta.info[i];
+  }
+
+  *model = info;
+  return TRUE;
+}
+
+/**
+ * @brief Check the state tensors with the input and output tensors of the model.
+ * @param self "this" pointer
+ * @return TRUE if the state tensors are valid.
+ */
+static gboolean
+gst_tensor_filter_state_validate (GstTensorFilter * self)
+{
+  GstTensorFilterProperties *prop;
+  GstTensorInfo *in_info, *out_info;
+  guint k;
+
+  prop = &self->prop;
+
+  if (self->num_state_in != self->num_state_out) {
+    GST_ERROR_OBJECT (self,
+        "The number of state-inputs (%u) and state-outputs (%u) differ.",
+        self->num_state_in, self->num_state_out);
+    return FALSE;
+  }
+
+  for (k = 0; k < self->num_state_in; k++) {
+    if (self->state_in[k] >= prop->input_meta.num_tensors ||
+        self->state_out[k] >= prop->output_meta.num_tensors) {
+      GST_ERROR_OBJECT (self, "Invalid index of state tensor %u.", k);
+      return FALSE;
+    }
+
+    if (gst_tensor_filter_state_index (self, self->state_in[k]) != (gint) k) {
+      GST_ERROR_OBJECT (self, "Duplicated index of state tensor %u.", k);
+      return FALSE;
+    }
+
+    in_info = &prop->input_meta.info[self->state_in[k]];
+    out_info = &prop->output_meta.info[self->state_out[k]];
+
+    if (in_info->type != out_info->type ||
+        gst_tensor_info_get_size (in_info) !=
+        gst_tensor_info_get_size (out_info)) {
+      GST_ERROR_OBJECT (self,
+          "The state tensor %u of input and output are not compatible.", k);
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Get the state tensor given to the invoke.
+ * @param self "this" pointer
+ * @param k the index of state
+ * @return the memory block of the state tensor, zero-filled for the first invoke. (transfer none)
+ */
+static GstMemory *
+gst_tensor_filter_state_get (GstTensorFilter * self, guint k)
+{
+  GstMapInfo info;
+  gsize size;
+
+  if (self->state_mem[k] == NULL) {
+    size = gst_tensor_info_get_size (&self->prop.input_meta.
+        info[self->state_in[k]]);
+    self->state_mem[k] = gst_allocator_alloc (NULL, size, NULL);
+
+    g_assert (gst_memory_map (self->state_mem[k], &info, GST_MAP_WRITE));
+    memset (info.data, 0, info.size);
+    gst_memory_unmap (self->state_mem[k], &info);
+  }
+
+  return self->state_mem[k];
+}
+
+/**
+ * @brief Get the memory block for the state tensor of the output.
+ * @param self "this" pointer
+ * @param k the index of state
+ * @param size the size of the state tensor
+ * @return the memory block (transfer full)
+ *
+ * The memory blocks are double-buffered; the model reads the state tensor of the previous invoke,
+ * and writes the new one into the other memory block, which is reused if it is not referred anymore.
+ */
+static GstMemory *
+gst_tensor_filter_state_alloc (GstTensorFilter * self, guint k, gsize size)
+{
+  GstMemory *mem;
+
+  mem = self->state_spare[k];
+  self->state_spare[k] = NULL;
+
+  /* still referred by the downstream */
+  if (mem && GST_MINI_OBJECT_REFCOUNT_VALUE (mem) > 1) {
+    gst_memory_unref (mem);
+    mem = NULL;
+  }
+
+  if (mem == NULL)
+    mem = gst_allocator_alloc (NULL, size, NULL);
+
+  return mem;
+}
+
+/**
+ * @brief Keep the state tensor of the output for the next invoke.
+ * @param self "this" pointer
+ * @param k the index of state
+ * @param mem the memory block of the output state tensor (transfer none)
+ */
+static void
+gst_tensor_filter_state_update (GstTensorFilter * self, guint k,
+    GstMemory * mem)
+{
+  if (self->state_spare[k])
+    gst_memory_unref (self->state_spare[k]);
+
+  /* swap, the previous state tensor is the spare memory block */
+  self->state_spare[k] = self->state_mem[k];
+  self->state_mem[k] = gst_memory_ref (mem);
+}
+
+/**
+ * @brief Check whether the tensors are selected or reordered with input-combination or output-combination.
+ */
+#define gst_tensor_filter_combi_used(self) \
+    ((self)->num_combi_in > 0 || (self)->num_combi_out > 0)
+
+/**
+ * @brief Select the input tensors of the model from the tensors of sink pad (input-combination).
+ * @param self "this" pointer
+ * @param pad the tensors info of sink pad
+ * @param[out] model the input tensors info of the model (may be same as pad)
+ * @return TRUE if OK. FALSE if the index is out of the tensors of sink pad.
+ */
+static gboolean
+gst_tensor_filter_combi_select (GstTensorFilter * self,
+    const GstTensorsInfo * pad, GstTensorsInfo * model)
+{
+  GstTensorsInfo info;
+  guint i;
+
+  if (self->num_combi_in == 0) {
+    *model = *pad;
+    return TRUE;
+  }
+
+  gst_tensors_info_init (&info);
+
+  for (i = 0; i < self->num_combi_in; i++) {
+    if (self->combi_in[i] >= pad->num_tensors)
+      return FALSE;
+
+    info.info[i] = pad->info[self->combi_in[i]];
+  }
+
+  info.num_tensors = self->num_combi_in;
+  *model = info;
+  return TRUE;
+}
+
+/**
+ * @brief Compose the tensors of source pad with the input tensors passed through and the output tensors of the model (output-combination).
+ * @param self "this" pointer
+ * @param pad the tensors info of sink pad
+ * @param model the output tensors info of the model
+ * @param[out] out the tensors info of source pad (may be same as pad or model)
+ * @return TRUE if OK. FALSE if the index is out of the tensors, or the input tensor is unknown.
+ */
+static gboolean
+gst_tensor_filter_combi_output (GstTensorFilter * self,
+    const GstTensorsInfo * pad, const GstTensorsInfo * model,
+    GstTensorsInfo * out)
+{
+  GstTensorsInfo info;
+  const GstTensorsInfo *from;
+  guint i, k;
+
+  if (self->num_combi_out == 0) {
+    *out = *model;
+    return TRUE;
+  }
+
+  gst_tensors_info_init (&info);
+
+  for (i = 0; i < self->num_combi_out; i++) {
+    from = (self->combi_out_input[i]) ? pad : model;
+    k = self->combi_out[i];
+
+    if (k >= from->num_tensors || !gst_tensor_info_validate (&from->info[k]))
+      return FALSE;
+
+    info.info[i] = from->info[k];
+  }
+
+  info.num_tensors = self->num_combi_out;
+  *out = info;
+  return TRUE;
+}
+
 /**
  * @brief Configure input and output tensor info from incaps.
  * @param self "this" pointer
@@ -917,6 +2647,7 @@ gst_tensor_filter_configure_tensor (GstTensorFilter * self,
   GstTensorFilterProperties *prop;
   GstStructure *structure;
   GstTensorsConfig in_config, out_config;
+  GstTensorsInfo in_info;
 
   g_return_val_if_fail (incaps != NULL, FALSE);
 
@@ -938,10 +2669,55 @@ gst_tensor_filter_configure_tensor (GstTensorFilter * self,
    * If true, fully configured tensor info from caps.
    */
   if (gst_tensors_config_validate (&in_config)) {
+    if (gst_tensor_filter_combi_used (self) && (self->num_state_in > 0 ||
+            self->num_state_out > 0)) {
+      GST_ERROR_OBJECT (self,
+          "The tensor combination cannot be used with the state tensors.");
+      return FALSE;
+    }
+
+    /** the input tensors of the model, selected from the tensors of sink pad */
+    if (!gst_tensor_filter_combi_select (self, &in_config.info, &in_info)) {
+      GST_ERROR_OBJECT (self,
+          "The input-combination is out of the input tensors (%u).",
+          in_config.info.num_tensors);
+      return FALSE;
+    }
+
+    /** the state tensors are not in the caps, given by the element */
+    if (self->num_state_in > 0) {
+      if (!gst_tensor_filter_state_merge (self, &in_info, &in_info)) {
+        GST_ERROR_OBJECT (self,
+            "Cannot get the state tensors, the input tensors of the model should be given.");
+        return FALSE;
+      }
+    }
+
+    /** the tensors info given by caps may be changed (e.g., the resolution of the camera) */
+    if (self->configured &&
+        !gst_tensors_config_is_equal (&self->in_config, &in_config)) {
+      if (self->dim_negotiated) {
+        silent_debug ("Renegotiate the tensors info.\n");
+        prop->input_configured = FALSE;
+        prop->output_configured = FALSE;
+        gst_tensors_info_init (&prop->input_meta);
+        gst_tensors_info_init (&prop->output_meta);
+        self->configured = FALSE;
+      } else if (gst_tensor_filter_combi_used (self)) {
+        /** the tensors not selected or passed through may be changed */
+        self->configured = FALSE;
+      }
+    }
+
+    if (!self->configured) {
+      self->dim_negotiated = (prop->input_meta.num_tensors == 0 &&
+          prop->output_meta.num_tensors == 0);
+    }
+
     /** if set-property called and already has info, verify it! */
     if (prop->input_meta.num_tensors > 0) {
-      if (!gst_tensors_info_is_equal (&in_config.info, &prop->input_meta)) {
-        gchar *str = _compare_tensors (&in_config.info, &prop->input_meta);
+      if (!gst_tensors_info_is_equal (&in_info, &prop->input_meta)) {
+        gchar *str = _compare_tensors (&in_info, &prop->input_meta);
         GST_ERROR_OBJECT (self, "The input tensor is not compatible.\n%s", str);
         g_free (str);
 
@@ -950,7 +2726,7 @@ gst_tensor_filter_configure_tensor (GstTensorFilter * self,
     }
 
     prop->input_configured = TRUE;
-    prop->input_meta = in_config.info;
+    prop->input_meta = in_info;
 
     /** call setInputDimension if output tensor is not configured */
     if (!prop->output_configured) {
@@ -958,14 +2734,13 @@ gst_tensor_filter_configure_tensor (GstTensorFilter * self,
       int res;
 
       gst_tensors_info_init (&out_info);
-      gst_tensor_filter_call (self, res, setInputDimension, &in_config.info,
-          &out_info);
+      res = gst_tensor_filter_set_input_dim (self, &in_info, &out_info, TRUE);
 
       if (res == 0) {
         /** if set-property called and already has info, verify it! */
         if (prop->output_meta.num_tensors > 0) {
           if (!gst_tensors_info_is_equal (&prop->output_meta, &out_info)) {
-            gchar *str = _compare_tensors (&in_config.info, &prop->input_meta);
+            gchar *str = _compare_tensors (&in_info, &prop->input_meta);
             GST_ERROR_OBJECT (self,
                 "The output tensor is not compatible.\n%s", str);
             g_free (str);
@@ -992,10 +2767,23 @@ gst_tensor_filter_configure_tensor (GstTensorFilter * self,
      * GstTensorFilter cannot assure the framerate.
      * Simply set the framerate of out-tensor from incaps.
      */
-    out_config.info = prop->output_meta;
+    if (!gst_tensor_filter_combi_output (self, &in_config.info,
+            &prop->output_meta, &out_config.info)) {
+      GST_ERROR_OBJECT (self,
+          "The output-combination is out of the input tensors (%u) or the output tensors (%u).",
+          in_config.info.num_tensors, prop->output_meta.num_tensors);
+      return FALSE;
+    }
+
     out_config.rate_n = in_config.rate_n;
     out_config.rate_d = in_config.rate_d;
 
+    if (!self->configured && (self->num_state_in > 0 ||
+            self->num_state_out > 0)) {
+      if (!gst_tensor_filter_state_validate (self))
+        return FALSE;
+    }
+
     if (self->configured) {
       /** already configured, compare to old. */
       g_assert (gst_tensors_config_is_equal (&self->in_config, &in_config));
@@ -1082,39 +2870,58 @@ gst_tensor_filter_transform_caps (GstBaseTransform * trans,
 
   if (direction == GST_PAD_SINK) {
     /* caps: sink pad. get src pad info */
-    if (self->prop.output_configured) {
+    GstTensorsInfo pad_info, out_info;
+    int res = -1;
+
+    pad_info = config.info;
+
+    if (self->prop.output_configured && !self->dim_negotiated) {
       /* fixed tensor info */
-      config.info = self->prop.output_meta;
-      result = gst_tensor_filter_caps_from_config (self, &config);
+      out_info = self->prop.output_meta;
+      res = 0;
     } else {
       GstTensorsInfo in_info;
 
       /* check in-tensor info to call setInputDimension */
-      in_info = config.info;
-      if (gst_tensors_info_validate (&in_info)) {
-        int res = -1;
+      if (!gst_tensor_filter_combi_select (self, &pad_info, &in_info)) {
+        /* the tensors not selected yet */
+        gst_tensors_info_init (&in_info);
+      }
+
+      if (self->num_state_in > 0 &&
+          !gst_tensor_filter_state_merge (self, &in_info, &in_info)) {
+        /* the state tensors are unknown */
+        gst_tensors_info_init (&in_info);
+      }
 
+      if (gst_tensors_info_validate (&in_info)) {
         /* call setInputDimension with given input tensor */
-        gst_tensor_filter_call (self, res, setInputDimension, &in_info,
-            &config.info);
+        res = gst_tensor_filter_set_input_dim (self, &in_info, &out_info,
+            FALSE);
 
-        if (res == 0) {
-          result = gst_tensor_filter_caps_from_config (self, &config);
-        } else {
+        if (res != 0) {
           GST_ERROR_OBJECT (self, "Cannot get the output tensor info.");
           g_assert (0);
-          result = gst_caps_from_string (CAPS_STRING);
         }
-      } else {
-        /* we don't know the exact tensor info yet */
-        result = gst_caps_from_string (CAPS_STRING);
       }
     }
+
+    /* the input tensors passed through should be known */
+    if (res == 0 && gst_tensor_filter_combi_output (self, &pad_info,
+            &out_info, &config.info)) {
+      result = gst_tensor_filter_caps_from_config (self, &config);
+    } else {
+      /* we don't know the exact tensor info yet */
+      result = gst_caps_from_string (CAPS_STRING);
+    }
   } else {
     /* caps: src pad. get sink pad info */
-    if (self->prop.input_configured) {
-      /* fixed tensor info */
+    if (self->prop.input_configured && !self->dim_negotiated &&
+        self->num_combi_in == 0) {
+      /* fixed tensor info, without the state tensors */
       config.info = self->prop.input_meta;
+      if (self->num_state_in > 0)
+        gst_tensor_filter_state_strip (self, &config.info, &config.info);
       result = gst_tensor_filter_caps_from_config (self, &config);
     } else {
       /* we don't know the exact tensor info from src pad caps */
@@ -1172,7 +2979,45 @@ gst_tensor_filter_fixate_caps (GstBaseTransform * trans,
 }
 
 /**
- * @brief set caps. required vmethod of GstBaseTransform.
+ * @brief Check whether the sub-plugin can write the output tensors into the input buffer.
+ * @param self "this" pointer
+ * @return TRUE if in-place mode is available
+ */
+static gboolean
+gst_tensor_filter_check_in_place (GstTensorFilter * self)
+{
+  GstTensorsInfo *in_info, *out_info;
+  guint i;
+
+  if (!self->fw || !gst_tensor_filter_allow_in_place (self) ||
+      gst_tensor_filter_allocate_in_invoke (self))
+    return FALSE;
+
+  /* the state tensors are not in the input buffer */
+  if (self->num_state_in > 0)
+    return FALSE;
+
+  /* the tensors in the input buffer are not the input tensors of the model */
+  if (gst_tensor_filter_combi_used (self))
+    return FALSE;
+
+  in_info = &self->prop.input_meta;
+  out_info = &self->prop.output_meta;
+
+  if (in_info->num_tensors != out_info->num_tensors)
+    return FALSE;
+
+  for (i = 0; i < in_info->num_tensors; i++) {
+    if (gst_tensor_info_get_size (&in_info->info[i]) !=
+        gst_tensor_info_get_size (&out_info->info[i]))
+      return FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief set caps. required vmethod of GstBaseTransform.
  */
 static gboolean
 gst_tensor_filter_set_caps (GstBaseTransform * trans,
@@ -1181,6 +3026,7 @@ gst_tensor_filter_set_caps (GstBaseTransform * trans,
   GstTensorFilter *self;
   GstStructure *structure;
   GstTensorsConfig config;
+  gboolean in_place;
 
   self = GST_TENSOR_FILTER_CAST (trans);
 
@@ -1211,6 +3057,18 @@ gst_tensor_filter_set_caps (GstBaseTransform * trans,
     return FALSE;
   }
 
+  /** invoke in-place if the sub-plugin allows it with the fixed tensors */
+  in_place = gst_tensor_filter_check_in_place (self);
+  silent_debug ("in-place mode = %d", in_place);
+
+  gst_base_transform_set_in_place (trans, in_place);
+
+  /* the caps for the new model swapped while streaming */
+  if (self->swap_wait_caps) {
+    self->swap_wait_caps = FALSE;
+    gst_tensor_filter_swap_post (self);
+  }
+
   return TRUE;
 }
 
@@ -1239,6 +3097,1527 @@ gst_tensor_filter_transform_size (GstBaseTransform * trans,
   return TRUE;
 }
 
+/**
+ * @brief Decide the allocation of output buffers. optional vmethod of BaseTransform
+ *
+ * The buffers in the pool have the memory blocks for each output tensor.
+ * The pool is not used if the sub-plugin allocates the output tensors in invoke.
+ */
+static gboolean
+gst_tensor_filter_decide_allocation (GstBaseTransform * trans,
+    GstQuery * query)
+{
+  GstTensorFilter *self;
+  GstBufferPool *pool;
+  GstStructure *config;
+  GstCaps *caps;
+  guint size, min, max;
+
+  self = GST_TENSOR_FILTER_CAST (trans);
+
+  /**
+   * The state tensors of the output are double-buffered without the pool.
+   * With output-combination, the output buffer has the input tensors passed through.
+   */
+  if (!self->configured || self->fw == NULL ||
+      gst_tensor_filter_allocate_in_invoke (self) ||
+      self->num_state_out > 0 || self->num_combi_out > 0) {
+    return GST_BASE_TRANSFORM_CLASS (parent_class)->decide_allocation (trans,
+        query);
+  }
+
+  min = self->min_buffers;
+  max = self->max_buffers;
+
+  /** downstream may require more buffers */
+  if (gst_query_get_n_allocation_pools (query) > 0) {
+    guint down_min, down_max;
+
+    gst_query_parse_nth_allocation_pool (query, 0, NULL, NULL, &down_min,
+        &down_max);
+    min = MAX (min, down_min);
+  }
+
+  if (max > 0 && max < min) {
+    GST_WARNING_OBJECT (self,
+        "max-buffers (%u) is less than the required buffers (%u)", max, min);
+    max = min;
+  }
+
+  gst_query_parse_allocation (query, &caps, NULL);
+  size = gst_tensor_filter_out_size (self, -1);
+
+  pool = gst_tensor_filter_pool_new (&self->prop.output_meta);
+  config = gst_buffer_pool_get_config (pool);
+  gst_buffer_pool_config_set_params (config, caps, size, min, max);
+
+  if (!gst_buffer_pool_set_config (pool, config)) {
+    GST_ERROR_OBJECT (self, "Failed to set config of the buffer pool.");
+    gst_object_unref (pool);
+    return FALSE;
+  }
+
+  silent_debug ("buffer pool for output, size %u min %u max %u", size, min,
+      max);
+
+  if (gst_query_get_n_allocation_pools (query) > 0) {
+    gst_query_set_nth_allocation_pool (query, 0, pool, size, min, max);
+  } else {
+    gst_query_add_allocation_pool (query, pool, size, min, max);
+  }
+
+  gst_object_unref (pool);
+  return TRUE;
+}
+
+/**
+ * @brief Propose the buffer pool for input tensors to upstream. optional vmethod of BaseTransform
+ */
+static gboolean
+gst_tensor_filter_propose_allocation (GstBaseTransform * trans,
+    GstQuery * decide_query, GstQuery * query)
+{
+  GstTensorFilter *self;
+  GstBufferPool *pool;
+  GstStructure *config;
+  GstCaps *caps;
+  gboolean need_pool;
+  guint size;
+
+  self = GST_TENSOR_FILTER_CAST (trans);
+
+  if (!GST_BASE_TRANSFORM_CLASS (parent_class)->propose_allocation (trans,
+          decide_query, query)) {
+    return FALSE;
+  }
+
+  /* passthrough or in-place, the query is handled by downstream */
+  if (decide_query == NULL)
+    return TRUE;
+
+  gst_query_parse_allocation (query, &caps, &need_pool);
+
+  if (!need_pool || !self->prop.input_configured || self->num_state_in > 0 ||
+      self->num_combi_in > 0 || gst_query_get_n_allocation_pools (query) > 0) {
+    return TRUE;
+  }
+
+  size = gst_tensor_filter_in_size (self);
+
+  pool = gst_tensor_filter_pool_new (&self->prop.input_meta);
+  config = gst_buffer_pool_get_config (pool);
+  gst_buffer_pool_config_set_params (config, caps, size, self->min_buffers,
+      self->max_buffers);
+
+  if (!gst_buffer_pool_set_config (pool, config)) {
+    GST_WARNING_OBJECT (self, "Failed to set config of the buffer pool.");
+    gst_object_unref (pool);
+    return TRUE;
+  }
+
+  gst_query_add_allocation_pool (query, pool, size, self->min_buffers,
+      self->max_buffers);
+  gst_object_unref (pool);
+  return TRUE;
+}
+
+/**
+ * @brief A unit of invoke, a frame or a batch of frames.
+ */
+typedef struct
+{
+  guint num_buffers; /**< the number of frames */
+  guint max_buffers; /**< the batch size */
+  GstBuffer **inbuf; /**< input buffers */
+  GstBuffer **outbuf; /**< output buffers (same as inbuf in in-place mode) */
+  gboolean done; /**< TRUE if the job is invoked */
+  GstFlowReturn ret; /**< the result of invoke */
+} GstTensorFilterJob;
+
+/**
+ * @brief Create a new job.
+ * @param batch_size the maximum number of frames in this job
+ */
+static GstTensorFilterJob *
+gst_tensor_filter_job_new (guint batch_size)
+{
+  GstTensorFilterJob *job;
+
+  job = g_new0 (GstTensorFilterJob, 1);
+  job->max_buffers = batch_size;
+  job->inbuf = g_new0 (GstBuffer *, batch_size);
+  job->outbuf = g_new0 (GstBuffer *, batch_size);
+  job->done = FALSE;
+  job->ret = GST_FLOW_OK;
+
+  return job;
+}
+
+/**
+ * @brief Free the job and its buffers.
+ */
+static void
+gst_tensor_filter_job_free (GstTensorFilterJob * job)
+{
+  guint i;
+
+  for (i = 0; i < job->num_buffers; i++) {
+    if (job->outbuf[i])
+      gst_buffer_unref (job->outbuf[i]);
+    if (job->inbuf[i] && job->inbuf[i] != job->outbuf[i])
+      gst_buffer_unref (job->inbuf[i]);
+  }
+
+  g_free (job->inbuf);
+  g_free (job->outbuf);
+  g_free (job);
+}
+
+/**
+ * @brief Take the output buffer of the frame from the job.
+ */
+static GstBuffer *
+gst_tensor_filter_job_take_output (GstTensorFilterJob * job, guint index)
+{
+  GstBuffer *outbuf;
+
+  outbuf = job->outbuf[index];
+  job->outbuf[index] = NULL;
+
+  /* in in-place mode, inbuf is pushed */
+  if (job->inbuf[index] == outbuf)
+    job->inbuf[index] = NULL;
+
+  return outbuf;
+}
+
+/**
+ * @brief Invoke the model once with a batch of frames.
+ * @param self "this" pointer
+ * @param job the batch of frames
+ * @return TRUE if invoked. FALSE if the sub-plugin cannot invoke the batch, then each frame should be invoked.
+ */
+static gboolean
+gst_tensor_filter_invoke_batch (GstTensorFilter * self,
+    GstTensorFilterJob * job)
+{
+  GstTensorFilterProperties *prop;
+  GstTensorMemory *in_tensors, *out_tensors;
+  GstMapInfo *in_info, *out_info;
+  GstBuffer *buf;
+  GstMemory *mem;
+  gboolean in_place;
+  guint b, i, idx, n_in, n_out;
+  gpointer arrays;
+  gint64 start;
+  gint ret;
+
+  prop = &self->prop;
+
+  if (self->fw->invoke_batch_NN == NULL ||
+      gst_tensor_filter_allocate_in_invoke (self) ||
+      gst_tensor_filter_combi_used (self))
+    return FALSE;
+
+  gst_tensor_filter_thread_apply (self);
+
+  in_place = gst_base_transform_is_in_place (GST_BASE_TRANSFORM_CAST (self));
+  n_in = prop->input_meta.num_tensors;
+  n_out = prop->output_meta.num_tensors;
+
+  /* a memory block for the arrays of all frames, allocated once for the batch */
+  arrays = g_malloc0 ((sizeof (GstMapInfo) + sizeof (GstTensorMemory)) *
+      job->num_buffers * (n_in + n_out));
+  in_info = (GstMapInfo *) arrays;
+  out_info = in_info + job->num_buffers * n_in;
+  in_tensors = (GstTensorMemory *) (out_info + job->num_buffers * n_out);
+  out_tensors = in_tensors + job->num_buffers * n_in;
+
+  for (b = 0; b < job->num_buffers; b++) {
+    /* 1. Set input tensors of each frame. */
+    buf = (in_place) ? job->outbuf[b] : job->inbuf[b];
+    g_assert (gst_buffer_n_memory (buf) == n_in);
+
+    for (i = 0; i < n_in; i++) {
+      idx = b * n_in + i;
+      g_assert (gst_buffer_map_range (buf, i, 1, &in_info[idx],
+              (in_place) ? GST_MAP_READWRITE : GST_MAP_READ));
+
+      in_tensors[idx].data = in_info[idx].data;
+      in_tensors[idx].size = in_info[idx].size;
+      in_tensors[idx].type = prop->input_meta.info[i].type;
+    }
+
+    /* 2. Prepare output tensors of each frame. */
+    buf = job->outbuf[b];
+
+    if (!in_place && gst_buffer_n_memory (buf) == 0) {
+      for (i = 0; i < n_out; i++) {
+        mem = gst_allocator_alloc (NULL, gst_tensor_filter_out_size (self, i),
+            NULL);
+        gst_buffer_append_memory (buf, mem);
+      }
+    }
+
+    for (i = 0; i < n_out; i++) {
+      idx = b * n_out + i;
+
+      if (in_place) {
+        out_tensors[idx].data = in_tensors[idx].data;
+      } else {
+        g_assert (gst_buffer_map_range (buf, i, 1, &out_info[idx],
+                GST_MAP_WRITE));
+        out_tensors[idx].data = out_info[idx].data;
+      }
+
+      out_tensors[idx].size = gst_tensor_filter_out_size (self, i);
+      out_tensors[idx].type = prop->output_meta.info[i].type;
+    }
+  }
+
+  /* 3. Call the filter-subplugin callback, "invoke_batch" */
+  start = g_get_monotonic_time ();
+  gst_tensor_filter_call (self, ret, invoke_batch_NN, in_tensors, out_tensors,
+      job->num_buffers);
+  if (ret == 0)
+    gst_tensor_filter_stats_record (self, start, job->num_buffers);
+
+  /* 4. Free map info. */
+  for (b = 0; b < job->num_buffers; b++) {
+    buf = (in_place) ? job->outbuf[b] : job->inbuf[b];
+
+    for (i = 0; i < n_in; i++)
+      gst_buffer_unmap (buf, &in_info[b * n_in + i]);
+
+    if (!in_place) {
+      for (i = 0; i < n_out; i++)
+        gst_buffer_unmap (job->outbuf[b], &out_info[b * n_out + i]);
+    }
+  }
+
+  g_free (arrays);
+
+  if (ret != 0) {
+    GST_WARNING_OBJECT (self,
+        "Failed to invoke a batch of %u frames, invoke each frame.",
+        job->num_buffers);
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Invoke the model with the frames in the job.
+ * @param self "this" pointer
+ * @param job a frame or a batch of frames
+ * @return GST_FLOW_OK if all frames are invoked
+ */
+static GstFlowReturn
+gst_tensor_filter_invoke_job (GstTensorFilter * self, GstTensorFilterJob * job)
+{
+  GstBaseTransform *trans;
+  GstFlowReturn ret = GST_FLOW_OK;
+  guint i;
+
+  trans = GST_BASE_TRANSFORM_CAST (self);
+
+  if (job->num_buffers > 1 && gst_tensor_filter_invoke_batch (self, job))
+    return GST_FLOW_OK;
+
+  for (i = 0; i < job->num_buffers && ret == GST_FLOW_OK; i++) {
+    if (gst_base_transform_is_in_place (trans)) {
+      ret = gst_tensor_filter_transform_ip (trans, job->outbuf[i]);
+    } else {
+      ret = gst_tensor_filter_transform (trans, job->inbuf[i], job->outbuf[i]);
+    }
+  }
+
+  return ret;
+}
+
+/**
+ * @brief Worker thread function to invoke the model with a job.
+ *
+ * Invoked jobs are pushed in arrival order by the task of the source pad.
+ */
+static void
+gst_tensor_filter_async_invoke (gpointer data, gpointer user_data)
+{
+  GstTensorFilter *self;
+  GstTensorFilterJob *job;
+  GstFlowReturn ret;
+  gboolean flushing;
+
+  self = GST_TENSOR_FILTER_CAST (user_data);
+  job = (GstTensorFilterJob *) data;
+
+  g_mutex_lock (&self->inflight_lock);
+  flushing = self->flushing;
+  g_mutex_unlock (&self->inflight_lock);
+
+  if (flushing) {
+    /* skip invoke, the job will be dropped */
+    ret = GST_FLOW_FLUSHING;
+  } else {
+    ret = gst_tensor_filter_invoke_job (self, job);
+  }
+
+  g_mutex_lock (&self->inflight_lock);
+  job->ret = ret;
+  job->done = TRUE;
+  g_cond_broadcast (&self->inflight_cond);
+  g_mutex_unlock (&self->inflight_lock);
+}
+
+/**
+ * @brief Queue the batch being accumulated to the workers.
+ * @param self "this" pointer
+ * @note Called with inflight_lock.
+ */
+static void
+gst_tensor_filter_async_queue_batch (GstTensorFilter * self)
+{
+  GstTensorFilterJob *job;
+
+  job = (GstTensorFilterJob *) self->batch;
+  self->batch = NULL;
+
+  g_queue_push_tail (&self->inflight, job);
+  g_thread_pool_push (self->workers, job, NULL);
+}
+
+/**
+ * @brief Task function of the source pad to push the invoked frames in arrival order.
+ *
+ * This also invokes the partial batch when batch-timeout-ms expires.
+ */
+static void
+gst_tensor_filter_async_push (gpointer user_data)
+{
+  GstTensorFilter *self;
+  GstBaseTransform *trans;
+  GstTensorFilterJob *job;
+  GstFlowReturn ret;
+  guint i;
+
+  self = GST_TENSOR_FILTER_CAST (user_data);
+  trans = GST_BASE_TRANSFORM_CAST (self);
+
+  g_mutex_lock (&self->inflight_lock);
+  while (!self->flushing) {
+    job = (GstTensorFilterJob *) g_queue_peek_head (&self->inflight);
+    if (job && job->done)
+      break;
+
+    if (self->batch && self->batch_timeout > 0) {
+      if (g_get_monotonic_time () >= self->batch_deadline) {
+        gst_tensor_filter_async_queue_batch (self);
+        continue;
+      }
+
+      g_cond_wait_until (&self->inflight_cond, &self->inflight_lock,
+          self->batch_deadline);
+    } else {
+      g_cond_wait (&self->inflight_cond, &self->inflight_lock);
+    }
+  }
+
+  if (self->flushing) {
+    g_mutex_unlock (&self->inflight_lock);
+    goto pause;
+  }
+
+  /* the drain waits for this job until its outputs are pushed */
+  job = (GstTensorFilterJob *) g_queue_pop_head (&self->inflight);
+  self->pushing = TRUE;
+  g_mutex_unlock (&self->inflight_lock);
+
+  ret = job->ret;
+  for (i = 0; i < job->num_buffers && ret == GST_FLOW_OK; i++) {
+    ret = gst_pad_push (trans->srcpad,
+        gst_tensor_filter_job_take_output (job, i));
+  }
+
+  if (job->ret == GST_FLOW_OK &&
+      (ret == GST_FLOW_NOT_LINKED || ret < GST_FLOW_EOS)) {
+    GST_ELEMENT_ERROR (self, STREAM, FAILED,
+        ("Internal data stream error."),
+        ("streaming stopped, reason %s", gst_flow_get_name (ret)));
+  }
+
+  gst_tensor_filter_job_free (job);
+
+  /* wake up the streaming thread waiting for a free slot */
+  g_mutex_lock (&self->inflight_lock);
+  if (self->last_ret == GST_FLOW_OK)
+    self->last_ret = ret;
+  self->pushing = FALSE;
+  g_cond_broadcast (&self->inflight_cond);
+  g_mutex_unlock (&self->inflight_lock);
+
+  if (ret == GST_FLOW_OK)
+    return;
+
+  silent_debug ("pausing task, reason %s", gst_flow_get_name (ret));
+
+pause:
+  gst_pad_pause_task (trans->srcpad);
+}
+
+/**
+ * @brief Wait until all in-flight frames are pushed.
+ * @param self "this" pointer
+ * @note Called with the stream lock of the sink pad (e.g., before serialized events).
+ */
+static void
+gst_tensor_filter_async_drain (GstTensorFilter * self)
+{
+  g_mutex_lock (&self->inflight_lock);
+  while (!self->flushing && self->last_ret == GST_FLOW_OK &&
+      (self->pushing || !g_queue_is_empty (&self->inflight))) {
+    g_cond_wait (&self->inflight_cond, &self->inflight_lock);
+  }
+  g_mutex_unlock (&self->inflight_lock);
+}
+
+/**
+ * @brief Drop all in-flight frames. The workers skip invoke while flushing.
+ * @param self "this" pointer
+ */
+static void
+gst_tensor_filter_async_clear (GstTensorFilter * self)
+{
+  GstTensorFilterJob *job;
+  GList *l;
+
+  g_mutex_lock (&self->inflight_lock);
+
+  /* wait for the jobs being invoked by the workers */
+  l = self->inflight.head;
+  while (l) {
+    job = (GstTensorFilterJob *) l->data;
+
+    if (job->done) {
+      l = l->next;
+    } else {
+      g_cond_wait (&self->inflight_cond, &self->inflight_lock);
+      l = self->inflight.head;
+    }
+  }
+
+  while ((job = g_queue_pop_head (&self->inflight)) != NULL)
+    gst_tensor_filter_job_free (job);
+
+  g_cond_broadcast (&self->inflight_cond);
+  g_mutex_unlock (&self->inflight_lock);
+}
+
+/**
+ * @brief Set or unset flushing state of asynchronous invoke.
+ * @param self "this" pointer
+ * @param flushing TRUE to stop waiting for in-flight frames
+ */
+static void
+gst_tensor_filter_async_set_flushing (GstTensorFilter * self,
+    gboolean flushing)
+{
+  g_mutex_lock (&self->inflight_lock);
+  self->flushing = flushing;
+  if (!flushing)
+    self->last_ret = GST_FLOW_OK;
+  g_cond_broadcast (&self->inflight_cond);
+  g_mutex_unlock (&self->inflight_lock);
+}
+
+/**
+ * @brief Add the input buffer to the batch being accumulated.
+ * @param self "this" pointer
+ * @param inbuf the input buffer (transfer full)
+ * @param[out] ready TRUE if the batch is full or batch-timeout-ms expires
+ */
+static GstFlowReturn
+gst_tensor_filter_batch_add (GstTensorFilter * self, GstBuffer * inbuf,
+    gboolean * ready)
+{
+  GstBaseTransform *trans;
+  GstTensorFilterJob *job;
+  GstBuffer *buf = NULL;
+  GstFlowReturn ret;
+
+  trans = GST_BASE_TRANSFORM_CAST (self);
+  *ready = FALSE;
+
+  /* this returns inbuf (or its copy) in in-place mode */
+  ret = GST_BASE_TRANSFORM_GET_CLASS (trans)->prepare_output_buffer (trans,
+      inbuf, &buf);
+  if (ret != GST_FLOW_OK || buf == NULL) {
+    gst_buffer_unref (inbuf);
+    return ret;
+  }
+
+  g_mutex_lock (&self->inflight_lock);
+  job = (GstTensorFilterJob *) self->batch;
+
+  if (job == NULL) {
+    job = gst_tensor_filter_job_new (MAX (self->batch_size, 1));
+    self->batch = job;
+    self->batch_deadline = g_get_monotonic_time () +
+        (gint64) self->batch_timeout * G_TIME_SPAN_MILLISECOND;
+  }
+
+  job->inbuf[job->num_buffers] = inbuf;
+  job->outbuf[job->num_buffers] = buf;
+  job->num_buffers++;
+
+  *ready = (job->num_buffers >= job->max_buffers);
+  if (!(*ready) && self->batch_timeout > 0)
+    *ready = (g_get_monotonic_time () >= self->batch_deadline);
+
+  /* the task waits for the deadline of the batch */
+  g_cond_broadcast (&self->inflight_cond);
+  g_mutex_unlock (&self->inflight_lock);
+
+  if (self->workers) {
+    /* start the task if it is not started (e.g., after flushing) */
+    gst_pad_start_task (trans->srcpad, gst_tensor_filter_async_push, self,
+        NULL);
+  }
+
+  return GST_FLOW_OK;
+}
+
+/**
+ * @brief Invoke the batch being accumulated. In asynchronous mode, this queues the batch to the workers.
+ * @param self "this" pointer
+ * @param[out] outbuf the first output buffer to be pushed in synchronous mode. The others are kept in outbufs.
+ */
+static GstFlowReturn
+gst_tensor_filter_batch_submit (GstTensorFilter * self, GstBuffer ** outbuf)
+{
+  GstTensorFilterJob *job;
+  GstFlowReturn ret;
+  guint i;
+
+  *outbuf = NULL;
+
+  if (self->workers == NULL) {
+    job = (GstTensorFilterJob *) self->batch;
+    self->batch = NULL;
+
+    if (job == NULL)
+      return GST_FLOW_OK;
+
+    ret = gst_tensor_filter_invoke_job (self, job);
+    if (ret == GST_FLOW_OK) {
+      for (i = 0; i < job->num_buffers; i++) {
+        g_queue_push_tail (&self->outbufs,
+            gst_tensor_filter_job_take_output (job, i));
+      }
+
+      *outbuf = (GstBuffer *) g_queue_pop_head (&self->outbufs);
+    }
+
+    gst_tensor_filter_job_free (job);
+    return ret;
+  }
+
+  /* wait for a free slot */
+  g_mutex_lock (&self->inflight_lock);
+  while (!self->flushing && self->last_ret == GST_FLOW_OK &&
+      g_queue_get_length (&self->inflight) >= self->max_inflight) {
+    g_cond_wait (&self->inflight_cond, &self->inflight_lock);
+  }
+  ret = (self->flushing) ? GST_FLOW_FLUSHING : self->last_ret;
+
+  /* the task may have queued the batch when batch-timeout-ms expired */
+  if (ret == GST_FLOW_OK && self->batch != NULL)
+    gst_tensor_filter_async_queue_batch (self);
+  g_mutex_unlock (&self->inflight_lock);
+
+  return ret;
+}
+
+/**
+ * @brief Invoke the partial batch and push the output buffers, before serialized events.
+ * @param self "this" pointer
+ */
+static void
+gst_tensor_filter_batch_flush (GstTensorFilter * self)
+{
+  GstBaseTransform *trans;
+  GstBuffer *outbuf;
+  GstFlowReturn ret;
+
+  trans = GST_BASE_TRANSFORM_CAST (self);
+
+  ret = gst_tensor_filter_batch_submit (self, &outbuf);
+
+  /* in asynchronous mode, the task pushes the output buffers */
+  while (outbuf) {
+    if (ret == GST_FLOW_OK) {
+      ret = gst_pad_push (trans->srcpad, outbuf);
+    } else {
+      gst_buffer_unref (outbuf);
+    }
+
+    outbuf = (GstBuffer *) g_queue_pop_head (&self->outbufs);
+  }
+
+  if (ret != GST_FLOW_OK) {
+    GST_WARNING_OBJECT (self, "Failed to push the partial batch, reason %s",
+        gst_flow_get_name (ret));
+  }
+}
+
+/**
+ * @brief Drop the batch being accumulated and the output buffers not pushed.
+ * @param self "this" pointer
+ */
+static void
+gst_tensor_filter_batch_clear (GstTensorFilter * self)
+{
+  GstTensorFilterJob *job;
+  GstBuffer *buf;
+
+  g_mutex_lock (&self->inflight_lock);
+  job = (GstTensorFilterJob *) self->batch;
+  self->batch = NULL;
+  g_mutex_unlock (&self->inflight_lock);
+
+  if (job)
+    gst_tensor_filter_job_free (job);
+
+  while ((buf = g_queue_pop_head (&self->outbufs)) != NULL)
+    gst_buffer_unref (buf);
+}
+
+/**
+ * @brief Get the time to invoke a frame, measured with the invoke statistics.
+ * @param self "this" pointer
+ * @return the time (nsec) per frame. 0 if not invoked.
+ *
+ * A batch invoke is shared by its frames, and the worker threads invoke the frames concurrently.
+ */
+static GstClockTime
+gst_tensor_filter_throttle_interval (GstTensorFilter * self)
+{
+  guint64 total, frames;
+
+  g_mutex_lock (&self->stats.lock);
+  total = self->stats.total;
+  frames = self->stats.frames;
+  g_mutex_unlock (&self->stats.lock);
+
+  if (frames == 0)
+    return 0;
+
+  return gst_util_uint64_scale (total, GST_USECOND,
+      frames * MAX (self->num_threads, 1));
+}
+
+/**
+ * @brief Submit the input buffer, skipping the frame late or arriving faster than invoke. optional vmethod of BaseTransform
+ *
+ * The default submit_input_buffer drops the frame with QoS. With throttle, this also drops the frame if its timestamp
+ * is earlier than the time to invoke a frame after the last invoked frame.
+ * The new model given while streaming is swapped here, before the frame is invoked.
+ */
+static GstFlowReturn
+gst_tensor_filter_submit_input_buffer (GstBaseTransform * trans,
+    gboolean is_discont, GstBuffer * inbuf)
+{
+  GstTensorFilter *self;
+  GstClockTime ts, interval;
+  GstFlowReturn ret;
+
+  self = GST_TENSOR_FILTER_CAST (trans);
+
+  /* the new model given while streaming, swapped between invokes */
+  gst_tensor_filter_swap_commit (self);
+
+  ret = GST_BASE_TRANSFORM_CLASS (parent_class)->submit_input_buffer (trans,
+      is_discont, inbuf);
+  if (ret != GST_FLOW_OK || gst_base_transform_is_passthrough (trans))
+    return ret;
+
+  if (G_UNLIKELY (self->swap_wait_caps) && trans->queued_buf) {
+    /* the input tensors of the old model, cannot be invoked with the new model */
+    gst_buffer_unref (trans->queued_buf);
+    trans->queued_buf = NULL;
+    self->swap_dropped++;
+    return GST_FLOW_OK;
+  }
+
+  if (trans->queued_buf == NULL) {
+    /* dropped by QoS */
+    g_mutex_lock (&self->stats.lock);
+    self->stats.skipped++;
+    g_mutex_unlock (&self->stats.lock);
+    return ret;
+  }
+
+  if (!self->throttle)
+    return ret;
+
+  ts = GST_BUFFER_PTS (trans->queued_buf);
+  if (!GST_CLOCK_TIME_IS_VALID (ts))
+    return ret;
+
+  if (is_discont || !GST_CLOCK_TIME_IS_VALID (self->throttle_last_ts) ||
+      ts < self->throttle_last_ts) {
+    self->throttle_last_ts = ts;
+    return ret;
+  }
+
+  interval = gst_tensor_filter_throttle_interval (self);
+  if (ts - self->throttle_last_ts < interval) {
+    silent_debug ("throttle, skip the frame %" GST_TIME_FORMAT,
+        GST_TIME_ARGS (ts));
+
+    gst_buffer_unref (trans->queued_buf);
+    trans->queued_buf = NULL;
+    g_mutex_lock (&self->stats.lock);
+    self->stats.skipped++;
+    g_mutex_unlock (&self->stats.lock);
+    return GST_FLOW_OK;
+  }
+
+  self->throttle_last_ts = ts;
+  return ret;
+}
+
+/**
+ * @brief Generate the output buffer with the batch invoke or asynchronous invoke. optional vmethod of BaseTransform
+ *
+ * If batch-size is 1 and max-inflight is 0, this is the same as the default.
+ * With batch-size, the input buffers are accumulated and invoked at once, then this returns the output buffers one by one.
+ * With max-inflight, this returns without the output buffer and the task of the source pad pushes it.
+ * QoS is handled by the default submit_input_buffer before a frame gets in-flight.
+ */
+static GstFlowReturn
+gst_tensor_filter_generate_output (GstBaseTransform * trans,
+    GstBuffer ** outbuf)
+{
+  GstTensorFilter *self;
+  GstBuffer *inbuf;
+  GstFlowReturn ret;
+  gboolean ready;
+
+  self = GST_TENSOR_FILTER_CAST (trans);
+
+  if ((self->workers == NULL && (self->batch_size <= 1 ||
+              self->num_state_in > 0) && self->batch == NULL)
+      || gst_base_transform_is_passthrough (trans)) {
+    return GST_BASE_TRANSFORM_CLASS (parent_class)->generate_output (trans,
+        outbuf);
+  }
+
+  *outbuf = NULL;
+
+  /* the output buffers of the batch invoked synchronously */
+  if (!g_queue_is_empty (&self->outbufs)) {
+    *outbuf = (GstBuffer *) g_queue_pop_head (&self->outbufs);
+    return GST_FLOW_OK;
+  }
+
+  inbuf = trans->queued_buf;
+  trans->queued_buf = NULL;
+
+  /* the input buffer may be dropped by QoS */
+  if (inbuf == NULL)
+    return GST_FLOW_OK;
+
+  ret = gst_tensor_filter_check_invoke (self);
+  if (G_UNLIKELY (ret != GST_FLOW_OK)) {
+    gst_buffer_unref (inbuf);
+    return ret;
+  }
+
+  ret = gst_tensor_filter_batch_add (self, inbuf, &ready);
+  if (ret != GST_FLOW_OK || !ready)
+    return ret;
+
+  return gst_tensor_filter_batch_submit (self, outbuf);
+}
+
+/**
+ * @brief Event handler for sink pad. optional vmethod of BaseTransform
+ *
+ * The partial batch is invoked and the in-flight frames are pushed before serialized events (e.g., EOS and caps).
+ * They are dropped when flushing.
+ */
+static gboolean
+gst_tensor_filter_sink_event (GstBaseTransform * trans, GstEvent * event)
+{
+  GstTensorFilter *self;
+  gboolean res;
+
+  self = GST_TENSOR_FILTER_CAST (trans);
+
+  /* the recurrence restarts with zero-filled state tensors */
+  if (GST_EVENT_TYPE (event) == GST_EVENT_FLUSH_STOP)
+    gst_tensor_filter_state_reset (self);
+
+  /* the streaming thread invoking the model synchronously is shared, restore it at the end of stream */
+  if (GST_EVENT_TYPE (event) == GST_EVENT_EOS)
+    gst_tensor_filter_thread_restore (self);
+
+  if (self->workers == NULL && self->batch == NULL) {
+    return GST_BASE_TRANSFORM_CLASS (parent_class)->sink_event (trans, event);
+  }
+
+  switch (GST_EVENT_TYPE (event)) {
+    case GST_EVENT_FLUSH_START:
+      if (self->workers) {
+        gst_tensor_filter_async_set_flushing (self, TRUE);
+
+        /* unblock the task pushing a frame, and then wait for it */
+        res = GST_BASE_TRANSFORM_CLASS (parent_class)->sink_event (trans,
+            event);
+        gst_pad_pause_task (trans->srcpad);
+        return res;
+      }
+      break;
+    case GST_EVENT_FLUSH_STOP:
+      gst_tensor_filter_batch_clear (self);
+
+      if (self->workers) {
+        gst_tensor_filter_async_clear (self);
+        gst_tensor_filter_async_set_flushing (self, FALSE);
+      }
+      break;
+    default:
+      if (GST_EVENT_IS_SERIALIZED (event)) {
+        gst_tensor_filter_batch_flush (self);
+
+        if (self->workers)
+          gst_tensor_filter_async_drain (self);
+      }
+      break;
+  }
+
+  return GST_BASE_TRANSFORM_CLASS (parent_class)->sink_event (trans, event);
+}
+
+/**
+ * @brief Invoke the opened model with zero-filled tensors.
+ * @param filter the element with the opened model
+ * @param in_info the input tensors info
+ * @param out_info the output tensors info
+ * @param count the number of invokes
+ * @return the number of invokes done. Less than count if the model fails to invoke.
+ */
+static guint
+gst_tensor_filter_warmup_invoke (GstTensorFilter * filter,
+    const GstTensorsInfo * in_info, const GstTensorsInfo * out_info,
+    guint count)
+{
+  GstTensorMemory in_tensors[NNS_TENSOR_SIZE_LIMIT];
+  GstTensorMemory out_tensors[NNS_TENSOR_SIZE_LIMIT];
+  GDestroyNotify release[NNS_TENSOR_SIZE_LIMIT];
+  void *user_data[NNS_TENSOR_SIZE_LIMIT];
+  gpointer saved = NULL;
+  gboolean allocate_in_invoke;
+  guint n, i;
+  gint ret;
+
+  /* the threads created by the sub-plugin on the first invoke inherit the attributes */
+  if (filter->prop.cpu_affinity || filter->prop.thread_priority != 0)
+    gst_tensor_thread_pin (filter->prop.cpu_affinity,
+        filter->prop.thread_priority, &saved);
+
+  allocate_in_invoke = gst_tensor_filter_allocate_in_invoke (filter);
+
+  for (i = 0; i < in_info->num_tensors; i++) {
+    in_tensors[i].size = gst_tensor_info_get_size (&in_info->info[i]);
+    in_tensors[i].type = in_info->info[i].type;
+    in_tensors[i].data = g_malloc0 (in_tensors[i].size);
+  }
+
+  for (i = 0; i < out_info->num_tensors; i++) {
+    out_tensors[i].size = gst_tensor_info_get_size (&out_info->info[i]);
+    out_tensors[i].type = out_info->info[i].type;
+    out_tensors[i].data = NULL;
+
+    if (!allocate_in_invoke)
+      out_tensors[i].data = g_malloc (out_tensors[i].size);
+  }
+
+  for (n = 0; n < count; n++) {
+    if (allocate_in_invoke && filter->fw->invoke_with_release_NN) {
+      for (i = 0; i < out_info->num_tensors; i++) {
+        release[i] = NULL;
+        user_data[i] = NULL;
+      }
+
+      gst_tensor_filter_call (filter, ret, invoke_with_release_NN, in_tensors,
+          out_tensors, release, user_data);
+    } else {
+      gst_tensor_filter_call (filter, ret, invoke_NN, in_tensors, out_tensors);
+    }
+
+    if (ret != 0)
+      break;
+
+    /* the sub-plugin allocated the output tensors */
+    if (allocate_in_invoke) {
+      for (i = 0; i < out_info->num_tensors; i++) {
+        if (filter->fw->invoke_with_release_NN && release[i])
+          release[i] (user_data[i]);
+        else
+          g_free (out_tensors[i].data);
+        out_tensors[i].data = NULL;
+      }
+    }
+  }
+
+  for (i = 0; i < in_info->num_tensors; i++)
+    g_free (in_tensors[i].data);
+  for (i = 0; i < out_info->num_tensors; i++)
+    g_free (out_tensors[i].data);
+
+  gst_tensor_thread_restore (saved);
+  return n;
+}
+
+/**
+ * @brief Open the model and invoke it with zero-filled tensors, to cut the latency of the first frames.
+ * @param self "this" pointer
+ *
+ * The input tensors are given by getInputDimension or the properties. The output tensors are given by getOutputDimension,
+ * the properties or setInputDimension.
+ */
+static void
+gst_tensor_filter_warmup (GstTensorFilter * self)
+{
+  GstTensorFilterProperties *prop;
+  GstTensorsInfo in_info, out_info;
+  gint64 start;
+  guint n;
+  gint ret;
+
+  prop = &self->prop;
+  self->warmup_time = 0;
+
+  if (self->warmup == 0 || self->fw == NULL || prop->model_file == NULL)
+    return;
+
+  start = g_get_monotonic_time ();
+
+  /* this opens the model */
+  gst_tensor_filter_load_tensor_info (self);
+  if (!prop->fw_opened) {
+    GST_WARNING_OBJECT (self, "Failed to open the model %s", prop->model_file);
+    return;
+  }
+
+  in_info = prop->input_meta;
+  out_info = prop->output_meta;
+
+  if (!gst_tensors_info_validate (&in_info)) {
+    GST_INFO_OBJECT (self, "Cannot warm up, unknown input tensors.");
+    return;
+  }
+
+  if (!gst_tensors_info_validate (&out_info)) {
+    gst_tensors_info_init (&out_info);
+    ret = gst_tensor_filter_set_input_dim (self, &in_info, &out_info, TRUE);
+
+    if (ret != 0 || !gst_tensors_info_validate (&out_info)) {
+      GST_INFO_OBJECT (self, "Cannot warm up, unknown output tensors.");
+      return;
+    }
+  }
+
+  n = gst_tensor_filter_warmup_invoke (self, &in_info, &out_info,
+      self->warmup);
+  if (n < self->warmup)
+    GST_WARNING_OBJECT (self, "Failed to invoke the model to warm up.");
+
+  self->warmup_time = g_get_monotonic_time () - start;
+
+  GST_INFO_OBJECT (self, "Warmed up the model with %u invokes: %"
+      G_GINT64_FORMAT " us", n, self->warmup_time);
+  silent_debug ("Warm-up time = %" G_GINT64_FORMAT " us\n",
+      self->warmup_time);
+}
+
+/**
+ * @brief Open the new model and warm it up with the current tensors. Called by the streaming thread at the swap.
+ * @param self "this" pointer
+ * @return TRUE if the new model is ready to invoke the frames
+ *
+ * The model is opened with the element and its properties, the model file of the properties is the new one.
+ * The input tensors are given by getInputDimension, or the current input tensors of the element.
+ * The output tensors are given by getOutputDimension, or setInputDimension with the input tensors.
+ */
+static gboolean
+gst_tensor_filter_swap_prepare (GstTensorFilter * self)
+{
+  GstTensorFilterProperties *prop;
+  GstTensorsInfo in_info, out_info;
+  gint ret;
+
+  prop = &self->prop;
+
+  gst_tensor_filter_open_fw (self);
+  if (!prop->fw_opened) {
+    GST_WARNING_OBJECT (self, "Failed to open the model %s",
+        prop->model_file);
+    return FALSE;
+  }
+
+  gst_tensors_info_init (&in_info);
+  gst_tensor_filter_call (self, ret, getInputDimension, &in_info);
+  if (ret == 0)
+    prop->input_meta = in_info;
+
+  gst_tensors_info_init (&out_info);
+  gst_tensor_filter_call (self, ret, getOutputDimension, &out_info);
+  if (ret != 0) {
+    gst_tensors_info_init (&out_info);
+    ret = gst_tensor_filter_set_input_dim (self, &prop->input_meta,
+        &out_info, TRUE);
+  }
+
+  if (ret != 0 || !gst_tensors_info_validate (&prop->input_meta) ||
+      !gst_tensors_info_validate (&out_info)) {
+    GST_WARNING_OBJECT (self, "Cannot get the tensors of the model %s",
+        prop->model_file);
+    return FALSE;
+  }
+
+  prop->output_meta = out_info;
+  prop->input_configured = TRUE;
+  prop->output_configured = TRUE;
+
+  /* invoke at least once, the first frame should not wait for lazy initialization */
+  if (gst_tensor_filter_warmup_invoke (self, &prop->input_meta,
+          &prop->output_meta, MAX (self->warmup, 1)) <
+      MAX (self->warmup, 1)) {
+    GST_WARNING_OBJECT (self, "Failed to invoke the model %s",
+        prop->model_file);
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Read the new model file ahead, so that the sub-plugin opens it from the page cache.
+ * @param self "this" pointer
+ * @return TRUE if the file is read. FALSE if failed or cancelled.
+ */
+static gboolean
+gst_tensor_filter_swap_read_ahead (GstTensorFilter * self)
+{
+  FILE *fp;
+  gchar *block;
+  gboolean ret = TRUE;
+
+  fp = fopen (self->swap_model, "rb");
+  if (fp == NULL)
+    return FALSE;
+
+  block = g_malloc (64 * 1024);
+  while (fread (block, 1, 64 * 1024, fp) > 0) {
+    if (g_atomic_int_get (&self->swap_state) != SWAP_LOADING) {
+      ret = FALSE;
+      break;
+    }
+  }
+
+  if (ferror (fp))
+    ret = FALSE;
+
+  g_free (block);
+  fclose (fp);
+  return ret;
+}
+
+/**
+ * @brief Thread function to read the new model file ahead of the swap.
+ * @param data "this" pointer
+ *
+ * The sub-plugin is not called here. The model is opened by the streaming thread with the element itself,
+ * the sub-plugin may keep the pointer of the element or its properties.
+ */
+static gpointer
+gst_tensor_filter_swap_thread (gpointer data)
+{
+  GstTensorFilter *self;
+  gboolean ready;
+
+  self = GST_TENSOR_FILTER_CAST (data);
+
+  ready = gst_tensor_filter_swap_read_ahead (self);
+
+  g_mutex_lock (&self->swap_lock);
+  /* cancelled if not loading */
+  if (g_atomic_int_get (&self->swap_state) == SWAP_LOADING) {
+    g_atomic_int_set (&self->swap_state, ready ? SWAP_READY : SWAP_FAILED);
+    g_cond_broadcast (&self->swap_cond);
+  } else {
+    ready = TRUE;
+  }
+  g_mutex_unlock (&self->swap_lock);
+
+  if (!ready) {
+    GST_ELEMENT_WARNING (self, RESOURCE, OPEN_READ,
+        ("Cannot read the model %s, keep the current model.",
+            self->swap_model), (NULL));
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief Start loading the model given while streaming.
+ * @param self "this" pointer
+ * @param model_file the path of the new model (transfer full)
+ *
+ * The model file is read ahead by the swap thread, then the streaming thread closes the old model and opens
+ * the new one with the element between the frames.
+ */
+static void
+gst_tensor_filter_swap_start (GstTensorFilter * self, gchar * model_file)
+{
+  /* the model given before is not swapped yet */
+  gst_tensor_filter_swap_join (self, FALSE);
+
+  g_mutex_lock (&self->swap_lock);
+  self->swap_model = model_file;
+  self->swap_request = g_get_monotonic_time ();
+  g_atomic_int_set (&self->swap_state, SWAP_LOADING);
+  g_mutex_unlock (&self->swap_lock);
+
+  GST_INFO_OBJECT (self, "Loading the model %s", model_file);
+  self->swap_thread = g_thread_new ("tensor_filter_swap",
+      gst_tensor_filter_swap_thread, self);
+}
+
+/**
+ * @brief Close the old model and open the new one with the element.
+ * @param self "this" pointer
+ * @param[out] changed TRUE if the tensors of the new model are different, to be renegotiated
+ * @return TRUE if swapped. FALSE if the new model cannot be opened, the old model is opened again.
+ * @note Called with swap_lock, when no frame is being invoked.
+ */
+static gboolean
+gst_tensor_filter_swap_exchange (GstTensorFilter * self, gboolean * changed)
+{
+  GstTensorFilterProperties *prop;
+  GstTensorsInfo in_info, out_info, applied;
+  gboolean in_configured, out_configured;
+  const gchar *model_file;
+  gboolean ready;
+  gint64 start;
+
+  prop = &self->prop;
+  start = g_get_monotonic_time ();
+
+  in_info = prop->input_meta;
+  out_info = prop->output_meta;
+  in_configured = prop->input_configured;
+  out_configured = prop->output_configured;
+  applied = self->dim_applied;
+  model_file = prop->model_file;
+
+  /* the cached results of setInputDimension are for the old model */
+  gst_tensor_filter_close_fw (self);
+  gst_tensor_filter_dim_cache_clear (self);
+
+  prop->model_file = self->swap_model;
+  self->swap_model = NULL;
+
+  ready = gst_tensor_filter_swap_prepare (self);
+  self->swap_load_time = g_get_monotonic_time () - start;
+
+  if (!ready) {
+    /* keep the old model */
+    gst_tensor_filter_close_fw (self);
+    gst_tensor_filter_dim_cache_clear (self);
+    g_free ((gchar *) prop->model_file);
+    prop->model_file = model_file;
+    prop->input_meta = in_info;
+    prop->output_meta = out_info;
+    prop->input_configured = in_configured;
+    prop->output_configured = out_configured;
+
+    gst_tensor_filter_open_fw (self);
+    if (gst_tensors_info_validate (&applied))
+      gst_tensor_filter_set_input_dim (self, &applied, &out_info, TRUE);
+
+    g_atomic_int_set (&self->swap_state, SWAP_FAILED);
+    g_cond_broadcast (&self->swap_cond);
+    return FALSE;
+  }
+
+  g_free ((gchar *) model_file);
+
+  self->swap_wait_caps = !gst_tensors_info_is_equal (&in_info,
+      &prop->input_meta);
+  *changed = (self->swap_wait_caps ||
+      !gst_tensors_info_is_equal (&out_info, &prop->output_meta));
+
+  if (*changed) {
+    /* get the tensors info from the new model again */
+    prop->input_configured = FALSE;
+    prop->output_configured = FALSE;
+    gst_tensors_info_init (&prop->input_meta);
+    gst_tensors_info_init (&prop->output_meta);
+    self->configured = FALSE;
+  }
+
+  /* the recurrence restarts with the new model */
+  gst_tensor_filter_state_reset (self);
+
+  g_atomic_int_set (&self->swap_state, SWAP_DONE);
+  g_cond_broadcast (&self->swap_cond);
+  return TRUE;
+}
+
+/**
+ * @brief Swap the model if the new model is ready. Called by the streaming thread before invoke.
+ * @param self "this" pointer
+ *
+ * The frames accumulated or in-flight are invoked with the old model before the swap.
+ * If the input tensors are changed, the frames are dropped until the caps for the new model arrive.
+ * If only the output tensors are changed, the source pad is renegotiated with the next frame.
+ */
+static void
+gst_tensor_filter_swap_commit (GstTensorFilter * self)
+{
+  GstBaseTransform *trans;
+  gboolean changed = FALSE;
+  gboolean swapped;
+  gint64 start;
+
+  if (G_LIKELY (g_atomic_int_get (&self->swap_state) != SWAP_READY))
+    return;
+
+  trans = GST_BASE_TRANSFORM_CAST (self);
+  start = g_get_monotonic_time ();
+
+  gst_tensor_filter_batch_flush (self);
+  if (self->workers)
+    gst_tensor_filter_async_drain (self);
+
+  g_mutex_lock (&self->swap_lock);
+  /* cancelled while the old model finishes the frames */
+  if (g_atomic_int_get (&self->swap_state) != SWAP_READY) {
+    g_mutex_unlock (&self->swap_lock);
+    return;
+  }
+
+  swapped = gst_tensor_filter_swap_exchange (self, &changed);
+
+  self->swap_stall = g_get_monotonic_time () - start;
+  if (swapped) {
+    self->swap_latency = g_get_monotonic_time () - self->swap_request;
+    self->swap_dropped = 0;
+  }
+  g_mutex_unlock (&self->swap_lock);
+
+  if (!swapped) {
+    GST_ELEMENT_WARNING (self, RESOURCE, OPEN_READ,
+        ("Cannot load the model, keep the current model."), (NULL));
+    return;
+  }
+
+  GST_INFO_OBJECT (self, "Swapped the model %s in %" G_GUINT64_FORMAT
+      " us (loaded in %" G_GINT64_FORMAT " us, stream blocked %"
+      G_GINT64_FORMAT " us)", self->prop.model_file, self->swap_latency,
+      self->swap_load_time, self->swap_stall);
+
+  if (self->swap_wait_caps) {
+    /* upstream may negotiate the input tensors of the new model */
+    gst_pad_push_event (trans->sinkpad, gst_event_new_reconfigure ());
+  } else {
+    if (changed)
+      gst_base_transform_reconfigure_src (trans);
+    gst_tensor_filter_swap_post (self);
+  }
+}
+
+/**
+ * @brief Cancel and join the thread reading the new model ahead.
+ * @param self "this" pointer
+ * @param commit TRUE to take the path of the new model not swapped yet (e.g., when stopping), opened with the next start.
+ *        FALSE to discard the new model.
+ * @note Called when no frame is being invoked if commit is TRUE.
+ */
+static void
+gst_tensor_filter_swap_join (GstTensorFilter * self, gboolean commit)
+{
+  gint state;
+
+  if (self->swap_thread == NULL)
+    return;
+
+  g_mutex_lock (&self->swap_lock);
+  state = g_atomic_int_get (&self->swap_state);
+  if (state == SWAP_LOADING || state == SWAP_READY) {
+    g_atomic_int_set (&self->swap_state, SWAP_DONE);
+    g_cond_broadcast (&self->swap_cond);
+  }
+  g_mutex_unlock (&self->swap_lock);
+
+  g_thread_join (self->swap_thread);
+  self->swap_thread = NULL;
+
+  if (commit && self->swap_model &&
+      (state == SWAP_LOADING || state == SWAP_READY)) {
+    gst_tensor_filter_close_fw (self);
+
+    g_mutex_lock (&self->swap_lock);
+    g_free ((gchar *) self->prop.model_file);
+    self->prop.model_file = self->swap_model;
+    self->swap_model = NULL;
+    g_mutex_unlock (&self->swap_lock);
+
+    gst_tensor_filter_dim_cache_clear (self);
+  }
+
+  g_free (self->swap_model);
+  self->swap_model = NULL;
+  g_atomic_int_set (&self->swap_state, SWAP_NONE);
+}
+
+/**
+ * @brief Post the element message "tensor_filter-model-swap" when the new model invokes the frames.
+ * @param self "this" pointer
+ */
+static void
+gst_tensor_filter_swap_post (GstTensorFilter * self)
+{
+  GstStructure *s;
+
+  s = gst_structure_new ("tensor_filter-model-swap",
+      "model", G_TYPE_STRING, self->prop.model_file,
+      "latency", G_TYPE_UINT64, self->swap_latency,
+      "load-time", G_TYPE_UINT64, (guint64) self->swap_load_time,
+      "stall", G_TYPE_UINT64, (guint64) self->swap_stall,
+      "dropped", G_TYPE_UINT, self->swap_dropped, NULL);
+
+  gst_element_post_message (GST_ELEMENT_CAST (self),
+      gst_message_new_element (GST_OBJECT_CAST (self), s));
+}
+
+/**
+ * @brief Change state of the element.
+ *
+ * In asynchronous mode, the task of the source pad holds the stream lock while waiting for the invoked frames.
+ * Stop the task before the pads are deactivated.
+ */
+static GstStateChangeReturn
+gst_tensor_filter_change_state (GstElement * element,
+    GstStateChange transition)
+{
+  GstTensorFilter *self;
+  GstBaseTransform *trans;
+  GstStateChangeReturn ret;
+
+  self = GST_TENSOR_FILTER (element);
+  trans = GST_BASE_TRANSFORM_CAST (element);
+
+  switch (transition) {
+    case GST_STATE_CHANGE_NULL_TO_READY:
+      gst_tensor_filter_warmup (self);
+      break;
+    case GST_STATE_CHANGE_PAUSED_TO_READY:
+      if (self->workers) {
+        gst_tensor_filter_async_set_flushing (self, TRUE);
+        gst_pad_stop_task (trans->srcpad);
+      }
+      break;
+    default:
+      break;
+  }
+
+  ret = GST_ELEMENT_CLASS (parent_class)->change_state (element, transition);
+
+  switch (transition) {
+    case GST_STATE_CHANGE_READY_TO_NULL:
+      /* the model opened to warm up if the element has not started */
+      gst_tensor_filter_close_fw (self);
+      break;
+    default:
+      break;
+  }
+
+  return ret;
+}
+
+/**
+ * @brief Create the worker threads for asynchronous invoke.
+ * @param self "this" pointer
+ */
+static void
+gst_tensor_filter_async_start (GstTensorFilter * self)
+{
+  gint num_threads = 1;
+
+  if (self->max_inflight == 0)
+    return;
+
+  /* each invoke depends on the state tensors of the previous one */
+  if (self->num_state_in > 0) {
+    GST_WARNING_OBJECT (self,
+        "max-inflight is ignored with the state tensors, invoke synchronously.");
+    return;
+  }
+
+  /* the model is invoked by a single thread unless the sub-plugin is reentrant */
+  if (self->fw && self->fw->allow_concurrent_invoke) {
+    num_threads = (gint) MIN (self->max_inflight, g_get_num_processors ());
+  }
+
+  silent_debug ("asynchronous invoke, %u in-flight frames with %d threads",
+      self->max_inflight, num_threads);
+
+  self->flushing = FALSE;
+  self->pushing = FALSE;
+  self->last_ret = GST_FLOW_OK;
+  self->num_threads = (guint) num_threads;
+  /**
+   * The workers are not shared, cpu-affinity or thread-priority may be given while streaming.
+   * The threads exit with the pool, and do not go back to the shared threads of GLib pinned.
+   */
+  self->workers = g_thread_pool_new (gst_tensor_filter_async_invoke, self,
+      num_threads, TRUE, NULL);
+}
+
+/**
+ * @brief Stop the task and the worker threads, and drop all in-flight frames.
+ * @param self "this" pointer
+ */
+static void
+gst_tensor_filter_async_stop (GstTensorFilter * self)
+{
+  GstBaseTransform *trans;
+
+  trans = GST_BASE_TRANSFORM_CAST (self);
+
+  if (self->workers == NULL)
+    return;
+
+  gst_tensor_filter_async_set_flushing (self, TRUE);
+  gst_pad_stop_task (trans->srcpad);
+
+  /* wait for the workers to finish the queued frames (invoke is skipped) */
+  g_thread_pool_free (self->workers, FALSE, TRUE);
+  self->workers = NULL;
+
+  /* the worker threads are not shared and exit, the attributes are not restored */
+  GST_OBJECT_LOCK (self);
+  g_hash_table_remove_all (self->thread_applied);
+  GST_OBJECT_UNLOCK (self);
+
+  gst_tensor_filter_async_clear (self);
+}
+
 /**
  * @brief Called when the element starts processing. optional vmethod of BaseTransform
  * @param trans "this" pointer
@@ -1252,6 +4631,11 @@ gst_tensor_filter_start (GstBaseTransform * trans)
   self = GST_TENSOR_FILTER_CAST (trans);
 
   gst_tensor_filter_open_fw (self);
+  gst_tensor_filter_stats_reset (self);
+  self->throttle_last_ts = GST_CLOCK_TIME_NONE;
+  self->num_threads = 1;
+  gst_tensor_filter_state_reset (self);
+  gst_tensor_filter_async_start (self);
   return TRUE;
 }
 
@@ -1267,6 +4651,13 @@ gst_tensor_filter_stop (GstBaseTransform * trans)
 
   self = GST_TENSOR_FILTER_CAST (trans);
 
+  gst_tensor_filter_async_stop (self);
+  /* the streaming thread invoking the model synchronously, after a flush, an error or a state change */
+  gst_tensor_filter_thread_restore_all (self);
+  gst_tensor_filter_batch_clear (self);
+  gst_tensor_filter_swap_join (self, TRUE);
+  self->swap_wait_caps = FALSE;
+  gst_tensor_filter_state_reset (self);
   gst_tensor_filter_close_fw (self);
   return TRUE;
 }
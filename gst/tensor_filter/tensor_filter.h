@@ -22,8 +22,6 @@
  * @see		http://github.com/nnsuite/nnstreamer
  * @author	MyungJoo Ham <myungjoo.ham@samsung.com>
  * @bug		No known bugs except for NYI items
- *
- * @todo TBD: Should we disable "in-place" mode? (what if output size > input size?)
  */
 
 #ifndef __GST_TENSOR_FILTER_H__
@@ -55,6 +53,37 @@ typedef struct _GstTensorFilterFramework GstTensorFilterFramework;
 
 extern const char *nnfw_names[];
 
+/**
+ * @brief The number of buckets of the invoke latency histogram.
+ *
+ * Latency (usec) below 8 has its own bucket. Each power of two above is split into 8 buckets (12.5% resolution).
+ */
+#define GST_TENSOR_FILTER_STATS_BUCKETS (256)
+
+/**
+ * @brief Statistics of invoke. Updated with the lock by the thread invoking the model.
+ */
+typedef struct
+{
+  GMutex lock; /**< lock for the statistics */
+  gint64 first; /**< the monotonic time (usec) when the first invoke starts (-1 if not invoked) */
+  gint64 last_end; /**< the monotonic time (usec) when the last invoke ends */
+  gint64 next_post; /**< the monotonic time (usec) to post the next message */
+  guint64 count; /**< the number of invokes */
+  guint64 frames; /**< the number of invoked frames (a batch invoke has multiple frames) */
+  guint64 skipped; /**< the number of frames skipped by QoS or throttle */
+  guint64 total; /**< the sum of latency (usec) */
+  guint last; /**< the latency (usec) of the last invoke */
+  guint min; /**< the minimum latency (usec) */
+  guint max; /**< the maximum latency (usec) */
+  guint64 histogram[GST_TENSOR_FILTER_STATS_BUCKETS]; /**< the number of invokes for each latency bucket */
+} GstTensorFilterStats;
+
+/**
+ * @brief The maximum number of setInputDimension results cached for negotiation.
+ */
+#define GST_TENSOR_FILTER_DIM_CACHE_SIZE (16)
+
 /**
  * @brief Internal data structure for tensor_filter instances.
  */
@@ -69,8 +98,82 @@ struct _GstTensorFilter
   /** internal properties for tensor-filter */
   int silent; /**< Verbose mode if FALSE. int instead of gboolean for non-glib custom plugins */
   gboolean configured; /**< True if already successfully configured tensor metadata */
-  GstTensorsConfig in_config; /**< input tensor info */
-  GstTensorsConfig out_config; /**< output tensor info */
+  GstTensorsConfig in_config; /**< input tensor info of sink pad */
+  GstTensorsConfig out_config; /**< output tensor info of source pad */
+
+  /** buffer pool for output tensors */
+  guint min_buffers; /**< the number of buffers to be pre-allocated in the pool */
+  guint max_buffers; /**< the maximum number of buffers in the pool (0 for unlimited) */
+
+  /** asynchronous invoke */
+  guint max_inflight; /**< the maximum number of in-flight frames (0 for synchronous invoke) */
+  GThreadPool *workers; /**< worker threads invoking the model. NULL in synchronous mode */
+  GQueue inflight; /**< in-flight frames in arrival order */
+  GMutex inflight_lock; /**< lock for in-flight frames */
+  GCond inflight_cond; /**< signaled when a frame is invoked or pushed */
+  gboolean flushing; /**< TRUE while flushing or stopping */
+  gboolean pushing; /**< TRUE while the source pad task pushes the outputs of a dequeued frame */
+  GstFlowReturn last_ret; /**< the last flow return of pushing the invoked frames */
+
+  /** batch invoke */
+  guint batch_size; /**< the number of frames invoked at once */
+  guint batch_timeout; /**< the time (ms) to wait for a full batch (0 to wait for a full batch) */
+  gpointer batch; /**< the batch being accumulated. NULL if no frame arrives */
+  gint64 batch_deadline; /**< the monotonic time to invoke the partial batch */
+  GQueue outbufs; /**< the output buffers of the batch to be pushed in synchronous mode */
+
+  /** statistics */
+  GstTensorFilterStats stats; /**< invoke latency and throughput */
+  guint stats_interval; /**< the interval (msec) to post the statistics message (0 to disable) */
+
+  /** QoS and throttle */
+  gboolean throttle; /**< TRUE to skip the frames arriving faster than invoke */
+  GstClockTime throttle_last_ts; /**< the timestamp of the last frame not skipped */
+  guint num_threads; /**< the number of threads invoking the model */
+
+  /** warm-up */
+  guint warmup; /**< the number of dummy invokes to warm up the model when the element goes to READY */
+  gint64 warmup_time; /**< the time (usec) to open and warm up the model */
+
+  /** negotiation cache */
+  GMutex dim_lock; /**< lock for the negotiation cache, held while setInputDimension configures the sub-plugin */
+  GQueue dim_cache; /**< the results of setInputDimension for the model, the most recent first */
+  GstTensorsInfo dim_applied; /**< the input tensors info given to the sub-plugin with the last setInputDimension */
+  guint dim_cache_hits; /**< the number of setInputDimension calls served by the cache */
+  guint dim_cache_misses; /**< the number of setInputDimension calls to the sub-plugin */
+  gboolean dim_negotiated; /**< TRUE if the tensors info is given by caps (not by the model or properties), which may be renegotiated */
+
+  /** recurrent state tensors */
+  guint num_state_in; /**< the number of state tensors of the input (property state-inputs) */
+  guint num_state_out; /**< the number of state tensors of the output (property state-outputs) */
+  guint state_in[NNS_TENSOR_SIZE_LIMIT]; /**< the index of input tensor for each state */
+  guint state_out[NNS_TENSOR_SIZE_LIMIT]; /**< the index of output tensor for each state, fed back to the input of the next invoke */
+  GstMemory *state_mem[NNS_TENSOR_SIZE_LIMIT]; /**< the state tensors given to the next invoke. NULL to start with zero-filled tensors */
+  GstMemory *state_spare[NNS_TENSOR_SIZE_LIMIT]; /**< the memory blocks to be reused for the state tensors of the next invoke (double-buffered) */
+
+  /** tensor combination */
+  guint num_combi_in; /**< the number of input tensors of the model selected from the input buffer (property input-combination). 0 for all tensors in order */
+  guint combi_in[NNS_TENSOR_SIZE_LIMIT]; /**< the index of the tensor in the input buffer for each input tensor of the model */
+  guint num_combi_out; /**< the number of tensors in the output buffer (property output-combination). 0 for the output tensors of the model in order */
+  guint combi_out[NNS_TENSOR_SIZE_LIMIT]; /**< the index of the input or output tensor for each tensor in the output buffer */
+  gboolean combi_out_input[NNS_TENSOR_SIZE_LIMIT]; /**< TRUE if the tensor in the output buffer is the input tensor passed through */
+
+  /** thread affinity and priority */
+  gint thread_conf; /**< the generation of cpu-affinity and thread-priority, applied once to each invoke thread. 0 if not given */
+  GHashTable *thread_applied; /**< GstTensorFilterThreadConf applied to each invoke thread (GThread), with the attributes to be restored. Protected by the object lock */
+
+  /** hot model swap */
+  GThread *swap_thread; /**< the thread reading the model given while streaming ahead of the swap. NULL if no swap */
+  GMutex swap_lock; /**< lock for the model swap */
+  GCond swap_cond; /**< signaled when the new model is ready or swapped */
+  gint swap_state; /**< GstTensorFilterSwapState, read atomically before each invoke */
+  gchar *swap_model; /**< the path of the new model, moved into the properties of the element at the swap */
+  gint64 swap_request; /**< the monotonic time (usec) when the new model is given */
+  gint64 swap_load_time; /**< the time (usec) to open and warm up the new model */
+  gint64 swap_stall; /**< the time (usec) the stream is blocked to swap the model */
+  guint64 swap_latency; /**< the time (usec) from the new model given to the first invoke with it */
+  guint swap_dropped; /**< the number of frames dropped by the last swap (waiting for the caps of the new model) */
+  gboolean swap_wait_caps; /**< TRUE if the new model needs the input tensors other than the current caps */
 };
 
 /**
@@ -109,8 +212,9 @@ GType gst_tensor_filter_get_type (void);
 struct _GstTensorFilterFramework
 {
   gchar *name; /**< Name of the neural network framework, searchable by FRAMEWORK property */
-  gboolean allow_in_place; /**< TRUE if InPlace transfer of input-to-output is allowed. Not supported in main, yet */
-  gboolean allocate_in_invoke; /**< TRUE if invoke_NN is going to allocate outputptr by itself and return the address via outputptr. Do not change this value after cap negotiation is complete (or the stream has been started). */
+  gboolean allow_in_place; /**< TRUE if InPlace transfer of input-to-output is allowed. tensor_filter/main invokes in-place only if each output tensor has the same size as the corresponding input tensor. Do not change this value after cap negotiation is complete (or the stream has been started). Ignored if allowInPlace is given. */
+  gboolean allocate_in_invoke; /**< TRUE if invoke_NN is going to allocate outputptr by itself and return the address via outputptr. Do not change this value after cap negotiation is complete (or the stream has been started). Ignored if allocateInInvoke is given. */
+  gboolean allow_concurrent_invoke; /**< TRUE if invoke_NN may be called from multiple threads at the same time with the same private_data. If FALSE, tensor_filter/main invokes the model from a single worker thread in asynchronous mode (max-inflight > 0). */
 
   int (*invoke_NN) (const GstTensorFilter * filter, void **private_data,
       const GstTensorMemory * input, GstTensorMemory * output);
@@ -119,10 +223,38 @@ struct _GstTensorFilterFramework
        * @param[in] filter "this" pointer. Use this to read property values
        * @param[in/out] private_data A subplugin may save its internal private data here. The subplugin is responsible for alloc/free of this pointer.
        * @param[in] input The array of input tensors. Allocated and filled by tensor_filter/main
-       * @param[out] output The array of output tensors. Allocated by tensor_filter/main and to be filled by invoke_NN. If allocate_in_invoke is TRUE, sub-plugin should allocate the memory block for output tensor. (data in GstTensorMemory)
+       * @param[out] output The array of output tensors. Allocated by tensor_filter/main and to be filled by invoke_NN. If allocate_in_invoke is TRUE, sub-plugin should allocate the memory block for output tensor. (data in GstTensorMemory) In in-place mode (allow_in_place), each output tensor shares the memory block of the input tensor. (output[i].data == input[i].data)
        * @return 0 if OK. non-zero if error.
        */
 
+  int (*invoke_with_release_NN) (const GstTensorFilter * filter,
+      void **private_data, const GstTensorMemory * input,
+      GstTensorMemory * output, GDestroyNotify * release, void **user_data);
+      /**< Optional. Set NULL if not supported. If allocate_in_invoke is TRUE, tensor_filter/main calls this instead of invoke_NN.
+       * The sub-plugin may return the memory blocks it owns (e.g., a ring buffer or an arena) as the output tensors, which flow downstream without copy.
+       *
+       * @param[in] filter "this" pointer. Use this to read property values
+       * @param[in/out] private_data A subplugin may save its internal private data here. The subplugin is responsible for alloc/free of this pointer.
+       * @param[in] input The array of input tensors. Allocated and filled by tensor_filter/main
+       * @param[out] output The array of output tensors. The sub-plugin sets the memory block for each output tensor. (data in GstTensorMemory)
+       * @param[out] release The array of callbacks, each is called with user_data[i] when the last buffer referring output[i] is released. Initialized with NULL; if NULL, output[i].data is freed with g_free.
+       * @param[out] user_data The array of user data for release. This may be called after close; thus, user_data should hold everything release needs.
+       * @return 0 if OK. non-zero if error.
+       */
+
+  int (*invoke_batch_NN) (const GstTensorFilter * filter, void **private_data,
+      const GstTensorMemory * input, GstTensorMemory * output, guint batch);
+      /**< Optional. Set NULL if not supported. Invoke the given network model once with a batch of frames (batch-size > 1).
+       * Not used if allocate_in_invoke is TRUE.
+       *
+       * @param[in] filter "this" pointer. Use this to read property values
+       * @param[in/out] private_data A subplugin may save its internal private data here. The subplugin is responsible for alloc/free of this pointer.
+       * @param[in] input The array of input tensors of all frames. The i-th tensor of the b-th frame is input[b * input_meta.num_tensors + i].
+       * @param[out] output The array of output tensors of all frames, in the same order as input. Allocated by tensor_filter/main and to be filled by invoke_batch_NN.
+       * @param[in] batch The number of frames.
+       * @return 0 if OK. non-zero if error. Then, tensor_filter/main invokes each frame with invoke_NN.
+       */
+
   int (*getInputDimension) (const GstTensorFilter * filter,
       void **private_data, GstTensorsInfo * info);
       /**< Optional. Set NULL if not supported. Get dimension of input tensor
@@ -180,11 +312,30 @@ struct _GstTensorFilterFramework
        * @param[in] filter "this" pointer. Use this to read property values
        * @param[in/out] private_data A subplugin may save its internal private data here. The subplugin is responsible for alloc/free of this pointer. Normally, close() frees private_data and set NULL.
        */
+
+  gboolean (*allocateInInvoke) (const GstTensorFilter * filter,
+      void **private_data);
+      /**< Optional. Set NULL to use allocate_in_invoke for all instances. tensor_filter.c calls this after open if the sub-plugin decides it for each opened model.
+       *
+       * @param[in] filter "this" pointer. Use this to read property values
+       * @param[in/out] private_data A subplugin may save its internal private data here. The subplugin is responsible for alloc/free of this pointer.
+       * @return TRUE if invoke allocates the output tensors of this instance (same as allocate_in_invoke).
+       */
+
+  gboolean (*allowInPlace) (const GstTensorFilter * filter,
+      void **private_data);
+      /**< Optional. Set NULL to use allow_in_place for all instances. tensor_filter.c calls this after open, when the caps are set, if the sub-plugin decides it for each opened model.
+       *
+       * @param[in] filter "this" pointer. Use this to read property values
+       * @param[in/out] private_data A subplugin may save its internal private data here. The subplugin is responsible for alloc/free of this pointer.
+       * @return TRUE if this instance may invoke in-place (same as allow_in_place).
+       */
 };
 
 extern GstTensorFilterFramework NNS_support_tensorflow_lite;
 extern GstTensorFilterFramework NNS_support_tensorflow;
 extern GstTensorFilterFramework NNS_support_custom;
+extern GstTensorFilterFramework NNS_support_nnscpu;
 
 extern GstTensorFilterFramework *tensor_filter_supported[];
 
@@ -29,6 +29,7 @@
 #include "tensor_filter.h"
 #include "tensor_filter_custom.h"
 #include <glib.h>
+#include <string.h>
 #include <dlfcn.h>
 
 /**
@@ -40,6 +41,7 @@ struct _internal_data
 
   void *handle;
   NNStreamer_custom_class *methods;
+  NNStreamer_custom_ext_class ext; /**< the optional callbacks, zero-filled if not given */
 
   void *customFW_private_data;
 };
@@ -53,6 +55,7 @@ static int
 custom_loadlib (const GstTensorFilter * filter, void **private_data)
 {
   internal_data *ptr;
+  NNStreamer_custom_ext_class **ext;
   char *dlsym_error;
 
   if (filter->privateData != NULL) {
@@ -90,6 +93,16 @@ custom_loadlib (const GstTensorFilter * filter, void **private_data)
     return -1;
   }
 
+  /* the optional callbacks, within the size given by the custom filter */
+  ext = (NNStreamer_custom_ext_class **) dlsym (ptr->handle,
+      "NNStreamer_custom_ext");
+  if (ext != NULL && *ext != NULL) {
+    memcpy (&ptr->ext, *ext, MIN ((*ext)->size,
+            sizeof (NNStreamer_custom_ext_class)));
+  }
+  ptr->ext.size = sizeof (NNStreamer_custom_ext_class);
+  dlerror ();
+
   g_assert (ptr->methods->initfunc);
   ptr->customFW_private_data = ptr->methods->initfunc (&(filter->prop));
 
@@ -115,13 +128,69 @@ custom_open (const GstTensorFilter * filter, void **private_data)
     return -1;
 
   ptr = *private_data;
-  g_assert (!ptr->methods->invoke != !ptr->methods->allocate_invoke);   /* XOR! */
+  g_assert (!ptr->methods->invoke != !(ptr->methods->allocate_invoke ||
+          ptr->ext.allocate_invoke_release));      /* XOR! */
 
-  if (ptr->methods->allocate_invoke)
-    NNS_support_custom.allocate_in_invoke = TRUE;
+  /* in_place_invoke is an addition to invoke */
+  g_assert (!ptr->ext.in_place_invoke || ptr->methods->invoke);
+
+  /* invoke_batch is an addition to invoke */
+  g_assert (!ptr->ext.invoke_batch || ptr->methods->invoke);
   return 0;
 }
 
+/**
+ * @brief Check if the custom filter of this instance allocates the output tensors in invoke
+ */
+static gboolean
+custom_allocateInInvoke (const GstTensorFilter * filter, void **private_data)
+{
+  internal_data *ptr = *private_data;
+
+  g_assert (ptr);
+  return (ptr->methods->allocate_invoke != NULL ||
+      ptr->ext.allocate_invoke_release != NULL);
+}
+
+/**
+ * @brief Check if the custom filter of this instance supports in-place invoke
+ */
+static gboolean
+custom_allowInPlace (const GstTensorFilter * filter, void **private_data)
+{
+  internal_data *ptr = *private_data;
+
+  g_assert (ptr);
+  return (ptr->ext.in_place_invoke != NULL);
+}
+
+/**
+ * @brief Check if tensor_filter invokes in-place (the output tensors share the memory blocks of the input tensors)
+ * @param filter The parent object
+ * @param input The array of input tensors (of all frames, frame-major)
+ * @param output The array of output tensors (of all frames, frame-major)
+ * @param batch The number of frames
+ */
+static gboolean
+custom_is_in_place (const GstTensorFilter * filter,
+    const GstTensorMemory * input, const GstTensorMemory * output,
+    guint batch)
+{
+  guint i, num_tensors;
+
+  /* in-place only if each output tensor has the input tensor at the same index */
+  num_tensors = filter->prop.input_meta.num_tensors;
+  if (num_tensors != filter->prop.output_meta.num_tensors)
+    return FALSE;
+
+  for (i = 0; i < num_tensors * batch; i++) {
+    if (input[i].data != output[i].data)
+      return FALSE;
+  }
+
+  return TRUE;
+}
+
 /**
  * @brief The mandatory callback for GstTensorFilterFramework
  * @param filter The parent object
@@ -141,6 +210,14 @@ custom_invoke (const GstTensorFilter * filter, void **private_data,
   g_assert (filter->privateData && *private_data == filter->privateData);
   ptr = *private_data;
 
+  if (custom_is_in_place (filter, input, output, 1)) {
+    if (ptr->ext.in_place_invoke == NULL)
+      return -1;
+
+    return ptr->ext.in_place_invoke (ptr->customFW_private_data,
+        &(filter->prop), output);
+  }
+
   if (ptr->methods->invoke) {
     return ptr->methods->invoke (ptr->customFW_private_data, &(filter->prop),
         input, output);
@@ -152,6 +229,69 @@ custom_invoke (const GstTensorFilter * filter, void **private_data,
   }
 }
 
+/**
+ * @brief The optional callback for GstTensorFilterFramework, invoke with the output tensors owned by the custom filter
+ * @param filter The parent object
+ * @param[in] input The array of input tensors
+ * @param[out] output The array of output tensors
+ * @param[out] release The array of callbacks to release the output tensors
+ * @param[out] user_data The array of user data for release
+ * @return 0 if OK. non-zero if error.
+ */
+static int
+custom_invoke_with_release (const GstTensorFilter * filter,
+    void **private_data, const GstTensorMemory * input,
+    GstTensorMemory * output, GDestroyNotify * release, void **user_data)
+{
+  int retval = custom_loadlib (filter, private_data);
+  internal_data *ptr;
+
+  g_assert (retval == 1);       /* open must be called before */
+
+  g_assert (filter->privateData && *private_data == filter->privateData);
+  ptr = *private_data;
+
+  if (ptr->ext.allocate_invoke_release) {
+    return ptr->ext.allocate_invoke_release (ptr->customFW_private_data,
+        &(filter->prop), input, output, (NNS_custom_release_func *) release,
+        user_data);
+  } else if (ptr->methods->allocate_invoke) {
+    return ptr->methods->allocate_invoke (ptr->customFW_private_data,
+        &(filter->prop), input, output);
+  } else {
+    return -1;
+  }
+}
+
+/**
+ * @brief The optional callback for GstTensorFilterFramework, invoke a batch of frames
+ * @param filter The parent object
+ * @param[in] input The array of input tensors of all frames
+ * @param[out] output The array of output tensors of all frames
+ * @param[in] batch The number of frames
+ * @return 0 if OK. non-zero if error. (tensor_filter invokes each frame)
+ */
+static int
+custom_invoke_batch (const GstTensorFilter * filter, void **private_data,
+    const GstTensorMemory * input, GstTensorMemory * output, guint batch)
+{
+  int retval = custom_loadlib (filter, private_data);
+  internal_data *ptr;
+
+  g_assert (retval == 1);       /* open must be called before */
+
+  g_assert (filter->privateData && *private_data == filter->privateData);
+  ptr = *private_data;
+
+  /* in-place mode, each frame is invoked with in_place_invoke */
+  if (ptr->ext.invoke_batch == NULL ||
+      custom_is_in_place (filter, input, output, batch))
+    return -1;
+
+  return ptr->ext.invoke_batch (ptr->customFW_private_data,
+      &(filter->prop), input, output, batch);
+}
+
 /**
  * @brief The optional callback for GstTensorFilterFramework
  */
@@ -233,9 +373,12 @@ custom_close (const GstTensorFilter * filter, void **private_data)
 
 GstTensorFilterFramework NNS_support_custom = {
   .name = "custom",
-  .allow_in_place = FALSE,      /* custom cannot support in-place (output == input). */
-  .allocate_in_invoke = FALSE,  /* GstTensorFilter allocates output buffers */
+  .allow_in_place = FALSE,      /* decided by allowInPlace, custom may support in-place (output == input) with in_place_invoke. */
+  .allocate_in_invoke = FALSE,  /* decided by allocateInInvoke for each custom filter */
+  .allow_concurrent_invoke = FALSE,     /* custom filters may keep their states in private_data */
   .invoke_NN = custom_invoke,
+  .invoke_with_release_NN = custom_invoke_with_release,
+  .invoke_batch_NN = custom_invoke_batch,
 
   /* We need to disable getI/O-dim or setI-dim with the first call */
   .getInputDimension = custom_getInputDim,
@@ -243,4 +386,6 @@ GstTensorFilterFramework NNS_support_custom = {
   .setInputDimension = custom_setInputDim,
   .open = custom_open,
   .close = custom_close,
+  .allocateInInvoke = custom_allocateInInvoke,
+  .allowInPlace = custom_allowInPlace,
 };
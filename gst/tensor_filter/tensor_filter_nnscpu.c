@@ -0,0 +1,226 @@
+/**
+ * GStreamer Tensor_Filter, nnscpu Module
+ * Copyright (C) 2018 Samsung Electronics Co., Ltd. All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ */
+/**
+ * @file	tensor_filter_nnscpu.c
+ * @date	16 Oct 2026
+ * @brief	Built-in CPU inference engine module for tensor_filter gstreamer plugin
+ * @see		http://github.com/nnsuite/nnstreamer
+ * @bug		No known bugs except for NYI items
+ *
+ * This is the per-NN-framework plugin (nnscpu) for tensor_filter.
+ * Fill in "GstTensorFilterFramework" for tensor_filter.h/c
+ *
+ * nnscpu runs the lightweight models without external libraries.
+ * The model is the graph file of nnscpu. (See tensor_filter_nnscpu_core.c)
+ */
+
+#include "tensor_filter.h"
+#include "tensor_filter_nnscpu_core.h"
+#include <glib.h>
+#include <string.h>
+
+/**
+ * @brief Options of nnscpu from the custom property
+ */
+typedef struct
+{
+  gboolean acceleration; /**< TRUE to use the SIMD kernels */
+} nnscpu_option;
+
+/**
+ * @brief internal data of nnscpu
+ */
+struct _Nnscpu_data
+{
+  nnscpu_graph *graph;
+  nnscpu_option option; /**< the options the graph is loaded with */
+};
+typedef struct _Nnscpu_data nnscpu_data;
+
+static void nnscpu_close (const GstTensorFilter * filter, void **private_data);
+
+/**
+ * @brief Parse the custom property of nnscpu.
+ * @param filter : tensor_filter instance
+ * @param[out] option : the parsed options
+ *
+ * The custom property is a comma-separated list of Key:Value.
+ * e.g., custom=Acceleration:false runs the scalar kernels.
+ */
+static void
+nnscpu_parseCustomOption (const GstTensorFilter * filter,
+    nnscpu_option * option)
+{
+  gchar **options;
+  gchar **pair;
+  guint i;
+
+  option->acceleration = TRUE;
+
+  if (filter->prop.custom_properties == NULL)
+    return;
+
+  options = g_strsplit (filter->prop.custom_properties, ",", -1);
+
+  for (i = 0; options[i] != NULL; i++) {
+    pair = g_strsplit (options[i], ":", 2);
+
+    if (pair[0] == NULL || pair[1] == NULL) {
+      g_strfreev (pair);
+      continue;
+    }
+
+    g_strstrip (pair[0]);
+    g_strstrip (pair[1]);
+
+    if (g_ascii_strcasecmp (pair[0], "Acceleration") == 0) {
+      if (g_ascii_strcasecmp (pair[1], "true") == 0) {
+        option->acceleration = TRUE;
+      } else if (g_ascii_strcasecmp (pair[1], "false") == 0) {
+        option->acceleration = FALSE;
+      } else {
+        GST_WARNING ("Invalid value of Acceleration: %s", pair[1]);
+      }
+    }
+
+    g_strfreev (pair);
+  }
+
+  g_strfreev (options);
+}
+
+/**
+ * @brief Load the graph of nnscpu
+ * @param filter : tensor_filter instance
+ * @param private_data : nnscpu plugin's private data
+ * @return 0 if successfully loaded. 1 if skipped (already loaded). -1 if error
+ */
+static int
+nnscpu_loadModelFile (const GstTensorFilter * filter, void **private_data)
+{
+  nnscpu_data *cpu;
+  nnscpu_option option;
+
+  nnscpu_parseCustomOption (filter, &option);
+
+  if (filter->privateData != NULL) {
+    cpu = *private_data;
+    if (strcmp (filter->prop.model_file,
+            nnscpu_graph_get_path (cpu->graph)) ||
+        option.acceleration != cpu->option.acceleration) {
+      nnscpu_close (filter, private_data);
+    } else {
+      return 1;
+    }
+  }
+
+  if (!filter->prop.model_file || filter->prop.model_file[0] == '\0')
+    return -1;
+
+  cpu = g_new0 (nnscpu_data, 1);
+  cpu->option = option;
+  cpu->graph = nnscpu_graph_load (filter->prop.model_file,
+      option.acceleration);
+
+  if (cpu->graph == NULL) {
+    g_free (cpu);
+    return -1;
+  }
+
+  *private_data = cpu;
+  return 0;
+}
+
+/**
+ * @brief The open callback for GstTensorFilterFramework. Called before anything else
+ * @param filter : tensor_filter instance
+ * @param private_data : nnscpu plugin's private data
+ */
+static int
+nnscpu_open (const GstTensorFilter * filter, void **private_data)
+{
+  return nnscpu_loadModelFile (filter, private_data);
+}
+
+/**
+ * @brief The mandatory callback for GstTensorFilterFramework
+ * @param[in] input The array of input tensors
+ * @param[out] output The array of output tensors
+ * @return 0 if OK. non-zero if error.
+ */
+static int
+nnscpu_invoke (const GstTensorFilter * filter, void **private_data,
+    const GstTensorMemory * input, GstTensorMemory * output)
+{
+  nnscpu_data *cpu;
+  cpu = *private_data;
+  g_assert (filter->privateData && *private_data == filter->privateData);
+  return nnscpu_graph_invoke (cpu->graph, input, output);
+}
+
+/**
+ * @brief The optional callback for GstTensorFilterFramework
+ */
+static int
+nnscpu_getInputDim (const GstTensorFilter * filter, void **private_data,
+    GstTensorsInfo * info)
+{
+  nnscpu_data *cpu;
+  cpu = *private_data;
+  g_assert (filter->privateData && *private_data == filter->privateData);
+  nnscpu_graph_get_input_info (cpu->graph, info);
+  return 0;
+}
+
+/**
+ * @brief The optional callback for GstTensorFilterFramework
+ */
+static int
+nnscpu_getOutputDim (const GstTensorFilter * filter, void **private_data,
+    GstTensorsInfo * info)
+{
+  nnscpu_data *cpu;
+  cpu = *private_data;
+  g_assert (filter->privateData && *private_data == filter->privateData);
+  nnscpu_graph_get_output_info (cpu->graph, info);
+  return 0;
+}
+
+/**
+ * @brief Free privateData and move on.
+ */
+static void
+nnscpu_close (const GstTensorFilter * filter, void **private_data)
+{
+  nnscpu_data *cpu;
+  cpu = *private_data;
+  nnscpu_graph_free (cpu->graph);
+  g_free (cpu);
+  *private_data = NULL;
+  g_assert (filter->privateData == NULL);
+}
+
+GstTensorFilterFramework NNS_support_nnscpu = {
+  .name = "nnscpu",
+  .allow_in_place = FALSE,
+  .allocate_in_invoke = FALSE,
+  .allow_concurrent_invoke = FALSE,     /* the intermediate tensors are in the arena of the graph */
+  .invoke_NN = nnscpu_invoke,
+  .getInputDimension = nnscpu_getInputDim,
+  .getOutputDimension = nnscpu_getOutputDim,
+  .open = nnscpu_open,
+  .close = nnscpu_close,
+};
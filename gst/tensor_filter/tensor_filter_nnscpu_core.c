@@ -0,0 +1,1739 @@
+/**
+ * Copyright (C) 2018 Samsung Electronics Co., Ltd. All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ */
+/**
+ * @file   tensor_filter_nnscpu_core.c
+ * @date   16 Oct 2026
+ * @brief  Built-in CPU inference engine (nnscpu) for tensor_filter
+ * @see    http://github.com/nnsuite/nnstreamer
+ * @bug    No known bugs.
+ *
+ * The graph is loaded from a text file, one statement per line:
+ *   weights FILE                      the binary file of constant tensors (relative to the graph)
+ *   input NAME DIM TYPE [scale=S zero=Z]
+ *   const NAME DIM TYPE offset=BYTES [scale=S zero=Z]
+ *   output NAME [NAME ...]
+ *   OP NAME INPUT [INPUT ...] [key=value ...]
+ *
+ * The dimension is innermost-first as the caps of other/tensor. (e.g., C:W:H:N)
+ * The tensors are float32 or asymmetric quantized uint8 (real = scale * (q - zero)).
+ * The hot loops are ORC kernels vectorized for the host CPU, with scalar fallback.
+ */
+
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <tensor_common.h>
+#include "tensor_filter_nnscpu_core.h"
+
+#ifdef HAVE_ORC
+#include "nnscpu-orc.h"
+#endif
+
+/**
+ * @brief The maximum number of input tensors of an operation
+ */
+#define NNSCPU_MAX_NODE_INPUTS NNS_TENSOR_SIZE_LIMIT
+
+/**
+ * @brief Align the offset of tensors in the arena for vector loads
+ */
+#define NNSCPU_ALIGN(s) (((s) + 15) & ~((gsize) 15))
+
+/**
+ * @brief Operations of nnscpu
+ */
+typedef enum
+{
+  NNSCPU_OP_CONV2D = 0,
+  NNSCPU_OP_DWCONV2D,
+  NNSCPU_OP_FC,
+  NNSCPU_OP_MAXPOOL,
+  NNSCPU_OP_AVGPOOL,
+  NNSCPU_OP_RELU,
+  NNSCPU_OP_RELU6,
+  NNSCPU_OP_SOFTMAX,
+  NNSCPU_OP_ADD,
+  NNSCPU_OP_CONCAT,
+} nnscpu_op;
+
+/**
+ * @brief Fused activation of operations
+ */
+typedef enum
+{
+  NNSCPU_ACT_NONE = 0,
+  NNSCPU_ACT_RELU,
+  NNSCPU_ACT_RELU6,
+} nnscpu_act;
+
+/**
+ * @brief Where the memory of a tensor comes from
+ */
+typedef enum
+{
+  NNSCPU_TENSOR_INPUT = 0,  /**< input tensor of invoke */
+  NNSCPU_TENSOR_CONST,      /**< in the weights file */
+  NNSCPU_TENSOR_NODE,       /**< written by an operation, in the arena or the output tensor of invoke */
+} nnscpu_tensor_kind;
+
+/**
+ * @brief The description of operations
+ */
+static const struct
+{
+  const gchar *name;
+  nnscpu_op op;
+  guint min_inputs;
+  guint max_inputs;
+  const gchar *attrs;   /**< the allowed attributes, comma-separated */
+} nnscpu_ops[] = {
+  {"conv2d", NNSCPU_OP_CONV2D, 2, 3, ",stride,pad,act,scale,zero,"},
+  {"dwconv2d", NNSCPU_OP_DWCONV2D, 2, 3, ",stride,pad,act,scale,zero,"},
+  {"fc", NNSCPU_OP_FC, 2, 3, ",act,scale,zero,"},
+  {"maxpool", NNSCPU_OP_MAXPOOL, 1, 1, ",size,stride,pad,"},
+  {"avgpool", NNSCPU_OP_AVGPOOL, 1, 1, ",size,stride,pad,"},
+  {"relu", NNSCPU_OP_RELU, 1, 1, ","},
+  {"relu6", NNSCPU_OP_RELU6, 1, 1, ","},
+  {"softmax", NNSCPU_OP_SOFTMAX, 1, 1, ",scale,zero,"},
+  {"add", NNSCPU_OP_ADD, 2, 2, ",act,scale,zero,"},
+  {"concat", NNSCPU_OP_CONCAT, 2, NNSCPU_MAX_NODE_INPUTS, ",axis,scale,zero,"},
+  {NULL, 0, 0, 0, NULL},
+};
+
+/**
+ * @brief A tensor of the graph
+ */
+typedef struct
+{
+  gchar *name; /**< unique name in the graph */
+  GstTensorInfo info; /**< type and dimension */
+  gsize size; /**< the size in bytes */
+  gdouble scale; /**< quantization scale (uint8) */
+  gint zero; /**< quantization zero point (uint8) */
+  gboolean quantized; /**< TRUE if scale and zero are given */
+  nnscpu_tensor_kind kind; /**< where the memory comes from */
+  guint index; /**< the index of input tensor */
+  gsize offset; /**< the offset in the weights file or in the arena */
+  gint output; /**< the index of output tensor, -1 if not an output */
+  gpointer data; /**< the memory of the tensor while invoking */
+} nnscpu_tensor;
+
+/**
+ * @brief An operation of the graph
+ */
+typedef struct
+{
+  nnscpu_op op; /**< the operation */
+  guint num_inputs; /**< the number of input tensors */
+  guint inputs[NNSCPU_MAX_NODE_INPUTS]; /**< the indices of input tensors */
+  guint output; /**< the index of output tensor */
+  guint kernel[2]; /**< width and height of the window */
+  guint stride[2]; /**< horizontal and vertical stride */
+  guint pad[2]; /**< left and top padding */
+  gboolean pad_same; /**< TRUE if padding=same, FALSE if padding=valid */
+  nnscpu_act act; /**< fused activation */
+  guint axis; /**< the dimension to concatenate */
+} nnscpu_node;
+
+/**
+ * @brief The graph loaded
+ */
+struct _nnscpu_graph
+{
+  gchar *path; /**< the path of the graph file */
+  gboolean acceleration; /**< TRUE to use ORC kernels */
+  GArray *tensors; /**< nnscpu_tensor */
+  GArray *nodes; /**< nnscpu_node, in the order of execution */
+  guint num_inputs; /**< the number of input tensors */
+  guint inputs[NNS_TENSOR_SIZE_LIMIT]; /**< the indices of input tensors */
+  guint num_outputs; /**< the number of output tensors */
+  guint outputs[NNS_TENSOR_SIZE_LIMIT]; /**< the indices of output tensors */
+  gchar *weights; /**< the contents of the weights file */
+  gsize weights_size; /**< the size of the weights file */
+  gpointer arena; /**< the memory of intermediate tensors */
+  gint32 *acc; /**< the accumulators of quantized operations */
+};
+
+#define nnscpu_tensor_at(g,i) (&g_array_index ((g)->tensors, nnscpu_tensor, (i)))
+#define nnscpu_node_at(g,i) (&g_array_index ((g)->nodes, nnscpu_node, (i)))
+
+/**
+ * Kernels. Each kernel works on n elements, with ORC if acceleration is enabled.
+ */
+
+/**
+ * @brief d[i] += s[i] * p
+ */
+static void
+nnscpu_mad_f32 (const nnscpu_graph * graph, gfloat * d, const gfloat * s,
+    gfloat p, guint n)
+{
+  guint i;
+
+#ifdef HAVE_ORC
+  if (graph->acceleration) {
+    nns_cpu_orc_mad_f32 (d, s, p, n);
+    return;
+  }
+#endif
+  for (i = 0; i < n; i++)
+    d[i] += s[i] * p;
+}
+
+/**
+ * @brief d[i] += s1[i] * s2[i]
+ */
+static void
+nnscpu_mac_f32 (const nnscpu_graph * graph, gfloat * d, const gfloat * s1,
+    const gfloat * s2, guint n)
+{
+  guint i;
+
+#ifdef HAVE_ORC
+  if (graph->acceleration) {
+    nns_cpu_orc_mac_f32 (d, s1, s2, n);
+    return;
+  }
+#endif
+  for (i = 0; i < n; i++)
+    d[i] += s1[i] * s2[i];
+}
+
+/**
+ * @brief d[i] += s[i]
+ */
+static void
+nnscpu_acc_f32 (const nnscpu_graph * graph, gfloat * d, const gfloat * s,
+    guint n)
+{
+  guint i;
+
+#ifdef HAVE_ORC
+  if (graph->acceleration) {
+    nns_cpu_orc_acc_f32 (d, s, n);
+    return;
+  }
+#endif
+  for (i = 0; i < n; i++)
+    d[i] += s[i];
+}
+
+/**
+ * @brief d[i] = s1[i] + s2[i]
+ */
+static void
+nnscpu_add_f32 (const nnscpu_graph * graph, gfloat * d, const gfloat * s1,
+    const gfloat * s2, guint n)
+{
+  guint i;
+
+#ifdef HAVE_ORC
+  if (graph->acceleration) {
+    nns_cpu_orc_add_f32 (d, s1, s2, n);
+    return;
+  }
+#endif
+  for (i = 0; i < n; i++)
+    d[i] = s1[i] + s2[i];
+}
+
+/**
+ * @brief d[i] = max (d[i], s[i])
+ */
+static void
+nnscpu_max_f32 (const nnscpu_graph * graph, gfloat * d, const gfloat * s,
+    guint n)
+{
+  guint i;
+
+#ifdef HAVE_ORC
+  if (graph->acceleration) {
+    nns_cpu_orc_max_f32 (d, s, n);
+    return;
+  }
+#endif
+  for (i = 0; i < n; i++)
+    d[i] = MAX (d[i], s[i]);
+}
+
+/**
+ * @brief d[i] *= p
+ */
+static void
+nnscpu_scale_f32 (const nnscpu_graph * graph, gfloat * d, gfloat p, guint n)
+{
+  guint i;
+
+#ifdef HAVE_ORC
+  if (graph->acceleration) {
+    nns_cpu_orc_scale_f32 (d, p, n);
+    return;
+  }
+#endif
+  for (i = 0; i < n; i++)
+    d[i] *= p;
+}
+
+/**
+ * @brief d[i] = clamp (d[i], lo, hi)
+ */
+static void
+nnscpu_clamp_f32 (const nnscpu_graph * graph, gfloat * d, gfloat lo,
+    gfloat hi, guint n)
+{
+  guint i;
+
+#ifdef HAVE_ORC
+  if (graph->acceleration) {
+    nns_cpu_orc_clamp_f32 (d, lo, hi, n);
+    return;
+  }
+#endif
+  for (i = 0; i < n; i++)
+    d[i] = CLAMP (d[i], lo, hi);
+}
+
+/**
+ * @brief d[i] += (s[i] - sz) * p
+ */
+static void
+nnscpu_mad_u8 (const nnscpu_graph * graph, gint32 * d, const guint8 * s,
+    gint p, gint sz, guint n)
+{
+  guint i;
+
+#ifdef HAVE_ORC
+  if (graph->acceleration) {
+    nns_cpu_orc_mad_u8 (d, s, p, sz, n);
+    return;
+  }
+#endif
+  for (i = 0; i < n; i++)
+    d[i] += ((gint32) s[i] - sz) * p;
+}
+
+/**
+ * @brief d[i] += (s1[i] - z1) * (s2[i] - z2)
+ */
+static void
+nnscpu_mac_u8 (const nnscpu_graph * graph, gint32 * d, const guint8 * s1,
+    const guint8 * s2, gint z1, gint z2, guint n)
+{
+  guint i;
+
+#ifdef HAVE_ORC
+  if (graph->acceleration) {
+    nns_cpu_orc_mac_u8 (d, s1, s2, z1, z2, n);
+    return;
+  }
+#endif
+  for (i = 0; i < n; i++)
+    d[i] += ((gint32) s1[i] - z1) * ((gint32) s2[i] - z2);
+}
+
+/**
+ * @brief d[i] += s[i]
+ */
+static void
+nnscpu_acc_u8 (const nnscpu_graph * graph, gint32 * d, const guint8 * s,
+    guint n)
+{
+  guint i;
+
+#ifdef HAVE_ORC
+  if (graph->acceleration) {
+    nns_cpu_orc_acc_u8 (d, s, n);
+    return;
+  }
+#endif
+  for (i = 0; i < n; i++)
+    d[i] += s[i];
+}
+
+/**
+ * @brief d[i] = max (d[i], s[i])
+ */
+static void
+nnscpu_max_u8 (const nnscpu_graph * graph, guint8 * d, const guint8 * s,
+    guint n)
+{
+  guint i;
+
+#ifdef HAVE_ORC
+  if (graph->acceleration) {
+    nns_cpu_orc_max_u8 (d, s, n);
+    return;
+  }
+#endif
+  for (i = 0; i < n; i++)
+    d[i] = MAX (d[i], s[i]);
+}
+
+/**
+ * @brief d[i] = clamp (d[i], lo, hi)
+ */
+static void
+nnscpu_clamp_u8 (const nnscpu_graph * graph, guint8 * d, gint lo, gint hi,
+    guint n)
+{
+  guint i;
+
+#ifdef HAVE_ORC
+  if (graph->acceleration) {
+    nns_cpu_orc_clamp_u8 (d, lo, hi, n);
+    return;
+  }
+#endif
+  for (i = 0; i < n; i++)
+    d[i] = CLAMP (d[i], lo, hi);
+}
+
+/**
+ * @brief Quantize the real value with the rounding half up.
+ */
+static guint8
+nnscpu_quantize (gdouble v, gint zero, gint lo, gint hi)
+{
+  gdouble q = floor (v + 0.5) + zero;
+
+  return (guint8) CLAMP (q, lo, hi);
+}
+
+/**
+ * @brief Get the range of the fused activation of float32 tensor.
+ */
+static void
+nnscpu_act_range_f32 (nnscpu_act act, gfloat * lo, gfloat * hi)
+{
+  *lo = -FLT_MAX;
+  *hi = FLT_MAX;
+
+  if (act == NNSCPU_ACT_RELU || act == NNSCPU_ACT_RELU6)
+    *lo = 0.0f;
+  if (act == NNSCPU_ACT_RELU6)
+    *hi = 6.0f;
+}
+
+/**
+ * @brief Get the range of the fused activation of quantized tensor.
+ */
+static void
+nnscpu_act_range_u8 (nnscpu_act act, const nnscpu_tensor * t, gint * lo,
+    gint * hi)
+{
+  *lo = 0;
+  *hi = 255;
+
+  if (act == NNSCPU_ACT_RELU || act == NNSCPU_ACT_RELU6)
+    *lo = MAX (*lo, t->zero);
+  if (act == NNSCPU_ACT_RELU6)
+    *hi = MIN (*hi, t->zero + (gint) floor (6.0 / t->scale + 0.5));
+}
+
+/**
+ * @brief Apply the fused activation to float32 tensor.
+ */
+static void
+nnscpu_activate_f32 (const nnscpu_graph * graph, nnscpu_act act,
+    nnscpu_tensor * t)
+{
+  gfloat lo, hi;
+
+  if (act == NNSCPU_ACT_NONE)
+    return;
+
+  nnscpu_act_range_f32 (act, &lo, &hi);
+  nnscpu_clamp_f32 (graph, t->data, lo, hi, t->size / sizeof (gfloat));
+}
+
+/**
+ * Operations. The dimension of feature maps is C:W:H:N.
+ */
+
+/**
+ * @brief Get the input position of the window, -1 if it is in the padding.
+ */
+static gint
+nnscpu_window_pos (guint o, guint k, guint stride, guint pad, guint size)
+{
+  gint pos = (gint) (o * stride + k) - (gint) pad;
+
+  return (pos < 0 || pos >= (gint) size) ? -1 : pos;
+}
+
+/**
+ * @brief conv2d. filter is OC:IC:KW:KH, bias is OC.
+ */
+static void
+nnscpu_run_conv2d (nnscpu_graph * graph, const nnscpu_node * node)
+{
+  nnscpu_tensor *x, *w, *b, *y;
+  guint IC, W, H, N, OC, KW, KH, OW, OH;
+  guint n, oy, ox, ky, kx, ic, oc, pixel;
+  gint iy, ix, lo, hi;
+  gdouble m;
+
+  x = nnscpu_tensor_at (graph, node->inputs[0]);
+  w = nnscpu_tensor_at (graph, node->inputs[1]);
+  b = (node->num_inputs > 2) ? nnscpu_tensor_at (graph, node->inputs[2]) : NULL;
+  y = nnscpu_tensor_at (graph, node->output);
+
+  IC = x->info.dimension[0];
+  W = x->info.dimension[1];
+  H = x->info.dimension[2];
+  N = x->info.dimension[3];
+  OC = w->info.dimension[0];
+  KW = w->info.dimension[2];
+  KH = w->info.dimension[3];
+  OW = y->info.dimension[1];
+  OH = y->info.dimension[2];
+
+  if (x->info.type == _NNS_FLOAT32) {
+    const gfloat *xd = x->data, *wd = w->data;
+    gfloat *yp;
+
+    for (n = 0; n < N; n++) {
+      for (oy = 0; oy < OH; oy++) {
+        for (ox = 0; ox < OW; ox++) {
+          yp = (gfloat *) y->data + ((n * OH + oy) * OW + ox) * OC;
+
+          if (b)
+            memcpy (yp, b->data, OC * sizeof (gfloat));
+          else
+            memset (yp, 0, OC * sizeof (gfloat));
+
+          for (ky = 0; ky < KH; ky++) {
+            iy = nnscpu_window_pos (oy, ky, node->stride[1], node->pad[1], H);
+            if (iy < 0)
+              continue;
+
+            for (kx = 0; kx < KW; kx++) {
+              const gfloat *xp, *wp;
+
+              ix = nnscpu_window_pos (ox, kx, node->stride[0], node->pad[0],
+                  W);
+              if (ix < 0)
+                continue;
+
+              xp = xd + ((n * H + iy) * W + ix) * IC;
+              wp = wd + (ky * KW + kx) * IC * OC;
+
+              for (ic = 0; ic < IC; ic++)
+                nnscpu_mad_f32 (graph, yp, wp + ic * OC, xp[ic], OC);
+            }
+          }
+        }
+      }
+    }
+
+    nnscpu_activate_f32 (graph, node->act, y);
+  } else {
+    const guint8 *xd = x->data, *wd = w->data;
+    guint8 *yp;
+    gint32 *acc = graph->acc;
+
+    m = x->scale * w->scale / y->scale;
+    nnscpu_act_range_u8 (node->act, y, &lo, &hi);
+
+    for (n = 0; n < N; n++) {
+      for (oy = 0; oy < OH; oy++) {
+        for (ox = 0; ox < OW; ox++) {
+          pixel = (n * OH + oy) * OW + ox;
+          yp = (guint8 *) y->data + pixel * OC;
+
+          if (b)
+            memcpy (acc, b->data, OC * sizeof (gint32));
+          else
+            memset (acc, 0, OC * sizeof (gint32));
+
+          for (ky = 0; ky < KH; ky++) {
+            iy = nnscpu_window_pos (oy, ky, node->stride[1], node->pad[1], H);
+            if (iy < 0)
+              continue;
+
+            for (kx = 0; kx < KW; kx++) {
+              const guint8 *xp, *wp;
+              gint v;
+
+              ix = nnscpu_window_pos (ox, kx, node->stride[0], node->pad[0],
+                  W);
+              if (ix < 0)
+                continue;
+
+              xp = xd + ((n * H + iy) * W + ix) * IC;
+              wp = wd + (ky * KW + kx) * IC * OC;
+
+              for (ic = 0; ic < IC; ic++) {
+                /* the padding and zero inputs do not change the accumulators */
+                v = (gint) xp[ic] - x->zero;
+                if (v != 0)
+                  nnscpu_mad_u8 (graph, acc, wp + ic * OC, v, w->zero, OC);
+              }
+            }
+          }
+
+          for (oc = 0; oc < OC; oc++)
+            yp[oc] = nnscpu_quantize (acc[oc] * m, y->zero, lo, hi);
+        }
+      }
+    }
+  }
+}
+
+/**
+ * @brief dwconv2d (depth multiplier 1). filter is C:KW:KH:1, bias is C.
+ */
+static void
+nnscpu_run_dwconv2d (nnscpu_graph * graph, const nnscpu_node * node)
+{
+  nnscpu_tensor *x, *w, *b, *y;
+  guint C, W, H, N, KW, KH, OW, OH;
+  guint n, oy, ox, ky, kx, c;
+  gint iy, ix, lo, hi;
+  gdouble m;
+
+  x = nnscpu_tensor_at (graph, node->inputs[0]);
+  w = nnscpu_tensor_at (graph, node->inputs[1]);
+  b = (node->num_inputs > 2) ? nnscpu_tensor_at (graph, node->inputs[2]) : NULL;
+  y = nnscpu_tensor_at (graph, node->output);
+
+  C = x->info.dimension[0];
+  W = x->info.dimension[1];
+  H = x->info.dimension[2];
+  N = x->info.dimension[3];
+  KW = w->info.dimension[1];
+  KH = w->info.dimension[2];
+  OW = y->info.dimension[1];
+  OH = y->info.dimension[2];
+
+  if (x->info.type == _NNS_FLOAT32) {
+    const gfloat *xd = x->data, *wd = w->data;
+    gfloat *yp;
+
+    for (n = 0; n < N; n++) {
+      for (oy = 0; oy < OH; oy++) {
+        for (ox = 0; ox < OW; ox++) {
+          yp = (gfloat *) y->data + ((n * OH + oy) * OW + ox) * C;
+
+          if (b)
+            memcpy (yp, b->data, C * sizeof (gfloat));
+          else
+            memset (yp, 0, C * sizeof (gfloat));
+
+          for (ky = 0; ky < KH; ky++) {
+            iy = nnscpu_window_pos (oy, ky, node->stride[1], node->pad[1], H);
+            if (iy < 0)
+              continue;
+
+            for (kx = 0; kx < KW; kx++) {
+              ix = nnscpu_window_pos (ox, kx, node->stride[0], node->pad[0],
+                  W);
+              if (ix < 0)
+                continue;
+
+              nnscpu_mac_f32 (graph, yp, xd + ((n * H + iy) * W + ix) * C,
+                  wd + (ky * KW + kx) * C, C);
+            }
+          }
+        }
+      }
+    }
+
+    nnscpu_activate_f32 (graph, node->act, y);
+  } else {
+    const guint8 *xd = x->data, *wd = w->data;
+    guint8 *yp;
+    gint32 *acc = graph->acc;
+
+    m = x->scale * w->scale / y->scale;
+    nnscpu_act_range_u8 (node->act, y, &lo, &hi);
+
+    for (n = 0; n < N; n++) {
+      for (oy = 0; oy < OH; oy++) {
+        for (ox = 0; ox < OW; ox++) {
+          yp = (guint8 *) y->data + ((n * OH + oy) * OW + ox) * C;
+
+          if (b)
+            memcpy (acc, b->data, C * sizeof (gint32));
+          else
+            memset (acc, 0, C * sizeof (gint32));
+
+          for (ky = 0; ky < KH; ky++) {
+            iy = nnscpu_window_pos (oy, ky, node->stride[1], node->pad[1], H);
+            if (iy < 0)
+              continue;
+
+            for (kx = 0; kx < KW; kx++) {
+              ix = nnscpu_window_pos (ox, kx, node->stride[0], node->pad[0],
+                  W);
+              if (ix < 0)
+                continue;
+
+              nnscpu_mac_u8 (graph, acc, xd + ((n * H + iy) * W + ix) * C,
+                  wd + (ky * KW + kx) * C, x->zero, w->zero, C);
+            }
+          }
+
+          for (c = 0; c < C; c++)
+            yp[c] = nnscpu_quantize (acc[c] * m, y->zero, lo, hi);
+        }
+      }
+    }
+  }
+}
+
+/**
+ * @brief fc. The input is flattened to IN:1:1:N, filter is OUT:IN, bias is OUT.
+ */
+static void
+nnscpu_run_fc (nnscpu_graph * graph, const nnscpu_node * node)
+{
+  nnscpu_tensor *x, *w, *b, *y;
+  guint IN, OUT, N;
+  guint n, i, o;
+  gint v, lo, hi;
+  gdouble m;
+
+  x = nnscpu_tensor_at (graph, node->inputs[0]);
+  w = nnscpu_tensor_at (graph, node->inputs[1]);
+  b = (node->num_inputs > 2) ? nnscpu_tensor_at (graph, node->inputs[2]) : NULL;
+  y = nnscpu_tensor_at (graph, node->output);
+
+  OUT = w->info.dimension[0];
+  IN = w->info.dimension[1];
+  N = x->info.dimension[3];
+
+  if (x->info.type == _NNS_FLOAT32) {
+    const gfloat *xp, *wd = w->data;
+    gfloat *yp;
+
+    for (n = 0; n < N; n++) {
+      xp = (const gfloat *) x->data + n * IN;
+      yp = (gfloat *) y->data + n * OUT;
+
+      if (b)
+        memcpy (yp, b->data, OUT * sizeof (gfloat));
+      else
+        memset (yp, 0, OUT * sizeof (gfloat));
+
+      for (i = 0; i < IN; i++)
+        nnscpu_mad_f32 (graph, yp, wd + i * OUT, xp[i], OUT);
+    }
+
+    nnscpu_activate_f32 (graph, node->act, y);
+  } else {
+    const guint8 *xp, *wd = w->data;
+    guint8 *yp;
+    gint32 *acc = graph->acc;
+
+    m = x->scale * w->scale / y->scale;
+    nnscpu_act_range_u8 (node->act, y, &lo, &hi);
+
+    for (n = 0; n < N; n++) {
+      xp = (const guint8 *) x->data + n * IN;
+      yp = (guint8 *) y->data + n * OUT;
+
+      if (b)
+        memcpy (acc, b->data, OUT * sizeof (gint32));
+      else
+        memset (acc, 0, OUT * sizeof (gint32));
+
+      for (i = 0; i < IN; i++) {
+        v = (gint) xp[i] - x->zero;
+        if (v != 0)
+          nnscpu_mad_u8 (graph, acc, wd + i * OUT, v, w->zero, OUT);
+      }
+
+      for (o = 0; o < OUT; o++)
+        yp[o] = nnscpu_quantize (acc[o] * m, y->zero, lo, hi);
+    }
+  }
+}
+
+/**
+ * @brief maxpool and avgpool. The average excludes the padding.
+ */
+static void
+nnscpu_run_pool (nnscpu_graph * graph, const nnscpu_node * node)
+{
+  nnscpu_tensor *x, *y;
+  guint C, W, H, N, OW, OH;
+  guint n, oy, ox, ky, kx, c, count;
+  gint iy, ix;
+  gboolean is_max;
+  gsize esize, in_off;
+  gpointer yp;
+
+  x = nnscpu_tensor_at (graph, node->inputs[0]);
+  y = nnscpu_tensor_at (graph, node->output);
+  is_max = (node->op == NNSCPU_OP_MAXPOOL);
+
+  C = x->info.dimension[0];
+  W = x->info.dimension[1];
+  H = x->info.dimension[2];
+  N = x->info.dimension[3];
+  OW = y->info.dimension[1];
+  OH = y->info.dimension[2];
+  esize = tensor_element_size[x->info.type];
+
+  for (n = 0; n < N; n++) {
+    for (oy = 0; oy < OH; oy++) {
+      for (ox = 0; ox < OW; ox++) {
+        yp = (guint8 *) y->data + ((n * OH + oy) * OW + ox) * C * esize;
+        count = 0;
+
+        if (x->info.type == _NNS_FLOAT32) {
+          if (is_max) {
+            for (c = 0; c < C; c++)
+              ((gfloat *) yp)[c] = -FLT_MAX;
+          } else {
+            memset (yp, 0, C * sizeof (gfloat));
+          }
+        } else {
+          if (is_max)
+            memset (yp, 0, C);
+          else
+            memset (graph->acc, 0, C * sizeof (gint32));
+        }
+
+        for (ky = 0; ky < node->kernel[1]; ky++) {
+          iy = nnscpu_window_pos (oy, ky, node->stride[1], node->pad[1], H);
+          if (iy < 0)
+            continue;
+
+          for (kx = 0; kx < node->kernel[0]; kx++) {
+            ix = nnscpu_window_pos (ox, kx, node->stride[0], node->pad[0], W);
+            if (ix < 0)
+              continue;
+
+            in_off = ((n * H + iy) * W + ix) * C;
+            count++;
+
+            if (x->info.type == _NNS_FLOAT32) {
+              if (is_max)
+                nnscpu_max_f32 (graph, yp, (gfloat *) x->data + in_off, C);
+              else
+                nnscpu_acc_f32 (graph, yp, (gfloat *) x->data + in_off, C);
+            } else {
+              if (is_max)
+                nnscpu_max_u8 (graph, yp, (guint8 *) x->data + in_off, C);
+              else
+                nnscpu_acc_u8 (graph, graph->acc, (guint8 *) x->data + in_off,
+                    C);
+            }
+          }
+        }
+
+        if (is_max || count == 0)
+          continue;
+
+        if (x->info.type == _NNS_FLOAT32) {
+          nnscpu_scale_f32 (graph, yp, 1.0f / count, C);
+        } else {
+          for (c = 0; c < C; c++)
+            ((guint8 *) yp)[c] = (graph->acc[c] + count / 2) / count;
+        }
+      }
+    }
+  }
+}
+
+/**
+ * @brief relu and relu6. The quantization is the same as the input.
+ */
+static void
+nnscpu_run_relu (nnscpu_graph * graph, const nnscpu_node * node)
+{
+  nnscpu_tensor *x, *y;
+  nnscpu_act act;
+  gfloat flo, fhi;
+  gint lo, hi;
+
+  x = nnscpu_tensor_at (graph, node->inputs[0]);
+  y = nnscpu_tensor_at (graph, node->output);
+  act = (node->op == NNSCPU_OP_RELU6) ? NNSCPU_ACT_RELU6 : NNSCPU_ACT_RELU;
+
+  memcpy (y->data, x->data, y->size);
+
+  if (x->info.type == _NNS_FLOAT32) {
+    nnscpu_act_range_f32 (act, &flo, &fhi);
+    nnscpu_clamp_f32 (graph, y->data, flo, fhi, y->size / sizeof (gfloat));
+  } else {
+    nnscpu_act_range_u8 (act, y, &lo, &hi);
+    nnscpu_clamp_u8 (graph, y->data, lo, hi, y->size);
+  }
+}
+
+/**
+ * @brief softmax along the innermost dimension.
+ */
+static void
+nnscpu_run_softmax (nnscpu_graph * graph, const nnscpu_node * node)
+{
+  nnscpu_tensor *x, *y;
+  guint C, rows, r, c;
+  gdouble v, max, sum;
+  gdouble *e;
+
+  x = nnscpu_tensor_at (graph, node->inputs[0]);
+  y = nnscpu_tensor_at (graph, node->output);
+
+  C = x->info.dimension[0];
+  rows = get_tensor_element_count (x->info.dimension) / C;
+  e = g_new (gdouble, C);
+
+  for (r = 0; r < rows; r++) {
+    max = -DBL_MAX;
+    for (c = 0; c < C; c++) {
+      if (x->info.type == _NNS_FLOAT32)
+        v = ((gfloat *) x->data)[r * C + c];
+      else
+        v = x->scale * (((guint8 *) x->data)[r * C + c] - x->zero);
+
+      e[c] = v;
+      max = MAX (max, v);
+    }
+
+    sum = 0.0;
+    for (c = 0; c < C; c++) {
+      e[c] = exp (e[c] - max);
+      sum += e[c];
+    }
+
+    for (c = 0; c < C; c++) {
+      if (y->info.type == _NNS_FLOAT32)
+        ((gfloat *) y->data)[r * C + c] = (gfloat) (e[c] / sum);
+      else
+        ((guint8 *) y->data)[r * C + c] =
+            nnscpu_quantize (e[c] / sum / y->scale, y->zero, 0, 255);
+    }
+  }
+
+  g_free (e);
+}
+
+/**
+ * @brief add of the tensors with the same dimension.
+ */
+static void
+nnscpu_run_add (nnscpu_graph * graph, const nnscpu_node * node)
+{
+  nnscpu_tensor *a, *b, *y;
+  const guint8 *ap, *bp;
+  guint8 *yp;
+  gsize i, count;
+  gint lo, hi;
+
+  a = nnscpu_tensor_at (graph, node->inputs[0]);
+  b = nnscpu_tensor_at (graph, node->inputs[1]);
+  y = nnscpu_tensor_at (graph, node->output);
+
+  if (y->info.type == _NNS_FLOAT32) {
+    nnscpu_add_f32 (graph, y->data, a->data, b->data,
+        y->size / sizeof (gfloat));
+    nnscpu_activate_f32 (graph, node->act, y);
+  } else {
+    ap = a->data;
+    bp = b->data;
+    yp = y->data;
+    count = y->size;
+
+    nnscpu_act_range_u8 (node->act, y, &lo, &hi);
+
+    for (i = 0; i < count; i++) {
+      yp[i] = nnscpu_quantize ((a->scale * (ap[i] - a->zero) +
+              b->scale * (bp[i] - b->zero)) / y->scale, y->zero, lo, hi);
+    }
+  }
+}
+
+/**
+ * @brief concat along the given dimension. The quantized inputs are requantized if needed.
+ */
+static void
+nnscpu_run_concat (nnscpu_graph * graph, const nnscpu_node * node)
+{
+  nnscpu_tensor *x, *y;
+  gsize esize, outer, inner, o, k;
+  guint i, d;
+  guint8 *yp;
+  const guint8 *xp;
+
+  y = nnscpu_tensor_at (graph, node->output);
+  esize = tensor_element_size[y->info.type];
+
+  outer = 1;
+  for (d = node->axis + 1; d < NNS_TENSOR_RANK_LIMIT; d++)
+    outer *= y->info.dimension[d];
+
+  yp = y->data;
+
+  for (o = 0; o < outer; o++) {
+    for (i = 0; i < node->num_inputs; i++) {
+      x = nnscpu_tensor_at (graph, node->inputs[i]);
+
+      inner = 1;
+      for (d = 0; d <= node->axis; d++)
+        inner *= x->info.dimension[d];
+
+      xp = (const guint8 *) x->data + o * inner * esize;
+
+      if (y->info.type == _NNS_FLOAT32 ||
+          (x->scale == y->scale && x->zero == y->zero)) {
+        nns_memcpy (yp, xp, inner * esize);
+      } else {
+        for (k = 0; k < inner; k++) {
+          yp[k] = nnscpu_quantize (x->scale * (xp[k] - x->zero) / y->scale,
+              y->zero, 0, 255);
+        }
+      }
+
+      yp += inner * esize;
+    }
+  }
+}
+
+/**
+ * @brief Run an operation.
+ */
+static void
+nnscpu_run_node (nnscpu_graph * graph, const nnscpu_node * node)
+{
+  switch (node->op) {
+    case NNSCPU_OP_CONV2D:
+      nnscpu_run_conv2d (graph, node);
+      break;
+    case NNSCPU_OP_DWCONV2D:
+      nnscpu_run_dwconv2d (graph, node);
+      break;
+    case NNSCPU_OP_FC:
+      nnscpu_run_fc (graph, node);
+      break;
+    case NNSCPU_OP_MAXPOOL:
+    case NNSCPU_OP_AVGPOOL:
+      nnscpu_run_pool (graph, node);
+      break;
+    case NNSCPU_OP_RELU:
+    case NNSCPU_OP_RELU6:
+      nnscpu_run_relu (graph, node);
+      break;
+    case NNSCPU_OP_SOFTMAX:
+      nnscpu_run_softmax (graph, node);
+      break;
+    case NNSCPU_OP_ADD:
+      nnscpu_run_add (graph, node);
+      break;
+    case NNSCPU_OP_CONCAT:
+      nnscpu_run_concat (graph, node);
+      break;
+    default:
+      g_assert_not_reached ();
+      break;
+  }
+}
+
+/**
+ * Graph loader.
+ */
+
+/**
+ * @brief Find the tensor with the name.
+ * @return the index of tensor, -1 if not found.
+ */
+static gint
+nnscpu_find_tensor (nnscpu_graph * graph, const gchar * name)
+{
+  guint i;
+
+  for (i = 0; i < graph->tensors->len; i++) {
+    if (g_str_equal (nnscpu_tensor_at (graph, i)->name, name))
+      return (gint) i;
+  }
+
+  return -1;
+}
+
+/**
+ * @brief Get the value of the attribute.
+ * @return the value, NULL if not given.
+ */
+static const gchar *
+nnscpu_get_attr (gchar ** attrs, guint num_attrs, const gchar * key)
+{
+  gsize len = strlen (key);
+  guint i;
+
+  for (i = 0; i < num_attrs; i++) {
+    if (strncmp (attrs[i], key, len) == 0 && attrs[i][len] == '=')
+      return attrs[i] + len + 1;
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief Parse the pair of positive integers "A:B", or "A" for both.
+ */
+static gboolean
+nnscpu_parse_pair (const gchar * str, guint pair[2])
+{
+  gchar *end;
+  guint64 val;
+
+  val = g_ascii_strtoull (str, &end, 10);
+  if (end == str || val == 0 || val > G_MAXUINT)
+    return FALSE;
+  pair[0] = pair[1] = (guint) val;
+
+  if (*end == ':') {
+    str = end + 1;
+    val = g_ascii_strtoull (str, &end, 10);
+    if (end == str || val == 0 || val > G_MAXUINT)
+      return FALSE;
+    pair[1] = (guint) val;
+  }
+
+  return (*end == '\0');
+}
+
+/**
+ * @brief Parse the quantization of the tensor. (scale=S zero=Z)
+ */
+static gboolean
+nnscpu_parse_quant (nnscpu_tensor * t, gchar ** attrs, guint num_attrs)
+{
+  const gchar *scale, *zero;
+  gchar *end;
+  gint64 val;
+
+  scale = nnscpu_get_attr (attrs, num_attrs, "scale");
+  zero = nnscpu_get_attr (attrs, num_attrs, "zero");
+
+  if (scale == NULL && zero == NULL)
+    return TRUE;
+
+  if (scale == NULL)
+    return FALSE;
+
+  t->scale = g_ascii_strtod (scale, &end);
+  if (end == scale || *end != '\0' || t->scale <= 0.0)
+    return FALSE;
+
+  t->zero = 0;
+  if (zero) {
+    val = g_ascii_strtoll (zero, &end, 10);
+    if (end == zero || *end != '\0' || val < 0 || val > 255)
+      return FALSE;
+    t->zero = (gint) val;
+  }
+
+  t->quantized = TRUE;
+  return TRUE;
+}
+
+/**
+ * @brief Add a tensor to the graph.
+ * @return the index of tensor, -1 if the name is already used.
+ */
+static gint
+nnscpu_add_tensor (nnscpu_graph * graph, const gchar * name,
+    nnscpu_tensor * t)
+{
+  if (nnscpu_find_tensor (graph, name) >= 0)
+    return -1;
+
+  t->name = g_strdup (name);
+  t->size = gst_tensor_info_get_size (&t->info);
+  t->output = -1;
+  g_array_append_val (graph->tensors, *t);
+  return (gint) graph->tensors->len - 1;
+}
+
+/**
+ * @brief Get the output size and padding of the window along a dimension.
+ */
+static gboolean
+nnscpu_window_out (guint in, guint k, guint stride, gboolean same, guint * out,
+    guint * pad)
+{
+  guint total;
+
+  if (same) {
+    *out = (in + stride - 1) / stride;
+    total = (*out - 1) * stride + k;
+    *pad = (total > in) ? (total - in) / 2 : 0;
+  } else {
+    if (in < k)
+      return FALSE;
+    *out = (in - k) / stride + 1;
+    *pad = 0;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Check the input tensors and get the output tensor of the operation.
+ * @param[out] y the output tensor (type, dimension and quantization)
+ * @return NULL if OK, or the error message.
+ */
+static const gchar *
+nnscpu_infer (nnscpu_graph * graph, nnscpu_node * node, nnscpu_tensor * y,
+    gchar ** attrs, guint num_attrs)
+{
+  nnscpu_tensor *x, *w, *b, *t;
+  const gchar *val;
+  gboolean quantized;
+  guint i, d, pair[2];
+  gint64 axis;
+
+  x = nnscpu_tensor_at (graph, node->inputs[0]);
+  quantized = (x->info.type == _NNS_UINT8);
+
+  if (x->info.type != _NNS_FLOAT32 && x->info.type != _NNS_UINT8)
+    return "the type of input should be float32 or uint8";
+  if (quantized && !x->quantized)
+    return "the quantization of input is not given";
+
+  y->info = x->info;
+  y->scale = x->scale;
+  y->zero = x->zero;
+  y->quantized = x->quantized;
+
+  node->stride[0] = node->stride[1] = 1;
+  node->pad_same = FALSE;
+  node->act = NNSCPU_ACT_NONE;
+
+  if ((val = nnscpu_get_attr (attrs, num_attrs, "stride")) &&
+      !nnscpu_parse_pair (val, node->stride))
+    return "invalid stride";
+
+  if ((val = nnscpu_get_attr (attrs, num_attrs, "pad"))) {
+    if (g_str_equal (val, "same"))
+      node->pad_same = TRUE;
+    else if (!g_str_equal (val, "valid"))
+      return "invalid pad (same or valid)";
+  }
+
+  if ((val = nnscpu_get_attr (attrs, num_attrs, "act"))) {
+    if (g_str_equal (val, "relu"))
+      node->act = NNSCPU_ACT_RELU;
+    else if (g_str_equal (val, "relu6"))
+      node->act = NNSCPU_ACT_RELU6;
+    else if (!g_str_equal (val, "none"))
+      return "invalid act (none, relu or relu6)";
+  }
+
+  switch (node->op) {
+    case NNSCPU_OP_CONV2D:
+    case NNSCPU_OP_DWCONV2D:
+    case NNSCPU_OP_FC:
+      w = nnscpu_tensor_at (graph, node->inputs[1]);
+      b = (node->num_inputs > 2) ?
+          nnscpu_tensor_at (graph, node->inputs[2]) : NULL;
+
+      if (w->info.type != x->info.type)
+        return "the type of filter should be the same as input";
+      if (quantized && !w->quantized)
+        return "the quantization of filter is not given";
+
+      if (node->op == NNSCPU_OP_CONV2D) {
+        if (w->info.dimension[1] != x->info.dimension[0])
+          return "the filter should be OC:IC:KW:KH";
+        node->kernel[0] = w->info.dimension[2];
+        node->kernel[1] = w->info.dimension[3];
+        y->info.dimension[0] = w->info.dimension[0];
+      } else if (node->op == NNSCPU_OP_DWCONV2D) {
+        if (w->info.dimension[0] != x->info.dimension[0] ||
+            w->info.dimension[3] != 1)
+          return "the filter should be C:KW:KH:1";
+        node->kernel[0] = w->info.dimension[1];
+        node->kernel[1] = w->info.dimension[2];
+      } else {
+        if (w->info.dimension[1] != x->info.dimension[0] *
+            x->info.dimension[1] * x->info.dimension[2] ||
+            w->info.dimension[2] != 1 || w->info.dimension[3] != 1)
+          return "the filter should be OUT:IN";
+        y->info.dimension[0] = w->info.dimension[0];
+        y->info.dimension[1] = y->info.dimension[2] = 1;
+      }
+
+      if (b) {
+        if (b->info.type != (quantized ? _NNS_INT32 : _NNS_FLOAT32))
+          return "the type of bias should be float32 (int32 if quantized)";
+        if (get_tensor_element_count (b->info.dimension) !=
+            y->info.dimension[0])
+          return "the size of bias should be the number of output channels";
+      }
+
+      if (quantized) {
+        y->quantized = FALSE;
+        if (!nnscpu_parse_quant (y, attrs, num_attrs) || !y->quantized)
+          return "the quantization of output (scale and zero) is not given";
+      }
+      break;
+    case NNSCPU_OP_MAXPOOL:
+    case NNSCPU_OP_AVGPOOL:
+      if (!(val = nnscpu_get_attr (attrs, num_attrs, "size")) ||
+          !nnscpu_parse_pair (val, pair))
+        return "invalid size of the window";
+      node->kernel[0] = pair[0];
+      node->kernel[1] = pair[1];
+      break;
+    case NNSCPU_OP_RELU:
+    case NNSCPU_OP_RELU6:
+      break;
+    case NNSCPU_OP_SOFTMAX:
+      if (quantized) {
+        y->scale = 1.0 / 256.0;
+        y->zero = 0;
+        if (!nnscpu_parse_quant (y, attrs, num_attrs))
+          return "invalid quantization of output";
+      }
+      break;
+    case NNSCPU_OP_ADD:
+      t = nnscpu_tensor_at (graph, node->inputs[1]);
+      if (!gst_tensor_info_is_equal (&t->info, &x->info))
+        return "the inputs of add should have the same type and dimension";
+      if (quantized) {
+        if (!t->quantized)
+          return "the quantization of input is not given";
+        if (!nnscpu_parse_quant (y, attrs, num_attrs))
+          return "invalid quantization of output";
+      }
+      break;
+    case NNSCPU_OP_CONCAT:
+      axis = 0;
+      if ((val = nnscpu_get_attr (attrs, num_attrs, "axis")))
+        axis = g_ascii_strtoll (val, NULL, 10);
+      if (axis < 0 || axis >= NNS_TENSOR_RANK_LIMIT)
+        return "invalid axis";
+      node->axis = (guint) axis;
+
+      for (i = 1; i < node->num_inputs; i++) {
+        t = nnscpu_tensor_at (graph, node->inputs[i]);
+        if (t->info.type != x->info.type)
+          return "the inputs of concat should have the same type";
+        if (quantized && !t->quantized)
+          return "the quantization of input is not given";
+
+        for (d = 0; d < NNS_TENSOR_RANK_LIMIT; d++) {
+          if (d != node->axis && t->info.dimension[d] != x->info.dimension[d])
+            return "the inputs of concat should have the same dimension except the axis";
+        }
+
+        y->info.dimension[node->axis] += t->info.dimension[node->axis];
+      }
+
+      if (quantized && !nnscpu_parse_quant (y, attrs, num_attrs))
+        return "invalid quantization of output";
+      break;
+    default:
+      g_assert_not_reached ();
+      break;
+  }
+
+  /* the window of spatial operations */
+  if (node->op == NNSCPU_OP_CONV2D || node->op == NNSCPU_OP_DWCONV2D ||
+      node->op == NNSCPU_OP_MAXPOOL || node->op == NNSCPU_OP_AVGPOOL) {
+    for (d = 0; d < 2; d++) {
+      if (!nnscpu_window_out (x->info.dimension[d + 1], node->kernel[d],
+              node->stride[d], node->pad_same, &y->info.dimension[d + 1],
+              &node->pad[d]))
+        return "the window is larger than input";
+    }
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief Parse a line of the graph.
+ * @return NULL if OK, or the error message.
+ */
+static const gchar *
+nnscpu_parse_line (nnscpu_graph * graph, const gchar * dir, gchar ** args,
+    guint num_args, gchar ** attrs, guint num_attrs)
+{
+  nnscpu_tensor t;
+  nnscpu_node node;
+  const gchar *val, *err;
+  gchar *path, *end;
+  guint i, k;
+  gint idx;
+  guint64 offset;
+  gchar *allowed;
+
+  memset (&t, 0, sizeof (t));
+  memset (&node, 0, sizeof (node));
+
+  if (g_str_equal (args[0], "weights")) {
+    if (num_args != 2 || num_attrs > 0)
+      return "usage: weights FILE";
+    if (graph->weights)
+      return "the weights file is already given";
+
+    if (g_path_is_absolute (args[1]))
+      path = g_strdup (args[1]);
+    else
+      path = g_build_filename (dir, args[1], NULL);
+
+    if (!g_file_get_contents (path, &graph->weights, &graph->weights_size,
+            NULL)) {
+      g_free (path);
+      return "cannot read the weights file";
+    }
+
+    g_free (path);
+    return NULL;
+  }
+
+  if (g_str_equal (args[0], "input") || g_str_equal (args[0], "const")) {
+    if (num_args != 4)
+      return "usage: input|const NAME DIM TYPE [key=value ...]";
+
+    if (get_tensor_dimension (args[2], t.info.dimension) == 0)
+      return "invalid dimension";
+    t.info.type = get_tensor_type (args[3]);
+    if (!gst_tensor_info_validate (&t.info))
+      return "invalid tensor";
+    if (!nnscpu_parse_quant (&t, attrs, num_attrs))
+      return "invalid quantization";
+
+    if (args[0][0] == 'i') {
+      if (graph->num_inputs >= NNS_TENSOR_SIZE_LIMIT)
+        return "too many input tensors";
+      t.kind = NNSCPU_TENSOR_INPUT;
+      t.index = graph->num_inputs;
+    } else {
+      if (graph->weights == NULL)
+        return "the weights file is not given";
+      if (!(val = nnscpu_get_attr (attrs, num_attrs, "offset")))
+        return "the offset in the weights file is not given";
+
+      offset = g_ascii_strtoull (val, &end, 10);
+      if (end == val || *end != '\0' ||
+          offset % tensor_element_size[t.info.type] != 0)
+        return "invalid offset (aligned with the size of element)";
+      if (offset + gst_tensor_info_get_size (&t.info) > graph->weights_size)
+        return "the weights file is too small";
+
+      t.kind = NNSCPU_TENSOR_CONST;
+      t.offset = (gsize) offset;
+      t.data = graph->weights + t.offset;
+    }
+
+    idx = nnscpu_add_tensor (graph, args[1], &t);
+    if (idx < 0)
+      return "the name is already used";
+
+    if (t.kind == NNSCPU_TENSOR_INPUT)
+      graph->inputs[graph->num_inputs++] = (guint) idx;
+    return NULL;
+  }
+
+  if (g_str_equal (args[0], "output")) {
+    if (num_args < 2 || num_attrs > 0)
+      return "usage: output NAME [NAME ...]";
+
+    for (i = 1; i < num_args; i++) {
+      idx = nnscpu_find_tensor (graph, args[i]);
+      if (idx < 0)
+        return "unknown tensor";
+      if (nnscpu_tensor_at (graph, idx)->kind != NNSCPU_TENSOR_NODE)
+        return "the output should be written by an operation";
+      if (nnscpu_tensor_at (graph, idx)->output >= 0)
+        return "the output is already given";
+      if (graph->num_outputs >= NNS_TENSOR_SIZE_LIMIT)
+        return "too many output tensors";
+
+      nnscpu_tensor_at (graph, idx)->output = (gint) graph->num_outputs;
+      graph->outputs[graph->num_outputs++] = (guint) idx;
+    }
+    return NULL;
+  }
+
+  for (k = 0; nnscpu_ops[k].name; k++) {
+    if (g_str_equal (args[0], nnscpu_ops[k].name))
+      break;
+  }
+
+  if (nnscpu_ops[k].name == NULL)
+    return "unknown statement";
+
+  node.op = nnscpu_ops[k].op;
+  node.num_inputs = num_args - 2;
+  if (num_args < 2 || node.num_inputs < nnscpu_ops[k].min_inputs ||
+      node.num_inputs > nnscpu_ops[k].max_inputs)
+    return "invalid number of inputs";
+
+  for (i = 0; i < num_attrs; i++) {
+    allowed = g_strdup_printf (",%.*s,", (int) strcspn (attrs[i], "="),
+        attrs[i]);
+    val = strstr (nnscpu_ops[k].attrs, allowed);
+    g_free (allowed);
+
+    if (val == NULL)
+      return "unknown attribute";
+  }
+
+  for (i = 0; i < node.num_inputs; i++) {
+    idx = nnscpu_find_tensor (graph, args[i + 2]);
+    if (idx < 0)
+      return "unknown tensor (defined in the later line?)";
+    node.inputs[i] = (guint) idx;
+  }
+
+  if ((err = nnscpu_infer (graph, &node, &t, attrs, num_attrs)))
+    return err;
+
+  t.kind = NNSCPU_TENSOR_NODE;
+  idx = nnscpu_add_tensor (graph, args[1], &t);
+  if (idx < 0)
+    return "the name is already used";
+
+  node.output = (guint) idx;
+  g_array_append_val (graph->nodes, node);
+  return NULL;
+}
+
+/**
+ * @brief Parse the graph file.
+ */
+static gboolean
+nnscpu_parse (nnscpu_graph * graph)
+{
+  gchar *contents, *dir;
+  gchar **lines, **tokens;
+  gchar *args[NNSCPU_MAX_NODE_INPUTS + 2];
+  gchar *attrs[NNSCPU_MAX_NODE_INPUTS + 2];
+  guint num_args, num_attrs;
+  const gchar *err = NULL;
+  guint l, i;
+
+  if (!g_file_get_contents (graph->path, &contents, NULL, NULL)) {
+    GST_ERROR ("Cannot read the graph %s", graph->path);
+    return FALSE;
+  }
+
+  dir = g_path_get_dirname (graph->path);
+  lines = g_strsplit (contents, "\n", -1);
+
+  for (l = 0; lines[l] && err == NULL; l++) {
+    /* remove comments */
+    if (strchr (lines[l], '#'))
+      *strchr (lines[l], '#') = '\0';
+
+    tokens = g_strsplit_set (lines[l], " \t\r", -1);
+    num_args = num_attrs = 0;
+
+    for (i = 0; tokens[i]; i++) {
+      if (tokens[i][0] == '\0')
+        continue;
+
+      if (num_args + num_attrs >= G_N_ELEMENTS (args)) {
+        err = "too many arguments";
+        break;
+      }
+
+      if (strchr (tokens[i], '='))
+        attrs[num_attrs++] = tokens[i];
+      else
+        args[num_args++] = tokens[i];
+    }
+
+    if (err == NULL && num_args > 0)
+      err = nnscpu_parse_line (graph, dir, args, num_args, attrs, num_attrs);
+    else if (err == NULL && num_attrs > 0)
+      err = "no statement";
+
+    g_strfreev (tokens);
+  }
+
+  if (err) {
+    GST_ERROR ("%s:%u: %s", graph->path, l, err);
+  } else if (graph->num_inputs == 0 || graph->num_outputs == 0) {
+    GST_ERROR ("%s: the input and output tensors should be given",
+        graph->path);
+    err = "no input or output";
+  }
+
+  g_strfreev (lines);
+  g_free (dir);
+  g_free (contents);
+  return (err == NULL);
+}
+
+/**
+ * @brief Allocate the memory of intermediate tensors and accumulators.
+ */
+static void
+nnscpu_prepare (nnscpu_graph * graph)
+{
+  nnscpu_tensor *t;
+  nnscpu_node *node;
+  gsize arena_size = 0;
+  guint i, max_channels = 1;
+
+  for (i = 0; i < graph->tensors->len; i++) {
+    t = nnscpu_tensor_at (graph, i);
+
+    if (t->kind == NNSCPU_TENSOR_NODE && t->output < 0) {
+      t->offset = arena_size;
+      arena_size += NNSCPU_ALIGN (t->size);
+    }
+  }
+
+  graph->arena = g_malloc0 (MAX (arena_size, 1));
+
+  for (i = 0; i < graph->tensors->len; i++) {
+    t = nnscpu_tensor_at (graph, i);
+
+    if (t->kind == NNSCPU_TENSOR_NODE && t->output < 0)
+      t->data = (guint8 *) graph->arena + t->offset;
+  }
+
+  /* the accumulators for the channels of an output pixel */
+  for (i = 0; i < graph->nodes->len; i++) {
+    node = nnscpu_node_at (graph, i);
+    t = nnscpu_tensor_at (graph, node->output);
+    max_channels = MAX (max_channels, t->info.dimension[0]);
+  }
+
+  graph->acc = g_new0 (gint32, max_channels);
+}
+
+/**
+ * @brief Load the graph of nnscpu.
+ * @param path the path of the graph file
+ * @param acceleration TRUE to use the SIMD kernels (ORC)
+ * @return the graph, NULL if error.
+ */
+nnscpu_graph *
+nnscpu_graph_load (const gchar * path, gboolean acceleration)
+{
+  nnscpu_graph *graph;
+
+  g_return_val_if_fail (path != NULL, NULL);
+
+  graph = g_new0 (nnscpu_graph, 1);
+  graph->path = g_strdup (path);
+  graph->acceleration = acceleration;
+  graph->tensors = g_array_new (FALSE, TRUE, sizeof (nnscpu_tensor));
+  graph->nodes = g_array_new (FALSE, TRUE, sizeof (nnscpu_node));
+
+  if (!nnscpu_parse (graph)) {
+    nnscpu_graph_free (graph);
+    return NULL;
+  }
+
+  nnscpu_prepare (graph);
+  return graph;
+}
+
+/**
+ * @brief Free the graph.
+ */
+void
+nnscpu_graph_free (nnscpu_graph * graph)
+{
+  guint i;
+
+  if (graph == NULL)
+    return;
+
+  for (i = 0; i < graph->tensors->len; i++)
+    g_free (nnscpu_tensor_at (graph, i)->name);
+
+  g_array_free (graph->tensors, TRUE);
+  g_array_free (graph->nodes, TRUE);
+  g_free (graph->weights);
+  g_free (graph->arena);
+  g_free (graph->acc);
+  g_free (graph->path);
+  g_free (graph);
+}
+
+/**
+ * @brief Get the path of the graph file.
+ */
+const gchar *
+nnscpu_graph_get_path (nnscpu_graph * graph)
+{
+  return graph->path;
+}
+
+/**
+ * @brief Get the input tensors info of the graph.
+ */
+void
+nnscpu_graph_get_input_info (nnscpu_graph * graph, GstTensorsInfo * info)
+{
+  guint i;
+
+  info->num_tensors = graph->num_inputs;
+  for (i = 0; i < graph->num_inputs; i++)
+    info->info[i] = nnscpu_tensor_at (graph, graph->inputs[i])->info;
+}
+
+/**
+ * @brief Get the output tensors info of the graph.
+ */
+void
+nnscpu_graph_get_output_info (nnscpu_graph * graph, GstTensorsInfo * info)
+{
+  guint i;
+
+  info->num_tensors = graph->num_outputs;
+  for (i = 0; i < graph->num_outputs; i++)
+    info->info[i] = nnscpu_tensor_at (graph, graph->outputs[i])->info;
+}
+
+/**
+ * @brief Run the graph.
+ * @param input the input tensors
+ * @param output the output tensors, allocated by the caller
+ * @return 0 if OK. -1 if the size of tensors is not matched.
+ */
+gint
+nnscpu_graph_invoke (nnscpu_graph * graph, const GstTensorMemory * input,
+    GstTensorMemory * output)
+{
+  nnscpu_tensor *t;
+  guint i;
+
+  for (i = 0; i < graph->num_inputs; i++) {
+    t = nnscpu_tensor_at (graph, graph->inputs[i]);
+    if (input[i].size != t->size) {
+      GST_ERROR ("The size of input tensor %u is not matched", i);
+      return -1;
+    }
+    t->data = input[i].data;
+  }
+
+  for (i = 0; i < graph->num_outputs; i++) {
+    t = nnscpu_tensor_at (graph, graph->outputs[i]);
+    if (output[i].size != t->size) {
+      GST_ERROR ("The size of output tensor %u is not matched", i);
+      return -1;
+    }
+    t->data = output[i].data;
+  }
+
+  for (i = 0; i < graph->nodes->len; i++)
+    nnscpu_run_node (graph, nnscpu_node_at (graph, i));
+
+  return 0;
+}
@@ -0,0 +1,47 @@
+/**
+ * Copyright (C) 2018 Samsung Electronics Co., Ltd. All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ */
+/**
+ * @file   tensor_filter_nnscpu_core.h
+ * @date   16 Oct 2026
+ * @brief  Built-in CPU inference engine (nnscpu) for tensor_filter
+ * @see    http://github.com/nnsuite/nnstreamer
+ * @bug    No known bugs.
+ *
+ * The graph of nnscpu is a text file, one statement per line. See README.md of tensor_filter.
+ */
+#ifndef __TENSOR_FILTER_NNSCPU_CORE_H__
+#define __TENSOR_FILTER_NNSCPU_CORE_H__
+
+#include <glib.h>
+#include <tensor_typedef.h>
+
+G_BEGIN_DECLS
+
+typedef struct _nnscpu_graph nnscpu_graph;
+
+extern nnscpu_graph *nnscpu_graph_load (const gchar * path,
+    gboolean acceleration);
+extern void nnscpu_graph_free (nnscpu_graph * graph);
+extern const gchar *nnscpu_graph_get_path (nnscpu_graph * graph);
+extern void nnscpu_graph_get_input_info (nnscpu_graph * graph,
+    GstTensorsInfo * info);
+extern void nnscpu_graph_get_output_info (nnscpu_graph * graph,
+    GstTensorsInfo * info);
+extern gint nnscpu_graph_invoke (nnscpu_graph * graph,
+    const GstTensorMemory * input, GstTensorMemory * output);
+
+G_END_DECLS
+
+#endif /* __TENSOR_FILTER_NNSCPU_CORE_H__ */
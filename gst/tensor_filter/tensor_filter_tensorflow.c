@@ -29,34 +29,155 @@
 #include "tensor_filter.h"
 #include "tensor_filter_tensorflow_core.h"
 #include <glib.h>
+#include <string.h>
 
 /**
- * @brief internal data of tensorflow lite
+ * @brief Options of tensorflow from the custom property
+ */
+typedef struct
+{
+  gchar *input_names; /**< the names of input tensors, comma-separated. NULL to find the placeholders */
+  gchar *output_names; /**< the names of output tensors, comma-separated. NULL to find the operations not consumed */
+} tf_option;
+
+/**
+ * @brief internal data of tensorflow
  */
 struct _Tf_data
 {
   void *tf_private_data;
+  tf_option option; /**< the options the model is loaded with */
 };
 typedef struct _Tf_data tf_data;
 
 /**
- * @brief Load tensorflow lite modelfile
+ * @brief Append the name of tensor to the comma-separated names.
+ */
+static void
+tf_appendName (gchar ** names, const gchar * name)
+{
+  gchar *appended;
+
+  if (*names == NULL) {
+    *names = g_strdup (name);
+  } else {
+    appended = g_strconcat (*names, ",", name, NULL);
+    g_free (*names);
+    *names = appended;
+  }
+}
+
+/**
+ * @brief Parse the custom property of tensorflow.
  * @param filter : tensor_filter instance
- * @param private_data : tensorflow lite plugin's private data
- * @return 0 if successfully loaded. 1 if skipped (already loaded). -1 if error
+ * @param[out] option : the parsed options. Free the names with tf_freeCustomOption.
+ *
+ * The custom property is a comma-separated list of Key:Value.
+ * Input:NAME and Output:NAME give the input and output tensors of the graph in order, repeated for each tensor.
+ * The name is the operation, with the index of its output if not 0. (e.g., custom=Input:x,Output:prob,Output:split:1)
+ * Without them, the input tensors are the placeholders and the output tensors are the outputs not consumed by other operations.
+ */
+static void
+tf_parseCustomOption (const GstTensorFilter * filter, tf_option * option)
+{
+  gchar **options;
+  gchar **pair;
+  guint i;
+
+  option->input_names = NULL;
+  option->output_names = NULL;
+
+  if (filter->prop.custom_properties == NULL)
+    return;
+
+  options = g_strsplit (filter->prop.custom_properties, ",", -1);
+
+  for (i = 0; options[i] != NULL; i++) {
+    pair = g_strsplit (options[i], ":", 2);
+
+    if (pair[0] == NULL || pair[1] == NULL) {
+      g_strfreev (pair);
+      continue;
+    }
+
+    g_strstrip (pair[0]);
+    g_strstrip (pair[1]);
+
+    if (g_ascii_strcasecmp (pair[0], "Input") == 0) {
+      tf_appendName (&option->input_names, pair[1]);
+    } else if (g_ascii_strcasecmp (pair[0], "Output") == 0) {
+      tf_appendName (&option->output_names, pair[1]);
+    }
+
+    g_strfreev (pair);
+  }
+
+  g_strfreev (options);
+}
+
+/**
+ * @brief Free the names of the options.
+ */
+static void
+tf_freeCustomOption (tf_option * option)
+{
+  g_free (option->input_names);
+  g_free (option->output_names);
+  option->input_names = NULL;
+  option->output_names = NULL;
+}
+
+/**
+ * @brief Free privateData and move on.
+ */
+static void
+tf_close (const GstTensorFilter * filter, void **private_data)
+{
+  tf_data *tf;
+  tf = *private_data;
+  tf_core_delete (tf->tf_private_data);
+  tf_freeCustomOption (&tf->option);
+  g_free (tf);
+  *private_data = NULL;
+  g_assert (filter->privateData == NULL);
+}
+
+/**
+ * @brief Load tensorflow modelfile
+ * @param filter : tensor_filter instance
+ * @param private_data : tensorflow plugin's private data
+ * @return 0 if successfully loaded. 1 if skipped (already loaded).
+ *        -1 if the object construction is failed.
+ *        -2 if the object initialization if failed
  */
 static int
 tf_loadModelFile (const GstTensorFilter * filter, void **private_data)
 {
   tf_data *tf;
+  tf_option option;
+
+  tf_parseCustomOption (filter, &option);
+
   if (filter->privateData != NULL) {
-    /** @todo : Check the integrity of filter->data and filter->model_file, nnfw */
-    return 1;
+    tf = *private_data;
+    if (strcmp (filter->prop.model_file,
+            tf_core_getModelPath (tf->tf_private_data)) ||
+        g_strcmp0 (option.input_names, tf->option.input_names) ||
+        g_strcmp0 (option.output_names, tf->option.output_names)) {
+      tf_close (filter, private_data);
+    } else {
+      tf_freeCustomOption (&option);
+      return 1;
+    }
   }
   tf = g_new0 (tf_data, 1); /** initialize tf Fill Zero! */
   *private_data = tf;
-  tf->tf_private_data = tf_core_new (filter->prop.model_file);
+  tf->option = option;
+  tf->tf_private_data = tf_core_new (filter->prop.model_file,
+      option.input_names, option.output_names);
   if (tf->tf_private_data) {
+    if (tf_core_init (tf->tf_private_data))
+      return -2;
     return 0;
   } else {
     return -1;
@@ -66,105 +187,105 @@ tf_loadModelFile (const GstTensorFilter * filter, void **private_data)
 /**
  * @brief The open callback for GstTensorFilterFramework. Called before anything else
  * @param filter : tensor_filter instance
- * @param private_data : tensorflow lite plugin's private data
+ * @param private_data : tensorflow plugin's private data
  */
 static int
 tf_open (const GstTensorFilter * filter, void **private_data)
 {
-  int retval = tf_loadModelFile (filter, private_data);
-  g_assert (retval == 0);       /** This must be called only once */
-  return 0;
+  return tf_loadModelFile (filter, private_data);
 }
 
 /**
  * @brief The mandatory callback for GstTensorFilterFramework
  * @param[in] input The array of input tensors
- * @param[out] output The array of output tensors
+ * @param[out] output The array of output tensors, allocated with g_malloc
+ * @return 0 if OK. non-zero if error.
  */
 static int
 tf_invoke (const GstTensorFilter * filter, void **private_data,
     const GstTensorMemory * input, GstTensorMemory * output)
 {
   int retval;
+  int i;
   tf_data *tf;
+  GDestroyNotify release[NNS_TENSOR_SIZE_LIMIT];
+  void *user_data[NNS_TENSOR_SIZE_LIMIT];
+
   tf = *private_data;
   g_assert (filter->privateData && *private_data == filter->privateData);
-  retval = tf_core_invoke (tf->tf_private_data, input, output);
+  retval = tf_core_invoke (tf->tf_private_data, input, output, release,
+      user_data);
   g_assert (retval == 0);
+  if (retval != 0)
+    return retval;
+
+  /* copy the output tensors of tensorflow */
+  for (i = 0; i < tf_core_getOutputSize (tf->tf_private_data); i++) {
+    output[i].data = g_memdup (output[i].data, output[i].size);
+    release[i] (user_data[i]);
+  }
+
   return retval;
 }
 
 /**
  * @brief The optional callback for GstTensorFilterFramework
+ * @param[in] input The array of input tensors
+ * @param[out] output The array of output tensors, the memory blocks of output tensors of tensorflow without copy
+ * @param[out] release The array of callbacks to release the output tensors of tensorflow
+ * @param[out] user_data The array of output tensors of tensorflow
+ * @return 0 if OK. non-zero if error.
  */
 static int
-tf_getInputDim (const GstTensorFilter * filter, void **private_data,
-    GstTensorsInfo * info)
+tf_invokeWithRelease (const GstTensorFilter * filter, void **private_data,
+    const GstTensorMemory * input, GstTensorMemory * output,
+    GDestroyNotify * release, void **user_data)
 {
-  int temp_idx = 0;
+  int retval;
   tf_data *tf;
   tf = *private_data;
-  temp_idx = tf_core_getInputSize (tf->tf_private_data);
-  if (temp_idx > 0)
-    temp_idx--;
-  else
-    temp_idx = 0;
   g_assert (filter->privateData && *private_data == filter->privateData);
-  return tf_core_getInputDim (tf->tf_private_data, info);
+  retval = tf_core_invoke (tf->tf_private_data, input, output, release,
+      user_data);
+  g_assert (retval == 0);
+  return retval;
 }
 
 /**
  * @brief The optional callback for GstTensorFilterFramework
  */
 static int
-tf_getOutputDim (const GstTensorFilter * filter, void **private_data,
+tf_getInputDim (const GstTensorFilter * filter, void **private_data,
     GstTensorsInfo * info)
 {
-  int temp_idx = 0;
   tf_data *tf;
   tf = *private_data;
-  temp_idx = tf_core_getOutputSize (tf->tf_private_data);
-  if (temp_idx > 0)
-    temp_idx--;
-  else
-    temp_idx = 0;
   g_assert (filter->privateData && *private_data == filter->privateData);
-  return tf_core_getOutputDim (tf->tf_private_data, info);
+  return tf_core_getInputDim (tf->tf_private_data, info);
 }
 
 /**
- * @brief The set-input-dim callback for GstTensorFilterFramework
+ * @brief The optional callback for GstTensorFilterFramework
  */
 static int
-tf_setInputDim (const GstTensorFilter * filter, void **private_data,
-    const GstTensorsInfo * in_info, GstTensorsInfo * out_info)
-{
-  /** @todo call tflite core apis */
-  return 0;                     /** NYI */
-}
-
-/**
- * @brief Free privateData and move on.
- */
-static void
-tf_close (const GstTensorFilter * filter, void **private_data)
+tf_getOutputDim (const GstTensorFilter * filter, void **private_data,
+    GstTensorsInfo * info)
 {
   tf_data *tf;
   tf = *private_data;
-  tf_core_delete (tf->tf_private_data);
-  g_free (tf);
-  *private_data = NULL;
-  g_assert (filter->privateData == NULL);
+  g_assert (filter->privateData && *private_data == filter->privateData);
+  return tf_core_getOutputDim (tf->tf_private_data, info);
 }
 
 GstTensorFilterFramework NNS_support_tensorflow = {
   .name = "tensorflow",
   .allow_in_place = FALSE,      /** @todo: support this to optimize performance later. */
-  .allocate_in_invoke = TRUE,
+  .allocate_in_invoke = TRUE,   /* the output tensors of tensorflow are pushed without copy */
+  .allow_concurrent_invoke = TRUE,      /* the session is thread-safe */
   .invoke_NN = tf_invoke,
+  .invoke_with_release_NN = tf_invokeWithRelease,
   .getInputDimension = tf_getInputDim,
   .getOutputDimension = tf_getOutputDim,
-  .setInputDimension = tf_setInputDim,
   .open = tf_open,
   .close = tf_close,
 };
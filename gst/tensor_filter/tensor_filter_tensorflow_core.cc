@@ -21,12 +21,13 @@
  * @date   08/02/2018
  * @brief  connection with tensorflow libraries.
  *
+ * The frozen graph (GraphDef) is run with the C API of tensorflow.
+ * A session is created once for the model and kept until the model is closed.
+ *
  * @bug     No known bugs.
  */
 
-#include <sys/time.h>
-#include <unistd.h>
-#include <algorithm>
+#include <string.h>
 
 #include "tensor_filter_tensorflow_core.h"
 
@@ -39,15 +40,24 @@
 
 /**
  * @brief	TFCore creator
- * @param	_model_path	: the logical path to '{model_name}.tffile' file
- * @note	the model of _model_path will be loaded simultaneously
+ * @param	_model_path	: the logical path to '{model_name}.pb' file (frozen graph)
+ * @param	_input_names	: the names of input tensors, comma-separated. nullptr or empty to find the placeholders
+ * @param	_output_names	: the names of output tensors, comma-separated. nullptr or empty to find the operations not consumed by others
+ * @note	the model is loaded with init ()
  * @return	Nothing
  */
-TFCore::TFCore (const char *_model_path)
+TFCore::TFCore (const char *_model_path, const char *_input_names,
+    const char *_output_names)
 {
   model_path = _model_path;
+  input_names = _input_names ? _input_names : "";
+  output_names = _output_names ? _output_names : "";
+
+  graph = nullptr;
+  session = nullptr;
 
-  loadModel ();
+  gst_tensors_info_init (&inputTensorMeta);
+  gst_tensors_info_init (&outputTensorMeta);
 }
 
 /**
@@ -56,72 +66,423 @@ TFCore::TFCore (const char *_model_path)
  */
 TFCore::~TFCore ()
 {
+  if (session) {
+    TF_Status *status = TF_NewStatus ();
+
+    TF_CloseSession (session, status);
+    TF_DeleteSession (session, status);
+    TF_DeleteStatus (status);
+  }
+
+  if (graph)
+    TF_DeleteGraph (graph);
 }
 
 /**
- * @brief	load the tf model
- * @note	the model will be loaded
+ * @brief	initialize the object with tensorflow model
  * @return 0 if OK. non-zero if error.
+ *        -1 if the model is not loaded.
+ *        -2 if the initialization of output tensor is failed.
  */
 int
-TFCore::loadModel ()
+TFCore::init ()
 {
-
+  if (loadModel ()) {
+    GST_ERROR ("Failed to load model\n");
+    return -1;
+  }
+  if (setOutputTensorProp ()) {
+    GST_ERROR ("Failed to initialize output tensor\n");
+    return -2;
+  }
   return 0;
 }
 
 /**
- * @brief	return the data type of the tensor
- * @param tensor_idx	: the index of the tensor
- * @param[out] type	: the data type of the input tensor
+ * @brief	get the model path
+ * @return the model path.
+ */
+const char *
+TFCore::getModelPath ()
+{
+  return model_path.c_str ();
+}
+
+/**
+ * @brief	load the tf model
+ * @note	the graph is imported, the input and output tensors are found, and the session is created.
  * @return 0 if OK. non-zero if error.
  */
 int
-TFCore::getTensorType (int tensor_idx, tensor_type * type)
+TFCore::loadModel ()
 {
+#if (DBG)
+  gint64 start_time = g_get_real_time ();
+#endif
+  gchar *content = nullptr;
+  gsize size;
+  GError *error = nullptr;
+  TF_Buffer *buffer;
+  TF_ImportGraphDefOptions *import_options;
+  TF_SessionOptions *session_options;
+  TF_Status *status;
+  int ret = 0;
 
-  return 0;
+  if (!g_file_get_contents (model_path.c_str (), &content, &size, &error)) {
+    GST_ERROR ("Failed to read model %s: %s\n", model_path.c_str (),
+        error->message);
+    g_error_free (error);
+    return -1;
+  }
+
+  status = TF_NewStatus ();
+  graph = TF_NewGraph ();
+
+  buffer = TF_NewBufferFromString (content, size);
+  import_options = TF_NewImportGraphDefOptions ();
+  TF_GraphImportGraphDef (graph, buffer, import_options, status);
+  TF_DeleteImportGraphDefOptions (import_options);
+  TF_DeleteBuffer (buffer);
+  g_free (content);
+
+  if (TF_GetCode (status) != TF_OK) {
+    GST_ERROR ("Failed to import graph: %s\n", TF_Message (status));
+    ret = -2;
+    goto done;
+  }
+
+  if (findTensors (input_names, true, inputs) ||
+      findTensors (output_names, false, outputs)) {
+    ret = -3;
+    goto done;
+  }
+
+  inputTensorMeta.num_tensors = inputs.size ();
+  input_shapes.resize (inputs.size ());
+  for (size_t i = 0; i < inputs.size (); ++i) {
+    /* the rank of input tensors should be known */
+    if (getTensorInfo (inputs[i], &inputTensorMeta.info[i],
+            &input_shapes[i]) != 0) {
+      GST_ERROR ("Failed to get the info of input tensor %s\n",
+          TF_OperationName (inputs[i].oper));
+      ret = -4;
+      goto done;
+    }
+  }
+
+  session_options = TF_NewSessionOptions ();
+  session = TF_NewSession (graph, session_options, status);
+  TF_DeleteSessionOptions (session_options);
+
+  if (TF_GetCode (status) != TF_OK) {
+    GST_ERROR ("Failed to create session: %s\n", TF_Message (status));
+    session = nullptr;
+    ret = -5;
+    goto done;
+  }
+
+#if (DBG)
+  gint64 stop_time = g_get_real_time ();
+  g_message ("Model is loaded: %" G_GINT64_FORMAT, (stop_time - start_time));
+#endif
+
+done:
+  TF_DeleteStatus (status);
+  return ret;
 }
 
 /**
- * @brief	return the Dimension of Input Tensor.
- * @param[out] info Structure for tensor info.
+ * @brief	find the input or output tensors of the graph
+ * @param	names	: the names of tensors, comma-separated ("operation" or "operation:index")
+ * @param	is_input	: true to find the input tensors
+ * @param[out] tensors	: the tensors found
+ * @note	if the names are not given, the input tensors are the placeholders and
+ *        the output tensors are the outputs of the operations not consumed by others, in the order of the graph.
  * @return 0 if OK. non-zero if error.
  */
 int
-TFCore::getInputTensorDim (GstTensorsInfo * info)
+TFCore::findTensors (const std::string & names, bool is_input,
+    std::vector < TF_Output > &tensors)
 {
-  /**
-   * @todo fill here
-   */
+  TF_Operation *oper;
+  size_t pos = 0;
+
+  tensors.clear ();
+
+  if (names.empty ()) {
+    while ((oper = TF_GraphNextOperation (graph, &pos)) != nullptr) {
+      const char *op_type = TF_OperationOpType (oper);
+      int num_outputs = TF_OperationNumOutputs (oper);
+      bool consumed = false;
+
+      if (is_input) {
+        if (g_str_equal (op_type, "Placeholder"))
+          tensors.push_back ({oper, 0});
+        continue;
+      }
+
+      if (num_outputs == 0 || g_str_equal (op_type, "Placeholder") ||
+          g_str_equal (op_type, "Const"))
+        continue;
+
+      for (int i = 0; i < num_outputs; ++i) {
+        if (TF_OperationOutputNumConsumers ({oper, i}) > 0)
+          consumed = true;
+      }
+
+      if (!consumed) {
+        for (int i = 0; i < num_outputs; ++i)
+          tensors.push_back ({oper, i});
+      }
+    }
+  } else {
+    gchar **tokens = g_strsplit (names.c_str (), ",", -1);
+
+    for (guint i = 0; tokens[i] != NULL; ++i) {
+      gchar *name = g_strstrip (tokens[i]);
+      gchar *index = strrchr (name, ':');
+      int idx = 0;
+
+      if (index) {
+        *index = '\0';
+        idx = (int) g_ascii_strtoll (index + 1, NULL, 10);
+      }
+
+      oper = TF_GraphOperationByName (graph, name);
+      if (oper == nullptr || idx < 0 || idx >= TF_OperationNumOutputs (oper)) {
+        GST_ERROR ("Cannot find the tensor %s:%d in the graph\n", name, idx);
+        g_strfreev (tokens);
+        return -1;
+      }
+
+      tensors.push_back ({oper, idx});
+    }
+
+    g_strfreev (tokens);
+  }
+
+  if (tensors.empty () || tensors.size () > NNS_TENSOR_SIZE_LIMIT) {
+    GST_ERROR ("Invalid number of %s tensors: %zu\n",
+        is_input ? "input" : "output", tensors.size ());
+    return -2;
+  }
+
   return 0;
 }
 
 /**
- * @brief	return the Dimension of Output Tensor.
- * @param[out] info Structure for tensor info.
- * @return 0 if OK. non-zero if error.
+ * @brief	return the data type of the tensor
+ * @param tfType	: the defined type of Tensorflow
+ * @return the enum of defined _NNS_TYPE
+ */
+tensor_type
+TFCore::getTensorType (TF_DataType tfType)
+{
+  switch (tfType) {
+    case TF_FLOAT:
+      return _NNS_FLOAT32;
+    case TF_DOUBLE:
+      return _NNS_FLOAT64;
+    case TF_INT32:
+      return _NNS_INT32;
+    case TF_UINT32:
+      return _NNS_UINT32;
+    case TF_INT16:
+      return _NNS_INT16;
+    case TF_UINT16:
+      return _NNS_UINT16;
+    case TF_INT8:
+      return _NNS_INT8;
+    case TF_UINT8:
+      return _NNS_UINT8;
+    case TF_INT64:
+      return _NNS_INT64;
+    case TF_UINT64:
+      return _NNS_UINT64;
+    default:
+      /** @todo Support other types (e.g., TF_BOOL cannot be fed as TF_INT8) */
+      break;
+  }
+
+  return _NNS_END;
+}
+
+/**
+ * @brief	return the data type of Tensorflow
+ * @param type	: the enum of defined _NNS_TYPE
+ * @return the defined type of Tensorflow
+ */
+TF_DataType
+TFCore::getTFType (tensor_type type)
+{
+  switch (type) {
+    case _NNS_FLOAT32:
+      return TF_FLOAT;
+    case _NNS_FLOAT64:
+      return TF_DOUBLE;
+    case _NNS_INT32:
+      return TF_INT32;
+    case _NNS_UINT32:
+      return TF_UINT32;
+    case _NNS_INT16:
+      return TF_INT16;
+    case _NNS_UINT16:
+      return TF_UINT16;
+    case _NNS_INT8:
+      return TF_INT8;
+    case _NNS_UINT8:
+      return TF_UINT8;
+    case _NNS_INT64:
+      return TF_INT64;
+    case _NNS_UINT64:
+      return TF_UINT64;
+    default:
+      break;
+  }
+
+  return TF_FLOAT;
+}
+
+/**
+ * @brief	return the info of the tensor in the graph
+ * @param tensor	: the tensor of the graph
+ * @param[out] info	: the tensor info. the unknown dimension (e.g., batch) is 1.
+ * @param[out] shape	: the shape to feed the tensor, outermost first. nullptr if not needed.
+ * @return 0 if OK. 1 if the shape is not known. negative if error.
  */
 int
-TFCore::getOutputTensorDim (GstTensorsInfo * info)
+TFCore::getTensorInfo (TF_Output tensor, GstTensorInfo * info,
+    std::vector < int64_t > *shape)
 {
-  /**
-   * @todo fill here
-   */
-  return 0;
+  TF_Status *status = TF_NewStatus ();
+  int num_dims;
+  int ret = 0;
+
+  info->type = getTensorType (TF_OperationOutputType (tensor));
+  if (info->type == _NNS_END) {
+    GST_ERROR ("Not supported type of tensor %s\n",
+        TF_OperationName (tensor.oper));
+    TF_DeleteStatus (status);
+    return -1;
+  }
+
+  num_dims = TF_GraphGetTensorNumDims (graph, tensor, status);
+  if (TF_GetCode (status) != TF_OK || num_dims < 0) {
+    TF_DeleteStatus (status);
+    return 1;
+  }
+
+  if (num_dims > NNS_TENSOR_RANK_LIMIT) {
+    GST_ERROR ("The rank of tensor %s is larger than %d\n",
+        TF_OperationName (tensor.oper), NNS_TENSOR_RANK_LIMIT);
+    TF_DeleteStatus (status);
+    return -2;
+  }
+
+  std::vector < int64_t > dims (num_dims);
+  TF_GraphGetTensorShape (graph, tensor, dims.data (), num_dims, status);
+  if (TF_GetCode (status) != TF_OK) {
+    GST_ERROR ("Failed to get the shape of tensor %s: %s\n",
+        TF_OperationName (tensor.oper), TF_Message (status));
+    TF_DeleteStatus (status);
+    return -3;
+  }
+  TF_DeleteStatus (status);
+
+  /* the order of dimension is reversed at CAPS negotiation */
+  for (int i = 0; i < NNS_TENSOR_RANK_LIMIT; ++i)
+    info->dimension[i] = 1;
+
+  for (int i = 0; i < num_dims; ++i) {
+    if (dims[i] < 0) {
+      dims[i] = 1;
+      ret = 1;
+    }
+    info->dimension[num_dims - 1 - i] = dims[i];
+  }
+
+  if (shape) {
+    *shape = dims;
+    /* the unknown dimension of input tensors is fed as 1 */
+    ret = 0;
+  }
+
+  return ret;
 }
 
 /**
- * @brief	return the Dimension of Tensor.
- * @param tensor_idx	: the real index of model of the tensor
- * @param[out] dim	: the array of the tensor
- * @param[out] type	: the data type of the tensor
+ * @brief extract and store the information of output tensors
+ * @note	if the shape of output tensors is not known in the graph (e.g., the batch is unknown),
+ *        the model is invoked once with zero-filled input tensors to get the shape.
  * @return 0 if OK. non-zero if error.
  */
 int
-TFCore::getTensorDim (tensor_dim dim, tensor_type * type)
+TFCore::setOutputTensorProp ()
 {
+  bool known = true;
+  int ret = 0;
+
+  outputTensorMeta.num_tensors = outputs.size ();
+  for (size_t i = 0; i < outputs.size (); ++i) {
+    ret = getTensorInfo (outputs[i], &outputTensorMeta.info[i], nullptr);
+    if (ret < 0)
+      return -1;
+    if (ret > 0)
+      known = false;
+  }
+  ret = 0;
+
+  if (!known) {
+    GstTensorMemory input[NNS_TENSOR_SIZE_LIMIT];
+    GstTensorMemory output[NNS_TENSOR_SIZE_LIMIT];
+    TF_Tensor *output_tensors[NNS_TENSOR_SIZE_LIMIT];
+    std::vector < std::vector < uint8_t >> zeros (inputs.size ());
+
+    for (size_t i = 0; i < inputs.size (); ++i) {
+      input[i].size = gst_tensor_info_get_size (&inputTensorMeta.info[i]);
+      input[i].type = inputTensorMeta.info[i].type;
+      zeros[i].resize (input[i].size);
+      input[i].data = zeros[i].data ();
+    }
+
+    /* the size of output tensors is not checked (0) */
+    for (size_t i = 0; i < outputs.size (); ++i)
+      output[i].size = 0;
+
+    if (invoke (input, output, output_tensors))
+      return -2;
 
+    for (size_t i = 0; i < outputs.size (); ++i) {
+      int num_dims = TF_NumDims (output_tensors[i]);
+
+      if (num_dims <= NNS_TENSOR_RANK_LIMIT) {
+        for (int d = 0; d < NNS_TENSOR_RANK_LIMIT; ++d)
+          outputTensorMeta.info[i].dimension[d] = 1;
+        for (int d = 0; d < num_dims; ++d)
+          outputTensorMeta.info[i].dimension[num_dims - 1 - d] =
+              TF_Dim (output_tensors[i], d);
+      } else {
+        GST_ERROR ("The rank of output tensor %zu is larger than %d\n", i,
+            NNS_TENSOR_RANK_LIMIT);
+        ret = -3;
+      }
+
+      TF_DeleteTensor (output_tensors[i]);
+    }
+
+    if (ret < 0)
+      return ret;
+  }
+
+#if (DBG)
+  for (int i = 0; i < outputTensorMeta.num_tensors; ++i) {
+    gchar *dim_str =
+        get_tensor_dimension_string (outputTensorMeta.info[i].dimension);
+    g_message ("outputTensorMeta[%d] >> type:%d, dim[%s]",
+        i, outputTensorMeta.info[i].type, dim_str);
+    g_free (dim_str);
+  }
+#endif
   return 0;
 }
 
@@ -132,7 +493,7 @@ TFCore::getTensorDim (tensor_dim dim, tensor_type * type)
 int
 TFCore::getInputTensorSize ()
 {
-  return input_size;
+  return inputTensorMeta.num_tensors;
 }
 
 /**
@@ -142,25 +503,135 @@ TFCore::getInputTensorSize ()
 int
 TFCore::getOutputTensorSize ()
 {
-  return output_size;
+  return outputTensorMeta.num_tensors;
+}
+
+/**
+ * @brief	return the Dimension of Input Tensor.
+ * @param[out] info Structure for tensor info.
+ * @return 0 if OK. non-zero if error.
+ */
+int
+TFCore::getInputTensorDim (GstTensorsInfo * info)
+{
+  info->num_tensors = inputTensorMeta.num_tensors;
+  memcpy (info->info, inputTensorMeta.info,
+      sizeof (GstTensorInfo) * inputTensorMeta.num_tensors);
+  return 0;
+}
+
+/**
+ * @brief	return the Dimension of Output Tensor.
+ * @param[out] info Structure for tensor info.
+ * @return 0 if OK. non-zero if error.
+ */
+int
+TFCore::getOutputTensorDim (GstTensorsInfo * info)
+{
+  info->num_tensors = outputTensorMeta.num_tensors;
+  memcpy (info->info, outputTensorMeta.info,
+      sizeof (GstTensorInfo) * outputTensorMeta.num_tensors);
+  return 0;
+}
+
+/**
+ * @brief	the deallocator of input tensors, which do nothing.
+ * @note	the memory of input tensors is owned by the input buffer.
+ */
+static void
+tf_core_noopDeallocator (void *data, size_t len, void *arg)
+{
+  /* do nothing */
 }
 
 /**
  * @brief	run the model with the input.
  * @param[in] input : The array of input tensors
- * @param[out]  output : The array of output tensors
+ * @param[in] output : The array of output tensors, with the expected size (0 not to check the size)
+ * @param[out] output_tensors : The output tensors allocated by tensorflow. The caller should delete them.
+ * @note	the input tensors wrap the memory of input buffer without copy (tensorflow copies the memory if not aligned).
+ *        tensorflow may forward the memory of an input tensor to the output (e.g., Identity and Reshape),
+ *        then the output tensor refers to the memory of input buffer; see tf_core_invoke.
+ *        this may be called from multiple threads, the session is thread-safe.
  * @return 0 if OK. non-zero if error.
  */
 int
-TFCore::invoke (const GstTensorMemory * input, GstTensorMemory * output)
+TFCore::invoke (const GstTensorMemory * input, GstTensorMemory * output,
+    TF_Tensor ** output_tensors)
 {
+#if (DBG)
+  gint64 start_time = g_get_real_time ();
+#endif
+  TF_Tensor *input_tensors[NNS_TENSOR_SIZE_LIMIT];
+  TF_Status *status;
+  int num_inputs = getInputTensorSize ();
+  int num_outputs = getOutputTensorSize ();
+  int ret = 0;
+
+  for (int i = 0; i < num_inputs; ++i) {
+    if (input[i].size != gst_tensor_info_get_size (&inputTensorMeta.info[i])) {
+      GST_ERROR ("The size of input tensor %d is not matched\n", i);
+      for (int j = 0; j < i; ++j)
+        TF_DeleteTensor (input_tensors[j]);
+      return -1;
+    }
+
+    input_tensors[i] =
+        TF_NewTensor (getTFType (inputTensorMeta.info[i].type),
+        input_shapes[i].data (), input_shapes[i].size (), input[i].data,
+        input[i].size, tf_core_noopDeallocator, nullptr);
+  }
+
+  status = TF_NewStatus ();
+  TF_SessionRun (session, nullptr, inputs.data (), input_tensors, num_inputs,
+      outputs.data (), output_tensors, num_outputs, nullptr, 0, nullptr,
+      status);
+
+  for (int i = 0; i < num_inputs; ++i)
+    TF_DeleteTensor (input_tensors[i]);
+
+  if (TF_GetCode (status) != TF_OK) {
+    GST_ERROR ("Failed to invoke: %s\n", TF_Message (status));
+    TF_DeleteStatus (status);
+    return -2;
+  }
+  TF_DeleteStatus (status);
+
+  for (int i = 0; i < num_outputs; ++i) {
+    if (output[i].size != 0 &&
+        TF_TensorByteSize (output_tensors[i]) != output[i].size) {
+      GST_ERROR ("The size of output tensor %d is not matched\n", i);
+      ret = -3;
+    }
+  }
+
+  if (ret) {
+    for (int i = 0; i < num_outputs; ++i)
+      TF_DeleteTensor (output_tensors[i]);
+    return ret;
+  }
+
+#if (DBG)
+  gint64 stop_time = g_get_real_time ();
+  g_message ("Invoke() is finished: %" G_GINT64_FORMAT,
+      (stop_time - start_time));
+#endif
+
   return 0;
 }
 
-extern void *
-tf_core_new (const char *_model_path)
+/**
+ * @brief	call the creator of TFCore class.
+ * @param	_model_path	: the logical path to '{model_name}.pb' file
+ * @param	_input_names	: the names of input tensors, comma-separated. NULL to find the placeholders
+ * @param	_output_names	: the names of output tensors, comma-separated. NULL to find the operations not consumed by others
+ * @return	TFCore class
+ */
+void *
+tf_core_new (const char *_model_path, const char *_input_names,
+    const char *_output_names)
 {
-  return new TFCore (_model_path);
+  return new TFCore (_model_path, _input_names, _output_names);
 }
 
 /**
@@ -168,19 +639,31 @@ tf_core_new (const char *_model_path)
  * @param	tf	: the class object
  * @return	Nothing
  */
-extern void
+void
 tf_core_delete (void *tf)
 {
   TFCore *c = (TFCore *) tf;
   delete c;
 }
 
+/**
+ * @brief	initialize the object with tensorflow model
+ * @param	tf	: the class object
+ * @return 0 if OK. non-zero if error.
+ */
+int
+tf_core_init (void *tf)
+{
+  TFCore *c = (TFCore *) tf;
+  return c->init ();
+}
+
 /**
  * @brief	get model path
  * @param	tf	: the class object
  * @return	model path
  */
-extern const char *
+const char *
 tf_core_getModelPath (void *tf)
 {
   TFCore *c = (TFCore *) tf;
@@ -237,17 +720,77 @@ tf_core_getOutputSize (void *tf)
   return c->getOutputTensorSize ();
 }
 
+/**
+ * @brief	check whether the memory is in the input tensors
+ * @param	c	: the class object
+ * @param[in] input : The array of input tensors
+ * @param	data	: the memory to be checked
+ * @return TRUE if the memory is in the input tensors
+ */
+static gboolean
+tf_core_isInputMemory (TFCore * c, const GstTensorMemory * input,
+    const void *data)
+{
+  const uint8_t *ptr = (const uint8_t *) data;
+
+  for (int i = 0; i < c->getInputTensorSize (); ++i) {
+    const uint8_t *start = (const uint8_t *) input[i].data;
+
+    if (ptr >= start && ptr < start + input[i].size)
+      return TRUE;
+  }
+
+  return FALSE;
+}
+
 /**
  * @brief	invoke the model
  * @param	tf	: the class object
  * @param[in] input : The array of input tensors
- * @param[out]  output : The array of output tensors
+ * @param[out]  output : The array of output tensors, the memory of the tensors allocated by tensorflow.
+ *        the memory forwarded from the input tensors is copied.
+ * @param[out]  release : The array of callbacks to release the output tensors
+ * @param[out]  user_data : The array of the output tensors of tensorflow, to be released
  * @return 0 if OK. non-zero if error.
  */
 int
 tf_core_invoke (void *tf, const GstTensorMemory * input,
-    GstTensorMemory * output)
+    GstTensorMemory * output, GDestroyNotify * release, void **user_data)
 {
   TFCore *c = (TFCore *) tf;
-  return c->invoke (input, output);
+  TF_Tensor *output_tensors[NNS_TENSOR_SIZE_LIMIT];
+  int ret;
+
+  ret = c->invoke (input, output, output_tensors);
+  if (ret)
+    return ret;
+
+  for (int i = 0; i < c->getOutputTensorSize (); ++i) {
+    output[i].data = TF_TensorData (output_tensors[i]);
+    output[i].size = TF_TensorByteSize (output_tensors[i]);
+    release[i] = tf_core_releaseTensor;
+    user_data[i] = output_tensors[i];
+
+    /* the memory of input buffer forwarded to the output, released by upstream after invoke */
+    if (tf_core_isInputMemory (c, input, output[i].data)) {
+      output[i].data = g_memdup (output[i].data, output[i].size);
+      TF_DeleteTensor (output_tensors[i]);
+      release[i] = g_free;
+      user_data[i] = output[i].data;
+    }
+  }
+
+  return 0;
+}
+
+/**
+ * @brief	release the output tensor of tensorflow
+ * @param	tensor	: the output tensor (TF_Tensor)
+ * @note	this may be called after the model is closed.
+ * @return	Nothing
+ */
+void
+tf_core_releaseTensor (void *tensor)
+{
+  TF_DeleteTensor ((TF_Tensor *) tensor);
 }
@@ -29,16 +29,16 @@
 #ifdef __cplusplus
 #include <iostream>
 #include <stdint.h>
+#include <vector>
+#include <string>
 #include <glib.h>
 
-#include <tensorflow/core/platform/init_main.h>
-#include <tensorflow/core/public/session.h>
-#include <tensorflow/core/framework/tensor_shape.h>
+#include <tensorflow/c/c_api.h>
 
 #include <tensor_common.h>
 
 /**
- * @brief	ring cache structure
+ * @brief	the tensorflow model (frozen graph) with a long-lived session
  */
 class TFCore
 {
@@ -46,40 +46,44 @@ public:
   /**
    * member functions.
    */
-  TFCore (const char *_model_path);
+  TFCore (const char *_model_path, const char *_input_names,
+      const char *_output_names);
    ~TFCore ();
 
-  /**
-   * @brief	get the model path.
-   * @return	saved model path.
-   */
-  const char *getModelPath ()
-  {
-    return model_path;
-  }
+  int init ();
   int loadModel ();
-  const char *getInputTensorName ();
-  const char *getOutputTensorName ();
-
+  const char *getModelPath ();
   int getInputTensorSize ();
   int getOutputTensorSize ();
   int getInputTensorDim (GstTensorsInfo * info);
   int getOutputTensorDim (GstTensorsInfo * info);
-  int getInputTensorDimSize ();
-  int getOutputTensorDimSize ();
-  int invoke (const GstTensorMemory * input, GstTensorMemory * output);
+  int invoke (const GstTensorMemory * input, GstTensorMemory * output,
+      TF_Tensor ** output_tensors);
 
 private:
   /**
    * member variables.
    */
-  const char *model_path;
-  int tensor_size;
-  int node_size;
-  int input_size;
-  int output_size;
-  int getTensorType (int tensor_idx, tensor_type * type);
-  int getTensorDim (tensor_dim dim, tensor_type * type);
+  std::string model_path; /**< The path of the model, copied because the property may be changed */
+  std::string input_names; /**< The names of input tensors, comma-separated. Empty to find the placeholders */
+  std::string output_names; /**< The names of output tensors, comma-separated. Empty to find the operations not consumed */
+
+  GstTensorsInfo inputTensorMeta;  /**< The tensor info of input tensors */
+  GstTensorsInfo outputTensorMeta;  /**< The tensor info of output tensors */
+
+  TF_Graph *graph; /**< The graph imported from the model */
+  TF_Session *session; /**< The session, kept while the model is loaded */
+  std::vector < TF_Output > inputs; /**< The input tensors of the graph */
+  std::vector < TF_Output > outputs; /**< The output tensors of the graph */
+  std::vector < std::vector < int64_t >> input_shapes; /**< The shape of input tensors to feed, outermost first */
+
+  int findTensors (const std::string & names, bool is_input,
+      std::vector < TF_Output > &tensors);
+  int getTensorInfo (TF_Output tensor, GstTensorInfo * info,
+      std::vector < int64_t > *shape);
+  int setOutputTensorProp ();
+  tensor_type getTensorType (TF_DataType tfType);
+  TF_DataType getTFType (tensor_type type);
 };
 
 /**
@@ -89,14 +93,18 @@ extern "C"
 {
 #endif
 
-  extern void *tf_core_new (const char *_model_path);
+  extern void *tf_core_new (const char *_model_path, const char *_input_names,
+      const char *_output_names);
   extern void tf_core_delete (void *tf);
+  extern int tf_core_init (void *tf);
   extern const char *tf_core_getModelPath (void *tf);
   extern int tf_core_getInputDim (void *tf, GstTensorsInfo * info);
   extern int tf_core_getOutputDim (void *tf, GstTensorsInfo * info);
   extern int tf_core_getInputSize (void *tf);
   extern int tf_core_getOutputSize (void *tf);
-  extern int tf_core_invoke (void *tf, const GstTensorMemory * input, GstTensorMemory * output);
+  extern int tf_core_invoke (void *tf, const GstTensorMemory * input,
+      GstTensorMemory * output, GDestroyNotify * release, void **user_data);
+  extern void tf_core_releaseTensor (void *tensor);
 
 #ifdef __cplusplus
 }
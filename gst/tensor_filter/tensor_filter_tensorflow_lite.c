@@ -31,15 +31,110 @@
 #include <glib.h>
 #include <string.h>
 
+/**
+ * @brief Options of tensorflow lite from the custom property
+ */
+typedef struct
+{
+  int num_interpreters; /**< the number of interpreters to invoke the model concurrently */
+  int num_threads; /**< the number of threads of each interpreter (0 for the default of tensorflow lite) */
+  int use_nnapi; /**< 1 to delegate the model to NNAPI */
+  int num_shapes; /**< the number of input shapes to keep the interpreters prepared (0 for the fixed input shape of the model) */
+} tflite_option;
+
 /**
  * @brief internal data of tensorflow lite
  */
 struct _Tflite_data
 {
   void *tflite_private_data;
+  tflite_option option; /**< the options the model is loaded with */
 };
 typedef struct _Tflite_data tflite_data;
 
+/**
+ * @brief Parse the custom property of tensorflow lite.
+ * @param filter : tensor_filter instance
+ * @param[out] option : the parsed options
+ *
+ * The custom property is a comma-separated list of Key:Value.
+ * e.g., custom=NumInterpreters:4,NumThreads:2,Delegate:NNAPI
+ *
+ * With NumShapes:N (N > 0), the input dimension is given by caps (setInputDimension),
+ * and the interpreters are kept prepared for up to N input shapes.
+ */
+static void
+tflite_parseCustomOption (const GstTensorFilter * filter,
+    tflite_option * option)
+{
+  gchar **options;
+  gchar **pair;
+  gint64 val;
+  guint i;
+
+  option->num_interpreters = 1;
+  option->num_threads = 0;
+  option->use_nnapi = 0;
+  option->num_shapes = 0;
+
+  if (filter->prop.custom_properties == NULL)
+    return;
+
+  options = g_strsplit (filter->prop.custom_properties, ",", -1);
+
+  for (i = 0; options[i] != NULL; i++) {
+    pair = g_strsplit (options[i], ":", 2);
+
+    if (pair[0] == NULL || pair[1] == NULL) {
+      g_strfreev (pair);
+      continue;
+    }
+
+    g_strstrip (pair[0]);
+    g_strstrip (pair[1]);
+
+    if (g_ascii_strcasecmp (pair[0], "NumInterpreters") == 0) {
+      val = g_ascii_strtoll (pair[1], NULL, 10);
+
+      if (val > 0 && val <= G_MAXINT) {
+        option->num_interpreters = (int) val;
+      } else {
+        GST_WARNING ("Invalid number of interpreters: %s", pair[1]);
+      }
+    } else if (g_ascii_strcasecmp (pair[0], "NumThreads") == 0) {
+      val = g_ascii_strtoll (pair[1], NULL, 10);
+
+      if (val > 0 && val <= G_MAXINT) {
+        option->num_threads = (int) val;
+      } else {
+        GST_WARNING ("Invalid number of threads: %s", pair[1]);
+      }
+    } else if (g_ascii_strcasecmp (pair[0], "NumShapes") == 0) {
+      val = g_ascii_strtoll (pair[1], NULL, 10);
+
+      if (val >= 0 && val <= G_MAXINT) {
+        option->num_shapes = (int) val;
+      } else {
+        GST_WARNING ("Invalid number of input shapes: %s", pair[1]);
+      }
+    } else if (g_ascii_strcasecmp (pair[0], "Delegate") == 0) {
+      if (g_ascii_strcasecmp (pair[1], "NNAPI") == 0) {
+        option->use_nnapi = 1;
+      } else if (g_ascii_strcasecmp (pair[1], "CPU") == 0 ||
+          g_ascii_strcasecmp (pair[1], "None") == 0) {
+        option->use_nnapi = 0;
+      } else {
+        GST_WARNING ("Delegate %s is not available, fall back to CPU.",
+            pair[1]);
+      }
+    }
+
+    g_strfreev (pair);
+  }
+
+  g_strfreev (options);
+}
+
 
 /**
  * @brief Free privateData and move on.
@@ -67,11 +162,21 @@ static int
 tflite_loadModelFile (const GstTensorFilter * filter, void **private_data)
 {
   tflite_data *tf;
+  tflite_option option;
+  gpointer saved;
+  int ret;
+
+  tflite_parseCustomOption (filter, &option);
+
   if (filter->privateData != NULL) {
     /** @todo : Check the integrity of filter->data and filter->model_file, nnfw */
     tf = *private_data;
     if (strcmp (filter->prop.model_file,
-            tflite_core_getModelPath (tf->tflite_private_data))) {
+            tflite_core_getModelPath (tf->tflite_private_data)) ||
+        option.num_interpreters != tf->option.num_interpreters ||
+        option.num_threads != tf->option.num_threads ||
+        option.use_nnapi != tf->option.use_nnapi ||
+        option.num_shapes != tf->option.num_shapes) {
       tflite_close (filter, private_data);
     } else {
       return 1;
@@ -79,9 +184,21 @@ tflite_loadModelFile (const GstTensorFilter * filter, void **private_data)
   }
   tf = g_new0 (tflite_data, 1); /** initialize tf Fill Zero! */
   *private_data = tf;
-  tf->tflite_private_data = tflite_core_new (filter->prop.model_file);
+  tf->option = option;
+  tf->tflite_private_data =
+      tflite_core_new (filter->prop.model_file, option.num_interpreters,
+      option.num_threads, option.use_nnapi, option.num_shapes);
   if (tf->tflite_private_data) {
-    if (tflite_core_init (tf->tflite_private_data))
+    /**
+     * The thread pool of the interpreters inherits the CPU affinity and the priority of the thread creating it.
+     * The pool created lazily by invoke is pinned with the invoke thread by tensor_filter.
+     */
+    gst_tensor_thread_pin (filter->prop.cpu_affinity,
+        filter->prop.thread_priority, &saved);
+    ret = tflite_core_init (tf->tflite_private_data);
+    gst_tensor_thread_restore (saved);
+
+    if (ret)
       return -2;
     return 0;
   } else {
@@ -114,13 +231,33 @@ tflite_invoke (const GstTensorFilter * filter, void **private_data,
   tflite_data *tf;
   tf = *private_data;
   g_assert (filter->privateData && *private_data == filter->privateData);
-  retval = tflite_core_invoke (tf->tflite_private_data, input, output);
+  retval = tflite_core_invoke (tf->tflite_private_data,
+      &filter->prop.input_meta, input, output);
   g_assert (retval == 0);
   return retval;
 }
 
+/**
+ * @brief The optional callback for GstTensorFilterFramework, invoke a batch of frames
+ * @param[in] input The array of input tensors of all frames
+ * @param[out] output The array of output tensors of all frames
+ * @param[in] batch The number of frames
+ * @return 0 if OK. non-zero if error.
+ */
+static int
+tflite_invoke_batch (const GstTensorFilter * filter, void **private_data,
+    const GstTensorMemory * input, GstTensorMemory * output, guint batch)
+{
+  tflite_data *tf;
+  tf = *private_data;
+  g_assert (filter->privateData && *private_data == filter->privateData);
+  return tflite_core_invokeBatch (tf->tflite_private_data,
+      &filter->prop.input_meta, input, output, batch);
+}
+
 /**
  * @brief The optional callback for GstTensorFilterFramework
+ * @note The input dimension is not fixed with NumShapes, given by caps.
  */
 static int
 tflite_getInputDim (const GstTensorFilter * filter, void **private_data,
@@ -129,12 +266,15 @@ tflite_getInputDim (const GstTensorFilter * filter, void **private_data,
   tflite_data *tf;
   tf = *private_data;
   g_assert (filter->privateData && *private_data == filter->privateData);
+  if (tf->option.num_shapes > 0)
+    return -1;
   int ret = tflite_core_getInputDim (tf->tflite_private_data, info);
   return ret;
 }
 
 /**
  * @brief The optional callback for GstTensorFilterFramework
+ * @note The output dimension is not fixed with NumShapes, given by setInputDimension.
  */
 static int
 tflite_getOutputDim (const GstTensorFilter * filter, void **private_data,
@@ -143,17 +283,38 @@ tflite_getOutputDim (const GstTensorFilter * filter, void **private_data,
   tflite_data *tf;
   tf = *private_data;
   g_assert (filter->privateData && *private_data == filter->privateData);
+  if (tf->option.num_shapes > 0)
+    return -1;
   int ret = tflite_core_getOutputDim (tf->tflite_private_data, info);
   return ret;
 }
 
+/**
+ * @brief The optional callback for GstTensorFilterFramework, reshape the input tensors
+ * @param[in] in_info The input tensors info
+ * @param[out] out_info The output tensors info for the input tensors
+ * @return 0 if OK. non-zero if error.
+ */
+static int
+tflite_setInputDim (const GstTensorFilter * filter, void **private_data,
+    const GstTensorsInfo * in_info, GstTensorsInfo * out_info)
+{
+  tflite_data *tf;
+  tf = *private_data;
+  g_assert (filter->privateData && *private_data == filter->privateData);
+  return tflite_core_setInputDim (tf->tflite_private_data, in_info, out_info);
+}
+
 GstTensorFilterFramework NNS_support_tensorflow_lite = {
   .name = "tensorflow-lite",
   .allow_in_place = FALSE,      /** @todo: support this to optimize performance later. */
   .allocate_in_invoke = FALSE,
+  .allow_concurrent_invoke = TRUE,      /* each invoke leases an interpreter (custom=NumInterpreters:N) */
   .invoke_NN = tflite_invoke,
+  .invoke_batch_NN = tflite_invoke_batch,
   .getInputDimension = tflite_getInputDim,
   .getOutputDimension = tflite_getOutputDim,
+  .setInputDimension = tflite_setInputDim,
   .open = tflite_open,
   .close = tflite_close,
 };
@@ -22,6 +22,7 @@
  */
 
 #include <sys/time.h>
+#include <sys/stat.h>
 #include <unistd.h>
 #include <algorithm>
 
@@ -34,15 +35,28 @@
 #define DBG FALSE
 #endif
 
+std::mutex TFLiteCore::cache_lock;
+std::map < std::string, std::weak_ptr < tflite::FlatBufferModel >>
+    TFLiteCore::model_cache;
+
 /**
  * @brief	TFLiteCore creator
  * @param	_model_path	: the logical path to '{model_name}.tffile' file
+ * @param	_num_interpreters	: the number of interpreters to invoke the model concurrently
+ * @param	_num_threads	: the number of threads of each interpreter (0 for the default)
+ * @param	_use_nnapi	: delegate the model to NNAPI
+ * @param	_num_shapes	: the number of input shapes to keep the interpreters prepared (0 for the fixed input shape)
  * @note	the model of _model_path will be loaded simultaneously
  * @return	Nothing
  */
-TFLiteCore::TFLiteCore (const char *_model_path)
+TFLiteCore::TFLiteCore (const char *_model_path, int _num_interpreters,
+    int _num_threads, bool _use_nnapi, int _num_shapes)
 {
   model_path = _model_path;
+  num_interpreters = MAX (_num_interpreters, 1);
+  num_threads = MAX (_num_threads, 0);
+  use_nnapi = _use_nnapi;
+  num_shapes = MAX (_num_shapes, 0);
 
   gst_tensors_info_init (&inputTensorMeta);
   gst_tensors_info_init (&outputTensorMeta);
@@ -54,6 +68,8 @@ TFLiteCore::TFLiteCore (const char *_model_path)
  */
 TFLiteCore::~TFLiteCore ()
 {
+  /* the interpreters refer to the model */
+  plans.clear ();
 }
 
 /**
@@ -91,9 +107,29 @@ TFLiteCore::getModelPath ()
   return model_path;
 }
 
+/**
+ * @brief	get the number of interpreters
+ * @return the number of interpreters.
+ */
+int
+TFLiteCore::getNumInterpreters ()
+{
+  return num_interpreters;
+}
+
+/**
+ * @brief	get the number of input shapes to keep the interpreters prepared
+ * @return the number of input shapes. 0 for the fixed input shape of the model.
+ */
+int
+TFLiteCore::getNumShapes ()
+{
+  return num_shapes;
+}
+
 /**
  * @brief	load the tflite model
- * @note	the model will be loaded
+ * @note	the model will be loaded once in the process, and the interpreters share it.
  * @return 0 if OK. non-zero if error.
  */
 int
@@ -103,10 +139,8 @@ TFLiteCore::loadModel ()
   gint64 start_time = g_get_real_time ();
 #endif
 
-  if (!interpreter) {
-    model =
-        std::unique_ptr < tflite::FlatBufferModel >
-        (tflite::FlatBufferModel::BuildFromFile (model_path));
+  if (plans.empty ()) {
+    model = getSharedModel (model_path);
     if (!model) {
       GST_ERROR ("Failed to mmap model\n");
       return -1;
@@ -114,13 +148,46 @@ TFLiteCore::loadModel ()
     /* If got any trouble at model, active below code. It'll be help to analyze. */
     /* model->error_reporter (); */
 
-    tflite::ops::builtin::BuiltinOpResolver resolver;
+    /* the interpreters for the input shape of the model */
+    std::shared_ptr < TFLitePlan > plan = buildPlan (nullptr);
+    if (!plan)
+      return -2;
+
+    plans.push_front (plan);
+  }
+#if (DBG)
+  gint64 stop_time = g_get_real_time ();
+  g_message ("Model is loaded with %d interpreters: %" G_GINT64_FORMAT,
+      num_interpreters, (stop_time - start_time));
+#endif
+  return 0;
+}
+
+/**
+ * @brief	build the interpreters and allocate the tensors for the input shape
+ * @param	in_info	: the input tensors info. nullptr for the input shape of the model
+ * @return	the interpreters prepared for the input shape. nullptr if error.
+ */
+std::shared_ptr < TFLitePlan >
+TFLiteCore::buildPlan (const GstTensorsInfo * in_info)
+{
+  std::shared_ptr < TFLitePlan > plan = std::make_shared < TFLitePlan > ();
+  tflite::ops::builtin::BuiltinOpResolver resolver;
+
+  for (int n = 0; n < num_interpreters; ++n) {
+    std::unique_ptr < tflite::Interpreter > interpreter;
+
     tflite::InterpreterBuilder (*model, resolver) (&interpreter);
     if (!interpreter) {
       GST_ERROR ("Failed to construct interpreter\n");
-      return -2;
+      return nullptr;
     }
 
+    if (num_threads > 0)
+      interpreter->SetNumThreads (num_threads);
+    if (use_nnapi)
+      interpreter->UseNNAPI (true);
+
     /** set allocation type to dynamic for in/out tensors */
     int tensor_idx;
 
@@ -136,18 +203,262 @@ TFLiteCore::loadModel ()
       interpreter->tensor (tensor_idx)->allocation_type = kTfLiteDynamic;
     }
 
+    /* reshape the input tensors, the order of dimension is reversed */
+    if (in_info) {
+      tensorSize = interpreter->inputs ().size ();
+      if ((int) in_info->num_tensors != tensorSize) {
+        GST_ERROR ("The number of input tensors is not matched\n");
+        return nullptr;
+      }
+
+      for (int i = 0; i < tensorSize; ++i) {
+        TfLiteTensor *tensor_ptr;
+        int len;
+
+        tensor_idx = interpreter->inputs ()[i];
+        tensor_ptr = interpreter->tensor (tensor_idx);
+        len = tensor_ptr->dims->size;
+
+        if (in_info->info[i].type != getTensorType (tensor_ptr->type)) {
+          GST_ERROR ("The type of input tensor %d is not matched\n", i);
+          return nullptr;
+        }
+
+        /* the rank of the model is kept, the remnants should be 1 */
+        for (int d = len; d < NNS_TENSOR_RANK_LIMIT; ++d) {
+          if (in_info->info[i].dimension[d] != 1) {
+            GST_ERROR ("The rank of input tensor %d is not matched\n", i);
+            return nullptr;
+          }
+        }
+
+        std::vector < int >dims (len);
+        std::reverse_copy (in_info->info[i].dimension,
+            in_info->info[i].dimension + len, dims.begin ());
+
+        if (interpreter->ResizeInputTensor (tensor_idx, dims) != kTfLiteOk) {
+          GST_ERROR ("Failed to resize input tensor %d\n", i);
+          return nullptr;
+        }
+      }
+    }
+
     if (interpreter->AllocateTensors () != kTfLiteOk) {
       GST_ERROR ("Failed to allocate tensors\n");
-      return -2;
+      return nullptr;
     }
+
+    if (in_info)
+      freeTensorData (interpreter.get ());
+
+    /* the entries are not changed after the plan is built, to be read without the lock */
+    plan->batch_buffers[interpreter.get ()] = std::vector < char > ();
+    plan->idle_interpreters.push_back (interpreter.get ());
+    plan->interpreters.push_back (std::move (interpreter));
   }
-#if (DBG)
-  gint64 stop_time = g_get_real_time ();
-  g_message ("Model is loaded: %" G_GINT64_FORMAT, (stop_time - start_time));
-#endif
+
+  tflite::Interpreter *interpreter = plan->interpreters[0].get ();
+
+  if (getTensorsInfo (interpreter, interpreter->inputs (),
+          &plan->inputTensorMeta) ||
+      getTensorsInfo (interpreter, interpreter->outputs (),
+          &plan->outputTensorMeta)) {
+    GST_ERROR ("Failed to get the tensors info\n");
+    return nullptr;
+  }
+
+  /* the model invokes a batch if the outermost dimension (batch axis) is 1 */
+  plan->batch_axis = true;
+  for (int idx : interpreter->inputs ()) {
+    TfLiteIntArray *dims = interpreter->tensor (idx)->dims;
+    if (dims->size == 0 || dims->data[0] != 1)
+      plan->batch_axis = false;
+  }
+  for (int idx : interpreter->outputs ()) {
+    TfLiteIntArray *dims = interpreter->tensor (idx)->dims;
+    if (dims->size == 0 || dims->data[0] != 1)
+      plan->batch_axis = false;
+  }
+
+  return plan;
+}
+
+/**
+ * @brief	get the model from the cache, or load the model if it is not loaded in the process.
+ * @param	path	: the path to the model file
+ * @note	the model is read-only, the objects loading the same model share it.
+ *        the model is reloaded if the file is modified.
+ * @return	the model. nullptr if error.
+ */
+std::shared_ptr < tflite::FlatBufferModel >
+TFLiteCore::getSharedModel (const char *path)
+{
+  std::lock_guard < std::mutex > lock (cache_lock);
+  std::shared_ptr < tflite::FlatBufferModel > shared;
+  struct stat st;
+
+  if (stat (path, &st) != 0) {
+    GST_ERROR ("Failed to get the status of model %s\n", path);
+    return nullptr;
+  }
+
+  std::string key = std::string (path) + ":" + std::to_string (st.st_mtime);
+
+  /* remove the models released by all objects */
+  for (auto it = model_cache.begin (); it != model_cache.end ();) {
+    if (it->second.expired ())
+      it = model_cache.erase (it);
+    else
+      ++it;
+  }
+
+  auto found = model_cache.find (key);
+  if (found != model_cache.end ()) {
+    shared = found->second.lock ();
+    if (shared)
+      return shared;
+  }
+
+  shared = std::shared_ptr < tflite::FlatBufferModel >
+      (tflite::FlatBufferModel::BuildFromFile (path));
+  if (shared)
+    model_cache[key] = shared;
+
+  return shared;
+}
+
+/**
+ * @brief	get an idle interpreter for the input tensors. wait until an interpreter is released if all interpreters are busy.
+ * @param[in] in_info : The input tensors info (of the first frame)
+ * @param[out] plan : The interpreters prepared for the input shape, which the interpreter belongs to
+ * @note	the plan is matched with the dimension and type of each input tensor, the most recently used first.
+ * @return	the interpreter to invoke the model. nullptr if the input shape is not prepared.
+ */
+tflite::Interpreter *
+TFLiteCore::leaseInterpreter (const GstTensorsInfo * in_info,
+    std::shared_ptr < TFLitePlan > &plan)
+{
+  std::unique_lock < std::mutex > lock (pool_lock);
+  tflite::Interpreter *interpreter;
+
+  plan = nullptr;
+  for (auto it = plans.begin (); it != plans.end (); ++it) {
+    if (gst_tensors_info_is_equal (&(*it)->inputTensorMeta, in_info)) {
+      plan = *it;
+      break;
+    }
+  }
+
+  if (!plan)
+    return nullptr;
+
+  /* the plan may be evicted while waiting, it is kept until released */
+  while (plan->idle_interpreters.empty ())
+    pool_cond.wait (lock);
+
+  interpreter = plan->idle_interpreters.back ();
+  plan->idle_interpreters.pop_back ();
+  return interpreter;
+}
+
+/**
+ * @brief	return the interpreter to the pool.
+ * @param	plan	: the interpreters which the interpreter belongs to
+ * @param	interpreter	: the interpreter from leaseInterpreter ()
+ */
+void
+TFLiteCore::releaseInterpreter (const std::shared_ptr < TFLitePlan > &plan,
+    tflite::Interpreter * interpreter)
+{
+  {
+    std::lock_guard < std::mutex > lock (pool_lock);
+    plan->idle_interpreters.push_back (interpreter);
+  }
+  /* the threads may wait for the interpreters of different input shapes */
+  pool_cond.notify_all ();
+}
+
+/**
+ * @brief	resize the outermost dimension of input tensors to invoke a batch of frames.
+ * @param	plan	: the interpreters which the interpreter belongs to
+ * @param	interpreter	: the interpreter from leaseInterpreter ()
+ * @param	batch	: the number of frames (1 to restore the dimension of the plan)
+ * @return 0 if OK. non-zero if error.
+ */
+int
+TFLiteCore::resizeBatch (const std::shared_ptr < TFLitePlan > &plan,
+    tflite::Interpreter * interpreter, unsigned int batch)
+{
+  TfLiteTensor *tensor_ptr;
+  int tensor_idx, len;
+  bool resized = false;
+
+  if (batch > 1 && !plan->batch_axis) {
+    GST_ERROR ("The outermost dimension of the model is not the batch axis");
+    return -1;
+  }
+
+  for (int i = 0; i < getInputTensorSize (); ++i) {
+    tensor_idx = interpreter->inputs ()[i];
+    tensor_ptr = interpreter->tensor (tensor_idx);
+    len = tensor_ptr->dims->size;
+
+    if (len == 0)
+      return -1;
+
+    /* the outermost dimension of tflite is the last one of NNStreamer */
+    std::vector<int> dims (tensor_ptr->dims->data,
+        tensor_ptr->dims->data + len);
+    dims[0] = plan->inputTensorMeta.info[i].dimension[len - 1] * batch;
+
+    if (dims[0] == tensor_ptr->dims->data[0])
+      continue;
+
+    if (interpreter->ResizeInputTensor (tensor_idx, dims) != kTfLiteOk) {
+      GST_ERROR ("Failed to resize input tensor for the batch %u", batch);
+      return -1;
+    }
+    resized = true;
+  }
+
+  if (!resized)
+    return 0;
+
+  if (interpreter->AllocateTensors () != kTfLiteOk) {
+    GST_ERROR ("Failed to allocate tensors for the batch %u", batch);
+    return -2;
+  }
+
+  freeTensorData (interpreter);
   return 0;
 }
 
+/**
+ * @brief	free the memory of in/out tensors allocated by tensorflow when the tensors are resized.
+ * @param	interpreter	: the interpreter resized
+ * @note	in/out tensors are dynamic, the memory is given for each invoke.
+ */
+void
+TFLiteCore::freeTensorData (tflite::Interpreter * interpreter)
+{
+  TfLiteTensor *tensor_ptr;
+  int tensorSize;
+
+  tensorSize = interpreter->inputs ().size ();
+  for (int i = 0; i < tensorSize; ++i) {
+    tensor_ptr = interpreter->tensor (interpreter->inputs ()[i]);
+    free (tensor_ptr->data.raw);
+    tensor_ptr->data.raw = nullptr;
+  }
+
+  tensorSize = interpreter->outputs ().size ();
+  for (int i = 0; i < tensorSize; ++i) {
+    tensor_ptr = interpreter->tensor (interpreter->outputs ()[i]);
+    free (tensor_ptr->data.raw);
+    tensor_ptr->data.raw = nullptr;
+  }
+}
+
 /**
  * @brief	return the data type of the tensor
  * @param tfType	: the defined type of Tensorflow Lite
@@ -183,24 +494,17 @@ TFLiteCore::getTensorType (TfLiteType tfType)
 int
 TFLiteCore::setInputTensorProp ()
 {
-  auto input_idx_list = interpreter->inputs ();
-  inputTensorMeta.num_tensors = input_idx_list.size ();
-
-  for (int i = 0; i < inputTensorMeta.num_tensors; ++i) {
-    if (getTensorDim (input_idx_list[i], inputTensorMeta.info[i].dimension)) {
-      return -1;
-    }
-    inputTensorMeta.info[i].type =
-        getTensorType (interpreter->tensor (input_idx_list[i])->type);
+  inputTensorMeta = plans.front ()->inputTensorMeta;
 
 #if (DBG)
+  for (int i = 0; i < inputTensorMeta.num_tensors; ++i) {
     gchar *dim_str =
         get_tensor_dimension_string (inputTensorMeta.info[i].dimension);
     g_message ("inputTensorMeta[%d] >> type:%d, dim[%s]",
         i, inputTensorMeta.info[i].type, dim_str);
     g_free (dim_str);
-#endif
   }
+#endif
   return 0;
 }
 
@@ -211,35 +515,54 @@ TFLiteCore::setInputTensorProp ()
 int
 TFLiteCore::setOutputTensorProp ()
 {
-  auto output_idx_list = interpreter->outputs ();
-  outputTensorMeta.num_tensors = output_idx_list.size ();
-
-  for (int i = 0; i < outputTensorMeta.num_tensors; ++i) {
-    if (getTensorDim (output_idx_list[i], outputTensorMeta.info[i].dimension)) {
-      return -1;
-    }
-    outputTensorMeta.info[i].type =
-        getTensorType (interpreter->tensor (output_idx_list[i])->type);
+  outputTensorMeta = plans.front ()->outputTensorMeta;
 
 #if (DBG)
+  for (int i = 0; i < outputTensorMeta.num_tensors; ++i) {
     gchar *dim_str =
         get_tensor_dimension_string (outputTensorMeta.info[i].dimension);
     g_message ("outputTensorMeta[%d] >> type:%d, dim[%s]",
         i, outputTensorMeta.info[i].type, dim_str);
     g_free (dim_str);
+  }
 #endif
+  return 0;
+}
+
+/**
+ * @brief	extract the information of the tensors.
+ * @param interpreter	: the interpreter with the allocated tensors
+ * @param tensors_idx	: the real indices of model of the tensors (inputs or outputs)
+ * @param[out] info	: the tensors info
+ * @return 0 if OK. non-zero if error.
+ */
+int
+TFLiteCore::getTensorsInfo (tflite::Interpreter * interpreter,
+    const std::vector < int > &tensors_idx, GstTensorsInfo * info)
+{
+  gst_tensors_info_init (info);
+  info->num_tensors = tensors_idx.size ();
+
+  for (int i = 0; i < info->num_tensors; ++i) {
+    if (getTensorDim (interpreter, tensors_idx[i], info->info[i].dimension)) {
+      return -1;
+    }
+    info->info[i].type =
+        getTensorType (interpreter->tensor (tensors_idx[i])->type);
   }
   return 0;
 }
 
 /**
  * @brief	return the Dimension of Tensor.
+ * @param interpreter	: the interpreter with the allocated tensors
  * @param tensor_idx	: the real index of model of the tensor
  * @param[out] dim	: the array of the tensor
  * @return 0 if OK. non-zero if error.
  */
 int
-TFLiteCore::getTensorDim (int tensor_idx, tensor_dim dim)
+TFLiteCore::getTensorDim (tflite::Interpreter * interpreter, int tensor_idx,
+    tensor_dim dim)
 {
   int len = interpreter->tensor (tensor_idx)->dims->size;
   g_assert (len <= NNS_TENSOR_RANK_LIMIT);
@@ -306,14 +629,76 @@ TFLiteCore::getOutputTensorDim (GstTensorsInfo * info)
   return 0;
 }
 
+/**
+ * @brief	reshape the input tensors, and return the output tensors info.
+ * @param[in] in_info : The input tensors info (e.g., from caps)
+ * @param[out] out_info : The output tensors info for the input shape
+ * @note	the interpreters are prepared for up to num_shapes input shapes, the least recently used is evicted.
+ *        switching between the prepared input shapes does not allocate tensors.
+ * @return 0 if OK. non-zero if error.
+ */
+int
+TFLiteCore::setInputTensorDim (const GstTensorsInfo * in_info,
+    GstTensorsInfo * out_info)
+{
+  std::shared_ptr < TFLitePlan > plan;
+
+  {
+    std::lock_guard < std::mutex > lock (pool_lock);
+
+    for (auto it = plans.begin (); it != plans.end (); ++it) {
+      if (gst_tensors_info_is_equal (&(*it)->inputTensorMeta, in_info)) {
+        /* the most recently used first */
+        plans.splice (plans.begin (), plans, it);
+        *out_info = plans.front ()->outputTensorMeta;
+        return 0;
+      }
+    }
+  }
+
+  /* the input shape of the model is fixed */
+  if (num_shapes == 0) {
+    GST_ERROR ("The input shape of the model cannot be changed\n");
+    return -1;
+  }
+
+#if (DBG)
+  gint64 start_time = g_get_real_time ();
+#endif
+
+  plan = buildPlan (in_info);
+  if (!plan)
+    return -1;
+
+  {
+    std::lock_guard < std::mutex > lock (pool_lock);
+
+    plans.push_front (plan);
+    while ((int) plans.size () > num_shapes)
+      plans.pop_back ();
+  }
+
+#if (DBG)
+  gint64 stop_time = g_get_real_time ();
+  g_message ("Input shape is prepared: %" G_GINT64_FORMAT,
+      (stop_time - start_time));
+#endif
+
+  *out_info = plan->outputTensorMeta;
+  return 0;
+}
+
 /**
  * @brief	run the model with the input.
+ * @param[in] in_info : The input tensors info
  * @param[in] input : The array of input tensors
  * @param[out]  output : The array of output tensors
+ * @note	this may be called from multiple threads. each invoke leases an idle interpreter.
  * @return 0 if OK. non-zero if error.
  */
 int
-TFLiteCore::invoke (const GstTensorMemory * input, GstTensorMemory * output)
+TFLiteCore::invoke (const GstTensorsInfo * in_info,
+    const GstTensorMemory * input, GstTensorMemory * output)
 {
 #if (DBG)
   gint64 start_time = g_get_real_time ();
@@ -322,6 +707,20 @@ TFLiteCore::invoke (const GstTensorMemory * input, GstTensorMemory * output)
   std::vector<int> tensors_idx;
   int tensor_idx;
   TfLiteTensor *tensor_ptr;
+  TfLiteStatus status;
+  std::shared_ptr < TFLitePlan > plan;
+  tflite::Interpreter *interpreter = leaseInterpreter (in_info, plan);
+
+  if (!interpreter) {
+    GST_ERROR ("The input shape is not prepared");
+    return -1;
+  }
+
+  /* restore the dimension if the interpreter has invoked a batch */
+  if (resizeBatch (plan, interpreter, 1)) {
+    releaseInterpreter (plan, interpreter);
+    return -2;
+  }
 
   for (int i = 0; i < getOutputTensorSize (); ++i) {
     tensor_idx = interpreter->outputs ()[i];
@@ -341,9 +740,12 @@ TFLiteCore::invoke (const GstTensorMemory * input, GstTensorMemory * output)
     tensors_idx.push_back (tensor_idx);
   }
 
-  if (interpreter->Invoke () != kTfLiteOk) {
-    GST_ERROR ("Failed to invoke");
-    return -3;
+  status = interpreter->Invoke ();
+  if (status != kTfLiteOk && use_nnapi) {
+    /* NNAPI is not available, fall back to CPU (this interpreter only) */
+    GST_WARNING ("Failed to invoke with NNAPI, fall back to CPU");
+    interpreter->UseNNAPI (false);
+    status = interpreter->Invoke ();
   }
 
   /** if it is not `nullptr`, tensorflow makes `free()` the memory itself. */
@@ -352,6 +754,13 @@ TFLiteCore::invoke (const GstTensorMemory * input, GstTensorMemory * output)
     interpreter->tensor (tensors_idx[i])->data.raw = nullptr;
   }
 
+  releaseInterpreter (plan, interpreter);
+
+  if (status != kTfLiteOk) {
+    GST_ERROR ("Failed to invoke");
+    return -3;
+  }
+
 #if (DBG)
   gint64 stop_time = g_get_real_time ();
   g_message ("Invoke() is finished: %" G_GINT64_FORMAT,
@@ -361,15 +770,152 @@ TFLiteCore::invoke (const GstTensorMemory * input, GstTensorMemory * output)
   return 0;
 }
 
+/**
+ * @brief	run the model once with a batch of frames.
+ * @param[in] in_info : The input tensors info of a frame
+ * @param[in] input : The array of input tensors of all frames (frame-major)
+ * @param[out]  output : The array of output tensors of all frames (frame-major)
+ * @param[in] batch : The number of frames
+ * @note	the outermost dimension of input tensors is multiplied by batch. the frames are copied into the staging buffer of the interpreter.
+ * @return 0 if OK. non-zero if error. (e.g., the model does not support the batch dimension)
+ */
+int
+TFLiteCore::invokeBatch (const GstTensorsInfo * in_info,
+    const GstTensorMemory * input, GstTensorMemory * output,
+    unsigned int batch)
+{
+#if (DBG)
+  gint64 start_time = g_get_real_time ();
+#endif
+
+  /* the offset of each tensor in the staging buffer, aligned for the kernels */
+  const size_t align = 16;
+  int num_inputs = getInputTensorSize ();
+  int num_outputs = getOutputTensorSize ();
+  std::vector < char > *staging;
+  TfLiteTensor *tensor_ptr;
+  TfLiteStatus status = kTfLiteError;
+  size_t size = 0, offset;
+  char *data;
+  int ret = 0;
+  std::shared_ptr < TFLitePlan > plan;
+  tflite::Interpreter *interpreter = leaseInterpreter (in_info, plan);
+
+  if (!interpreter) {
+    GST_ERROR ("The input shape is not prepared");
+    return -1;
+  }
+
+  /* the interpreter is leased, its staging buffer is not used by others */
+  staging = &plan->batch_buffers.at (interpreter);
+
+  if (resizeBatch (plan, interpreter, batch)) {
+    ret = -1;
+    goto done;
+  }
+
+  for (int i = 0; i < num_inputs; ++i) {
+    tensor_ptr = interpreter->tensor (interpreter->inputs ()[i]);
+
+    if (tensor_ptr->bytes != input[i].size * batch) {
+      ret = -1;
+      goto done;
+    }
+    size += (tensor_ptr->bytes + align - 1) / align * align;
+  }
+
+  for (int i = 0; i < num_outputs; ++i) {
+    tensor_ptr = interpreter->tensor (interpreter->outputs ()[i]);
+
+    /* the model should have the batch dimension in the output as well */
+    if (tensor_ptr->bytes != output[i].size * batch) {
+      GST_ERROR ("The output tensor %d does not have the batch dimension", i);
+      ret = -1;
+      goto done;
+    }
+    size += (tensor_ptr->bytes + align - 1) / align * align;
+  }
+
+  /* grown to the largest batch, and reused */
+  if (staging->size () < size)
+    staging->resize (size);
+  data = staging->data ();
+
+  for (int i = 0; i < num_inputs; ++i) {
+    tensor_ptr = interpreter->tensor (interpreter->inputs ()[i]);
+    tensor_ptr->data.raw = data;
+
+    offset = 0;
+    for (unsigned int b = 0; b < batch; ++b) {
+      memcpy (data + offset, input[b * num_inputs + i].data, input[i].size);
+      offset += input[i].size;
+    }
+    data += (tensor_ptr->bytes + align - 1) / align * align;
+  }
+
+  for (int i = 0; i < num_outputs; ++i) {
+    tensor_ptr = interpreter->tensor (interpreter->outputs ()[i]);
+    tensor_ptr->data.raw = data;
+    data += (tensor_ptr->bytes + align - 1) / align * align;
+  }
+
+  status = interpreter->Invoke ();
+  if (status != kTfLiteOk && use_nnapi) {
+    GST_WARNING ("Failed to invoke with NNAPI, fall back to CPU");
+    interpreter->UseNNAPI (false);
+    status = interpreter->Invoke ();
+  }
+  if (status != kTfLiteOk) {
+    GST_ERROR ("Failed to invoke a batch of %u frames", batch);
+    ret = -3;
+    goto done;
+  }
+
+  for (int i = 0; i < num_outputs; ++i) {
+    tensor_ptr = interpreter->tensor (interpreter->outputs ()[i]);
+
+    offset = 0;
+    for (unsigned int b = 0; b < batch; ++b) {
+      memcpy (output[b * num_outputs + i].data, tensor_ptr->data.raw + offset,
+          output[i].size);
+      offset += output[i].size;
+    }
+  }
+
+done:
+  /** if it is not `nullptr`, tensorflow makes `free()` the memory itself. */
+  for (int i = 0; i < num_inputs; ++i)
+    interpreter->tensor (interpreter->inputs ()[i])->data.raw = nullptr;
+
+  for (int i = 0; i < num_outputs; ++i)
+    interpreter->tensor (interpreter->outputs ()[i])->data.raw = nullptr;
+
+  releaseInterpreter (plan, interpreter);
+
+#if (DBG)
+  gint64 stop_time = g_get_real_time ();
+  g_message ("Invoke() with %u frames is finished: %" G_GINT64_FORMAT,
+      batch, (stop_time - start_time));
+#endif
+
+  return ret;
+}
+
 /**
  * @brief	call the creator of TFLiteCore class.
  * @param	_model_path	: the logical path to '{model_name}.tffile' file
+ * @param	_num_interpreters	: the number of interpreters to invoke the model concurrently
+ * @param	_num_threads	: the number of threads of each interpreter (0 for the default)
+ * @param	_use_nnapi	: 1 to delegate the model to NNAPI
+ * @param	_num_shapes	: the number of input shapes to keep the interpreters prepared (0 for the fixed input shape)
  * @return	TFLiteCore class
  */
 void *
-tflite_core_new (const char *_model_path)
+tflite_core_new (const char *_model_path, int _num_interpreters,
+    int _num_threads, int _use_nnapi, int _num_shapes)
 {
-  return new TFLiteCore (_model_path);
+  return new TFLiteCore (_model_path, _num_interpreters, _num_threads,
+      _use_nnapi != 0, _num_shapes);
 }
 
 /**
@@ -409,6 +955,18 @@ tflite_core_getModelPath (void *tflite)
   return c->getModelPath ();
 }
 
+/**
+ * @brief	get the number of interpreters
+ * @param	tflite	: the class object
+ * @return the number of interpreters.
+ */
+int
+tflite_core_getNumInterpreters (void *tflite)
+{
+  TFLiteCore *c = (TFLiteCore *) tflite;
+  return c->getNumInterpreters ();
+}
+
 /**
  * @brief	get the Dimension of Input Tensor of model
  * @param	tflite	: the class object
@@ -437,17 +995,51 @@ tflite_core_getOutputDim (void *tflite, GstTensorsInfo * info)
   return ret;
 }
 
+/**
+ * @brief	set the Dimension of Input Tensor of model, and get the Dimension of Output Tensor
+ * @param	tflite	: the class object
+ * @param[in] in_info Structure for input tensor info.
+ * @param[out] out_info Structure for output tensor info.
+ * @return 0 if OK. non-zero if error.
+ */
+int
+tflite_core_setInputDim (void *tflite, const GstTensorsInfo * in_info,
+    GstTensorsInfo * out_info)
+{
+  TFLiteCore *c = (TFLiteCore *) tflite;
+  return c->setInputTensorDim (in_info, out_info);
+}
+
 /**
  * @brief	invoke the model
  * @param	tflite	: the class object
+ * @param[in] in_info : The input tensors info
  * @param[in] input : The array of input tensors
  * @param[out]  output : The array of output tensors
  * @return 0 if OK. non-zero if error.
  */
 int
-tflite_core_invoke (void *tflite, const GstTensorMemory * input,
-    GstTensorMemory * output)
+tflite_core_invoke (void *tflite, const GstTensorsInfo * in_info,
+    const GstTensorMemory * input, GstTensorMemory * output)
+{
+  TFLiteCore *c = (TFLiteCore *) tflite;
+  return c->invoke (in_info, input, output);
+}
+
+/**
+ * @brief	invoke the model once with a batch of frames
+ * @param	tflite	: the class object
+ * @param[in] in_info : The input tensors info of a frame
+ * @param[in] input : The array of input tensors of all frames
+ * @param[out]  output : The array of output tensors of all frames
+ * @param[in] batch : The number of frames
+ * @return 0 if OK. non-zero if error.
+ */
+int
+tflite_core_invokeBatch (void *tflite, const GstTensorsInfo * in_info,
+    const GstTensorMemory * input, GstTensorMemory * output,
+    unsigned int batch)
 {
   TFLiteCore *c = (TFLiteCore *) tflite;
-  return c->invoke (input, output);
+  return c->invokeBatch (in_info, input, output, batch);
 }
@@ -26,6 +26,13 @@
 #ifdef __cplusplus
 #include <iostream>
 #include <stdint.h>
+#include <vector>
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+#include <mutex>
+#include <condition_variable>
 #include <glib.h>
 
 #include <tensorflow/contrib/lite/model.h>
@@ -35,38 +42,81 @@
 
 #include <tensor_common.h>
 
+/**
+ * @brief	the interpreters prepared (tensors allocated) for an input shape
+ */
+struct TFLitePlan
+{
+  GstTensorsInfo inputTensorMeta;  /**< The tensor info of input tensors */
+  GstTensorsInfo outputTensorMeta;  /**< The tensor info of output tensors */
+  std::vector < std::unique_ptr < tflite::Interpreter >> interpreters; /**< The interpreters sharing the model */
+  std::vector < tflite::Interpreter * > idle_interpreters; /**< The interpreters not being invoked */
+  bool batch_axis; /**< True if the outermost dimension of all input and output tensors is 1, to be resized for a batch of frames */
+  std::map < tflite::Interpreter *, std::vector < char >> batch_buffers; /**< The staging buffer of each interpreter, with the input and output tensors of a batch stacked. Kept for the next batch */
+};
+
 /**
  * @brief	ring cache structure
  */
 class TFLiteCore
 {
 public:
-  TFLiteCore (const char *_model_path);
+  TFLiteCore (const char *_model_path, int _num_interpreters,
+      int _num_threads, bool _use_nnapi, int _num_shapes);
   ~TFLiteCore ();
 
   int init();
   int loadModel ();
   const char* getModelPath();
+  int getNumInterpreters ();
+  int getNumShapes ();
   int setInputTensorProp ();
   int setOutputTensorProp ();
   int getInputTensorDim (GstTensorsInfo * info);
   int getOutputTensorDim (GstTensorsInfo * info);
-  int invoke (const GstTensorMemory * input, GstTensorMemory * output);
+  int setInputTensorDim (const GstTensorsInfo * in_info,
+      GstTensorsInfo * out_info);
+  int invoke (const GstTensorsInfo * in_info, const GstTensorMemory * input,
+      GstTensorMemory * output);
+  int invokeBatch (const GstTensorsInfo * in_info,
+      const GstTensorMemory * input, GstTensorMemory * output,
+      unsigned int batch);
 
 private:
 
   const char *model_path;
 
-  GstTensorsInfo inputTensorMeta;  /**< The tensor info of input tensors */
-  GstTensorsInfo outputTensorMeta;  /**< The tensor info of output tensors */
+  GstTensorsInfo inputTensorMeta;  /**< The tensor info of input tensors of the model */
+  GstTensorsInfo outputTensorMeta;  /**< The tensor info of output tensors of the model */
+
+  int num_interpreters; /**< The number of interpreters built from the model for each input shape */
+  int num_threads; /**< The number of threads of each interpreter (0 for the default) */
+  bool use_nnapi; /**< Delegate the model to NNAPI. Each interpreter falls back to CPU if NNAPI fails */
+  int num_shapes; /**< The maximum number of input shapes with the prepared interpreters (0 for the fixed input shape of the model) */
+  std::list < std::shared_ptr < TFLitePlan >> plans; /**< The interpreters prepared for each input shape, the most recently used first */
+  std::mutex pool_lock; /**< The lock for the plans and idle interpreters */
+  std::condition_variable pool_cond; /**< Signaled when an interpreter is released */
+  std::shared_ptr < tflite::FlatBufferModel > model; /**< The model, shared with other objects loading the same model */
 
-  std::unique_ptr < tflite::Interpreter > interpreter;
-  std::unique_ptr < tflite::FlatBufferModel > model;
+  static std::mutex cache_lock; /**< The lock for the model cache */
+  static std::map < std::string, std::weak_ptr < tflite::FlatBufferModel >> model_cache; /**< The models loaded in the process, keyed by the path and the modified time */
+  static std::shared_ptr < tflite::FlatBufferModel > getSharedModel (const char *path);
 
+  std::shared_ptr < TFLitePlan > buildPlan (const GstTensorsInfo * in_info);
+  tflite::Interpreter * leaseInterpreter (const GstTensorsInfo * in_info,
+      std::shared_ptr < TFLitePlan > &plan);
+  void releaseInterpreter (const std::shared_ptr < TFLitePlan > &plan,
+      tflite::Interpreter * interpreter);
+  int resizeBatch (const std::shared_ptr < TFLitePlan > &plan,
+      tflite::Interpreter * interpreter, unsigned int batch);
+  void freeTensorData (tflite::Interpreter * interpreter);
   int getInputTensorSize ();
   int getOutputTensorSize ();
   tensor_type getTensorType (TfLiteType tfType);
-  int getTensorDim (int tensor_idx, tensor_dim dim);
+  int getTensorDim (tflite::Interpreter * interpreter, int tensor_idx,
+      tensor_dim dim);
+  int getTensorsInfo (tflite::Interpreter * interpreter,
+      const std::vector < int > &tensors_idx, GstTensorsInfo * info);
 };
 
 /**
@@ -76,14 +126,22 @@ extern "C"
 {
 #endif
 
-  extern void *tflite_core_new (const char *_model_path);
+  extern void *tflite_core_new (const char *_model_path,
+      int _num_interpreters, int _num_threads, int _use_nnapi,
+      int _num_shapes);
   extern void tflite_core_delete (void *tflite);
   extern int tflite_core_init (void *tflite);
   extern const char *tflite_core_getModelPath (void *tflite);
+  extern int tflite_core_getNumInterpreters (void *tflite);
   extern int tflite_core_getInputDim (void *tflite, GstTensorsInfo * info);
   extern int tflite_core_getOutputDim (void *tflite, GstTensorsInfo * info);
-  extern int tflite_core_invoke (void *tflite, const GstTensorMemory * input,
-      GstTensorMemory * output);
+  extern int tflite_core_setInputDim (void *tflite,
+      const GstTensorsInfo * in_info, GstTensorsInfo * out_info);
+  extern int tflite_core_invoke (void *tflite, const GstTensorsInfo * in_info,
+      const GstTensorMemory * input, GstTensorMemory * output);
+  extern int tflite_core_invokeBatch (void *tflite,
+      const GstTensorsInfo * in_info, const GstTensorMemory * input,
+      GstTensorMemory * output, unsigned int batch);
 
 #ifdef __cplusplus
 }
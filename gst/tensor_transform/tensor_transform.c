@@ -55,6 +55,12 @@
 #include "transform-orc.h"
 #endif
 
+#if defined (__SSE2__)
+#include <emmintrin.h>
+#elif defined (__ARM_NEON) || defined (__ARM_NEON__)
+#include <arm_neon.h>
+#endif
+
 /**
  * @brief Macro for debug mode.
  */
@@ -118,12 +124,15 @@ static const gchar *gst_tensor_transform_mode_string[] = {
   [GTT_ARITHMETIC] = "arithmetic",
   [GTT_TRANSPOSE] = "transpose",
   [GTT_STAND] = "stand",
+  [GTT_NORMALIZE] = "normalize",
   [GTT_END] = "error"
 };
 
 static const gchar *gst_tensor_transform_stand_string[] = {
   [STAND_DEFAULT] = "default",
-  [STAND_END] = "error"
+  [STAND_DC_AVERAGE] = "dc-average",
+  [STAND_END] = "error",
+  NULL
 };
 
 static const gchar *gst_tensor_transform_operator_string[] = {
@@ -247,6 +256,8 @@ gst_tensor_transform_init (GstTensorTransform * filter)
   filter->option = NULL;
   filter->loaded = FALSE;
   filter->operators = NULL;
+  filter->stand_stats = NULL;
+  filter->stand_channels = 0;
   filter->acceleration = DEFAULT_ACCELERATION;
 #ifdef HAVE_ORC
   filter->orc_supported = FALSE;
@@ -508,86 +519,6 @@ gst_tensor_transform_get_value (GstTensorTransform * filter,
   return TRUE;
 }
 
-/**
- * @brief Macro for operator
- */
-#define handle_operator(d,v,oper,vtype) do { \
-    switch (oper) { \
-      case GTT_OP_ADD: \
-        (d)->data._##vtype += (v)->data._##vtype; \
-        break; \
-      case GTT_OP_MUL: \
-        (d)->data._##vtype *= (v)->data._##vtype; \
-        break; \
-      case GTT_OP_DIV: \
-        if ((v)->data._##vtype == 0) { \
-          GST_ERROR_OBJECT (filter, "Invalid state, denominator is 0."); \
-          return FALSE; \
-        } \
-        (d)->data._##vtype /= (v)->data._##vtype; \
-        break; \
-      default: \
-        GST_ERROR_OBJECT (filter, "Unknown operator %d", oper); \
-        return FALSE; \
-    } \
-  } while (0)
-
-/**
- * @brief Handle operators for tensor value
- * @param filter "this" pointer
- * @param desc struct for tensor value
- * @param val struct for tensor value
- * @param op operator for given tensor value
- * @return TRUE if no error
- */
-static gboolean
-gst_tensor_transform_do_operator (GstTensorTransform * filter,
-    tensor_transform_operand_s * desc, const tensor_transform_operand_s * val,
-    tensor_transform_operator op)
-{
-  g_return_val_if_fail (desc != NULL, FALSE);
-  g_return_val_if_fail (val != NULL, FALSE);
-  g_return_val_if_fail (desc->type == val->type, FALSE);
-
-  switch (desc->type) {
-    case _NNS_INT32:
-      handle_operator (desc, val, op, int32_t);
-      break;
-    case _NNS_UINT32:
-      handle_operator (desc, val, op, uint32_t);
-      break;
-    case _NNS_INT16:
-      handle_operator (desc, val, op, int16_t);
-      break;
-    case _NNS_UINT16:
-      handle_operator (desc, val, op, uint16_t);
-      break;
-    case _NNS_INT8:
-      handle_operator (desc, val, op, int8_t);
-      break;
-    case _NNS_UINT8:
-      handle_operator (desc, val, op, uint8_t);
-      break;
-    case _NNS_FLOAT64:
-      handle_operator (desc, val, op, double);
-      break;
-    case _NNS_FLOAT32:
-      handle_operator (desc, val, op, float);
-      break;
-    case _NNS_INT64:
-      handle_operator (desc, val, op, int64_t);
-      break;
-    case _NNS_UINT64:
-      handle_operator (desc, val, op, uint64_t);
-      break;
-    default:
-      GST_ERROR_OBJECT (filter, "Unknown tensor type %d", desc->type);
-      return FALSE;
-  }
-
-  return TRUE;
-}
-
 /**
  * @brief Macro for typecast
  */
@@ -723,7 +654,12 @@ gst_tensor_transform_set_option_data (GstTensorTransform * filter)
 
       filter->data_dimchg.from = a;
       filter->data_dimchg.to = b;
-      filter->loaded = TRUE;
+      filter->loaded = (a >= 0 && a < NNS_TENSOR_RANK_LIMIT &&
+          b >= 0 && b < NNS_TENSOR_RANK_LIMIT);
+      if (!filter->loaded) {
+        GST_ERROR_OBJECT (filter, "Invalid option %s, the axes should be less than %d",
+            filter->option, NNS_TENSOR_RANK_LIMIT);
+      }
       g_strfreev (strv);
       break;
     }
@@ -840,7 +776,9 @@ gst_tensor_transform_set_option_data (GstTensorTransform * filter)
     }
     case GTT_TRANSPOSE:
     {
-      int a, i;
+      guint64 a;
+      guint used = 0;
+      int i;
       gchar **strv = g_strsplit (filter->option, ":", NNS_TENSOR_RANK_LIMIT);
 
       for (i = 0; i < NNS_TENSOR_RANK_LIMIT; i++) {
@@ -848,19 +786,158 @@ gst_tensor_transform_set_option_data (GstTensorTransform * filter)
           a = g_ascii_strtoull (strv[i], NULL, 10);
         else
           a = 0;
-        filter->data_transpose.trans_order[i] = a;
+
+        /* out of range (e.g., a negative value), not a permutation */
+        if (a >= NNS_TENSOR_RANK_LIMIT) {
+          used = 0;
+          break;
+        }
+
+        filter->data_transpose.trans_order[i] = (uint8_t) a;
+        used |= (1U << a);
+      }
+
+      /* any permutation of the axes */
+      filter->loaded = (used == (1U << NNS_TENSOR_RANK_LIMIT) - 1);
+      if (!filter->loaded) {
+        GST_ERROR_OBJECT (filter,
+            "Invalid option %s, it should be a permutation of 0:1:2:3",
+            filter->option);
       }
 
-      filter->loaded = TRUE;
       g_strfreev (strv);
       break;
     }
     case GTT_STAND:
     {
-      filter->data_stand.mode =
-          gst_tensor_transform_get_stand_mode (filter->option);
-      g_assert (filter->data_stand.mode != STAND_END);
+      tensor_transform_stand *stand = &filter->data_stand;
+      gchar **strv = g_strsplit (filter->option, ";", -1);
+      gchar **kv;
+      guint i;
+
+      stand->mode = (strv[0] != NULL) ?
+          gst_tensor_transform_get_stand_mode (strv[0]) : STAND_END;
+      stand->out_type = _NNS_END;
+      stand->per_channel = FALSE;
+      stand->axis = 0;
+
+      filter->loaded = (stand->mode != STAND_END);
+      if (!filter->loaded) {
+        GST_ERROR_OBJECT (filter, "Invalid option %s, unknown stand mode",
+            filter->option);
+      }
+
+      for (i = 1; filter->loaded && strv[i] != NULL; i++) {
+        kv = g_strsplit (strv[i], ":", 2);
+
+        if (kv[0] == NULL || kv[1] == NULL) {
+          GST_ERROR_OBJECT (filter, "Invalid option %s", strv[i]);
+          filter->loaded = FALSE;
+        } else if (g_str_equal (kv[0], "axis")) {
+          stand->per_channel = TRUE;
+          stand->axis = g_ascii_strtoull (kv[1], NULL, 10);
+
+          if (stand->axis >= NNS_TENSOR_RANK_LIMIT) {
+            GST_ERROR_OBJECT (filter,
+                "Invalid option %s, the axis should be less than %d",
+                strv[i], NNS_TENSOR_RANK_LIMIT);
+            filter->loaded = FALSE;
+          }
+        } else if (g_str_equal (kv[0], "typecast")) {
+          stand->out_type = get_tensor_type (kv[1]);
+
+          if (stand->out_type == _NNS_END) {
+            GST_ERROR_OBJECT (filter, "Unknown tensor type %s", kv[1]);
+            filter->loaded = FALSE;
+          }
+        } else {
+          GST_ERROR_OBJECT (filter, "Unknown option %s", strv[i]);
+          filter->loaded = FALSE;
+        }
+
+        g_strfreev (kv);
+      }
+
+      g_strfreev (strv);
+      break;
+    }
+    case GTT_NORMALIZE:
+    {
+      tensor_transform_normalize *norm = &filter->data_normalize;
+      gchar **strv = g_strsplit (filter->option, ";", -1);
+      gchar **kv, **values;
+      double *vec;
+      guint i, j, num;
+
+      /* mean 0 and std 1 for all channels if not given */
+      norm->out_type = _NNS_END;
+      norm->axis = 0;
+      norm->num_mean = norm->num_std = 1;
+      norm->mean[0] = 0.0;
+      norm->std[0] = 1.0;
       filter->loaded = TRUE;
+
+      for (i = 0; strv[i] != NULL; i++) {
+        kv = g_strsplit (strv[i], ":", 2);
+
+        if (kv[0] == NULL || kv[1] == NULL) {
+          GST_ERROR_OBJECT (filter, "Invalid option %s", strv[i]);
+          filter->loaded = FALSE;
+        } else if (g_str_equal (kv[0], "mean") || g_str_equal (kv[0], "std")) {
+          vec = g_str_equal (kv[0], "mean") ? norm->mean : norm->std;
+          values = g_strsplit (kv[1], ",", -1);
+          num = g_strv_length (values);
+
+          if (num == 0 || num > NORMALIZE_CHANNEL_LIMIT) {
+            GST_ERROR_OBJECT (filter,
+                "Invalid option %s, the number of values should be 1 to %d",
+                strv[i], NORMALIZE_CHANNEL_LIMIT);
+            filter->loaded = FALSE;
+          } else {
+            for (j = 0; j < num; j++) {
+              vec[j] = g_ascii_strtod (values[j], NULL);
+
+              if (vec == norm->std && vec[j] == 0.0) {
+                GST_ERROR_OBJECT (filter, "Invalid option %s, std is 0",
+                    strv[i]);
+                filter->loaded = FALSE;
+              }
+            }
+
+            if (vec == norm->mean)
+              norm->num_mean = num;
+            else
+              norm->num_std = num;
+          }
+
+          g_strfreev (values);
+        } else if (g_str_equal (kv[0], "axis")) {
+          norm->axis = g_ascii_strtoull (kv[1], NULL, 10);
+
+          if (norm->axis >= NNS_TENSOR_RANK_LIMIT) {
+            GST_ERROR_OBJECT (filter,
+                "Invalid option %s, the axis should be less than %d",
+                strv[i], NNS_TENSOR_RANK_LIMIT);
+            filter->loaded = FALSE;
+          }
+        } else if (g_str_equal (kv[0], "typecast")) {
+          norm->out_type = get_tensor_type (kv[1]);
+
+          if (norm->out_type != _NNS_FLOAT32 && norm->out_type != _NNS_FLOAT64) {
+            GST_ERROR_OBJECT (filter,
+                "Invalid option %s, the type should be float32 or float64",
+                strv[i]);
+            filter->loaded = FALSE;
+          }
+        } else {
+          GST_ERROR_OBJECT (filter, "Unknown option %s", strv[i]);
+          filter->loaded = FALSE;
+        }
+
+        g_strfreev (kv);
+      }
+
+      g_strfreev (strv);
       break;
     }
     default:
@@ -959,9 +1036,355 @@ gst_tensor_transform_finalize (GObject * object)
     filter->operators = NULL;
   }
 
+  g_free (filter->stand_stats);
+  filter->stand_stats = NULL;
+
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
+/**
+ * @brief The size of the square tile to be transposed at once, which fits in L1 cache with 8-byte elements.
+ */
+#define TRANSPOSE_TILE 16
+
+/**
+ * @brief The largest size of an axis iterated inside without tiling (e.g., the channels of an image).
+ */
+#define TRANSPOSE_SMALL 4
+
+/**
+ * @brief Transpose a 4x4 block of 4-byte elements: out[r * os + c] = in[c * is + r]
+ */
+static void
+gst_tensor_transform_transpose_4x4 (const uint32_t * in, size_t is,
+    uint32_t * out, size_t os)
+{
+#if defined (__SSE2__)
+  __m128i v0, v1, v2, v3, t0, t1, t2, t3;
+
+  v0 = _mm_loadu_si128 ((const __m128i *) (in));
+  v1 = _mm_loadu_si128 ((const __m128i *) (in + is));
+  v2 = _mm_loadu_si128 ((const __m128i *) (in + 2 * is));
+  v3 = _mm_loadu_si128 ((const __m128i *) (in + 3 * is));
+
+  t0 = _mm_unpacklo_epi32 (v0, v1);
+  t1 = _mm_unpacklo_epi32 (v2, v3);
+  t2 = _mm_unpackhi_epi32 (v0, v1);
+  t3 = _mm_unpackhi_epi32 (v2, v3);
+
+  _mm_storeu_si128 ((__m128i *) (out), _mm_unpacklo_epi64 (t0, t1));
+  _mm_storeu_si128 ((__m128i *) (out + os), _mm_unpackhi_epi64 (t0, t1));
+  _mm_storeu_si128 ((__m128i *) (out + 2 * os), _mm_unpacklo_epi64 (t2, t3));
+  _mm_storeu_si128 ((__m128i *) (out + 3 * os), _mm_unpackhi_epi64 (t2, t3));
+#elif defined (__ARM_NEON) || defined (__ARM_NEON__)
+  uint32x4x2_t p, q;
+
+  p = vtrnq_u32 (vld1q_u32 (in), vld1q_u32 (in + is));
+  q = vtrnq_u32 (vld1q_u32 (in + 2 * is), vld1q_u32 (in + 3 * is));
+
+  vst1q_u32 (out, vcombine_u32 (vget_low_u32 (p.val[0]),
+          vget_low_u32 (q.val[0])));
+  vst1q_u32 (out + os, vcombine_u32 (vget_low_u32 (p.val[1]),
+          vget_low_u32 (q.val[1])));
+  vst1q_u32 (out + 2 * os, vcombine_u32 (vget_high_u32 (p.val[0]),
+          vget_high_u32 (q.val[0])));
+  vst1q_u32 (out + 3 * os, vcombine_u32 (vget_high_u32 (p.val[1]),
+          vget_high_u32 (q.val[1])));
+#else
+  size_t r, c;
+
+  for (r = 0; r < 4; r++)
+    for (c = 0; c < 4; c++)
+      out[r * os + c] = in[c * is + r];
+#endif
+}
+
+/**
+ * Macro to define the 2D transpose for each element size: out[r * os + c] = in[c * is + r], r < rows and c < cols.
+ * If an axis is small (e.g., the channels of NCHW <-> NHWC), it is iterated inside, so the other side is accessed
+ * sequentially, and 3 channels are unrolled. Otherwise, the matrix is transposed tile by tile.
+ * With block4, 4x4 blocks are transposed with SIMD.
+ */
+#define transpose2d(name,T,block4) \
+static void \
+name (const T * in, T * out, size_t rows, size_t cols, size_t is, size_t os) \
+{ \
+  size_t r, c, r0, c0, rn, cn; \
+  if (cols <= TRANSPOSE_SMALL) { \
+    r = 0; \
+    if (cols == 3) { \
+      /* interleave 3 channels (e.g., planar RGB to packed RGB) */ \
+      const T *p0 = in, *p1 = in + is, *p2 = in + 2 * is; \
+      T *o = out; \
+      for (; r < rows; r++, o += os) { \
+        o[0] = p0[r]; \
+        o[1] = p1[r]; \
+        o[2] = p2[r]; \
+      } \
+    } else if (block4 && cols == 4) { \
+      for (; r + 4 <= rows; r += 4) \
+        gst_tensor_transform_transpose_4x4 ((const uint32_t *) (in + r), is, \
+            (uint32_t *) (out + r * os), os); \
+    } \
+    for (; r < rows; r++) \
+      for (c = 0; c < cols; c++) \
+        out[r * os + c] = in[c * is + r]; \
+  } else if (rows <= TRANSPOSE_SMALL) { \
+    c = 0; \
+    if (rows == 3) { \
+      /* deinterleave 3 channels (e.g., packed RGB to planar RGB) */ \
+      const T *p = in; \
+      T *o0 = out, *o1 = out + os, *o2 = out + 2 * os; \
+      for (; c < cols; c++, p += is) { \
+        o0[c] = p[0]; \
+        o1[c] = p[1]; \
+        o2[c] = p[2]; \
+      } \
+    } else if (block4 && rows == 4) { \
+      for (; c + 4 <= cols; c += 4) \
+        gst_tensor_transform_transpose_4x4 ((const uint32_t *) (in + c * is), \
+            is, (uint32_t *) (out + c), os); \
+    } \
+    for (; c < cols; c++) \
+      for (r = 0; r < rows; r++) \
+        out[r * os + c] = in[c * is + r]; \
+  } else { \
+    for (r0 = 0; r0 < rows; r0 += TRANSPOSE_TILE) { \
+      rn = MIN (rows - r0, TRANSPOSE_TILE); \
+      for (c0 = 0; c0 < cols; c0 += TRANSPOSE_TILE) { \
+        cn = MIN (cols - c0, TRANSPOSE_TILE); \
+        r = 0; \
+        if (block4) { \
+          for (; r + 4 <= rn; r += 4) { \
+            for (c = 0; c + 4 <= cn; c += 4) \
+              gst_tensor_transform_transpose_4x4 ((const uint32_t *) \
+                  (in + (c0 + c) * is + r0 + r), is, \
+                  (uint32_t *) (out + (r0 + r) * os + c0 + c), os); \
+            for (; c < cn; c++) { \
+              out[(r0 + r) * os + c0 + c] = in[(c0 + c) * is + r0 + r]; \
+              out[(r0 + r + 1) * os + c0 + c] = in[(c0 + c) * is + r0 + r + 1]; \
+              out[(r0 + r + 2) * os + c0 + c] = in[(c0 + c) * is + r0 + r + 2]; \
+              out[(r0 + r + 3) * os + c0 + c] = in[(c0 + c) * is + r0 + r + 3]; \
+            } \
+          } \
+        } \
+        for (; r < rn; r++) \
+          for (c = 0; c < cn; c++) \
+            out[(r0 + r) * os + c0 + c] = in[(c0 + c) * is + r0 + r]; \
+      } \
+    } \
+  } \
+}
+
+/**
+ * @brief 2D transpose of 1-byte elements (see transpose2d)
+ */
+transpose2d (gst_tensor_transform_transpose_u8, uint8_t, FALSE);
+
+/**
+ * @brief 2D transpose of 2-byte elements (see transpose2d)
+ */
+transpose2d (gst_tensor_transform_transpose_u16, uint16_t, FALSE);
+
+/**
+ * @brief 2D transpose of 4-byte elements with SIMD shuffles (see transpose2d)
+ */
+transpose2d (gst_tensor_transform_transpose_u32, uint32_t, TRUE);
+
+/**
+ * @brief 2D transpose of 8-byte elements (see transpose2d)
+ */
+transpose2d (gst_tensor_transform_transpose_u64, uint64_t, FALSE);
+
+/**
+ * @brief 2D transpose of the elements of any size (e.g., the innermost axes not moved), tile by tile.
+ */
+static void
+gst_tensor_transform_transpose_any (const uint8_t * in, uint8_t * out,
+    size_t rows, size_t cols, size_t is, size_t os, size_t es)
+{
+  size_t r, c, r0, c0, rn, cn;
+
+  for (r0 = 0; r0 < rows; r0 += TRANSPOSE_TILE) {
+    rn = MIN (rows - r0, TRANSPOSE_TILE);
+    for (c0 = 0; c0 < cols; c0 += TRANSPOSE_TILE) {
+      cn = MIN (cols - c0, TRANSPOSE_TILE);
+      for (r = r0; r < r0 + rn; r++)
+        for (c = c0; c < c0 + cn; c++)
+          nns_memcpy (out + (r * os + c) * es, in + (c * is + r) * es, es);
+    }
+  }
+}
+
+/**
+ * @brief Make the plan to move the axes for the input dimension. Called when the caps is set.
+ * @param[in/out] filter "this" pointer
+ * @param[in] order the axis of input for each axis of output
+ *
+ * The axes of size 1 are removed, and the axes adjacent in both input and output are merged. If the innermost axis is
+ * not moved, it is merged into the element. Thus, NCHW <-> NHWC is a 2D transpose of (H * W) x C elements.
+ */
+static void
+gst_tensor_transform_axes_plan (GstTensorTransform * filter,
+    const uint8_t * order)
+{
+  tensor_transform_axes *plan;
+  uint32_t *dim;
+  size_t in_stride[NNS_TENSOR_RANK_LIMIT];
+  size_t stride, n;
+  guint i, r, a;
+
+  plan = &filter->axes;
+  dim = filter->in_config.info.dimension;
+
+  stride = 1;
+  for (i = 0; i < NNS_TENSOR_RANK_LIMIT; i++) {
+    in_stride[i] = stride;
+    stride *= dim[i];
+  }
+
+  /* the axes in the order of output, without the axes of size 1 */
+  r = 0;
+  stride = 1;
+  for (i = 0; i < NNS_TENSOR_RANK_LIMIT; i++) {
+    a = order[i];
+
+    if (dim[a] > 1) {
+      if (r > 0 && plan->in_stride[r - 1] * plan->size[r - 1] ==
+          in_stride[a]) {
+        /* adjacent in the input, merged */
+        plan->size[r - 1] *= dim[a];
+      } else {
+        plan->size[r] = dim[a];
+        plan->in_stride[r] = in_stride[a];
+        plan->out_stride[r] = stride;
+        r++;
+      }
+    }
+
+    stride *= dim[a];
+  }
+
+  plan->element_size = tensor_element_size[filter->in_config.info.type];
+
+  /* the innermost axis not moved is copied at once */
+  if (r > 0 && plan->in_stride[0] == 1) {
+    n = plan->size[0];
+    plan->element_size *= n;
+
+    for (i = 1; i < r; i++) {
+      plan->size[i - 1] = plan->size[i];
+      plan->in_stride[i - 1] = plan->in_stride[i] / n;
+      plan->out_stride[i - 1] = plan->out_stride[i] / n;
+    }
+    r--;
+  }
+
+  plan->rank = r;
+  silent_debug ("move %u axes with %" G_GSIZE_FORMAT "-byte elements\n", r,
+      plan->element_size);
+}
+
+/**
+ * @brief Move the axes of the input tensor with the plan. The plan should have the axes to be moved (rank > 0).
+ * @param[in] filter "this" pointer
+ * @param[in] inptr input tensor
+ * @param[out] outptr output tensor
+ */
+static void
+gst_tensor_transform_axes_move (GstTensorTransform * filter,
+    const uint8_t * inptr, uint8_t * outptr)
+{
+  const tensor_transform_axes *plan;
+  size_t idx[NNS_TENSOR_RANK_LIMIT];
+  size_t rows, cols, is, os, es, in_off, out_off;
+  guint i, b;
+
+  plan = &filter->axes;
+
+  /**
+   * The output axis 0 is contiguous in the output, and the axis b is contiguous in the input.
+   * Each 2D slice of these axes is transposed, for each index of the other axes.
+   */
+  for (b = 0; b < plan->rank; b++) {
+    if (plan->in_stride[b] == 1)
+      break;
+  }
+  g_assert (b > 0 && b < plan->rank);
+
+  es = plan->element_size;
+  cols = plan->size[0];
+  is = plan->in_stride[0];
+  rows = plan->size[b];
+  os = plan->out_stride[b];
+
+  memset (idx, 0, sizeof (idx));
+
+  do {
+    in_off = out_off = 0;
+    for (i = 1; i < plan->rank; i++) {
+      in_off += idx[i] * plan->in_stride[i];
+      out_off += idx[i] * plan->out_stride[i];
+    }
+
+    switch (es) {
+      case 1:
+        gst_tensor_transform_transpose_u8 (inptr + in_off, outptr + out_off,
+            rows, cols, is, os);
+        break;
+      case 2:
+        gst_tensor_transform_transpose_u16 ((const uint16_t *) inptr + in_off,
+            (uint16_t *) outptr + out_off, rows, cols, is, os);
+        break;
+      case 4:
+        gst_tensor_transform_transpose_u32 ((const uint32_t *) inptr + in_off,
+            (uint32_t *) outptr + out_off, rows, cols, is, os);
+        break;
+      case 8:
+        gst_tensor_transform_transpose_u64 ((const uint64_t *) inptr + in_off,
+            (uint64_t *) outptr + out_off, rows, cols, is, os);
+        break;
+      default:
+        gst_tensor_transform_transpose_any (inptr + in_off * es,
+            outptr + out_off * es, rows, cols, is, os, es);
+        break;
+    }
+
+    /* the next index of the other axes */
+    for (i = 1; i < plan->rank; i++) {
+      if (i == b)
+        continue;
+      if (++idx[i] < plan->size[i])
+        break;
+      idx[i] = 0;
+    }
+  } while (i < plan->rank);
+}
+
+/**
+ * @brief Get the axes of output for "dimchg" mode, the axis "from" is moved to "to" and the axes between are shifted.
+ * @param[in] filter "this" pointer
+ * @param[out] order the axis of input for each axis of output
+ */
+static void
+gst_tensor_transform_dimchg_order (GstTensorTransform * filter,
+    uint8_t * order)
+{
+  int from = filter->data_dimchg.from;
+  int to = filter->data_dimchg.to;
+  int i, k;
+
+  for (i = 0, k = 0; i < NNS_TENSOR_RANK_LIMIT; i++) {
+    if (i == to) {
+      order[i] = from;
+    } else {
+      if (k == from)
+        k++;
+      order[i] = k++;
+    }
+  }
+}
+
 /**
  * @brief subrouting for tensor-tranform, "dimchg" case.
  * @param[in/out] filter "this" pointer
@@ -973,19 +1396,7 @@ static GstFlowReturn
 gst_tensor_transform_dimchg (GstTensorTransform * filter,
     const uint8_t * inptr, uint8_t * outptr)
 {
-  /** @todo NYI */
-  uint32_t *fromDim = filter->in_config.info.dimension;
-  uint32_t *toDim = filter->out_config.info.dimension;
-  tensor_type in_tensor_type = filter->in_config.info.type;
-  int from = filter->data_dimchg.from;
-  int to = filter->data_dimchg.to;
-  int i, j, k;
-  unsigned int loopLimit = 1;
-  size_t loopBlockSize = tensor_element_size[in_tensor_type];
-  size_t copyblocksize = tensor_element_size[in_tensor_type];
-  size_t copyblocklimit = 1;
-
-  if (from == to) {
+  if (filter->axes.rank == 0) {
     /** Useless memcpy. Do not call this or @todo do "IP" operation */
     nns_memcpy (outptr, inptr,
         gst_tensor_info_get_size (&filter->in_config.info));
@@ -994,50 +1405,11 @@ gst_tensor_transform_dimchg (GstTensorTransform * filter,
     return GST_FLOW_OK;
   }
 
-  g_assert (from >= 0 && from < NNS_TENSOR_RANK_LIMIT);
-  g_assert (to >= 0 && to < NNS_TENSOR_RANK_LIMIT);
-  g_assert (fromDim[from] == toDim[to]);
-
-  if (from < to) {
-    /**
-     * Smaller-loop-ed a to larger-loop-ed b
-     * E.g., [N][H][W][c] (c:W:H:N) --> [N][c][H][W] (W:H:c:N)
-     *
-     * @todo CRITICAL-TODO: Optimize the performance!
-     */
-    for (i = NNS_TENSOR_RANK_LIMIT - 1; i > to; i--)
-      loopLimit *= toDim[i];
-    for (i = 0; i < to; i++)
-      loopBlockSize *= toDim[i];
-
-    for (i = 0; i < from; i++)
-      copyblocksize *= fromDim[i];
-    for (i = 0; i < to; i++)
-      copyblocklimit *= toDim[i];
-
-    for (i = 0; i < loopLimit; i++) {
-      /* [i1][i2][...][iN][b][...] i = i1 x i2 x ... x iN */
-      uint8_t *destptr = outptr + loopBlockSize * toDim[to] * i;
-      const uint8_t *srcptr = inptr + loopBlockSize * toDim[to] * i;
-
-      for (j = 0; j < toDim[to]; j++) {
-        uint8_t *j_destptr = destptr + loopBlockSize * j;
-        for (k = 0; k < copyblocklimit; k++) {
-          nns_memcpy (j_destptr + copyblocksize * k,
-              srcptr + k * copyblocksize * toDim[to] + j * copyblocksize,
-              copyblocksize);
-        }
-      }
-    }
-  } else {
-    /**
-     * Larger-loop-ed a to smaller-loop-ed b
-     * E.g., [N][c][H][W] (W:H:c:N) --> [N][H][W][c] (c:W:H:N)
-     * @todo NYI
-     */
-    g_assert (0);
-  }
-
+  /**
+   * The axis "from" is moved to "to" and the axes between are shifted, in both directions.
+   * E.g., [N][H][W][c] (c:W:H:N) <--> [N][c][H][W] (W:H:c:N) is a 2D transpose of (H * W) x c elements.
+   */
+  gst_tensor_transform_axes_move (filter, inptr, outptr);
   return GST_FLOW_OK;
 }
 
@@ -1086,140 +1458,367 @@ gst_tensor_transform_typecast (GstTensorTransform * filter,
 }
 
 /**
- * @brief subrouting for tensor-tranform, "arithmetic" case.
- * @param[in/out] filter "this" pointer
- * @param[in] inptr input tensor
- * @param[out] outptr output tensor
- * @return Gst flow status
+ * @brief The number of elements processed at once in "arithmetic" mode.
+ * A block of the output (8KB at most) stays in the cache while the operators are applied, so each element is read and written only once in memory.
  */
-static GstFlowReturn
-gst_tensor_transform_arithmetic (GstTensorTransform * filter,
-    const uint8_t * inptr, uint8_t * outptr)
-{
-  size_t num = get_tensor_element_count (filter->in_config.info.dimension);
-  tensor_type in_tensor_type = filter->in_config.info.type;
-  tensor_type out_tensor_type = filter->out_config.info.type;
-
-  GSList *walk;
-  tensor_transform_operator_s *op_s;
-  tensor_transform_operand_s value;
-  size_t i, data_idx;
-
-#ifdef HAVE_ORC
-  if (orc_supported (filter)) {
-    walk = filter->operators;
+#define ARITH_BLOCK 1024
 
-    /**
-     * Typecast should be called at the first.
-     * Do the typecast. If in/out type is same, this will copy the input array to output.
-     */
-    orc_typecast (inptr, outptr, num, in_tensor_type, out_tensor_type);
+/**
+ * @brief Macros to typecast a block of elements.
+ * Float to unsigned integer goes through the signed integer, same as gst_tensor_transform_typecast_value().
+ */
+#define arith_typecast_loop(i,o,n,itype,vtype,otype) do { \
+    const itype *_src = (const itype *) (i); \
+    otype *_dst = (otype *) (o); \
+    size_t _k; \
+    for (_k = 0; _k < (n); _k++) \
+      _dst[_k] = (otype) (vtype) _src[_k]; \
+  } while (0)
 
-    while (walk) {
-      op_s = (tensor_transform_operator_s *) walk->data;
+#define arith_typecast_to(i,o,n,itype,is_float,otype) do { \
+    switch (otype) { \
+      case _NNS_INT32: arith_typecast_loop (i, o, n, itype, int32_t, int32_t); break; \
+      case _NNS_UINT32: \
+        if (is_float) arith_typecast_loop (i, o, n, itype, int32_t, uint32_t); \
+        else arith_typecast_loop (i, o, n, itype, uint32_t, uint32_t); \
+        break; \
+      case _NNS_INT16: arith_typecast_loop (i, o, n, itype, int16_t, int16_t); break; \
+      case _NNS_UINT16: \
+        if (is_float) arith_typecast_loop (i, o, n, itype, int16_t, uint16_t); \
+        else arith_typecast_loop (i, o, n, itype, uint16_t, uint16_t); \
+        break; \
+      case _NNS_INT8: arith_typecast_loop (i, o, n, itype, int8_t, int8_t); break; \
+      case _NNS_UINT8: \
+        if (is_float) arith_typecast_loop (i, o, n, itype, int8_t, uint8_t); \
+        else arith_typecast_loop (i, o, n, itype, uint8_t, uint8_t); \
+        break; \
+      case _NNS_FLOAT64: arith_typecast_loop (i, o, n, itype, double, double); break; \
+      case _NNS_FLOAT32: arith_typecast_loop (i, o, n, itype, float, float); break; \
+      case _NNS_INT64: arith_typecast_loop (i, o, n, itype, int64_t, int64_t); break; \
+      case _NNS_UINT64: \
+        if (is_float) arith_typecast_loop (i, o, n, itype, int64_t, uint64_t); \
+        else arith_typecast_loop (i, o, n, itype, uint64_t, uint64_t); \
+        break; \
+      default: GST_ERROR_OBJECT (filter, "Unsupported type %d", otype); g_assert (0); break; \
+    } \
+  } while (0)
 
-      if (op_s->op != GTT_OP_TYPECAST) {
-        gst_tensor_transform_typecast_value (filter, &op_s->value,
-            out_tensor_type);
-        orc_operator (outptr, num, &op_s->value, op_s->op);
-      }
+#define arith_typecast(i,o,n,itype,otype) do { \
+    switch (itype) { \
+      case _NNS_INT32: arith_typecast_to (i, o, n, int32_t, FALSE, otype); break; \
+      case _NNS_UINT32: arith_typecast_to (i, o, n, uint32_t, FALSE, otype); break; \
+      case _NNS_INT16: arith_typecast_to (i, o, n, int16_t, FALSE, otype); break; \
+      case _NNS_UINT16: arith_typecast_to (i, o, n, uint16_t, FALSE, otype); break; \
+      case _NNS_INT8: arith_typecast_to (i, o, n, int8_t, FALSE, otype); break; \
+      case _NNS_UINT8: \
+        if (otype == _NNS_FLOAT32) gst_tensor_transform_arith_u8_to_f32 ((const uint8_t *) (i), (float *) (o), n); \
+        else arith_typecast_to (i, o, n, uint8_t, FALSE, otype); \
+        break; \
+      case _NNS_FLOAT64: \
+        if (otype == _NNS_FLOAT32) gst_tensor_transform_arith_f64_to_f32 ((const double *) (i), (float *) (o), n); \
+        else arith_typecast_to (i, o, n, double, TRUE, otype); \
+        break; \
+      case _NNS_FLOAT32: \
+        if (otype == _NNS_FLOAT64) gst_tensor_transform_arith_f32_to_f64 ((const float *) (i), (double *) (o), n); \
+        else arith_typecast_to (i, o, n, float, TRUE, otype); \
+        break; \
+      case _NNS_INT64: arith_typecast_to (i, o, n, int64_t, FALSE, otype); break; \
+      case _NNS_UINT64: arith_typecast_to (i, o, n, uint64_t, FALSE, otype); break; \
+      default: GST_ERROR_OBJECT (filter, "Unsupported type %d", itype); g_assert (0); break; \
+    } \
+  } while (0)
 
-      walk = g_slist_next (walk);
-    }
+/**
+ * @brief Macros to apply an operator to a block of elements, with the operand of the same type.
+ */
+#define arith_operator_loop(i,n,val,op,vtype) do { \
+    vtype *_dst = (vtype *) (i); \
+    const vtype _val = (val); \
+    size_t _k; \
+    switch (op) { \
+      case GTT_OP_ADD: for (_k = 0; _k < (n); _k++) _dst[_k] += _val; break; \
+      case GTT_OP_MUL: for (_k = 0; _k < (n); _k++) _dst[_k] *= _val; break; \
+      case GTT_OP_DIV: for (_k = 0; _k < (n); _k++) _dst[_k] /= _val; break; \
+      default: GST_ERROR_OBJECT (filter, "Unknown operator %d", op); break; \
+    } \
+  } while (0)
 
-    return GST_FLOW_OK;
+/**
+ * @brief Typecast a block of uint8 to float32, the common preprocessing of images.
+ */
+static void
+gst_tensor_transform_arith_u8_to_f32 (const uint8_t * in, float *out, size_t n)
+{
+  size_t k = 0;
+#if defined (__SSE2__)
+  const __m128i zero = _mm_setzero_si128 ();
+
+  for (; k + 16 <= n; k += 16) {
+    __m128i v = _mm_loadu_si128 ((const __m128i *) (in + k));
+    __m128i lo = _mm_unpacklo_epi8 (v, zero);
+    __m128i hi = _mm_unpackhi_epi8 (v, zero);
+
+    _mm_storeu_ps (out + k, _mm_cvtepi32_ps (_mm_unpacklo_epi16 (lo, zero)));
+    _mm_storeu_ps (out + k + 4,
+        _mm_cvtepi32_ps (_mm_unpackhi_epi16 (lo, zero)));
+    _mm_storeu_ps (out + k + 8,
+        _mm_cvtepi32_ps (_mm_unpacklo_epi16 (hi, zero)));
+    _mm_storeu_ps (out + k + 12,
+        _mm_cvtepi32_ps (_mm_unpackhi_epi16 (hi, zero)));
+  }
+#elif defined (__ARM_NEON) || defined (__ARM_NEON__)
+  for (; k + 16 <= n; k += 16) {
+    uint8x16_t v = vld1q_u8 (in + k);
+    uint16x8_t lo = vmovl_u8 (vget_low_u8 (v));
+    uint16x8_t hi = vmovl_u8 (vget_high_u8 (v));
+
+    vst1q_f32 (out + k, vcvtq_f32_u32 (vmovl_u16 (vget_low_u16 (lo))));
+    vst1q_f32 (out + k + 4, vcvtq_f32_u32 (vmovl_u16 (vget_high_u16 (lo))));
+    vst1q_f32 (out + k + 8, vcvtq_f32_u32 (vmovl_u16 (vget_low_u16 (hi))));
+    vst1q_f32 (out + k + 12, vcvtq_f32_u32 (vmovl_u16 (vget_high_u16 (hi))));
   }
 #endif
 
-  for (i = 0; i < num; ++i) {
-    /* init value with input tensor type */
-    data_idx = tensor_element_size[in_tensor_type] * i;
-    gst_tensor_transform_set_value (filter, &value, in_tensor_type,
-        (gpointer) (inptr + data_idx));
+  for (; k < n; k++)
+    out[k] = (float) in[k];
+}
 
-    walk = filter->operators;
-    while (walk) {
-      op_s = (tensor_transform_operator_s *) walk->data;
+/**
+ * @brief Typecast a block of float32 to float64.
+ */
+static void
+gst_tensor_transform_arith_f32_to_f64 (const float *in, double *out, size_t n)
+{
+  size_t k = 0;
+#if defined (__SSE2__)
+  __m128 v;
+
+  for (; k + 4 <= n; k += 4) {
+    v = _mm_loadu_ps (in + k);
+    _mm_storeu_pd (out + k, _mm_cvtps_pd (v));
+    _mm_storeu_pd (out + k + 2, _mm_cvtps_pd (_mm_movehl_ps (v, v)));
+  }
+#elif defined (__aarch64__)
+  float32x4_t v;
 
-      /**
-       * @todo add more options
-       */
-      switch (op_s->op) {
-        case GTT_OP_TYPECAST:
-          gst_tensor_transform_typecast_value (filter, &value,
-              op_s->value.type);
-          break;
-        case GTT_OP_ADD:
-        case GTT_OP_MUL:
-        case GTT_OP_DIV:
-          gst_tensor_transform_typecast_value (filter, &op_s->value,
-              value.type);
-          gst_tensor_transform_do_operator (filter, &value, &op_s->value,
-              op_s->op);
-          break;
-        default:
-          g_assert (0);
-          return GST_FLOW_ERROR;
-      }
+  for (; k + 4 <= n; k += 4) {
+    v = vld1q_f32 (in + k);
+    vst1q_f64 (out + k, vcvt_f64_f32 (vget_low_f32 (v)));
+    vst1q_f64 (out + k + 2, vcvt_f64_f32 (vget_high_f32 (v)));
+  }
+#endif
 
-      walk = g_slist_next (walk);
-    }
+  for (; k < n; k++)
+    out[k] = (double) in[k];
+}
 
-    /* set output value */
-    g_assert (out_tensor_type == value.type);
-    data_idx = tensor_element_size[out_tensor_type] * i;
-    gst_tensor_transform_get_value (filter, &value,
-        (gpointer) (outptr + data_idx));
+/**
+ * @brief Typecast a block of float64 to float32, rounded to nearest same as the scalar cast.
+ */
+static void
+gst_tensor_transform_arith_f64_to_f32 (const double *in, float *out, size_t n)
+{
+  size_t k = 0;
+#if defined (__SSE2__)
+  for (; k + 4 <= n; k += 4) {
+    _mm_storeu_ps (out + k, _mm_movelh_ps (_mm_cvtpd_ps (_mm_loadu_pd (in + k)),
+            _mm_cvtpd_ps (_mm_loadu_pd (in + k + 2))));
   }
+#elif defined (__aarch64__)
+  for (; k + 4 <= n; k += 4) {
+    vst1q_f32 (out + k, vcombine_f32 (vcvt_f32_f64 (vld1q_f64 (in + k)),
+            vcvt_f32_f64 (vld1q_f64 (in + k + 2))));
+  }
+#endif
 
-  return GST_FLOW_OK;
+  for (; k < n; k++)
+    out[k] = (float) in[k];
+}
+
+/**
+ * @brief Apply an operator to a block of float32. Same result with the scalar operation for each element.
+ */
+static void
+gst_tensor_transform_arith_f32 (GstTensorTransform * filter, float *v,
+    size_t n, float val, tensor_transform_operator op)
+{
+  size_t k = 0;
+#if defined (__SSE2__)
+  const __m128 c = _mm_set1_ps (val);
+
+  switch (op) {
+    case GTT_OP_ADD:
+      for (; k + 4 <= n; k += 4)
+        _mm_storeu_ps (v + k, _mm_add_ps (_mm_loadu_ps (v + k), c));
+      break;
+    case GTT_OP_MUL:
+      for (; k + 4 <= n; k += 4)
+        _mm_storeu_ps (v + k, _mm_mul_ps (_mm_loadu_ps (v + k), c));
+      break;
+    case GTT_OP_DIV:
+      for (; k + 4 <= n; k += 4)
+        _mm_storeu_ps (v + k, _mm_div_ps (_mm_loadu_ps (v + k), c));
+      break;
+    default:
+      break;
+  }
+#elif defined (__ARM_NEON) || defined (__ARM_NEON__)
+  const float32x4_t c = vdupq_n_f32 (val);
+
+  switch (op) {
+    case GTT_OP_ADD:
+      for (; k + 4 <= n; k += 4)
+        vst1q_f32 (v + k, vaddq_f32 (vld1q_f32 (v + k), c));
+      break;
+    case GTT_OP_MUL:
+      for (; k + 4 <= n; k += 4)
+        vst1q_f32 (v + k, vmulq_f32 (vld1q_f32 (v + k), c));
+      break;
+#if defined (__aarch64__)
+    case GTT_OP_DIV:
+      for (; k + 4 <= n; k += 4)
+        vst1q_f32 (v + k, vdivq_f32 (vld1q_f32 (v + k), c));
+      break;
+#endif
+    default:
+      break;
+  }
+#endif
+
+  arith_operator_loop (v + k, n - k, val, op, float);
 }
 
 /**
- * Macro to run loop for various data types with transpose
+ * @brief Macro to apply an operator to a block of elements with the type of operand.
  */
-#define transposeloop(cl,ck,cj,ci,sl,sk,sj,si,typesize) do { \
-    size_t i, j, k, l;                                  \
-    int inidx = 0, outidx=0;                            \
-    for(cl=0;cl<sl;cl++)                      \
-      for(ci=0;ci<si;ci++)                    \
-	for(cj=0;cj<sj;cj++)                  \
-	  for(ck=0;ck<sk;ck++){               \
-	    outidx=si*sj*sk*cl + sj*sk*ci + sk*cj+ck; \
-	    inidx = SK*SJ*SI*l + SJ*SI*k + SI*j + i; \
-	    const uint8_t *_in = inptr+inidx*typesize; \
-	    uint8_t *_out = outptr + outidx *typesize; \
-	    nns_memcpy(_out, _in, typesize); \
-	  }                                                      \
-  } while(0);
+#define arith_operator(i,n,v,op) do { \
+    switch ((v)->type) { \
+      case _NNS_INT32: arith_operator_loop (i, n, (v)->data._int32_t, op, int32_t); break; \
+      case _NNS_UINT32: arith_operator_loop (i, n, (v)->data._uint32_t, op, uint32_t); break; \
+      case _NNS_INT16: arith_operator_loop (i, n, (v)->data._int16_t, op, int16_t); break; \
+      case _NNS_UINT16: arith_operator_loop (i, n, (v)->data._uint16_t, op, uint16_t); break; \
+      case _NNS_INT8: arith_operator_loop (i, n, (v)->data._int8_t, op, int8_t); break; \
+      case _NNS_UINT8: arith_operator_loop (i, n, (v)->data._uint8_t, op, uint8_t); break; \
+      case _NNS_FLOAT64: arith_operator_loop (i, n, (v)->data._double, op, double); break; \
+      case _NNS_FLOAT32: gst_tensor_transform_arith_f32 (filter, (float *) (i), n, (v)->data._float, op); break; \
+      case _NNS_INT64: arith_operator_loop (i, n, (v)->data._int64_t, op, int64_t); break; \
+      case _NNS_UINT64: arith_operator_loop (i, n, (v)->data._uint64_t, op, uint64_t); break; \
+      default: GST_ERROR_OBJECT (filter, "Unsupported type %d", (v)->type); g_assert (0); break; \
+    } \
+  } while (0)
 
 /**
- * @brief subrouting for tensor-tranform, "transpose" case.
+ * @brief Prepare the operators of "arithmetic" mode for the negotiated tensor type.
+ * The operands are cast to the output type once here, not for each buffer.
+ * @param[in/out] filter "this" pointer
+ * @return TRUE if no error
+ */
+static gboolean
+gst_tensor_transform_arithmetic_compile (GstTensorTransform * filter)
+{
+  tensor_type out_tensor_type = filter->out_config.info.type;
+  tensor_transform_operator_s *op_s;
+  tensor_transform_operand_s denom;
+  GSList *walk;
+
+  for (walk = filter->operators; walk; walk = g_slist_next (walk)) {
+    op_s = (tensor_transform_operator_s *) walk->data;
+
+    if (op_s->op == GTT_OP_TYPECAST)
+      continue;
+
+    op_s->applied = op_s->value;
+    if (!gst_tensor_transform_typecast_value (filter, &op_s->applied,
+            out_tensor_type))
+      return FALSE;
+
+    if (op_s->op == GTT_OP_DIV) {
+      denom = op_s->applied;
+      gst_tensor_transform_typecast_value (filter, &denom, _NNS_FLOAT64);
+
+      if (denom.data._double == 0) {
+        GST_ERROR_OBJECT (filter, "Invalid state, denominator is 0.");
+        return FALSE;
+      }
+    }
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief subrouting for tensor-tranform, "arithmetic" case.
+ * All operators are applied to a block of elements before moving to the next block, in a single pass over the tensor.
  * @param[in/out] filter "this" pointer
  * @param[in] inptr input tensor
  * @param[out] outptr output tensor
  * @return Gst flow status
  */
 static GstFlowReturn
-gst_tensor_transform_transpose (GstTensorTransform * filter,
+gst_tensor_transform_arithmetic (GstTensorTransform * filter,
     const uint8_t * inptr, uint8_t * outptr)
 {
-  int i, from, to;
-  gboolean checkdim = FALSE;
-  uint32_t *fromDim = filter->in_config.info.dimension;
+  size_t num = get_tensor_element_count (filter->in_config.info.dimension);
   tensor_type in_tensor_type = filter->in_config.info.type;
-  size_t type_size = tensor_element_size[in_tensor_type];
-  size_t indexI, indexJ, SL, SI, SJ, SK;
-  for (i = 0; i < NNS_TENSOR_RANK_LIMIT; i++) {
-    from = i;
-    to = filter->data_transpose.trans_order[i];
-    if (from != to) {
-      checkdim = TRUE;
-      break;
+  tensor_type out_tensor_type = filter->out_config.info.type;
+  size_t in_es = tensor_element_size[in_tensor_type];
+  size_t out_es = tensor_element_size[out_tensor_type];
+
+  GSList *walk;
+  tensor_transform_operator_s *op_s;
+  const uint8_t *in;
+  uint8_t *out;
+  size_t i, n;
+
+  for (i = 0; i < num; i += n) {
+    n = MIN (num - i, ARITH_BLOCK);
+    in = inptr + i * in_es;
+    out = outptr + i * out_es;
+
+#ifdef HAVE_ORC
+    if (orc_supported (filter)) {
+      /**
+       * Typecast should be called at the first.
+       * Do the typecast. If in/out type is same, this will copy the input array to output.
+       */
+      orc_typecast (in, out, n, in_tensor_type, out_tensor_type);
+
+      for (walk = filter->operators; walk; walk = g_slist_next (walk)) {
+        op_s = (tensor_transform_operator_s *) walk->data;
+
+        if (op_s->op != GTT_OP_TYPECAST)
+          orc_operator (out, n, &op_s->applied, op_s->op);
+      }
+
+      continue;
+    }
+#endif
+
+    arith_typecast (in, out, n, in_tensor_type, out_tensor_type);
+
+    for (walk = filter->operators; walk; walk = g_slist_next (walk)) {
+      op_s = (tensor_transform_operator_s *) walk->data;
+
+      if (op_s->op != GTT_OP_TYPECAST)
+        arith_operator (out, n, &op_s->applied, op_s->op);
     }
   }
 
-  if (!checkdim) {
+  return GST_FLOW_OK;
+}
+
+/**
+ * @brief subrouting for tensor-tranform, "transpose" case.
+ * @param[in/out] filter "this" pointer
+ * @param[in] inptr input tensor
+ * @param[out] outptr output tensor
+ * @return Gst flow status
+ */
+static GstFlowReturn
+gst_tensor_transform_transpose (GstTensorTransform * filter,
+    const uint8_t * inptr, uint8_t * outptr)
+{
+  if (filter->axes.rank == 0) {
     nns_memcpy (outptr, inptr,
         gst_tensor_info_get_size (&filter->in_config.info));
     GST_WARNING_OBJECT (filter,
@@ -1227,42 +1826,190 @@ gst_tensor_transform_transpose (GstTensorTransform * filter,
     return GST_FLOW_OK;
   }
 
-  indexI = filter->data_transpose.trans_order[0];
-  indexJ = filter->data_transpose.trans_order[1];
-  SL = fromDim[3], SI = fromDim[0], SJ = fromDim[1], SK = fromDim[2];
+  gst_tensor_transform_axes_move (filter, inptr, outptr);
+  return GST_FLOW_OK;
+}
 
-  g_assert (filter->data_transpose.trans_order[3] == 3);
+/**
+ * @brief Sum of v[k], k = 0, step, 2 * step, ... < n, with 4 partial sums.
+ */
+static double
+gst_tensor_transform_stand_sum (const double *v, size_t n, size_t step)
+{
+  double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+  size_t k = 0;
+
+  for (; k + 3 * step < n; k += 4 * step) {
+    s0 += v[k];
+    s1 += v[k + step];
+    s2 += v[k + 2 * step];
+    s3 += v[k + 3 * step];
+  }
 
-  switch (indexI) {
-    case 0:
-      if (indexJ == 1) {
-        transposeloop (l, i, j, k, SL, SI, SJ, SK, type_size);
-      } else {
-        transposeloop (l, i, k, j, SL, SI, SK, SJ, type_size);
-      }
-      break;
-    case 1:
-      if (indexJ == 0) {
-        transposeloop (l, j, i, k, SL, SJ, SI, SK, type_size);
-      } else {
-        transposeloop (l, j, k, i, SL, SJ, SK, SI, type_size);
-      }
-      break;
-    case 2:
-      if (indexJ == 0) {
-        transposeloop (l, k, i, j, SL, SK, SI, SJ, type_size);
-      } else {
-        transposeloop (l, k, j, i, SL, SK, SJ, SI, type_size);
-      }
-      break;
+  for (; k < n; k += step)
+    s0 += v[k];
+
+  return (s0 + s1) + (s2 + s3);
+}
+
+/**
+ * @brief Sum of (v[k] - center)^2, k = 0, step, 2 * step, ... < n, with 4 partial sums.
+ */
+static double
+gst_tensor_transform_stand_sum_sq (const double *v, size_t n, size_t step,
+    double center)
+{
+  double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+  double d0, d1, d2, d3;
+  size_t k = 0;
+
+  for (; k + 3 * step < n; k += 4 * step) {
+    d0 = v[k] - center;
+    d1 = v[k + step] - center;
+    d2 = v[k + 2 * step] - center;
+    d3 = v[k + 3 * step] - center;
+    s0 += d0 * d0;
+    s1 += d1 * d1;
+    s2 += d2 * d2;
+    s3 += d3 * d3;
   }
 
-  return GST_FLOW_OK;
+  for (; k < n; k += step) {
+    d0 = v[k] - center;
+    s0 += d0 * d0;
+  }
+
+  return (s0 + s1) + (s2 + s3);
+}
+
+/**
+ * @brief Gather the statistics of the channels in a row, block by block.
+ *        The mean and squared differences of a block are merged into the statistics of the channel (Chan et al.).
+ * @param[in] filter "this" pointer
+ * @param[in] in input elements, the channel of k-th element is (k % period)
+ * @param[in] n the number of elements
+ * @param[in/out] stats the statistics of the channels
+ * @param[in] period the number of channels interleaved
+ * @param[in] tmp a buffer of ARITH_BLOCK elements
+ */
+static void
+gst_tensor_transform_stand_stats (GstTensorTransform * filter,
+    const uint8_t * in, size_t n, tensor_transform_stat * stats,
+    size_t period, double *tmp)
+{
+  tensor_type in_tensor_type = filter->in_config.info.type;
+  size_t in_es = tensor_element_size[in_tensor_type];
+  tensor_transform_stat *st;
+  double count, mean, m2, delta, total;
+  size_t i, c, len;
+
+  for (i = 0; i < n; i += len) {
+    len = MIN (n - i, ARITH_BLOCK);
+    arith_typecast (in + i * in_es, tmp, len, in_tensor_type, _NNS_FLOAT64);
+
+    for (c = 0; c < MIN (period, len); c++) {
+      st = &stats[(i + c) % period];
+
+      count = (double) ((len - c + period - 1) / period);
+      mean = gst_tensor_transform_stand_sum (tmp + c, len - c, period) / count;
+      m2 = gst_tensor_transform_stand_sum_sq (tmp + c, len - c, period, mean);
+
+      delta = mean - st->mean;
+      total = st->count + count;
+      st->mean += delta * count / total;
+      st->m2 += m2 + delta * delta * st->count * count / total;
+      st->count = total;
+    }
+  }
+}
+
+/**
+ * @brief Standardize the elements with stride: v[k] = (v[k] - mean) / denom, and the absolute value if required.
+ */
+static void
+gst_tensor_transform_stand_scale (double *v, size_t n, double mean,
+    double denom, size_t step, gboolean absolute)
+{
+  size_t k = 0;
+  double x;
+
+#if defined (__SSE2__)
+  if (step == 1) {
+    const __m128d m = _mm_set1_pd (mean);
+    const __m128d d = _mm_set1_pd (denom);
+    const __m128d sign = _mm_set1_pd (-0.0);
+    __m128d y;
+
+    for (; k + 2 <= n; k += 2) {
+      y = _mm_div_pd (_mm_sub_pd (_mm_loadu_pd (v + k), m), d);
+      if (absolute)
+        y = _mm_andnot_pd (sign, y);
+      _mm_storeu_pd (v + k, y);
+    }
+  }
+#elif defined (__aarch64__)
+  if (step == 1) {
+    const float64x2_t m = vdupq_n_f64 (mean);
+    const float64x2_t d = vdupq_n_f64 (denom);
+    float64x2_t y;
+
+    for (; k + 2 <= n; k += 2) {
+      y = vdivq_f64 (vsubq_f64 (vld1q_f64 (v + k), m), d);
+      if (absolute)
+        y = vabsq_f64 (y);
+      vst1q_f64 (v + k, y);
+    }
+  }
+#endif
+
+  for (; k < n; k += step) {
+    x = (v[k] - mean) / denom;
+    v[k] = absolute ? fabs (x) : x;
+  }
+}
+
+/**
+ * @brief Standardize the channels in a row with the statistics, block by block.
+ * @param[in] filter "this" pointer
+ * @param[in] in input elements, the channel of k-th element is (k % period)
+ * @param[out] out output elements
+ * @param[in] n the number of elements
+ * @param[in] stats the statistics of the channels
+ * @param[in] period the number of channels interleaved
+ * @param[in] tmp a buffer of ARITH_BLOCK elements
+ */
+static void
+gst_tensor_transform_stand_apply (GstTensorTransform * filter,
+    const uint8_t * in, uint8_t * out, size_t n,
+    const tensor_transform_stat * stats, size_t period, double *tmp)
+{
+  tensor_type in_tensor_type = filter->in_config.info.type;
+  tensor_type out_tensor_type = filter->out_config.info.type;
+  size_t in_es = tensor_element_size[in_tensor_type];
+  size_t out_es = tensor_element_size[out_tensor_type];
+  gboolean absolute = (filter->data_stand.mode == STAND_DEFAULT);
+  const tensor_transform_stat *st;
+  size_t i, c, len;
+
+  for (i = 0; i < n; i += len) {
+    len = MIN (n - i, ARITH_BLOCK);
+    arith_typecast (in + i * in_es, tmp, len, in_tensor_type, _NNS_FLOAT64);
+
+    for (c = 0; c < MIN (period, len); c++) {
+      st = &stats[(i + c) % period];
+      gst_tensor_transform_stand_scale (tmp + c, len - c, st->mean, st->denom,
+          period, absolute);
+    }
+
+    arith_typecast (tmp, out + i * out_es, len, _NNS_FLOAT64, out_tensor_type);
+  }
 }
 
 /**
  * @brief subrouting for tensor-tranform, "stand" case.
- *        : pixel = abs((pixel - average(tensor))/(std(tensor) + val))
+ *        default : pixel = abs((pixel - average(tensor))/(std(tensor) + val))
+ *        dc-average : pixel = pixel - average(tensor), the output type should be float32 or float64
+ *        With the axis in the option, the average and std are of each channel along the axis.
  * @param[in/out] filter "this" pointer
  * @param[in] inptr input tensor
  * @param[out] outptr output tensor
@@ -1272,41 +2019,309 @@ static GstFlowReturn
 gst_tensor_transform_stand (GstTensorTransform * filter,
     const uint8_t * inptr, uint8_t * outptr)
 {
-  int i;
-  size_t Size;
-  uint32_t *fromDim = filter->in_config.info.dimension;
-  double average, stand;
-
-  float *in = (float *) inptr;
-  float *out = (float *) outptr;
-  Size = fromDim[3] * fromDim[2] * fromDim[1] * fromDim[0];
+  tensor_transform_stand *stand = &filter->data_stand;
+  uint32_t *dim = filter->in_config.info.dimension;
+  size_t in_es = tensor_element_size[filter->in_config.info.type];
+  size_t out_es = tensor_element_size[filter->out_config.info.type];
+  size_t inner, channels = 1, outer = 1, i, c, o, row;
+  tensor_transform_stat *stats = filter->stand_stats;
+  double tmp[ARITH_BLOCK];
+
+  inner = get_tensor_element_count (dim);
+
+  if (stand->per_channel) {
+    inner = 1;
+    for (i = 0; i < stand->axis; i++)
+      inner *= dim[i];
+    channels = dim[stand->axis];
+    for (i = stand->axis + 1; i < NNS_TENSOR_RANK_LIMIT; i++)
+      outer *= dim[i];
+  }
 
-  switch (filter->data_stand.mode) {
+  switch (stand->mode) {
     case STAND_DEFAULT:
-    {
-      average = 0.0;
+    case STAND_DC_AVERAGE:
+      break;
+    default:
+      GST_ERROR_OBJECT (filter, "Cannot identify mode\n");
+      g_assert (0);
+      return GST_FLOW_ERROR;
+  }
+
+  g_assert (stats != NULL && channels <= filter->stand_channels);
+  memset (stats, 0, sizeof (tensor_transform_stat) * channels);
 
-      for (i = 0; i < Size; i++) {
-        average = (in[i] - average) / (i + 1) + average;
+  /* the statistics in a single pass, channels are interleaved if inner is 1 */
+  if (inner == 1) {
+    gst_tensor_transform_stand_stats (filter, inptr, channels * outer, stats,
+        channels, tmp);
+  } else {
+    for (o = 0, row = 0; o < outer; o++) {
+      for (c = 0; c < channels; c++, row++) {
+        gst_tensor_transform_stand_stats (filter, inptr + row * inner * in_es,
+            inner, stats + c, 1, tmp);
       }
+    }
+  }
 
-      stand = 0.0;
+  for (c = 0; c < channels; c++) {
+    if (stand->mode == STAND_DC_AVERAGE) {
+      stats[c].denom = 1.0;
+    } else {
+      /* sample standard deviation */
+      stats[c].denom = (stats[c].count > 1.0) ?
+          sqrt (stats[c].m2 / (stats[c].count - 1.0)) : 0.0;
+      stats[c].denom += 1e-10;
+    }
+  }
 
-      for (i = 0; i < Size; i++) {
-        stand += pow (in[i] - average, 2) / (Size - 1);
+  if (inner == 1) {
+    gst_tensor_transform_stand_apply (filter, inptr, outptr, channels * outer,
+        stats, channels, tmp);
+  } else {
+    for (o = 0, row = 0; o < outer; o++) {
+      for (c = 0; c < channels; c++, row++) {
+        gst_tensor_transform_stand_apply (filter, inptr + row * inner * in_es,
+            outptr + row * inner * out_es, inner, stats + c, 1, tmp);
       }
+    }
+  }
+
+  return GST_FLOW_OK;
+}
+
+/**
+ * @brief Check the option of "stand" mode with the negotiated tensor info and allocate the statistics.
+ * @param[in] filter "this" pointer
+ * @return TRUE if no error
+ */
+static gboolean
+gst_tensor_transform_stand_check (GstTensorTransform * filter)
+{
+  tensor_transform_stand *stand = &filter->data_stand;
+  tensor_type out_tensor_type = filter->out_config.info.type;
+  guint channels = 1;
+
+  /* dc-average keeps the sign of the differences, these wrap in integer types */
+  if (stand->mode == STAND_DC_AVERAGE &&
+      out_tensor_type != _NNS_FLOAT32 && out_tensor_type != _NNS_FLOAT64) {
+    GST_ERROR_OBJECT (filter,
+        "The output type of dc-average should be float32 or float64, set typecast in the option.");
+    return FALSE;
+  }
+
+  if (stand->per_channel)
+    channels = filter->in_config.info.dimension[stand->axis];
+
+  if (filter->stand_stats == NULL || filter->stand_channels < channels) {
+    g_free (filter->stand_stats);
+    filter->stand_stats = g_new0 (tensor_transform_stat, channels);
+    filter->stand_channels = channels;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Macro to normalize a block of elements: v[k] = (v[k] - mean[k % period]) / std[k % period]
+ */
+#define normalize_loop(v,k,n,mean,std,period) do { \
+    size_t _p = 0; \
+    for (; (k) < (n); (k)++) { \
+      (v)[k] = ((v)[k] - (mean)[_p]) / (std)[_p]; \
+      if (++_p == (period)) \
+        _p = 0; \
+    } \
+  } while (0)
+
+/**
+ * @brief Normalize a block of float32, the length of the repeated mean and std (period) is a multiple of 4.
+ * Same result with the scalar operations for each element.
+ */
+static void
+gst_tensor_transform_normalize_f32 (float *v, size_t n, const float *mean,
+    const float *std, size_t period)
+{
+  size_t k = 0;
+#if defined (__SSE2__) || defined (__aarch64__)
+  size_t p;
+
+  for (; k + period <= n; k += period) {
+    for (p = 0; p < period; p += 4) {
+#if defined (__SSE2__)
+      __m128 x = _mm_sub_ps (_mm_loadu_ps (v + k + p),
+          _mm_loadu_ps (mean + p));
+
+      _mm_storeu_ps (v + k + p, _mm_div_ps (x, _mm_loadu_ps (std + p)));
+#else
+      float32x4_t x = vsubq_f32 (vld1q_f32 (v + k + p), vld1q_f32 (mean + p));
+
+      vst1q_f32 (v + k + p, vdivq_f32 (x, vld1q_f32 (std + p)));
+#endif
+    }
+  }
+#endif
+
+  normalize_loop (v, k, n, mean, std, period);
+}
+
+/**
+ * @brief Normalize a block of float64 (see gst_tensor_transform_normalize_f32)
+ */
+static void
+gst_tensor_transform_normalize_f64 (double *v, size_t n, const double *mean,
+    const double *std, size_t period)
+{
+  size_t k = 0;
+
+  normalize_loop (v, k, n, mean, std, period);
+}
+
+/**
+ * @brief Check the option of "normalize" mode with the negotiated tensor info.
+ * @param[in] filter "this" pointer
+ * @return TRUE if no error
+ */
+static gboolean
+gst_tensor_transform_normalize_check (GstTensorTransform * filter)
+{
+  tensor_transform_normalize *norm = &filter->data_normalize;
+  tensor_type out_tensor_type = filter->out_config.info.type;
+  uint32_t channels = filter->in_config.info.dimension[norm->axis];
+
+  if (out_tensor_type != _NNS_FLOAT32 && out_tensor_type != _NNS_FLOAT64) {
+    GST_ERROR_OBJECT (filter,
+        "The output type should be float32 or float64, set typecast in the option.");
+    return FALSE;
+  }
+
+  if ((norm->num_mean != 1 && norm->num_mean != channels) ||
+      (norm->num_std != 1 && norm->num_std != channels)) {
+    GST_ERROR_OBJECT (filter,
+        "The number of mean (%u) and std (%u) should be 1 or the dimension %u (%u)",
+        norm->num_mean, norm->num_std, norm->axis, channels);
+    return FALSE;
+  }
+
+  /* per-channel values are repeated in the buffers of the interleaved case */
+  if ((norm->num_mean != 1 || norm->num_std != 1) &&
+      channels > NORMALIZE_CHANNEL_LIMIT) {
+    GST_ERROR_OBJECT (filter, "The dimension %u (%u) should be less than %d",
+        norm->axis, channels, NORMALIZE_CHANNEL_LIMIT + 1);
+    return FALSE;
+  }
+
+  return TRUE;
+}
 
-      stand = sqrt (stand);
-      for (i = 0; i < Size; i++) {
-        out[i] = fabs ((in[i] - average) / (stand + 1e-10));
+/**
+ * @brief Normalize the elements in a row with the repeated mean and std, block by block.
+ * @param[in] filter "this" pointer
+ * @param[in] in input elements
+ * @param[out] out output elements
+ * @param[in] n the number of elements
+ * @param[in] mean_f mean values repeated in a period for float32 output
+ * @param[in] std_f std values repeated in a period for float32 output
+ * @param[in] mean_d mean values repeated in a period for float64 output
+ * @param[in] std_d std values repeated in a period for float64 output
+ * @param[in] period the number of values repeated, a multiple of 4
+ */
+static void
+gst_tensor_transform_normalize_row (GstTensorTransform * filter,
+    const uint8_t * in, uint8_t * out, size_t n, const float *mean_f,
+    const float *std_f, const double *mean_d, const double *std_d,
+    size_t period)
+{
+  tensor_type in_tensor_type = filter->in_config.info.type;
+  tensor_type out_tensor_type = filter->out_config.info.type;
+  size_t in_es = tensor_element_size[in_tensor_type];
+  size_t out_es = tensor_element_size[out_tensor_type];
+  size_t block = (ARITH_BLOCK / period) * period;
+  size_t i, len;
+
+  for (i = 0; i < n; i += len) {
+    len = MIN (n - i, block);
+
+    arith_typecast (in + i * in_es, out + i * out_es, len, in_tensor_type,
+        out_tensor_type);
+
+    if (out_tensor_type == _NNS_FLOAT32) {
+      gst_tensor_transform_normalize_f32 ((float *) (out + i * out_es), len,
+          mean_f, std_f, period);
+    } else {
+      gst_tensor_transform_normalize_f64 ((double *) (out + i * out_es), len,
+          mean_d, std_d, period);
+    }
+  }
+}
+
+/**
+ * @brief subrouting for tensor-tranform, "normalize" case.
+ *        : out = (in - mean[c]) / std[c], c is the index along the axis
+ * @param[in/out] filter "this" pointer
+ * @param[in] inptr input tensor
+ * @param[out] outptr output tensor
+ * @return Gst flow status
+ */
+static GstFlowReturn
+gst_tensor_transform_normalize (GstTensorTransform * filter,
+    const uint8_t * inptr, uint8_t * outptr)
+{
+  tensor_transform_normalize *norm = &filter->data_normalize;
+  uint32_t *dim = filter->in_config.info.dimension;
+  size_t in_es = tensor_element_size[filter->in_config.info.type];
+  size_t out_es = tensor_element_size[filter->out_config.info.type];
+  float mean_f[4 * NORMALIZE_CHANNEL_LIMIT];
+  float std_f[4 * NORMALIZE_CHANNEL_LIMIT];
+  double mean_d[4 * NORMALIZE_CHANNEL_LIMIT];
+  double std_d[4 * NORMALIZE_CHANNEL_LIMIT];
+  size_t inner = 1, outer = 1, channels, period, i, c, o;
+
+  if (norm->num_mean == 1 && norm->num_std == 1) {
+    /* the same mean and std for all elements, a row of the tensor */
+    inner = get_tensor_element_count (dim);
+    channels = 1;
+  } else {
+    /* the number of channels is num_mean or num_std (checked with caps) */
+    for (i = 0; i < norm->axis; i++)
+      inner *= dim[i];
+    channels = dim[norm->axis];
+    for (i = norm->axis + 1; i < NNS_TENSOR_RANK_LIMIT; i++)
+      outer *= dim[i];
+  }
+
+  if (inner == 1) {
+    /* channels are interleaved, repeat the values 4 times for the vectors */
+    period = channels * 4;
+
+    for (i = 0; i < period; i++) {
+      c = i % channels;
+      mean_d[i] = norm->mean[(norm->num_mean == 1) ? 0 : c];
+      std_d[i] = norm->std[(norm->num_std == 1) ? 0 : c];
+      mean_f[i] = (float) mean_d[i];
+      std_f[i] = (float) std_d[i];
+    }
+
+    gst_tensor_transform_normalize_row (filter, inptr, outptr,
+        channels * outer, mean_f, std_f, mean_d, std_d, period);
+    return GST_FLOW_OK;
+  }
+
+  /* each channel has a row of inner elements */
+  for (o = 0; o < outer; o++) {
+    for (c = 0; c < channels; c++) {
+      for (i = 0; i < 4; i++) {
+        mean_d[i] = norm->mean[(norm->num_mean == 1) ? 0 : c];
+        std_d[i] = norm->std[(norm->num_std == 1) ? 0 : c];
+        mean_f[i] = (float) mean_d[i];
+        std_f[i] = (float) std_d[i];
       }
 
-      break;
+      gst_tensor_transform_normalize_row (filter, inptr, outptr, inner,
+          mean_f, std_f, mean_d, std_d, 4);
+      inptr += inner * in_es;
+      outptr += inner * out_es;
     }
-    default:
-      GST_ERROR_OBJECT (filter, "Cannot identify mode\n");
-      g_assert (0);
-      return GST_FLOW_ERROR;
   }
 
   return GST_FLOW_OK;
@@ -1352,6 +2367,9 @@ gst_tensor_transform_transform (GstBaseTransform * trans,
     case GTT_STAND:
       res = gst_tensor_transform_stand (filter, inptr, outptr);
       break;
+    case GTT_NORMALIZE:
+      res = gst_tensor_transform_normalize (filter, inptr, outptr);
+      break;
     default:
       res = GST_FLOW_NOT_SUPPORTED;
       break;
@@ -1406,6 +2424,10 @@ gst_tensor_transform_convert_dimension (GstTensorTransform * filter,
 {
   int i;
 
+  /* the option is invalid, cannot be negotiated */
+  if (!filter->loaded)
+    return FALSE;
+
   switch (filter->mode) {
     case GTT_DIMCHG:
       out_info->type = in_info->type;
@@ -1519,6 +2541,23 @@ gst_tensor_transform_convert_dimension (GstTensorTransform * filter,
         out_info->dimension[i] = in_info->dimension[i];
       }
       out_info->type = in_info->type;
+
+      if (direction == GST_PAD_SINK &&
+          filter->data_stand.out_type != _NNS_END) {
+        out_info->type = filter->data_stand.out_type;
+      }
+      break;
+
+    case GTT_NORMALIZE:
+      for (i = 0; i < NNS_TENSOR_RANK_LIMIT; i++) {
+        out_info->dimension[i] = in_info->dimension[i];
+      }
+      out_info->type = in_info->type;
+
+      if (direction == GST_PAD_SINK &&
+          filter->data_normalize.out_type != _NNS_END) {
+        out_info->type = filter->data_normalize.out_type;
+      }
       break;
 
     default:
@@ -1659,6 +2698,24 @@ gst_tensor_transform_set_caps (GstBaseTransform * trans,
   filter->in_config = in_config;
   filter->out_config = out_config;
 
+  if (filter->mode == GTT_DIMCHG) {
+    uint8_t order[NNS_TENSOR_RANK_LIMIT];
+
+    gst_tensor_transform_dimchg_order (filter, order);
+    gst_tensor_transform_axes_plan (filter, order);
+  } else if (filter->mode == GTT_TRANSPOSE) {
+    gst_tensor_transform_axes_plan (filter, filter->data_transpose.trans_order);
+  } else if (filter->mode == GTT_ARITHMETIC) {
+    if (!gst_tensor_transform_arithmetic_compile (filter))
+      goto error;
+  } else if (filter->mode == GTT_NORMALIZE) {
+    if (!gst_tensor_transform_normalize_check (filter))
+      goto error;
+  } else if (filter->mode == GTT_STAND) {
+    if (!gst_tensor_transform_stand_check (filter))
+      goto error;
+  }
+
 #ifdef HAVE_ORC
   /**
    * @todo support 64bit integer and remove the flag orc_supported
@@ -60,6 +60,7 @@ typedef enum
   GTT_ARITHMETIC = 2,           /* Arithmetic. "arithmetic" */
   GTT_TRANSPOSE = 3,            /* Transpose. "transpose" */
   GTT_STAND = 4,                /* Standardization. "stand" */
+  GTT_NORMALIZE = 5,            /* Per-channel normalization. "normalize" */
 
   GTT_END,
 } tensor_transform_mode;
@@ -77,6 +78,7 @@ typedef enum
 typedef enum
 {
   STAND_DEFAULT = 0,
+  STAND_DC_AVERAGE = 1,
   STAND_END,
 } tensor_transform_stand_mode;
 
@@ -110,7 +112,8 @@ typedef struct
 typedef struct
 {
   tensor_transform_operator op;
-  tensor_transform_operand_s value;
+  tensor_transform_operand_s value; /**< The operand as parsed from the option */
+  tensor_transform_operand_s applied; /**< The operand cast to the output type, set when the caps are negotiated */
 } tensor_transform_operator_s;
 
 /**
@@ -128,12 +131,55 @@ typedef struct _tensor_transform_transpose {
 } tensor_transform_transpose;
 
 /**
- * @brief Internal data structure for arithmetic mode.
+ * @brief Internal data structure to move the axes (transpose and dimchg mode), made for the input dimension.
+ *
+ * The axes of size 1 are removed and the axes adjacent in both input and output are merged.
+ */
+typedef struct _tensor_transform_axes {
+  guint rank; /**< the number of axes to be moved. 0 to copy the tensor */
+  size_t element_size; /**< the size (bytes) of the unit moved, the element with the innermost axes not moved */
+  size_t size[NNS_TENSOR_RANK_LIMIT]; /**< the size of each axis, in the order of the output */
+  size_t in_stride[NNS_TENSOR_RANK_LIMIT]; /**< the stride (units) of each axis in the input */
+  size_t out_stride[NNS_TENSOR_RANK_LIMIT]; /**< the stride (units) of each axis in the output */
+} tensor_transform_axes;
+
+/**
+ * @brief Internal data structure for stand mode.
  */
 typedef struct _tensor_transform_stand {
   tensor_transform_stand_mode mode;
+  tensor_type out_type; /**< tensor_type after cast. _NNS_END to keep the input type */
+  gboolean per_channel; /**< TRUE to get the statistics of each channel along the axis */
+  guint axis; /**< The dimension of channels */
 } tensor_transform_stand;
 
+/**
+ * @brief The statistics of a channel in stand mode, merged block by block.
+ */
+typedef struct _tensor_transform_stat {
+  double count; /**< The number of elements */
+  double mean; /**< The mean of elements */
+  double m2; /**< The sum of squared differences from the mean */
+  double denom; /**< The denominator of the differences from the mean */
+} tensor_transform_stat;
+
+/**
+ * @brief The max number of channels with their own mean and std in normalize mode.
+ */
+#define NORMALIZE_CHANNEL_LIMIT (16)
+
+/**
+ * @brief Internal data structure for normalize mode: out = (in - mean[c]) / std[c], c is the index along the axis.
+ */
+typedef struct _tensor_transform_normalize {
+  tensor_type out_type; /**< tensor_type after cast. _NNS_END to keep the input type */
+  guint axis; /**< The dimension of channels */
+  guint num_mean; /**< The number of mean values, 1 to apply the same value to all channels */
+  guint num_std; /**< The number of std values, 1 to apply the same value to all channels */
+  double mean[NORMALIZE_CHANNEL_LIMIT]; /**< The mean of each channel */
+  double std[NORMALIZE_CHANNEL_LIMIT]; /**< The standard deviation of each channel */
+} tensor_transform_normalize;
+
 /**
  * @brief Internal data structure for tensor_transform instances.
  */
@@ -150,13 +196,17 @@ struct _GstTensorTransform
     tensor_transform_arithmetic data_arithmetic; /**< Parsed option value for "arithmetic" mode. */
     tensor_transform_transpose data_transpose; /**< Parsed option value for "transpose" mode. */
     tensor_transform_stand data_stand; /**< Parsed option value for "stand" mode. */
+    tensor_transform_normalize data_normalize; /**< Parsed option value for "normalize" mode. */
   };
+  tensor_transform_axes axes; /**< The axes to be moved for "dimchg" and "transpose" mode */
   gboolean loaded; /**< TRUE if mode & option are loaded */
   gboolean acceleration; /**< TRUE to set orc acceleration */
 #ifdef HAVE_ORC
   gboolean orc_supported; /**< TRUE if orc supported */
 #endif
   GSList *operators; /**< operators list */
+  tensor_transform_stat *stand_stats; /**< The statistics of each channel for "stand" mode, allocated with the caps */
+  guint stand_channels; /**< The number of channels in stand_stats */
 
   GstTensorConfig in_config; /**< input tensor info */
   GstTensorConfig out_config; /**< output tensor info */
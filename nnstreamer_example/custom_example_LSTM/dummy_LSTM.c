@@ -11,6 +11,10 @@
  * @bug		No known bugs except for NYI items
  *
  * This supports two "4:4:4:1" float32 tensors, where the first one is the new tensor and the second one is "recurring" tensor (output of the previous frame).
+ *
+ * With batch-size of tensor_filter, the frames of a batch are invoked at once (invoke_batch).
+ * Each frame has its own recurring tensors; thus, the frames of a batch should be from different streams
+ * (e.g., tensor_mux of the LSTM states of multiple streams), not the consecutive frames of a stream.
  */
 
 #include <stdlib.h>
@@ -115,20 +119,15 @@ location (uint32_t c, uint32_t w, uint32_t h)
 }
 
 /**
- * @brief INFERENCE!
+ * @brief The LSTM cell of a frame.
  */
 static int
-pt_invoke (void *private_data, const GstTensorFilterProperties * prop,
-    const GstTensorMemory * input, GstTensorMemory * output)
+lstm_cell (const GstTensorMemory * input, GstTensorMemory * output)
 {
-  pt_data *data = private_data;
   uint32_t c, w, h;
   float *in0, *in1, *in2, *out0, *out1;
   float in2_tmp0, in2_tmp1;
 
-  if (!data || !input || !output)
-    return -EINVAL;
-
   in0 = input[0].data;
   in1 = input[1].data;
   in2 = input[2].data;
@@ -143,10 +142,10 @@ pt_invoke (void *private_data, const GstTensorFilterProperties * prop,
       for (c = 0; c < TSIZE; c++) {
         in2_tmp0 = (in2[location (c, w, h)] + in1[location (c, w, h)]) / 2;
         in2_tmp1 = tanh (in2[location (c, w, h)]);
-        in0[location (c, w, h)] = in0[location (c, w, h)] * in2_tmp0;
-        in0[location (c, w, h)] += (in2_tmp0 * in2_tmp1);
-        out0[location (c, w, h)] = in0[location (c, w, h)];
-        out1[location (c, w, h)] = tanh (in0[location (c, w, h)]) * in2_tmp0;
+        /* the input tensors are read-only, may be referred by others */
+        out0[location (c, w, h)] = in0[location (c, w, h)] * in2_tmp0;
+        out0[location (c, w, h)] += (in2_tmp0 * in2_tmp1);
+        out1[location (c, w, h)] = tanh (out0[location (c, w, h)]) * in2_tmp0;
       }
     }
   }
@@ -154,6 +153,45 @@ pt_invoke (void *private_data, const GstTensorFilterProperties * prop,
   return 0;
 }
 
+/**
+ * @brief INFERENCE!
+ */
+static int
+pt_invoke (void *private_data, const GstTensorFilterProperties * prop,
+    const GstTensorMemory * input, GstTensorMemory * output)
+{
+  pt_data *data = private_data;
+
+  if (!data || !input || !output)
+    return -EINVAL;
+
+  return lstm_cell (input, output);
+}
+
+/**
+ * @brief INFERENCE with a batch of frames! (frame-major arrays of 3 input and 2 output tensors)
+ */
+static int
+pt_invoke_batch (void *private_data, const GstTensorFilterProperties * prop,
+    const GstTensorMemory * input, GstTensorMemory * output,
+    unsigned int batch)
+{
+  pt_data *data = private_data;
+  unsigned int b;
+  int ret;
+
+  if (!data || !input || !output)
+    return -EINVAL;
+
+  for (b = 0; b < batch; b++) {
+    ret = lstm_cell (&input[b * 3], &output[b * 2]);
+    if (ret != 0)
+      return ret;
+  }
+
+  return 0;
+}
+
 static NNStreamer_custom_class NNStreamer_custom_body = {
   .initfunc = pt_init,
   .exitfunc = pt_exit,
@@ -164,3 +202,11 @@ static NNStreamer_custom_class NNStreamer_custom_body = {
 
 /* The dyn-loaded object */
 NNStreamer_custom_class *NNStreamer_custom = &NNStreamer_custom_body;
+
+static NNStreamer_custom_ext_class NNStreamer_custom_ext_body = {
+  .size = sizeof (NNStreamer_custom_ext_class),
+  .invoke_batch = pt_invoke_batch,
+};
+
+/* The optional callbacks */
+NNStreamer_custom_ext_class *NNStreamer_custom_ext = &NNStreamer_custom_ext_body;
@@ -99,6 +99,22 @@ pt_invoke (void *private_data, const GstTensorFilterProperties * prop,
   return 0;
 }
 
+/**
+ * @brief pt_in_place_invoke
+ */
+static int
+pt_in_place_invoke (void *private_data, const GstTensorFilterProperties * prop,
+    GstTensorMemory * tensors)
+{
+  pt_data *data = private_data;
+
+  g_assert (data);
+  g_assert (tensors);
+
+  /* output is the same as input, nothing to do */
+  return 0;
+}
+
 static NNStreamer_custom_class NNStreamer_custom_body = {
   .initfunc = pt_init,
   .exitfunc = pt_exit,
@@ -108,3 +124,11 @@ static NNStreamer_custom_class NNStreamer_custom_body = {
 
 /* The dyn-loaded object */
 NNStreamer_custom_class *NNStreamer_custom = &NNStreamer_custom_body;
+
+static NNStreamer_custom_ext_class NNStreamer_custom_ext_body = {
+  .size = sizeof (NNStreamer_custom_ext_class),
+  .in_place_invoke = pt_in_place_invoke,
+};
+
+/* The optional callbacks */
+NNStreamer_custom_ext_class *NNStreamer_custom_ext = &NNStreamer_custom_ext_body;
@@ -0,0 +1,50 @@
+#!/usr/bin/env python
+
+##
+# Copyright (C) 2018 Samsung Electronics
+# License: LGPL-2.1
+#
+# @file checkResult.py
+# @brief Compare the output tensors of nnscpu with the golden outputs
+#
+# usage: checkResult.py RESULT GOLDEN TYPE[,TYPE...] COUNT[,COUNT...]
+# The files have the output tensors in order; each has COUNT elements of TYPE (float32 or uint8).
+# float32 is compared with the tolerance of the summation order, and uint8 with the rounding error.
+
+import sys
+import numpy as np
+
+if len(sys.argv) != 5:
+    exit(9)
+
+result = open(sys.argv[1], 'rb').read()
+golden = open(sys.argv[2], 'rb').read()
+types = sys.argv[3].split(',')
+counts = [int(c) for c in sys.argv[4].split(',')]
+
+if len(result) != len(golden):
+    print('The size is not matched: %d / %d' % (len(result), len(golden)))
+    exit(1)
+
+offset = 0
+for i, (t, n) in enumerate(zip(types, counts)):
+    dtype = np.dtype(t)
+    r = np.frombuffer(result, dtype, n, offset).astype(np.float64)
+    g = np.frombuffer(golden, dtype, n, offset).astype(np.float64)
+    offset += n * dtype.itemsize
+
+    if t == 'uint8':
+        ok = np.abs(r - g) <= 1
+    else:
+        ok = np.abs(r - g) <= 1e-4 + 1e-4 * np.abs(g)
+
+    if not np.all(ok):
+        k = np.argmin(ok)
+        print('Tensor %d at %d: %r / %r' % (i, k, r[k], g[k]))
+        exit(2)
+
+if offset != len(golden):
+    print('Unchecked data: %d / %d' % (offset, len(golden)))
+    exit(3)
+
+exit(0)
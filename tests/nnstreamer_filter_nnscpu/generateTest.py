@@ -0,0 +1,328 @@
+#!/usr/bin/env python
+
+##
+# Copyright (C) 2018 Samsung Electronics
+# License: LGPL-2.1
+#
+# @file generateTest.py
+# @brief Generate the graphs of nnscpu, the input tensors and the golden outputs with the reference implementation
+#
+# The feature maps are NHWC (the dimension C:W:H:N of other/tensor).
+# Each test case N writes caseN.nnscpu, caseN.bin, caseN.in[0-9].raw and caseN.golden.
+
+import sys
+import math
+import numpy as np
+
+np.random.seed(20181016)
+
+
+def window(size, k, stride, same):
+    if same:
+        out = (size + stride - 1) // stride
+        total = (out - 1) * stride + k
+        pad = (total - size) // 2 if total > size else 0
+    else:
+        out = (size - k) // stride + 1
+        pad = 0
+    return out, pad
+
+
+def positions(o, k, stride, pad, size):
+    for i in range(k):
+        p = o * stride + i - pad
+        if 0 <= p < size:
+            yield i, p
+
+
+class Quant:
+    def __init__(self, scale, zero):
+        self.scale = scale
+        self.zero = zero
+
+
+def quantize(v, q, lo=0, hi=255):
+    return np.clip(np.floor(v + 0.5) + q.zero, lo, hi).astype(np.uint8)
+
+
+def act_range_f(act):
+    lo, hi = -np.inf, np.inf
+    if act in ('relu', 'relu6'):
+        lo = 0.0
+    if act == 'relu6':
+        hi = 6.0
+    return lo, hi
+
+
+def act_range_q(act, q):
+    lo, hi = 0, 255
+    if act in ('relu', 'relu6'):
+        lo = max(lo, q.zero)
+    if act == 'relu6':
+        hi = min(hi, q.zero + int(math.floor(6.0 / q.scale + 0.5)))
+    return lo, hi
+
+
+def conv2d(x, w, b, stride, same, act, xq=None, wq=None, yq=None, depthwise=False):
+    n, h, wd, c = x.shape
+    kh, kw = w.shape[0], w.shape[1]
+    oc = c if depthwise else w.shape[3]
+    ow, pl = window(wd, kw, stride[0], same)
+    oh, pt = window(h, kh, stride[1], same)
+    quant = xq is not None
+    acc = np.zeros((n, oh, ow, oc), dtype=np.int64 if quant else np.float64)
+
+    xs = x.astype(np.int64) - xq.zero if quant else x.astype(np.float64)
+    ws = w.astype(np.int64) - wq.zero if quant else w.astype(np.float64)
+
+    for oy in range(oh):
+        for ox in range(ow):
+            for ky, iy in positions(oy, kh, stride[1], pt, h):
+                for kx, ix in positions(ox, kw, stride[0], pl, wd):
+                    if depthwise:
+                        acc[:, oy, ox, :] += xs[:, iy, ix, :] * ws[ky, kx, :]
+                    else:
+                        acc[:, oy, ox, :] += xs[:, iy, ix, :].dot(ws[ky, kx])
+    if b is not None:
+        acc += b
+
+    if quant:
+        lo, hi = act_range_q(act, yq)
+        return quantize(acc * (xq.scale * wq.scale / yq.scale), yq, lo, hi)
+
+    lo, hi = act_range_f(act)
+    return np.clip(acc, lo, hi).astype(np.float32)
+
+
+def fc(x, w, b, act, xq=None, wq=None, yq=None):
+    n = x.shape[0]
+    quant = xq is not None
+    xs = x.reshape(n, -1).astype(np.int64 if quant else np.float64)
+    ws = w.astype(np.int64 if quant else np.float64)
+    if quant:
+        xs = xs - xq.zero
+        ws = ws - wq.zero
+    acc = xs.dot(ws)
+    if b is not None:
+        acc += b
+    acc = acc.reshape(n, 1, 1, -1)
+
+    if quant:
+        lo, hi = act_range_q(act, yq)
+        return quantize(acc * (xq.scale * wq.scale / yq.scale), yq, lo, hi)
+
+    lo, hi = act_range_f(act)
+    return np.clip(acc, lo, hi).astype(np.float32)
+
+
+def pool(x, size, stride, same, is_max):
+    n, h, wd, c = x.shape
+    ow, pl = window(wd, size[0], stride[0], same)
+    oh, pt = window(h, size[1], stride[1], same)
+    quant = (x.dtype == np.uint8)
+    y = np.zeros((n, oh, ow, c), dtype=x.dtype)
+
+    for oy in range(oh):
+        for ox in range(ow):
+            win = [x[:, iy, ix, :].astype(np.float64 if not quant else np.int64)
+                   for _, iy in positions(oy, size[1], stride[1], pt, h)
+                   for _, ix in positions(ox, size[0], stride[0], pl, wd)]
+            if is_max:
+                y[:, oy, ox, :] = np.max(win, axis=0)
+            elif quant:
+                y[:, oy, ox, :] = (np.sum(win, axis=0) + len(win) // 2) // len(win)
+            else:
+                y[:, oy, ox, :] = np.sum(win, axis=0) / len(win)
+    return y
+
+
+def softmax(x, xq=None, yq=None):
+    v = x.astype(np.float64)
+    if xq is not None:
+        v = xq.scale * (v - xq.zero)
+    e = np.exp(v - np.max(v, axis=-1, keepdims=True))
+    s = e / np.sum(e, axis=-1, keepdims=True)
+    if yq is not None:
+        return quantize(s / yq.scale, yq)
+    return s.astype(np.float32)
+
+
+def add(a, b, act, aq=None, bq=None, yq=None):
+    if aq is not None:
+        v = aq.scale * (a.astype(np.float64) - aq.zero) + \
+            bq.scale * (b.astype(np.float64) - bq.zero)
+        lo, hi = act_range_q(act, yq)
+        return quantize(v / yq.scale, yq, lo, hi)
+    lo, hi = act_range_f(act)
+    return np.clip(a.astype(np.float64) + b, lo, hi).astype(np.float32)
+
+
+def requantize(x, xq, yq):
+    if xq.scale == yq.scale and xq.zero == yq.zero:
+        return x
+    return quantize(xq.scale * (x.astype(np.float64) - xq.zero) / yq.scale, yq)
+
+
+def dims(a):
+    # NHWC to C:W:H:N
+    s = a.shape
+    while len(s) < 4:
+        s = (1,) + s
+    return '%d:%d:%d:%d' % (s[3], s[2], s[1], s[0])
+
+
+class Graph:
+    def __init__(self, name):
+        self.name = name
+        self.lines = ['# generated by generateTest.py', 'weights %s.bin' % name]
+        self.blob = b''
+        self.inputs = []
+
+    def input(self, name, a, q=None):
+        self.lines.append('input %s %s %s%s' % (name, dims(a), typename(a), qattr(q)))
+        self.inputs.append(a)
+
+    def const(self, name, a, q=None):
+        # align the offset for any type of element
+        self.blob += b'\0' * (-len(self.blob) % 16)
+        self.lines.append('const %s %s %s offset=%d%s' %
+                          (name, dims(a), typename(a), len(self.blob), qattr(q)))
+        self.blob += a.tobytes()
+
+    def op(self, line):
+        self.lines.append(line)
+
+    def write(self, outputs):
+        self.lines.append('output ' + ' '.join(n for n, _ in outputs))
+        with open(self.name + '.nnscpu', 'w') as f:
+            f.write('\n'.join(self.lines) + '\n')
+        with open(self.name + '.bin', 'wb') as f:
+            f.write(self.blob)
+        for i, a in enumerate(self.inputs):
+            with open('%s.in%d.raw' % (self.name, i), 'wb') as f:
+                f.write(a.tobytes())
+        with open(self.name + '.golden', 'wb') as f:
+            for _, a in outputs:
+                f.write(a.tobytes())
+
+
+def typename(a):
+    return {np.dtype(np.float32): 'float32', np.dtype(np.uint8): 'uint8',
+            np.dtype(np.int32): 'int32'}[a.dtype]
+
+
+def qattr(q):
+    return '' if q is None else ' scale=%r zero=%d' % (q.scale, q.zero)
+
+
+def randf(*shape):
+    return np.random.uniform(-1.0, 1.0, shape).astype(np.float32)
+
+
+def randq(*shape):
+    return np.random.randint(0, 256, shape).astype(np.uint8)
+
+
+# Case 1: float32 classifier, conv2d - maxpool - dwconv2d - avgpool - fc - softmax
+g = Graph('case1')
+x = randf(1, 12, 10, 3)
+w1, b1 = randf(3, 3, 3, 8), randf(8)
+w2, b2 = randf(3, 3, 8), randf(8)
+y = conv2d(x, w1, b1, (1, 1), True, 'relu')
+y = pool(y, (2, 2), (2, 2), False, True)
+y = conv2d(y, w2, b2, (1, 1), True, 'relu6', depthwise=True)
+y = pool(y, (3, 2), (2, 2), True, False)
+w3, b3 = randf(y[0].size, 10), randf(10)
+g.input('x', x)
+g.const('w1', w1)
+g.const('b1', b1)
+g.const('w2', w2.reshape(1, 3, 3, 8))
+g.const('b2', b2)
+g.const('w3', w3.reshape(1, 1, y[0].size, 10))
+g.const('b3', b3)
+g.op('conv2d c1 x w1 b1 pad=same act=relu')
+g.op('maxpool p1 c1 size=2 stride=2')
+g.op('dwconv2d c2 p1 w2 b2 pad=same act=relu6')
+g.op('avgpool p2 c2 size=3:2 stride=2 pad=same')
+g.op('fc f3 p2 w3 b3')
+g.op('softmax y f3')
+y = fc(y, w3, b3, 'none')
+g.write([('y', softmax(y))])
+
+# Case 2: float32 two inputs and two outputs, strided conv2d, add, relu6, concat
+g = Graph('case2')
+a, b = randf(1, 7, 9, 4), randf(1, 7, 9, 4)
+w1 = randf(2, 3, 4, 5)
+g.input('a', a)
+g.input('b', b)
+g.const('w1', w1)
+g.op('add s a b act=relu')
+g.op('conv2d c1 a w1 stride=2:1 pad=valid')
+g.op('relu6 r b')
+g.op('concat y s r axis=0')
+g.op('concat z y y axis=2')
+ys = add(a, b, 'relu')
+yc = conv2d(a, w1, None, (2, 1), False, 'none')
+yr = np.clip(b, 0.0, 6.0)
+yy = np.concatenate([ys, yr], axis=3)
+g.write([('c1', yc), ('z', np.concatenate([yy, yy], axis=1))])
+
+# Case 3: quantized uint8, conv2d - dwconv2d - maxpool - avgpool - fc - softmax, add and concat
+g = Graph('case3')
+xq, w1q, c1q = Quant(0.02, 128), Quant(0.005, 120), Quant(0.03, 10)
+w2q, c2q, w3q, f3q = Quant(0.01, 130), Quant(0.02, 0), Quant(0.004, 125), Quant(0.05, 100)
+x = randq(2, 11, 13, 3)
+w1 = randq(3, 3, 3, 6)
+b1 = np.random.randint(-2000, 2000, 6).astype(np.int32)
+w2 = randq(3, 3, 6)
+b2 = np.random.randint(-2000, 2000, 6).astype(np.int32)
+g.input('x', x, xq)
+g.const('w1', w1, w1q)
+g.const('b1', b1)
+g.const('w2', w2.reshape(1, 3, 3, 6), w2q)
+g.const('b2', b2)
+g.op('conv2d c1 x w1 b1 stride=2 pad=same act=relu scale=%r zero=%d' % (c1q.scale, c1q.zero))
+g.op('dwconv2d c2 c1 w2 b2 pad=same act=relu6 scale=%r zero=%d' % (c2q.scale, c2q.zero))
+g.op('maxpool p1 c2 size=2 stride=1')
+g.op('avgpool p2 c2 size=2 stride=2 pad=same')
+c1 = conv2d(x, w1, b1, (2, 2), True, 'relu', xq, w1q, c1q)
+c2 = conv2d(c1, w2, b2, (1, 1), True, 'relu6', c1q, w2q, c2q, depthwise=True)
+p1 = pool(c2, (2, 2), (1, 1), False, True)
+p2 = pool(c2, (2, 2), (2, 2), True, False)
+w3 = randq(p2[0].size, 7)
+b3 = np.random.randint(-500, 500, 7).astype(np.int32)
+g.const('w3', w3.reshape(1, 1, p2[0].size, 7), w3q)
+g.const('b3', b3)
+g.op('fc f3 p2 w3 b3 scale=%r zero=%d' % (f3q.scale, f3q.zero))
+g.op('softmax y f3')
+g.op('add s c2 c2 act=relu scale=0.03 zero=20')
+g.op('concat z s c2 axis=0 scale=0.025 zero=5')
+f3 = fc(p2, w3, b3, 'none', c2q, w3q, f3q)
+y = softmax(f3, f3q, Quant(1.0 / 256.0, 0))
+s = add(c2, c2, 'relu', c2q, c2q, Quant(0.03, 20))
+zq = Quant(0.025, 5)
+z = np.concatenate([requantize(s, Quant(0.03, 20), zq), requantize(c2, c2q, zq)], axis=3)
+g.write([('y', y), ('p1', p1), ('z', z)])
+
+# Benchmark: a small float32 CNN for 96x96 RGB input
+g = Graph('bench')
+x = randf(1, 96, 96, 3)
+g.input('x', x)
+g.const('w1', randf(3, 3, 3, 16))
+g.const('b1', randf(16))
+g.const('w2', randf(1, 3, 3, 16))
+g.const('b2', randf(16))
+g.const('w3', randf(1, 1, 16, 32))
+g.const('b3', randf(32))
+g.const('w4', randf(1, 1, 32 * 12 * 12, 10))
+g.op('conv2d c1 x w1 b1 stride=2 pad=same act=relu6')
+g.op('dwconv2d c2 c1 w2 b2 pad=same act=relu6')
+g.op('conv2d c3 c2 w3 b3 act=relu6')
+g.op('maxpool p3 c3 size=4 stride=4')
+g.op('fc f4 p3 w4')
+g.op('softmax y f4')
+g.lines.append('output y')
+with open('bench.nnscpu', 'w') as f:
+    f.write('\n'.join(g.lines) + '\n')
+with open('bench.bin', 'wb') as f:
+    f.write(g.blob)
@@ -0,0 +1,80 @@
+#!/usr/bin/env bash
+##
+## @file runTest.sh
+## @author MyungJoo Ham <myungjoo.ham@gmail.com>
+## @date Nov 01 2018
+## @brief SSAT Test Cases for NNStreamer
+##
+if [[ "$SSATAPILOADED" != "1" ]]
+then
+	SILENT=0
+	INDEPENDENT=1
+	search="ssat-api.sh"
+	source $search
+	printf "${Blue}Independent Mode${NC}
+"
+fi
+
+# This is compatible with SSAT (https://github.com/myungjoo/SSAT)
+testInit $1
+
+if [ "$SKIPGEN" == "YES" ]
+then
+  echo "Test Case Generation Skipped"
+  sopath=$2
+else
+  echo "Test Case Generation Started"
+  python generateTest.py
+  sopath=$1
+fi
+
+# The outputs of each case are written in order to a file. Run with the SIMD kernels and the scalar kernels.
+for ACCEL in true false; do
+	if [ "$ACCEL" == "true" ]; then
+		ID=0
+	else
+		ID=3
+	fi
+
+	# Case 1: float32 classifier (conv2d, maxpool, dwconv2d, avgpool, fc, softmax)
+	gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} filesrc location=case1.in0.raw ! application/octet-stream ! tensor_converter input-dim=3:10:12:1 input-type=float32 ! tensor_filter framework=nnscpu model=case1.nnscpu custom=Acceleration:${ACCEL} ! filesink location=case1.${ACCEL}.log" $(( ID + 1 )) 0 0 $PERFORMANCE
+	python checkResult.py case1.${ACCEL}.log case1.golden float32 10
+	testResult $? $(( ID + 1 )) "Golden test comparison of case 1, Acceleration:${ACCEL}" 0 1
+
+	# Case 2: float32 with two inputs and two outputs (add, strided valid conv2d, relu6, concat)
+	gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} tensor_mux name=mux ! tensor_filter framework=nnscpu model=case2.nnscpu custom=Acceleration:${ACCEL} ! filesink location=case2.${ACCEL}.log filesrc location=case2.in0.raw ! application/octet-stream ! tensor_converter input-dim=4:9:7:1 input-type=float32 ! mux.sink_0 filesrc location=case2.in1.raw ! application/octet-stream ! tensor_converter input-dim=4:9:7:1 input-type=float32 ! mux.sink_1" $(( ID + 2 )) 0 0 $PERFORMANCE
+	python checkResult.py case2.${ACCEL}.log case2.golden float32,float32 120,1008
+	testResult $? $(( ID + 2 )) "Golden test comparison of case 2, Acceleration:${ACCEL}" 0 1
+
+	# Case 3: quantized uint8 with the batch size 2 and three outputs
+	gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} filesrc location=case3.in0.raw ! application/octet-stream ! tensor_converter input-dim=3:13:11:2 input-type=uint8 ! tensor_filter framework=nnscpu model=case3.nnscpu custom=Acceleration:${ACCEL} ! filesink location=case3.${ACCEL}.log" $(( ID + 3 )) 0 0 $PERFORMANCE
+	python checkResult.py case3.${ACCEL}.log case3.golden uint8,uint8,uint8 14,360,1008
+	testResult $? $(( ID + 3 )) "Golden test comparison of case 3, Acceleration:${ACCEL}" 0 1
+done
+
+# Benchmark of the SIMD kernels and the scalar kernels, with 300 frames of 96x96 RGB
+for ACCEL in true false; do
+	if [ "$ACCEL" == "true" ]; then
+		TEST_ID=7
+	else
+		TEST_ID=8
+	fi
+	START_TIME=$(date +%s%N)
+	gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} videotestsrc num-buffers=300 ! video/x-raw,format=RGB,width=96,height=96,framerate=0/1 ! tensor_converter ! tensor_transform mode=typecast option=float32 ! tensor_filter framework=nnscpu model=bench.nnscpu custom=Acceleration:${ACCEL} ! fakesink" ${TEST_ID} 0 0 $PERFORMANCE
+	STOP_TIME=$(date +%s%N)
+	printf "Acceleration:${ACCEL}, 300 frames: $(( (STOP_TIME - START_TIME) / 1000000 )) ms\n"
+done
+
+# Tail latency (p99, usec) of invokes with and without pinning the invoke thread to the last CPU, with 300 frames
+LAST_CPU=$(( $(nproc) - 1 ))
+for PIN in none ${LAST_CPU}; do
+	if [ "$PIN" == "none" ]; then
+		PIN_OPTION=""
+	else
+		PIN_OPTION="cpu-affinity=${PIN}"
+	fi
+	P99=$(gst-launch-1.0 -m --gst-plugin-path=${PATH_TO_PLUGIN} videotestsrc num-buffers=300 ! video/x-raw,format=RGB,width=96,height=96,framerate=0/1 ! tensor_converter ! tensor_transform mode=typecast option=float32 ! tensor_filter framework=nnscpu model=bench.nnscpu stats-interval=100 ${PIN_OPTION} ! fakesink 2>&1 | grep -o "latency-p99=(uint)[0-9]*" | tail -n 1 | grep -o "[0-9]*$")
+	printf "cpu-affinity:${PIN}, latency-p99: ${P99} us\n"
+done
+
+report
@@ -0,0 +1,166 @@
+#!/usr/bin/env python
+
+##
+# Copyright (C) 2018 Samsung Electronics
+# License: LGPL-2.1
+#
+# @file generateTest.py
+# @brief Generate a frozen tensorflow graph, the input tensor and the golden outputs
+#
+# The graph (GraphDef) is encoded with the protobuf wire format without tensorflow.
+#   x (Placeholder, [?, 8, 8, 3]) - Conv2D 1x1 - BiasAdd - Relu (relu) - Mean over H, W - Softmax (prob)
+# The batch is unknown in the graph; tensor_filter feeds a frame as the batch 1.
+#
+# The second graph forwards the memory of the input tensor to the output.
+#   x (Placeholder, [?, 8, 8, 3]) - Reshape [?, 192] - Identity (y)
+
+import sys
+import struct
+import numpy as np
+
+np.random.seed(20181016)
+
+DT_FLOAT = 1
+DT_INT32 = 3
+
+
+def varint(n):
+    if n < 0:
+        n += 1 << 64
+    out = bytearray()
+    while True:
+        b = n & 0x7f
+        n >>= 7
+        if n:
+            out.append(b | 0x80)
+        else:
+            out.append(b)
+            return out
+
+
+def field(num, wire, payload):
+    return varint((num << 3) | wire) + payload
+
+
+def f_varint(num, n):
+    return field(num, 0, varint(n))
+
+
+def f_bytes(num, data):
+    if not isinstance(data, bytearray):
+        data = bytearray(data)
+    return field(num, 2, varint(len(data)) + data)
+
+
+def f_str(num, s):
+    return f_bytes(num, s.encode('ascii'))
+
+
+def shape(dims):
+    msg = bytearray()
+    for d in dims:
+        msg += f_bytes(2, f_varint(1, d))
+    return msg
+
+
+def tensor(a):
+    dtype = DT_FLOAT if a.dtype == np.float32 else DT_INT32
+    return (f_varint(1, dtype) + f_bytes(2, shape(a.shape)) +
+            f_bytes(4, a.tobytes()))
+
+
+def attr(key, value):
+    return f_bytes(5, f_str(1, key) + f_bytes(2, value))
+
+
+def a_type(t):
+    return f_varint(6, t)
+
+
+def a_shape(dims):
+    return f_bytes(7, shape(dims))
+
+
+def a_tensor(a):
+    return f_bytes(8, tensor(a))
+
+
+def a_str(s):
+    return f_str(2, s)
+
+
+def a_bool(b):
+    return f_varint(5, 1 if b else 0)
+
+
+def a_ints(ints):
+    packed = bytearray()
+    for i in ints:
+        packed += varint(i)
+    return f_bytes(1, f_bytes(3, packed))
+
+
+def node(name, op, inputs, attrs):
+    msg = f_str(1, name) + f_str(2, op)
+    for i in inputs:
+        msg += f_str(3, i)
+    for key, value in attrs:
+        msg += attr(key, value)
+    return f_bytes(1, msg)
+
+
+w = np.random.uniform(-1.0, 1.0, (1, 1, 3, 4)).astype(np.float32)
+b = np.random.uniform(-0.5, 0.5, (4,)).astype(np.float32)
+axes = np.array([1, 2], dtype=np.int32)
+
+graph = bytearray()
+graph += node('x', 'Placeholder', [],
+              [('dtype', a_type(DT_FLOAT)), ('shape', a_shape([-1, 8, 8, 3]))])
+graph += node('w', 'Const', [],
+              [('dtype', a_type(DT_FLOAT)), ('value', a_tensor(w))])
+graph += node('b', 'Const', [],
+              [('dtype', a_type(DT_FLOAT)), ('value', a_tensor(b))])
+graph += node('axes', 'Const', [],
+              [('dtype', a_type(DT_INT32)), ('value', a_tensor(axes))])
+graph += node('conv', 'Conv2D', ['x', 'w'],
+              [('T', a_type(DT_FLOAT)), ('strides', a_ints([1, 1, 1, 1])),
+               ('padding', a_str('SAME')), ('data_format', a_str('NHWC'))])
+graph += node('bias', 'BiasAdd', ['conv', 'b'], [('T', a_type(DT_FLOAT))])
+graph += node('relu', 'Relu', ['bias'], [('T', a_type(DT_FLOAT))])
+graph += node('mean', 'Mean', ['relu', 'axes'],
+              [('T', a_type(DT_FLOAT)), ('Tidx', a_type(DT_INT32)),
+               ('keep_dims', a_bool(False))])
+graph += node('prob', 'Softmax', ['mean'], [('T', a_type(DT_FLOAT))])
+graph += f_bytes(4, f_varint(1, 26))
+
+with open('model.pb', 'wb') as f:
+    f.write(graph)
+
+reshape = np.array([-1, 192], dtype=np.int32)
+
+graph = bytearray()
+graph += node('x', 'Placeholder', [],
+              [('dtype', a_type(DT_FLOAT)), ('shape', a_shape([-1, 8, 8, 3]))])
+graph += node('shape', 'Const', [],
+              [('dtype', a_type(DT_INT32)), ('value', a_tensor(reshape))])
+graph += node('reshape', 'Reshape', ['x', 'shape'],
+              [('T', a_type(DT_FLOAT)), ('Tshape', a_type(DT_INT32))])
+graph += node('y', 'Identity', ['reshape'], [('T', a_type(DT_FLOAT))])
+graph += f_bytes(4, f_varint(1, 26))
+
+with open('model_identity.pb', 'wb') as f:
+    f.write(graph)
+
+x = np.random.uniform(-1.0, 1.0, (1, 8, 8, 3)).astype(np.float32)
+with open('input.raw', 'wb') as f:
+    f.write(x.tobytes())
+
+relu = np.maximum(np.tensordot(x, w[0, 0], axes=([3], [0])) + b, 0.0)
+mean = relu.mean(axis=(1, 2))
+prob = np.exp(mean - mean.max()) / np.exp(mean - mean.max()).sum()
+
+with open('prob.golden', 'wb') as f:
+    f.write(prob.astype(np.float32).tobytes())
+with open('relu_prob.golden', 'wb') as f:
+    f.write(relu.astype(np.float32).tobytes())
+    f.write(prob.astype(np.float32).tobytes())
@@ -0,0 +1,49 @@
+#!/usr/bin/env bash
+##
+## @file runTest.sh
+## @author MyungJoo Ham <myungjoo.ham@gmail.com>
+## @date Nov 01 2018
+## @brief SSAT Test Cases for NNStreamer
+##
+if [[ "$SSATAPILOADED" != "1" ]]
+then
+	SILENT=0
+	INDEPENDENT=1
+	search="ssat-api.sh"
+	source $search
+	printf "${Blue}Independent Mode${NC}
+"
+fi
+
+# This is compatible with SSAT (https://github.com/myungjoo/SSAT)
+testInit $1
+
+if [ "$SKIPGEN" == "YES" ]
+then
+  echo "Test Case Generation Skipped"
+  sopath=$2
+else
+  echo "Test Case Generation Started"
+  python generateTest.py
+  sopath=$1
+fi
+
+# Run the model on CPU only
+export CUDA_VISIBLE_DEVICES=""
+
+# The input and output tensors found in the graph (the placeholder and the softmax)
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} filesrc location=input.raw ! application/octet-stream ! tensor_converter input-dim=3:8:8:1 input-type=float32 ! tensor_filter framework=tensorflow model=model.pb ! filesink location=tensorfilter.out.1.log" 1 0 0 $PERFORMANCE
+python checkResult.py tensorfilter.out.1.log prob.golden float32 4
+testResult $? 1 "Golden test comparison" 0 1
+
+# The output tensors given by the names
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} filesrc location=input.raw ! application/octet-stream ! tensor_converter input-dim=3:8:8:1 input-type=float32 ! tensor_filter framework=tensorflow model=model.pb custom=Input:x,Output:relu,Output:prob ! filesink location=tensorfilter.out.2.log" 2 0 0 $PERFORMANCE
+python checkResult.py tensorfilter.out.2.log relu_prob.golden float32,float32 256,4
+testResult $? 2 "Golden test comparison with the output tensors given by the names" 0 1
+
+# The output tensor forwarded from the memory of the input tensor (Reshape and Identity), copied before upstream releases the input
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} filesrc location=input.raw ! application/octet-stream ! tensor_converter input-dim=3:8:8:1 input-type=float32 ! tensor_filter framework=tensorflow model=model_identity.pb ! filesink location=tensorfilter.out.3.log" 3 0 0 $PERFORMANCE
+python checkResult.py tensorfilter.out.3.log input.raw float32 192
+testResult $? 3 "Golden test comparison of the output forwarded from the input" 0 1
+
+report
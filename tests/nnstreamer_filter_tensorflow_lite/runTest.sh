@@ -27,4 +27,35 @@ gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} filesrc location=\"${PATH_TO_IMAGE}
 python checkLabel.py tensorfilter.out.log ${PATH_TO_LABEL} ${PATH_TO_IMAGE}
 testResult $? 1 "Golden test comparison" 0 1
 
+# Test the interpreter pool with asynchronous invoke
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} filesrc location=\"${PATH_TO_IMAGE}\" ! pngdec ! videoscale ! imagefreeze ! videoconvert ! video/x-raw, format=RGB, framerate=0/1 ! tensor_converter ! tensor_filter framework=\"tensorflow-lite\" model=\"${PATH_TO_MODEL}\" custom=NumInterpreters:4 max-inflight=4 ! filesink location=\"tensorfilter.out.2.log\" " 2 0 0 $PERFORMANCE
+python checkLabel.py tensorfilter.out.2.log ${PATH_TO_LABEL} ${PATH_TO_IMAGE}
+testResult $? 2 "Golden test comparison with interpreter pool" 0 1
+
+# Test the model cache (startup benchmark), 10 filters share the model loaded once
+FILTERS=""
+for i in $(seq 2 10); do
+	FILTERS="${FILTERS} t. ! queue ! tensor_filter framework=\"tensorflow-lite\" model=\"${PATH_TO_MODEL}\" ! fakesink"
+done
+START_TIME=$(date +%s%N)
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} filesrc location=\"${PATH_TO_IMAGE}\" ! pngdec ! videoscale ! imagefreeze ! videoconvert ! video/x-raw, format=RGB, framerate=0/1 ! tensor_converter ! tee name=t t. ! queue ! tensor_filter framework=\"tensorflow-lite\" model=\"${PATH_TO_MODEL}\" ! filesink location=\"tensorfilter.out.3.log\" ${FILTERS}" 3 0 0 $PERFORMANCE
+STOP_TIME=$(date +%s%N)
+printf "10 filters with a model: $(( (STOP_TIME - START_TIME) / 1000000 )) ms\n"
+python checkLabel.py tensorfilter.out.3.log ${PATH_TO_LABEL} ${PATH_TO_IMAGE}
+testResult $? 3 "Golden test comparison with 10 filters sharing a model" 0 1
+
+# CPU-only benchmark of the number of threads (1 and 4), with 30 frames
+for THREADS in 1 4; do
+	TEST_ID=$(( 3 + THREADS / 4 + 1 ))
+	START_TIME=$(date +%s%N)
+	gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} filesrc location=\"${PATH_TO_IMAGE}\" ! pngdec ! videoscale ! imagefreeze num-buffers=30 ! videoconvert ! video/x-raw, format=RGB, framerate=0/1 ! tensor_converter ! tensor_filter framework=\"tensorflow-lite\" model=\"${PATH_TO_MODEL}\" custom=NumThreads:${THREADS},Delegate:CPU ! filesink location=\"tensorfilter.out.${TEST_ID}.log\" " ${TEST_ID} 0 0 $PERFORMANCE
+	STOP_TIME=$(date +%s%N)
+	printf "NumThreads:${THREADS}, 30 frames: $(( (STOP_TIME - START_TIME) / 1000000 )) ms\n"
+done
+
+# Test the input dimension given by caps (setInputDimension) with the interpreters prepared for the input shapes
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} filesrc location=\"${PATH_TO_IMAGE}\" ! pngdec ! videoscale ! imagefreeze ! videoconvert ! video/x-raw, format=RGB, framerate=0/1 ! tensor_converter ! tensor_filter framework=\"tensorflow-lite\" model=\"${PATH_TO_MODEL}\" custom=NumShapes:2 ! filesink location=\"tensorfilter.out.6.log\" " 6 0 0 $PERFORMANCE
+python checkLabel.py tensorfilter.out.6.log ${PATH_TO_LABEL} ${PATH_TO_IMAGE}
+testResult $? 6 "Golden test comparison with the input dimension given by caps" 0 1
+
 report
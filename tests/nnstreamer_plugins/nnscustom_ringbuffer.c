@@ -0,0 +1,177 @@
+/**
+ * "Ring Buffer"
+ * NNStreamer Custom Filter for Zero-Copy Output Test
+ * Copyright (C) 2018 Samsung Electronics Co., Ltd.
+ *
+ * LICENSE: LGPL-2.1
+ *
+ * @file  nnscustom_ringbuffer.c
+ * @date  16 Oct 2026
+ * @brief  Custom filter that gives you the frame number as 1:1:1:1 uint32 tensor, written in the ring buffer owned by this filter
+ *
+ * Input: ANY other/tensor
+ * Output: 1:1:1:1 uint32 other/tensor
+ *
+ * The output tensor is a slot of the ring buffer (RING_SIZE slots), which flows downstream without copy.
+ * The slot is recycled when the last buffer referring it is released.
+ * If all slots are in use, invoke fails.
+ *
+ * @bug  No known bugs
+ */
+
+#include <tensor_filter_custom.h>
+#include <assert.h>
+#include <glib.h>
+
+/**
+ * @brief The number of slots in the ring buffer
+ */
+#define RING_SIZE 2
+
+typedef struct _ring_data ring_data;
+
+/**
+ * @brief A slot of the ring buffer
+ */
+typedef struct
+{
+  uint32_t value; /***< The output tensor */
+  volatile gint in_use; /***< 1 if the output tensor is not released */
+  ring_data *ring; /***< The ring buffer of this slot */
+} ring_slot;
+
+/**
+ * @brief nnstreamer custom filter private data for Ring Buffer
+ */
+struct _ring_data
+{
+  volatile gint refcount; /***< Released after exit and all slots are released */
+  uint32_t counter; /***< This counts the frame number from 0 */
+  unsigned int next; /***< The next slot to be used */
+  ring_slot slots[RING_SIZE]; /***< The ring buffer */
+};
+
+/**
+ * @brief Unref the ring buffer and free it with the last reference.
+ */
+static void
+ring_unref (ring_data * ring)
+{
+  if (g_atomic_int_dec_and_test (&ring->refcount))
+    g_free (ring);
+}
+
+/**
+ * @brief nnstreamer custom filter standard vmethod
+ * Refer tensor_filter_custom.h
+ */
+static void *
+pt_init (const GstTensorFilterProperties * prop)
+{
+  ring_data *ring = g_new0 (ring_data, 1);
+  unsigned int i;
+
+  ring->refcount = 1;
+  for (i = 0; i < RING_SIZE; i++)
+    ring->slots[i].ring = ring;
+
+  return ring;
+}
+
+/**
+ * @brief nnstreamer custom filter standard vmethod
+ * Refer tensor_filter_custom.h
+ */
+static void
+pt_exit (void *_data, const GstTensorFilterProperties * prop)
+{
+  ring_data *ring = _data;
+
+  assert (ring);
+  ring_unref (ring);
+}
+
+/**
+ * @brief nnstreamer custom filter standard vmethod
+ * Refer tensor_filter_custom.h
+ */
+static int
+set_inputDim (void *_data, const GstTensorFilterProperties * prop,
+    const GstTensorsInfo * in_info, GstTensorsInfo * out_info)
+{
+  int i;
+
+  out_info->num_tensors = 1;
+  for (i = 0; i < NNS_TENSOR_RANK_LIMIT; i++)
+    out_info->info[0].dimension[i] = 1;
+  out_info->info[0].type = _NNS_UINT32;
+
+  return 0;
+}
+
+/**
+ * @brief Release callback of the output tensor, the slot will be recycled.
+ */
+static void
+release_slot (void *user_data)
+{
+  ring_slot *slot = user_data;
+
+  g_atomic_int_set (&slot->in_use, 0);
+  ring_unref (slot->ring);
+}
+
+/**
+ * @brief nnstreamer custom filter standard vmethod
+ * Refer tensor_filter_custom.h
+ */
+static int
+allocate_invoke_release (void *_data, const GstTensorFilterProperties * prop,
+    const GstTensorMemory * input, GstTensorMemory * output,
+    NNS_custom_release_func * release, void **user_data)
+{
+  ring_data *ring = _data;
+  ring_slot *slot;
+  unsigned int i;
+
+  for (i = 0; i < RING_SIZE; i++) {
+    slot = &ring->slots[(ring->next + i) % RING_SIZE];
+
+    if (g_atomic_int_compare_and_exchange (&slot->in_use, 0, 1))
+      break;
+  }
+
+  /* all slots are in use */
+  if (i == RING_SIZE)
+    return -1;
+
+  ring->next = (ring->next + i + 1) % RING_SIZE;
+
+  slot->value = ring->counter;
+  ring->counter = ring->counter + 1;
+
+  /* the slot holds the ring buffer until released */
+  g_atomic_int_inc (&ring->refcount);
+
+  output[0].data = &slot->value;
+  release[0] = release_slot;
+  user_data[0] = slot;
+  return 0;
+}
+
+static NNStreamer_custom_class NNStreamer_custom_body = {
+  .initfunc = pt_init,
+  .exitfunc = pt_exit,
+  .setInputDim = set_inputDim,
+};
+
+/* The dyn-loaded object */
+NNStreamer_custom_class *NNStreamer_custom = &NNStreamer_custom_body;
+
+static NNStreamer_custom_ext_class NNStreamer_custom_ext_body = {
+  .size = sizeof (NNStreamer_custom_ext_class),
+  .allocate_invoke_release = allocate_invoke_release,
+};
+
+/* The optional callbacks */
+NNStreamer_custom_ext_class *NNStreamer_custom_ext = &NNStreamer_custom_ext_body;
@@ -8,6 +8,10 @@
  */
 
 #include <string.h>
+#include <math.h>
+#ifdef __linux__
+#include <sched.h>
+#endif
 #include <gtest/gtest.h>
 #include <gst/gst.h>
 #include <gst/check/gstcheck.h>
@@ -1773,1272 +1777,2962 @@ TEST (test_tensor_transform, arithmetic_5_accel)
   gst_harness_teardown (h);
 }
 
-#ifdef HAVE_ORC
-#include "../../gst/tensor_transform/transform-orc.h"
-
 /**
- * @brief Test for tensor_transform orc functions (add constant value)
+ * @brief Test for tensor_transform arithmetic (typecast uint8 > float32, add -127.5, div 127.5, larger than a block of fused operators)
  */
-TEST (test_tensor_transform, orc_add)
+TEST (test_tensor_transform, arithmetic_6)
 {
-  const guint array_size = 10;
-  guint i;
+  const guint num_buffers = 3;
+  const guint array_size = 3 * 700;
 
-  /* add constant s8 */
-  int8_t data_s8[array_size] = { 0, };
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstTensorConfig config;
+  GstMemory *mem;
+  GstMapInfo info;
+  guint i, b;
+  gsize data_in_size, data_out_size;
 
-  for (i = 0; i < array_size; i++) {
-    data_s8[i] = i - 1;
-  }
+  h = gst_harness_new ("tensor_transform");
 
-  nns_orc_add_c_s8 (data_s8, -20, array_size);
+  g_object_set (h->element, "mode", "arithmetic",
+      "option", "typecast:float32,add:-127.5,div:127.5", NULL);
+  g_object_set (h->element, "acceleration", (gboolean) FALSE, NULL);
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_EQ (data_s8[i], i - 1 - 20);
-  }
+  /* input tensor info */
+  config.info.type = _NNS_UINT8;
+  get_tensor_dimension ("3:700", config.info.dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
 
-  for (i = 0; i < array_size; i++) {
-    data_s8[i] = i + 1;
-  }
+  gst_harness_set_src_caps (h, gst_tensor_caps_from_config (&config));
+  data_in_size = gst_tensor_info_get_size (&config.info);
 
-  nns_orc_add_c_s8 (data_s8, 20, array_size);
+  config.info.type = _NNS_FLOAT32;
+  data_out_size = gst_tensor_info_get_size (&config.info);
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_EQ (data_s8[i], i + 1 + 20);
-  }
+  /* push buffers */
+  for (b = 0; b < num_buffers; b++) {
+    /* set input buffer */
+    in_buf = gst_harness_create_buffer (h, data_in_size);
 
-  /* add constant u8 */
-  uint8_t data_u8[array_size] = { 0, };
+    mem = gst_buffer_peek_memory (in_buf, 0);
+    ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_WRITE));
 
-  for (i = 0; i < array_size; i++) {
-    data_u8[i] = i + 1;
-  }
+    for (i = 0; i < array_size; i++) {
+      uint8_t value = (i * 7 + b) % 256;
+      ((uint8_t *) info.data)[i] = value;
+    }
 
-  nns_orc_add_c_u8 (data_u8, 3, array_size);
+    gst_memory_unmap (mem, &info);
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_EQ (data_u8[i], i + 1 + 3);
-  }
+    EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
 
-  /* add constant s16 */
-  int16_t data_s16[array_size] = { 0, };
+    /* get output buffer */
+    out_buf = gst_harness_pull (h);
 
-  for (i = 0; i < array_size; i++) {
-    data_s16[i] = i - 1;
-  }
+    ASSERT_TRUE (out_buf != NULL);
+    ASSERT_EQ (gst_buffer_n_memory (out_buf), 1);
+    ASSERT_EQ (gst_buffer_get_size (out_buf), data_out_size);
 
-  nns_orc_add_c_s16 (data_s16, -16, array_size);
+    mem = gst_buffer_peek_memory (out_buf, 0);
+    ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_READ));
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_EQ (data_s16[i], i - 1 - 16);
-  }
+    for (i = 0; i < array_size; i++) {
+      float expected = ((float) ((i * 7 + b) % 256) - 127.5f) / 127.5f;
+      EXPECT_FLOAT_EQ (((float *) info.data)[i], expected);
+    }
 
-  for (i = 0; i < array_size; i++) {
-    data_s16[i] = i + 1;
+    gst_memory_unmap (mem, &info);
+    gst_buffer_unref (out_buf);
   }
 
-  nns_orc_add_c_s16 (data_s16, 16, array_size);
+  EXPECT_EQ (gst_harness_buffers_received (h), num_buffers);
+  gst_harness_teardown (h);
+}
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_EQ (data_s16[i], i + 1 + 16);
-  }
+/**
+ * @brief Test for tensor_transform arithmetic (acceleration, typecast uint8 > float32, add -127.5, div 127.5, larger than a block of fused operators)
+ */
+TEST (test_tensor_transform, arithmetic_6_accel)
+{
+  const guint num_buffers = 3;
+  const guint array_size = 3 * 700;
 
-  /* add constant u16 */
-  uint16_t data_u16[array_size] = { 0, };
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstTensorConfig config;
+  GstMemory *mem;
+  GstMapInfo info;
+  guint i, b;
+  gsize data_in_size, data_out_size;
 
-  for (i = 0; i < array_size; i++) {
-    data_u16[i] = i + 1;
-  }
+  h = gst_harness_new ("tensor_transform");
 
-  nns_orc_add_c_u16 (data_u16, 17, array_size);
+  g_object_set (h->element, "mode", "arithmetic",
+      "option", "typecast:float32,add:-127.5,div:127.5", NULL);
+  g_object_set (h->element, "acceleration", (gboolean) TRUE, NULL);
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_EQ (data_u16[i], i + 1 + 17);
-  }
+  /* input tensor info */
+  config.info.type = _NNS_UINT8;
+  get_tensor_dimension ("3:700", config.info.dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
 
-  /* add constant s32 */
-  int32_t data_s32[array_size] = { 0, };
+  gst_harness_set_src_caps (h, gst_tensor_caps_from_config (&config));
+  data_in_size = gst_tensor_info_get_size (&config.info);
 
-  for (i = 0; i < array_size; i++) {
-    data_s32[i] = i + 1;
-  }
+  config.info.type = _NNS_FLOAT32;
+  data_out_size = gst_tensor_info_get_size (&config.info);
 
-  nns_orc_add_c_s32 (data_s32, -32, array_size);
+  /* push buffers */
+  for (b = 0; b < num_buffers; b++) {
+    /* set input buffer */
+    in_buf = gst_harness_create_buffer (h, data_in_size);
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_EQ (data_s32[i], i + 1 - 32);
-  }
+    mem = gst_buffer_peek_memory (in_buf, 0);
+    ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_WRITE));
 
-  for (i = 0; i < array_size; i++) {
-    data_s32[i] = i + 1;
-  }
+    for (i = 0; i < array_size; i++) {
+      uint8_t value = (i * 7 + b) % 256;
+      ((uint8_t *) info.data)[i] = value;
+    }
 
-  nns_orc_add_c_s32 (data_s32, 32, array_size);
+    gst_memory_unmap (mem, &info);
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_EQ (data_s32[i], i + 1 + 32);
-  }
+    EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
 
-  /* add constant u32 */
-  uint32_t data_u32[array_size] = { 0, };
+    /* get output buffer */
+    out_buf = gst_harness_pull (h);
 
-  for (i = 0; i < array_size; i++) {
-    data_u32[i] = i + 1;
-  }
+    ASSERT_TRUE (out_buf != NULL);
+    ASSERT_EQ (gst_buffer_n_memory (out_buf), 1);
+    ASSERT_EQ (gst_buffer_get_size (out_buf), data_out_size);
 
-  nns_orc_add_c_u32 (data_u32, 33, array_size);
+    mem = gst_buffer_peek_memory (out_buf, 0);
+    ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_READ));
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_EQ (data_u32[i], i + 1 + 33);
+    for (i = 0; i < array_size; i++) {
+      float expected = ((float) ((i * 7 + b) % 256) - 127.5f) / 127.5f;
+      EXPECT_FLOAT_EQ (((float *) info.data)[i], expected);
+    }
+
+    gst_memory_unmap (mem, &info);
+    gst_buffer_unref (out_buf);
   }
 
-  /* add constant f32 */
-  float data_f32[array_size] = { 0, };
+  EXPECT_EQ (gst_harness_buffers_received (h), num_buffers);
+  gst_harness_teardown (h);
+}
 
-  for (i = 0; i < array_size; i++) {
-    data_f32[i] = i - .1;
-  }
+/**
+ * @brief Test for tensor_transform arithmetic (division by zero, caps not negotiated)
+ */
+TEST (test_tensor_transform, arithmetic_div_zero)
+{
+  GstHarness *h;
+  GstBuffer *in_buf;
+  GstTensorConfig config;
 
-  nns_orc_add_c_f32 (data_f32, -10.2, array_size);
+  h = gst_harness_new ("tensor_transform");
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_FLOAT_EQ (data_f32[i], i - .1 - 10.2);
-  }
+  g_object_set (h->element, "mode", "arithmetic",
+      "option", "typecast:int32,div:0.4", NULL);
 
-  for (i = 0; i < array_size; i++) {
-    data_f32[i] = i + .1;
-  }
+  /* input tensor info, the operand 0.4 is 0 in int32 */
+  config.info.type = _NNS_UINT8;
+  get_tensor_dimension ("5", config.info.dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
 
-  nns_orc_add_c_f32 (data_f32, 10.2, array_size);
+  gst_harness_set_src_caps (h, gst_tensor_caps_from_config (&config));
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_FLOAT_EQ (data_f32[i], i + .1 + 10.2);
-  }
+  in_buf = gst_harness_create_buffer (h,
+      gst_tensor_info_get_size (&config.info));
+  EXPECT_NE (gst_harness_push (h, in_buf), GST_FLOW_OK);
 
-  /* add constant f64 */
-  double data_f64[array_size] = { 0, };
+  gst_harness_teardown (h);
+}
 
-  for (i = 0; i < array_size; i++) {
-    data_f64[i] = i - .1;
-  }
+/**
+ * @brief Test for tensor_transform transpose (negative axis, caps not negotiated)
+ */
+TEST (test_tensor_transform, transpose_invalid_axis)
+{
+  GstHarness *h;
+  GstBuffer *in_buf;
+  GstTensorConfig config;
 
-  nns_orc_add_c_f64 (data_f64, -20.5, array_size);
+  h = gst_harness_new ("tensor_transform");
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_DOUBLE_EQ (data_f64[i], i - .1 - 20.5);
-  }
+  g_object_set (h->element, "mode", "transpose", "option", "-1:0:1:2", NULL);
 
-  for (i = 0; i < array_size; i++) {
-    data_f64[i] = i + .2;
-  }
+  /* input tensor info */
+  config.info.type = _NNS_UINT8;
+  get_tensor_dimension ("3:4:2:1", config.info.dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
 
-  nns_orc_add_c_f64 (data_f64, 20.5, array_size);
+  gst_harness_set_src_caps (h, gst_tensor_caps_from_config (&config));
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_DOUBLE_EQ (data_f64[i], i + .2 + 20.5);
-  }
+  in_buf = gst_harness_create_buffer (h,
+      gst_tensor_info_get_size (&config.info));
+  EXPECT_NE (gst_harness_push (h, in_buf), GST_FLOW_OK);
+
+  gst_harness_teardown (h);
 }
 
 /**
- * @brief Test for tensor_transform orc functions (mul constant value)
+ * @brief Test for tensor_transform normalize (typecast uint8 > float32, interleaved channels at the dimension 0)
  */
-TEST (test_tensor_transform, orc_mul)
+TEST (test_tensor_transform, normalize_1)
 {
-  const guint array_size = 10;
-  guint i;
-
-  /* mul constant s8 */
-  int8_t data_s8[array_size] = { 0, };
+  const guint num_buffers = 3;
+  const guint array_size = 3 * 4 * 2;
+  const float mean[3] = { 123.7, 116.3, 103.5 };
+  const float std[3] = { 58.4, 57.1, 57.4 };
 
-  for (i = 0; i < array_size; i++) {
-    data_s8[i] = i + 1;
-  }
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstTensorConfig config;
+  GstMemory *mem;
+  GstMapInfo info;
+  guint i, b, c;
+  gsize data_in_size, data_out_size;
 
-  nns_orc_mul_c_s8 (data_s8, -3, array_size);
+  h = gst_harness_new ("tensor_transform");
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_EQ (data_s8[i], (i + 1) * (-3));
-  }
+  g_object_set (h->element, "mode", "normalize",
+      "option", "typecast:float32;mean:123.7,116.3,103.5;std:58.4,57.1,57.4;axis:0", NULL);
+
+  /* input tensor info */
+  config.info.type = _NNS_UINT8;
+  get_tensor_dimension ("3:4:2", config.info.dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+
+  gst_harness_set_src_caps (h, gst_tensor_caps_from_config (&config));
+  data_in_size = gst_tensor_info_get_size (&config.info);
+
+  config.info.type = _NNS_FLOAT32;
+  data_out_size = gst_tensor_info_get_size (&config.info);
+
+  /* push buffers */
+  for (b = 0; b < num_buffers; b++) {
+    /* set input buffer */
+    in_buf = gst_harness_create_buffer (h, data_in_size);
+
+    mem = gst_buffer_peek_memory (in_buf, 0);
+    ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_WRITE));
+
+    for (i = 0; i < array_size; i++) {
+      uint8_t value = (i * 11 + b) % 256;
+      ((uint8_t *) info.data)[i] = value;
+    }
+
+    gst_memory_unmap (mem, &info);
+
+    EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+
+    /* get output buffer */
+    out_buf = gst_harness_pull (h);
+
+    ASSERT_TRUE (out_buf != NULL);
+    ASSERT_EQ (gst_buffer_n_memory (out_buf), 1);
+    ASSERT_EQ (gst_buffer_get_size (out_buf), data_out_size);
+
+    mem = gst_buffer_peek_memory (out_buf, 0);
+    ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_READ));
+
+    for (i = 0; i < array_size; i++) {
+      float expected;
+
+      c = i % 3;
+      expected = ((float) ((i * 11 + b) % 256) - mean[c]) / std[c];
+      EXPECT_FLOAT_EQ (((float *) info.data)[i], expected);
+    }
+
+    gst_memory_unmap (mem, &info);
+    gst_buffer_unref (out_buf);
+  }
+
+  EXPECT_EQ (gst_harness_buffers_received (h), num_buffers);
+  gst_harness_teardown (h);
+}
+
+/**
+ * @brief Test for tensor_transform normalize (float32, planar channels at the dimension 2 with a std for all channels)
+ */
+TEST (test_tensor_transform, normalize_2)
+{
+  const guint num_buffers = 3;
+  const guint array_size = 4 * 2 * 3;
+  const float mean[3] = { 123.7, 116.3, 103.5 };
+  const float std[3] = { 0.5, 0.5, 0.5 };
+
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstTensorConfig config;
+  GstMemory *mem;
+  GstMapInfo info;
+  guint i, b, c;
+  gsize data_in_size, data_out_size;
+
+  h = gst_harness_new ("tensor_transform");
+
+  g_object_set (h->element, "mode", "normalize",
+      "option", "mean:123.7,116.3,103.5;std:0.5;axis:2", NULL);
+
+  /* input tensor info */
+  config.info.type = _NNS_FLOAT32;
+  get_tensor_dimension ("4:2:3", config.info.dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+
+  gst_harness_set_src_caps (h, gst_tensor_caps_from_config (&config));
+  data_in_size = gst_tensor_info_get_size (&config.info);
+
+  config.info.type = _NNS_FLOAT32;
+  data_out_size = gst_tensor_info_get_size (&config.info);
+
+  /* push buffers */
+  for (b = 0; b < num_buffers; b++) {
+    /* set input buffer */
+    in_buf = gst_harness_create_buffer (h, data_in_size);
+
+    mem = gst_buffer_peek_memory (in_buf, 0);
+    ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_WRITE));
+
+    for (i = 0; i < array_size; i++) {
+      float value = (i + 1) * (b + 1) * 7.5;
+      ((float *) info.data)[i] = value;
+    }
+
+    gst_memory_unmap (mem, &info);
+
+    EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+
+    /* get output buffer */
+    out_buf = gst_harness_pull (h);
+
+    ASSERT_TRUE (out_buf != NULL);
+    ASSERT_EQ (gst_buffer_n_memory (out_buf), 1);
+    ASSERT_EQ (gst_buffer_get_size (out_buf), data_out_size);
+
+    mem = gst_buffer_peek_memory (out_buf, 0);
+    ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_READ));
+
+    for (i = 0; i < array_size; i++) {
+      float expected;
+
+      c = i / 8;
+      expected = ((float) ((i + 1) * (b + 1) * 7.5) - mean[c]) / std[c];
+      EXPECT_FLOAT_EQ (((float *) info.data)[i], expected);
+    }
+
+    gst_memory_unmap (mem, &info);
+    gst_buffer_unref (out_buf);
+  }
+
+  EXPECT_EQ (gst_harness_buffers_received (h), num_buffers);
+  gst_harness_teardown (h);
+}
+
+/**
+ * @brief Test for tensor_transform normalize (typecast uint8 > float32, a mean and std for all elements with the large dimension of the axis)
+ */
+TEST (test_tensor_transform, normalize_3)
+{
+  const guint num_buffers = 3;
+  const guint array_size = 3 * 224 * 2;
+
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstTensorConfig config;
+  GstMemory *mem;
+  GstMapInfo info;
+  guint i, b;
+  gsize data_in_size, data_out_size;
+
+  h = gst_harness_new ("tensor_transform");
+
+  g_object_set (h->element, "mode", "normalize",
+      "option", "typecast:float32;mean:127.5;std:127.5;axis:1", NULL);
+
+  /* input tensor info, 224 channels at the dimension 1 */
+  config.info.type = _NNS_UINT8;
+  get_tensor_dimension ("3:224:2", config.info.dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+
+  gst_harness_set_src_caps (h, gst_tensor_caps_from_config (&config));
+  data_in_size = gst_tensor_info_get_size (&config.info);
+
+  config.info.type = _NNS_FLOAT32;
+  data_out_size = gst_tensor_info_get_size (&config.info);
+
+  /* push buffers */
+  for (b = 0; b < num_buffers; b++) {
+    /* set input buffer */
+    in_buf = gst_harness_create_buffer (h, data_in_size);
+
+    mem = gst_buffer_peek_memory (in_buf, 0);
+    ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_WRITE));
+
+    for (i = 0; i < array_size; i++) {
+      uint8_t value = (i * 13 + b) % 256;
+      ((uint8_t *) info.data)[i] = value;
+    }
+
+    gst_memory_unmap (mem, &info);
+
+    EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+
+    /* get output buffer */
+    out_buf = gst_harness_pull (h);
+
+    ASSERT_TRUE (out_buf != NULL);
+    ASSERT_EQ (gst_buffer_n_memory (out_buf), 1);
+    ASSERT_EQ (gst_buffer_get_size (out_buf), data_out_size);
+
+    mem = gst_buffer_peek_memory (out_buf, 0);
+    ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_READ));
+
+    for (i = 0; i < array_size; i++) {
+      float expected = ((float) ((i * 13 + b) % 256) - 127.5f) / 127.5f;
+      EXPECT_FLOAT_EQ (((float *) info.data)[i], expected);
+    }
+
+    gst_memory_unmap (mem, &info);
+    gst_buffer_unref (out_buf);
+  }
+
+  EXPECT_EQ (gst_harness_buffers_received (h), num_buffers);
+  gst_harness_teardown (h);
+}
+
+/**
+ * @brief Test for tensor_transform normalize (the number of mean values is not matched with the channels)
+ */
+TEST (test_tensor_transform, normalize_channels_mismatch)
+{
+  GstHarness *h;
+  GstBuffer *in_buf;
+  GstTensorConfig config;
+
+  h = gst_harness_new ("tensor_transform");
+
+  g_object_set (h->element, "mode", "normalize",
+      "option", "typecast:float32;mean:123.7,116.3;std:58.4;axis:0", NULL);
+
+  /* input tensor info, 3 channels */
+  config.info.type = _NNS_UINT8;
+  get_tensor_dimension ("3:4:2", config.info.dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+
+  gst_harness_set_src_caps (h, gst_tensor_caps_from_config (&config));
+
+  in_buf = gst_harness_create_buffer (h,
+      gst_tensor_info_get_size (&config.info));
+  EXPECT_NE (gst_harness_push (h, in_buf), GST_FLOW_OK);
+
+  gst_harness_teardown (h);
+}
+
+/**
+ * @brief Test for tensor_transform stand (typecast uint8 > float32, dc-average of each channel at the dimension 0)
+ */
+TEST (test_tensor_transform, stand_dc_average)
+{
+  const guint num_buffers = 3;
+  const guint array_size = 3 * 4 * 2;
+
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstTensorConfig config;
+  GstMemory *mem;
+  GstMapInfo info;
+  guint i, b;
+  gsize data_in_size, data_out_size;
+  double mean[3];
+
+  h = gst_harness_new ("tensor_transform");
+
+  g_object_set (h->element, "mode", "stand",
+      "option", "dc-average;typecast:float32;axis:0", NULL);
+
+  /* input tensor info */
+  config.info.type = _NNS_UINT8;
+  get_tensor_dimension ("3:4:2", config.info.dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+
+  gst_harness_set_src_caps (h, gst_tensor_caps_from_config (&config));
+  data_in_size = gst_tensor_info_get_size (&config.info);
+
+  config.info.type = _NNS_FLOAT32;
+  data_out_size = gst_tensor_info_get_size (&config.info);
+
+  /* push buffers */
+  for (b = 0; b < num_buffers; b++) {
+    /* set input buffer */
+    in_buf = gst_harness_create_buffer (h, data_in_size);
+
+    mem = gst_buffer_peek_memory (in_buf, 0);
+    ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_WRITE));
+
+    mean[0] = mean[1] = mean[2] = 0.0;
+    for (i = 0; i < array_size; i++) {
+      uint8_t value = (i * 11 + b * 3) % 256;
+      ((uint8_t *) info.data)[i] = value;
+      mean[i % 3] += value / 8.0;
+    }
+
+    gst_memory_unmap (mem, &info);
+
+    EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+
+    /* get output buffer */
+    out_buf = gst_harness_pull (h);
+
+    ASSERT_TRUE (out_buf != NULL);
+    ASSERT_EQ (gst_buffer_n_memory (out_buf), 1);
+    ASSERT_EQ (gst_buffer_get_size (out_buf), data_out_size);
+
+    mem = gst_buffer_peek_memory (out_buf, 0);
+    ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_READ));
+
+    for (i = 0; i < array_size; i++) {
+      float expected = ((i * 11 + b * 3) % 256) - mean[i % 3];
+      EXPECT_NEAR (((float *) info.data)[i], expected, 1e-4);
+    }
+
+    gst_memory_unmap (mem, &info);
+    gst_buffer_unref (out_buf);
+  }
+
+  EXPECT_EQ (gst_harness_buffers_received (h), num_buffers);
+  gst_harness_teardown (h);
+}
+
+/**
+ * @brief Test for tensor_transform stand (dc-average with the integer output type)
+ */
+TEST (test_tensor_transform, stand_dc_average_invalid_type)
+{
+  GstHarness *h;
+  GstBuffer *in_buf;
+  GstTensorConfig config;
+
+  h = gst_harness_new ("tensor_transform");
+
+  g_object_set (h->element, "mode", "stand", "option", "dc-average", NULL);
+
+  /* input tensor info */
+  config.info.type = _NNS_UINT8;
+  get_tensor_dimension ("3:4:2:1", config.info.dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+
+  gst_harness_set_src_caps (h, gst_tensor_caps_from_config (&config));
+
+  in_buf = gst_harness_create_buffer (h,
+      gst_tensor_info_get_size (&config.info));
+  EXPECT_NE (gst_harness_push (h, in_buf), GST_FLOW_OK);
+
+  gst_harness_teardown (h);
+}
+
+/**
+ * @brief Test for tensor_transform stand (float64, default)
+ */
+TEST (test_tensor_transform, stand_default_float64)
+{
+  const guint array_size = 5;
+  const double data[5] = { 1.0, 2.0, 3.0, 4.0, 10.0 };
+
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstTensorConfig config;
+  GstMemory *mem;
+  GstMapInfo info;
+  guint i;
+  double mean, std;
+
+  h = gst_harness_new ("tensor_transform");
+
+  g_object_set (h->element, "mode", "stand", "option", "default", NULL);
+
+  /* input tensor info */
+  config.info.type = _NNS_FLOAT64;
+  get_tensor_dimension ("5", config.info.dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+
+  gst_harness_set_src_caps (h, gst_tensor_caps_from_config (&config));
+
+  /* mean 4 and sample variance 12.5 */
+  mean = 4.0;
+  std = sqrt (12.5);
+
+  in_buf = gst_harness_create_buffer (h,
+      gst_tensor_info_get_size (&config.info));
+  mem = gst_buffer_peek_memory (in_buf, 0);
+  ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_WRITE));
+  memcpy (info.data, data, sizeof (data));
+  gst_memory_unmap (mem, &info);
+
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+
+  out_buf = gst_harness_pull (h);
+  ASSERT_TRUE (out_buf != NULL);
+  ASSERT_EQ (gst_buffer_get_size (out_buf), sizeof (data));
+
+  mem = gst_buffer_peek_memory (out_buf, 0);
+  ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_READ));
+
+  for (i = 0; i < array_size; i++) {
+    double expected = fabs ((data[i] - mean) / (std + 1e-10));
+    EXPECT_DOUBLE_EQ (((double *) info.data)[i], expected);
+  }
+
+  gst_memory_unmap (mem, &info);
+  gst_buffer_unref (out_buf);
+
+  EXPECT_EQ (gst_harness_buffers_received (h), 1U);
+  gst_harness_teardown (h);
+}
+
+#ifdef HAVE_ORC
+#include "../../gst/tensor_transform/transform-orc.h"
+
+/**
+ * @brief Test for tensor_transform orc functions (add constant value)
+ */
+TEST (test_tensor_transform, orc_add)
+{
+  const guint array_size = 10;
+  guint i;
+
+  /* add constant s8 */
+  int8_t data_s8[array_size] = { 0, };
+
+  for (i = 0; i < array_size; i++) {
+    data_s8[i] = i - 1;
+  }
+
+  nns_orc_add_c_s8 (data_s8, -20, array_size);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_EQ (data_s8[i], i - 1 - 20);
+  }
+
+  for (i = 0; i < array_size; i++) {
+    data_s8[i] = i + 1;
+  }
+
+  nns_orc_add_c_s8 (data_s8, 20, array_size);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_EQ (data_s8[i], i + 1 + 20);
+  }
+
+  /* add constant u8 */
+  uint8_t data_u8[array_size] = { 0, };
+
+  for (i = 0; i < array_size; i++) {
+    data_u8[i] = i + 1;
+  }
+
+  nns_orc_add_c_u8 (data_u8, 3, array_size);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_EQ (data_u8[i], i + 1 + 3);
+  }
+
+  /* add constant s16 */
+  int16_t data_s16[array_size] = { 0, };
+
+  for (i = 0; i < array_size; i++) {
+    data_s16[i] = i - 1;
+  }
+
+  nns_orc_add_c_s16 (data_s16, -16, array_size);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_EQ (data_s16[i], i - 1 - 16);
+  }
+
+  for (i = 0; i < array_size; i++) {
+    data_s16[i] = i + 1;
+  }
+
+  nns_orc_add_c_s16 (data_s16, 16, array_size);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_EQ (data_s16[i], i + 1 + 16);
+  }
+
+  /* add constant u16 */
+  uint16_t data_u16[array_size] = { 0, };
+
+  for (i = 0; i < array_size; i++) {
+    data_u16[i] = i + 1;
+  }
+
+  nns_orc_add_c_u16 (data_u16, 17, array_size);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_EQ (data_u16[i], i + 1 + 17);
+  }
+
+  /* add constant s32 */
+  int32_t data_s32[array_size] = { 0, };
+
+  for (i = 0; i < array_size; i++) {
+    data_s32[i] = i + 1;
+  }
+
+  nns_orc_add_c_s32 (data_s32, -32, array_size);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_EQ (data_s32[i], i + 1 - 32);
+  }
+
+  for (i = 0; i < array_size; i++) {
+    data_s32[i] = i + 1;
+  }
+
+  nns_orc_add_c_s32 (data_s32, 32, array_size);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_EQ (data_s32[i], i + 1 + 32);
+  }
+
+  /* add constant u32 */
+  uint32_t data_u32[array_size] = { 0, };
+
+  for (i = 0; i < array_size; i++) {
+    data_u32[i] = i + 1;
+  }
+
+  nns_orc_add_c_u32 (data_u32, 33, array_size);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_EQ (data_u32[i], i + 1 + 33);
+  }
+
+  /* add constant f32 */
+  float data_f32[array_size] = { 0, };
+
+  for (i = 0; i < array_size; i++) {
+    data_f32[i] = i - .1;
+  }
+
+  nns_orc_add_c_f32 (data_f32, -10.2, array_size);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_FLOAT_EQ (data_f32[i], i - .1 - 10.2);
+  }
+
+  for (i = 0; i < array_size; i++) {
+    data_f32[i] = i + .1;
+  }
+
+  nns_orc_add_c_f32 (data_f32, 10.2, array_size);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_FLOAT_EQ (data_f32[i], i + .1 + 10.2);
+  }
+
+  /* add constant f64 */
+  double data_f64[array_size] = { 0, };
+
+  for (i = 0; i < array_size; i++) {
+    data_f64[i] = i - .1;
+  }
+
+  nns_orc_add_c_f64 (data_f64, -20.5, array_size);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_DOUBLE_EQ (data_f64[i], i - .1 - 20.5);
+  }
+
+  for (i = 0; i < array_size; i++) {
+    data_f64[i] = i + .2;
+  }
+
+  nns_orc_add_c_f64 (data_f64, 20.5, array_size);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_DOUBLE_EQ (data_f64[i], i + .2 + 20.5);
+  }
+}
+
+/**
+ * @brief Test for tensor_transform orc functions (mul constant value)
+ */
+TEST (test_tensor_transform, orc_mul)
+{
+  const guint array_size = 10;
+  guint i;
+
+  /* mul constant s8 */
+  int8_t data_s8[array_size] = { 0, };
+
+  for (i = 0; i < array_size; i++) {
+    data_s8[i] = i + 1;
+  }
+
+  nns_orc_mul_c_s8 (data_s8, -3, array_size);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_EQ (data_s8[i], (i + 1) * (-3));
+  }
+
+  for (i = 0; i < array_size; i++) {
+    data_s8[i] = i + 1;
+  }
+
+  nns_orc_mul_c_s8 (data_s8, 5, array_size);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_EQ (data_s8[i], (i + 1) * 5);
+  }
+
+  /* mul constant u8 */
+  uint8_t data_u8[array_size] = { 0, };
+
+  for (i = 0; i < array_size; i++) {
+    data_u8[i] = i + 1;
+  }
+
+  nns_orc_mul_c_u8 (data_u8, 3, array_size);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_EQ (data_u8[i], (i + 1) * 3);
+  }
+
+  /* mul constant s16 */
+  int16_t data_s16[array_size] = { 0, };
+
+  for (i = 0; i < array_size; i++) {
+    data_s16[i] = i + 1;
+  }
+
+  nns_orc_mul_c_s16 (data_s16, -16, array_size);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_EQ (data_s16[i], (i + 1) * (-16));
+  }
+
+  for (i = 0; i < array_size; i++) {
+    data_s16[i] = i + 1;
+  }
+
+  nns_orc_mul_c_s16 (data_s16, 16, array_size);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_EQ (data_s16[i], (i + 1) * 16);
+  }
+
+  /* mul constant u16 */
+  uint16_t data_u16[array_size] = { 0, };
+
+  for (i = 0; i < array_size; i++) {
+    data_u16[i] = i + 1;
+  }
+
+  nns_orc_mul_c_u16 (data_u16, 17, array_size);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_EQ (data_u16[i], (i + 1) * 17);
+  }
+
+  /* mul constant s32 */
+  int32_t data_s32[array_size] = { 0, };
+
+  for (i = 0; i < array_size; i++) {
+    data_s32[i] = i + 1;
+  }
+
+  nns_orc_mul_c_s32 (data_s32, -32, array_size);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_EQ (data_s32[i], (i + 1) * (-32));
+  }
+
+  for (i = 0; i < array_size; i++) {
+    data_s32[i] = i + 1;
+  }
+
+  nns_orc_mul_c_s32 (data_s32, 32, array_size);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_EQ (data_s32[i], (i + 1) * 32);
+  }
+
+  /* mul constant u32 */
+  uint32_t data_u32[array_size] = { 0, };
+
+  for (i = 0; i < array_size; i++) {
+    data_u32[i] = i + 1;
+  }
+
+  nns_orc_mul_c_u32 (data_u32, 33, array_size);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_EQ (data_u32[i], (i + 1) * 33);
+  }
+
+  /* mul constant f32 */
+  float data_f32[array_size] = { 0, };
+
+  for (i = 0; i < array_size; i++) {
+    data_f32[i] = i + 1 - .1;
+  }
+
+  nns_orc_mul_c_f32 (data_f32, -10.2, array_size);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_FLOAT_EQ (data_f32[i], (i + 1 - .1) * (-10.2));
+  }
+
+  for (i = 0; i < array_size; i++) {
+    data_f32[i] = i + .1;
+  }
+
+  nns_orc_mul_c_f32 (data_f32, 10.2, array_size);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_FLOAT_EQ (data_f32[i], (i + .1) * 10.2);
+  }
+
+  /* mul constant f64 */
+  double data_f64[array_size] = { 0, };
+
+  for (i = 0; i < array_size; i++) {
+    data_f64[i] = i + 1 - .1;
+  }
+
+  nns_orc_mul_c_f64 (data_f64, -20.5, array_size);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_DOUBLE_EQ (data_f64[i], (i + 1 - .1) * (-20.5));
+  }
+
+  for (i = 0; i < array_size; i++) {
+    data_f64[i] = i + .2;
+  }
+
+  nns_orc_mul_c_f64 (data_f64, 20.5, array_size);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_DOUBLE_EQ (data_f64[i], (i + .2) * 20.5);
+  }
+}
+
+/**
+ * @brief Test for tensor_transform orc functions (div constant value)
+ */
+TEST (test_tensor_transform, orc_div)
+{
+  const guint array_size = 10;
+  guint i;
+
+  /* div constant f32 */
+  float data_f32[array_size] = { 0, };
+
+  for (i = 0; i < array_size; i++) {
+    data_f32[i] = i + 1 - .1;
+  }
+
+  nns_orc_div_c_f32 (data_f32, -2.2, array_size);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_FLOAT_EQ (data_f32[i], (i + 1 - .1) / (-2.2));
+  }
+
+  for (i = 0; i < array_size; i++) {
+    data_f32[i] = i + 10.1;
+  }
+
+  nns_orc_div_c_f32 (data_f32, 10.2, array_size);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_FLOAT_EQ (data_f32[i], (i + 10.1) / 10.2);
+  }
+
+  /* div constant f64 */
+  double data_f64[array_size] = { 0, };
+
+  for (i = 0; i < array_size; i++) {
+    data_f64[i] = i + 1 - .1;
+  }
+
+  nns_orc_div_c_f64 (data_f64, -10.5, array_size);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_DOUBLE_EQ (data_f64[i], (i + 1 - .1) / (-10.5));
+  }
+
+  for (i = 0; i < array_size; i++) {
+    data_f64[i] = i + .2;
+  }
+
+  nns_orc_div_c_f64 (data_f64, 5.5, array_size);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_DOUBLE_EQ (data_f64[i], (i + .2) / 5.5);
+  }
+}
+
+/**
+ * @brief Test for tensor_transform orc functions (convert s8 to other type)
+ */
+TEST (test_tensor_transform, orc_conv_s8)
+{
+  const guint array_size = 10;
+  guint i;
+
+  int8_t data_s8[array_size] = { 0, };
+
+  for (i = 0; i < array_size; i++) {
+    data_s8[i] = (i + 1) * -1;
+  }
+
+  /* convert s8 */
+  int8_t res_s8[array_size] = { 0, };
+
+  nns_orc_conv_s8_to_s8 (res_s8, data_s8, array_size);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_EQ (res_s8[i], (int8_t) data_s8[i]);
+  }
+
+  /* convert u8 */
+  uint8_t res_u8[array_size] = { 0, };
+
+  nns_orc_conv_s8_to_u8 (res_u8, data_s8, array_size);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_EQ (res_u8[i], (uint8_t) data_s8[i]);
+  }
+
+  /* convert s16 */
+  int16_t res_s16[array_size] = { 0, };
+
+  nns_orc_conv_s8_to_s16 (res_s16, data_s8, array_size);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_EQ (res_s16[i], (int16_t) data_s8[i]);
+  }
+
+  /* convert u16 */
+  uint16_t res_u16[array_size] = { 0, };
+
+  nns_orc_conv_s8_to_u16 (res_u16, data_s8, array_size);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_EQ (res_u16[i], (uint16_t) data_s8[i]);
+  }
+
+  /* convert s32 */
+  int32_t res_s32[array_size] = { 0, };
+
+  nns_orc_conv_s8_to_s32 (res_s32, data_s8, array_size);
 
   for (i = 0; i < array_size; i++) {
-    data_s8[i] = i + 1;
+    EXPECT_EQ (res_s32[i], (int32_t) data_s8[i]);
+  }
+
+  /* convert u32 */
+  uint32_t res_u32[array_size] = { 0, };
+
+  nns_orc_conv_s8_to_u32 (res_u32, data_s8, array_size);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_EQ (res_u32[i], (uint32_t) data_s8[i]);
+  }
+
+  /* convert f32 */
+  float res_f32[array_size] = { 0, };
+
+  nns_orc_conv_s8_to_f32 (res_f32, data_s8, array_size);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_FLOAT_EQ (res_f32[i], (float) data_s8[i]);
+  }
+
+  /* convert f64 */
+  double res_f64[array_size] = { 0, };
+
+  nns_orc_conv_s8_to_f64 (res_f64, data_s8, array_size);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_DOUBLE_EQ (res_f64[i], (double) data_s8[i]);
+  }
+}
+
+/**
+ * @brief Test for tensor_transform orc functions (convert u8 to other type)
+ */
+TEST (test_tensor_transform, orc_conv_u8)
+{
+  const guint array_size = 10;
+  guint i;
+
+  uint8_t data_u8[array_size] = { 0, };
+
+  for (i = 0; i < array_size; i++) {
+    data_u8[i] = G_MAXUINT8 - i;
+  }
+
+  /* convert s8 */
+  int8_t res_s8[array_size] = { 0, };
+
+  nns_orc_conv_u8_to_s8 (res_s8, data_u8, array_size);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_EQ (res_s8[i], (int8_t) data_u8[i]);
+  }
+
+  /* convert u8 */
+  uint8_t res_u8[array_size] = { 0, };
+
+  nns_orc_conv_u8_to_u8 (res_u8, data_u8, array_size);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_EQ (res_u8[i], (uint8_t) data_u8[i]);
+  }
+
+  /* convert s16 */
+  int16_t res_s16[array_size] = { 0, };
+
+  nns_orc_conv_u8_to_s16 (res_s16, data_u8, array_size);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_EQ (res_s16[i], (int16_t) data_u8[i]);
+  }
+
+  /* convert u16 */
+  uint16_t res_u16[array_size] = { 0, };
+
+  nns_orc_conv_u8_to_u16 (res_u16, data_u8, array_size);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_EQ (res_u16[i], (uint16_t) data_u8[i]);
+  }
+
+  /* convert s32 */
+  int32_t res_s32[array_size] = { 0, };
+
+  nns_orc_conv_u8_to_s32 (res_s32, data_u8, array_size);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_EQ (res_s32[i], (int32_t) data_u8[i]);
+  }
+
+  /* convert u32 */
+  uint32_t res_u32[array_size] = { 0, };
+
+  nns_orc_conv_u8_to_u32 (res_u32, data_u8, array_size);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_EQ (res_u32[i], (uint32_t) data_u8[i]);
+  }
+
+  /* convert f32 */
+  float res_f32[array_size] = { 0, };
+
+  nns_orc_conv_u8_to_f32 (res_f32, data_u8, array_size);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_FLOAT_EQ (res_f32[i], (float) data_u8[i]);
+  }
+
+  /* convert f64 */
+  double res_f64[array_size] = { 0, };
+
+  nns_orc_conv_u8_to_f64 (res_f64, data_u8, array_size);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_DOUBLE_EQ (res_f64[i], (double) data_u8[i]);
+  }
+}
+
+/**
+ * @brief Test for tensor_transform orc functions (convert s16 to other type)
+ */
+TEST (test_tensor_transform, orc_conv_s16)
+{
+  const guint array_size = 10;
+  guint i;
+
+  int16_t data_s16[array_size] = { 0, };
+
+  for (i = 0; i < array_size; i++) {
+    data_s16[i] = (i + 1) * -1;
+  }
+
+  /* convert s8 */
+  int8_t res_s8[array_size] = { 0, };
+
+  nns_orc_conv_s16_to_s8 (res_s8, data_s16, array_size);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_EQ (res_s8[i], (int8_t) data_s16[i]);
+  }
+
+  /* convert u8 */
+  uint8_t res_u8[array_size] = { 0, };
+
+  nns_orc_conv_s16_to_u8 (res_u8, data_s16, array_size);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_EQ (res_u8[i], (uint8_t) data_s16[i]);
+  }
+
+  /* convert s16 */
+  int16_t res_s16[array_size] = { 0, };
+
+  nns_orc_conv_s16_to_s16 (res_s16, data_s16, array_size);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_EQ (res_s16[i], (int16_t) data_s16[i]);
+  }
+
+  /* convert u16 */
+  uint16_t res_u16[array_size] = { 0, };
+
+  nns_orc_conv_s16_to_u16 (res_u16, data_s16, array_size);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_EQ (res_u16[i], (uint16_t) data_s16[i]);
+  }
+
+  /* convert s32 */
+  int32_t res_s32[array_size] = { 0, };
+
+  nns_orc_conv_s16_to_s32 (res_s32, data_s16, array_size);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_EQ (res_s32[i], (int32_t) data_s16[i]);
+  }
+
+  /* convert u32 */
+  uint32_t res_u32[array_size] = { 0, };
+
+  nns_orc_conv_s16_to_u32 (res_u32, data_s16, array_size);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_EQ (res_u32[i], (uint32_t) data_s16[i]);
+  }
+
+  /* convert f32 */
+  float res_f32[array_size] = { 0, };
+
+  nns_orc_conv_s16_to_f32 (res_f32, data_s16, array_size);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_FLOAT_EQ (res_f32[i], (float) data_s16[i]);
+  }
+
+  /* convert f64 */
+  double res_f64[array_size] = { 0, };
+
+  nns_orc_conv_s16_to_f64 (res_f64, data_s16, array_size);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_DOUBLE_EQ (res_f64[i], (double) data_s16[i]);
+  }
+}
+
+/**
+ * @brief Test for tensor_transform orc functions (convert u16 to other type)
+ */
+TEST (test_tensor_transform, orc_conv_u16)
+{
+  const guint array_size = 10;
+  guint i;
+
+  uint16_t data_u16[array_size] = { 0, };
+
+  for (i = 0; i < array_size; i++) {
+    data_u16[i] = G_MAXUINT16 - i;
+  }
+
+  /* convert s8 */
+  int8_t res_s8[array_size] = { 0, };
+
+  nns_orc_conv_u16_to_s8 (res_s8, data_u16, array_size);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_EQ (res_s8[i], (int8_t) data_u16[i]);
+  }
+
+  /* convert u8 */
+  uint8_t res_u8[array_size] = { 0, };
+
+  nns_orc_conv_u16_to_u8 (res_u8, data_u16, array_size);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_EQ (res_u8[i], (uint8_t) data_u16[i]);
+  }
+
+  /* convert s16 */
+  int16_t res_s16[array_size] = { 0, };
+
+  nns_orc_conv_u16_to_s16 (res_s16, data_u16, array_size);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_EQ (res_s16[i], (int16_t) data_u16[i]);
+  }
+
+  /* convert u16 */
+  uint16_t res_u16[array_size] = { 0, };
+
+  nns_orc_conv_u16_to_u16 (res_u16, data_u16, array_size);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_EQ (res_u16[i], (uint16_t) data_u16[i]);
   }
 
-  nns_orc_mul_c_s8 (data_s8, 5, array_size);
+  /* convert s32 */
+  int32_t res_s32[array_size] = { 0, };
+
+  nns_orc_conv_u16_to_s32 (res_s32, data_u16, array_size);
 
   for (i = 0; i < array_size; i++) {
-    EXPECT_EQ (data_s8[i], (i + 1) * 5);
+    EXPECT_EQ (res_s32[i], (int32_t) data_u16[i]);
   }
 
-  /* mul constant u8 */
-  uint8_t data_u8[array_size] = { 0, };
+  /* convert u32 */
+  uint32_t res_u32[array_size] = { 0, };
+
+  nns_orc_conv_u16_to_u32 (res_u32, data_u16, array_size);
 
   for (i = 0; i < array_size; i++) {
-    data_u8[i] = i + 1;
+    EXPECT_EQ (res_u32[i], (uint32_t) data_u16[i]);
   }
 
-  nns_orc_mul_c_u8 (data_u8, 3, array_size);
+  /* convert f32 */
+  float res_f32[array_size] = { 0, };
+
+  nns_orc_conv_u16_to_f32 (res_f32, data_u16, array_size);
 
   for (i = 0; i < array_size; i++) {
-    EXPECT_EQ (data_u8[i], (i + 1) * 3);
+    EXPECT_FLOAT_EQ (res_f32[i], (float) data_u16[i]);
   }
 
-  /* mul constant s16 */
-  int16_t data_s16[array_size] = { 0, };
+  /* convert f64 */
+  double res_f64[array_size] = { 0, };
+
+  nns_orc_conv_u16_to_f64 (res_f64, data_u16, array_size);
 
   for (i = 0; i < array_size; i++) {
-    data_s16[i] = i + 1;
+    EXPECT_DOUBLE_EQ (res_f64[i], (double) data_u16[i]);
   }
+}
 
-  nns_orc_mul_c_s16 (data_s16, -16, array_size);
+/**
+ * @brief Test for tensor_transform orc functions (convert s32 to other type)
+ */
+TEST (test_tensor_transform, orc_conv_s32)
+{
+  const guint array_size = 10;
+  guint i;
+
+  int32_t data_s32[array_size] = { 0, };
 
   for (i = 0; i < array_size; i++) {
-    EXPECT_EQ (data_s16[i], (i + 1) * (-16));
+    data_s32[i] = (i + 1) * -1;
   }
 
+  /* convert s8 */
+  int8_t res_s8[array_size] = { 0, };
+
+  nns_orc_conv_s32_to_s8 (res_s8, data_s32, array_size);
+
   for (i = 0; i < array_size; i++) {
-    data_s16[i] = i + 1;
+    EXPECT_EQ (res_s8[i], (int8_t) data_s32[i]);
   }
 
-  nns_orc_mul_c_s16 (data_s16, 16, array_size);
+  /* convert u8 */
+  uint8_t res_u8[array_size] = { 0, };
+
+  nns_orc_conv_s32_to_u8 (res_u8, data_s32, array_size);
 
   for (i = 0; i < array_size; i++) {
-    EXPECT_EQ (data_s16[i], (i + 1) * 16);
+    EXPECT_EQ (res_u8[i], (uint8_t) data_s32[i]);
   }
 
-  /* mul constant u16 */
-  uint16_t data_u16[array_size] = { 0, };
+  /* convert s16 */
+  int16_t res_s16[array_size] = { 0, };
+
+  nns_orc_conv_s32_to_s16 (res_s16, data_s32, array_size);
 
   for (i = 0; i < array_size; i++) {
-    data_u16[i] = i + 1;
+    EXPECT_EQ (res_s16[i], (int16_t) data_s32[i]);
   }
 
-  nns_orc_mul_c_u16 (data_u16, 17, array_size);
+  /* convert u16 */
+  uint16_t res_u16[array_size] = { 0, };
+
+  nns_orc_conv_s32_to_u16 (res_u16, data_s32, array_size);
 
   for (i = 0; i < array_size; i++) {
-    EXPECT_EQ (data_u16[i], (i + 1) * 17);
+    EXPECT_EQ (res_u16[i], (uint16_t) data_s32[i]);
   }
 
-  /* mul constant s32 */
-  int32_t data_s32[array_size] = { 0, };
+  /* convert s32 */
+  int32_t res_s32[array_size] = { 0, };
+
+  nns_orc_conv_s32_to_s32 (res_s32, data_s32, array_size);
 
   for (i = 0; i < array_size; i++) {
-    data_s32[i] = i + 1;
+    EXPECT_EQ (res_s32[i], (int32_t) data_s32[i]);
   }
 
-  nns_orc_mul_c_s32 (data_s32, -32, array_size);
+  /* convert u32 */
+  uint32_t res_u32[array_size] = { 0, };
+
+  nns_orc_conv_s32_to_u32 (res_u32, data_s32, array_size);
 
   for (i = 0; i < array_size; i++) {
-    EXPECT_EQ (data_s32[i], (i + 1) * (-32));
+    EXPECT_EQ (res_u32[i], (uint32_t) data_s32[i]);
   }
 
+  /* convert f32 */
+  float res_f32[array_size] = { 0, };
+
+  nns_orc_conv_s32_to_f32 (res_f32, data_s32, array_size);
+
   for (i = 0; i < array_size; i++) {
-    data_s32[i] = i + 1;
+    EXPECT_FLOAT_EQ (res_f32[i], (float) data_s32[i]);
   }
 
-  nns_orc_mul_c_s32 (data_s32, 32, array_size);
+  /* convert f64 */
+  double res_f64[array_size] = { 0, };
+
+  nns_orc_conv_s32_to_f64 (res_f64, data_s32, array_size);
 
   for (i = 0; i < array_size; i++) {
-    EXPECT_EQ (data_s32[i], (i + 1) * 32);
+    EXPECT_DOUBLE_EQ (res_f64[i], (double) data_s32[i]);
   }
+}
+
+/**
+ * @brief Test for tensor_transform orc functions (convert u32 to other type)
+ */
+TEST (test_tensor_transform, orc_conv_u32)
+{
+  const guint array_size = 10;
+  guint i;
 
-  /* mul constant u32 */
   uint32_t data_u32[array_size] = { 0, };
 
   for (i = 0; i < array_size; i++) {
-    data_u32[i] = i + 1;
+    data_u32[i] = G_MAXUINT32 - i;
   }
 
-  nns_orc_mul_c_u32 (data_u32, 33, array_size);
+  /* convert s8 */
+  int8_t res_s8[array_size] = { 0, };
+
+  nns_orc_conv_u32_to_s8 (res_s8, data_u32, array_size);
 
   for (i = 0; i < array_size; i++) {
-    EXPECT_EQ (data_u32[i], (i + 1) * 33);
+    EXPECT_EQ (res_s8[i], (int8_t) data_u32[i]);
   }
 
-  /* mul constant f32 */
-  float data_f32[array_size] = { 0, };
+  /* convert u8 */
+  uint8_t res_u8[array_size] = { 0, };
+
+  nns_orc_conv_u32_to_u8 (res_u8, data_u32, array_size);
 
   for (i = 0; i < array_size; i++) {
-    data_f32[i] = i + 1 - .1;
+    EXPECT_EQ (res_u8[i], (uint8_t) data_u32[i]);
   }
 
-  nns_orc_mul_c_f32 (data_f32, -10.2, array_size);
+  /* convert s16 */
+  int16_t res_s16[array_size] = { 0, };
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_FLOAT_EQ (data_f32[i], (i + 1 - .1) * (-10.2));
-  }
+  nns_orc_conv_u32_to_s16 (res_s16, data_u32, array_size);
 
   for (i = 0; i < array_size; i++) {
-    data_f32[i] = i + .1;
+    EXPECT_EQ (res_s16[i], (int16_t) data_u32[i]);
   }
 
-  nns_orc_mul_c_f32 (data_f32, 10.2, array_size);
+  /* convert u16 */
+  uint16_t res_u16[array_size] = { 0, };
+
+  nns_orc_conv_u32_to_u16 (res_u16, data_u32, array_size);
 
   for (i = 0; i < array_size; i++) {
-    EXPECT_FLOAT_EQ (data_f32[i], (i + .1) * 10.2);
+    EXPECT_EQ (res_u16[i], (uint16_t) data_u32[i]);
   }
 
-  /* mul constant f64 */
-  double data_f64[array_size] = { 0, };
+  /* convert s32 */
+  int32_t res_s32[array_size] = { 0, };
+
+  nns_orc_conv_u32_to_s32 (res_s32, data_u32, array_size);
 
   for (i = 0; i < array_size; i++) {
-    data_f64[i] = i + 1 - .1;
+    EXPECT_EQ (res_s32[i], (int32_t) data_u32[i]);
   }
 
-  nns_orc_mul_c_f64 (data_f64, -20.5, array_size);
+  /* convert u32 */
+  uint32_t res_u32[array_size] = { 0, };
+
+  nns_orc_conv_u32_to_u32 (res_u32, data_u32, array_size);
 
   for (i = 0; i < array_size; i++) {
-    EXPECT_DOUBLE_EQ (data_f64[i], (i + 1 - .1) * (-20.5));
+    EXPECT_EQ (res_u32[i], (uint32_t) data_u32[i]);
   }
 
+  /* convert f32 */
+  float res_f32[array_size] = { 0, };
+
+  nns_orc_conv_u32_to_f32 (res_f32, data_u32, array_size);
+
   for (i = 0; i < array_size; i++) {
-    data_f64[i] = i + .2;
+    EXPECT_FLOAT_EQ (res_f32[i], (float) ((int32_t) data_u32[i]));
   }
 
-  nns_orc_mul_c_f64 (data_f64, 20.5, array_size);
+  /* convert f64 */
+  double res_f64[array_size] = { 0, };
+
+  nns_orc_conv_u32_to_f64 (res_f64, data_u32, array_size);
 
   for (i = 0; i < array_size; i++) {
-    EXPECT_DOUBLE_EQ (data_f64[i], (i + .2) * 20.5);
+    EXPECT_DOUBLE_EQ (res_f64[i], (double) ((int32_t) data_u32[i]));
   }
 }
 
 /**
- * @brief Test for tensor_transform orc functions (div constant value)
+ * @brief Test for tensor_transform orc functions (convert f32 to other type)
  */
-TEST (test_tensor_transform, orc_div)
+TEST (test_tensor_transform, orc_conv_f32)
 {
   const guint array_size = 10;
   guint i;
 
-  /* div constant f32 */
   float data_f32[array_size] = { 0, };
 
   for (i = 0; i < array_size; i++) {
-    data_f32[i] = i + 1 - .1;
+    data_f32[i] = (i + 1.) * -1.;
   }
 
-  nns_orc_div_c_f32 (data_f32, -2.2, array_size);
+  /* convert s8 */
+  int8_t res_s8[array_size] = { 0, };
+
+  nns_orc_conv_f32_to_s8 (res_s8, data_f32, array_size);
 
   for (i = 0; i < array_size; i++) {
-    EXPECT_FLOAT_EQ (data_f32[i], (i + 1 - .1) / (-2.2));
+    EXPECT_EQ (res_s8[i], (int8_t) data_f32[i]);
   }
 
+  /* convert u8 */
+  uint8_t res_u8[array_size] = { 0, };
+
+  nns_orc_conv_f32_to_u8 (res_u8, data_f32, array_size);
+
   for (i = 0; i < array_size; i++) {
-    data_f32[i] = i + 10.1;
+    int8_t val = (int8_t) data_f32[i];
+    EXPECT_EQ (res_u8[i], (uint8_t) val);
   }
 
-  nns_orc_div_c_f32 (data_f32, 10.2, array_size);
+  /* convert s16 */
+  int16_t res_s16[array_size] = { 0, };
+
+  nns_orc_conv_f32_to_s16 (res_s16, data_f32, array_size);
 
   for (i = 0; i < array_size; i++) {
-    EXPECT_FLOAT_EQ (data_f32[i], (i + 10.1) / 10.2);
+    EXPECT_EQ (res_s16[i], (int16_t) data_f32[i]);
   }
 
-  /* div constant f64 */
-  double data_f64[array_size] = { 0, };
+  /* convert u16 */
+  uint16_t res_u16[array_size] = { 0, };
+
+  nns_orc_conv_f32_to_u16 (res_u16, data_f32, array_size);
 
   for (i = 0; i < array_size; i++) {
-    data_f64[i] = i + 1 - .1;
+    int16_t val = (int16_t) data_f32[i];
+    EXPECT_EQ (res_u16[i], (uint16_t) val);
   }
 
-  nns_orc_div_c_f64 (data_f64, -10.5, array_size);
+  /* convert s32 */
+  int32_t res_s32[array_size] = { 0, };
+
+  nns_orc_conv_f32_to_s32 (res_s32, data_f32, array_size);
 
   for (i = 0; i < array_size; i++) {
-    EXPECT_DOUBLE_EQ (data_f64[i], (i + 1 - .1) / (-10.5));
+    EXPECT_EQ (res_s32[i], (int32_t) data_f32[i]);
   }
 
+  /* convert u32 */
+  uint32_t res_u32[array_size] = { 0, };
+
+  nns_orc_conv_f32_to_u32 (res_u32, data_f32, array_size);
+
   for (i = 0; i < array_size; i++) {
-    data_f64[i] = i + .2;
+    int32_t val = (int32_t) data_f32[i];
+    EXPECT_EQ (res_u32[i], (uint32_t) val);
   }
 
-  nns_orc_div_c_f64 (data_f64, 5.5, array_size);
+  /* convert f32 */
+  float res_f32[array_size] = { 0, };
+
+  nns_orc_conv_f32_to_f32 (res_f32, data_f32, array_size);
 
   for (i = 0; i < array_size; i++) {
-    EXPECT_DOUBLE_EQ (data_f64[i], (i + .2) / 5.5);
+    EXPECT_FLOAT_EQ (res_f32[i], (float) data_f32[i]);
+  }
+
+  /* convert f64 */
+  double res_f64[array_size] = { 0, };
+
+  nns_orc_conv_f32_to_f64 (res_f64, data_f32, array_size);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_DOUBLE_EQ (res_f64[i], (double) data_f32[i]);
   }
 }
 
 /**
- * @brief Test for tensor_transform orc functions (convert s8 to other type)
+ * @brief Test for tensor_transform orc functions (convert f64 to other type)
  */
-TEST (test_tensor_transform, orc_conv_s8)
+TEST (test_tensor_transform, orc_conv_f64)
 {
   const guint array_size = 10;
   guint i;
 
-  int8_t data_s8[array_size] = { 0, };
+  double data_f64[array_size] = { 0, };
 
   for (i = 0; i < array_size; i++) {
-    data_s8[i] = (i + 1) * -1;
+    data_f64[i] = (i + 1.) * -1.;
   }
 
   /* convert s8 */
   int8_t res_s8[array_size] = { 0, };
 
-  nns_orc_conv_s8_to_s8 (res_s8, data_s8, array_size);
+  nns_orc_conv_f64_to_s8 (res_s8, data_f64, array_size);
 
   for (i = 0; i < array_size; i++) {
-    EXPECT_EQ (res_s8[i], (int8_t) data_s8[i]);
+    EXPECT_EQ (res_s8[i], (int8_t) data_f64[i]);
   }
 
   /* convert u8 */
   uint8_t res_u8[array_size] = { 0, };
 
-  nns_orc_conv_s8_to_u8 (res_u8, data_s8, array_size);
+  nns_orc_conv_f64_to_u8 (res_u8, data_f64, array_size);
 
   for (i = 0; i < array_size; i++) {
-    EXPECT_EQ (res_u8[i], (uint8_t) data_s8[i]);
+    int8_t val = (int8_t) data_f64[i];
+    EXPECT_EQ (res_u8[i], (uint8_t) val);
   }
 
   /* convert s16 */
   int16_t res_s16[array_size] = { 0, };
 
-  nns_orc_conv_s8_to_s16 (res_s16, data_s8, array_size);
+  nns_orc_conv_f64_to_s16 (res_s16, data_f64, array_size);
 
   for (i = 0; i < array_size; i++) {
-    EXPECT_EQ (res_s16[i], (int16_t) data_s8[i]);
+    EXPECT_EQ (res_s16[i], (int16_t) data_f64[i]);
   }
 
   /* convert u16 */
   uint16_t res_u16[array_size] = { 0, };
 
-  nns_orc_conv_s8_to_u16 (res_u16, data_s8, array_size);
+  nns_orc_conv_f64_to_u16 (res_u16, data_f64, array_size);
 
   for (i = 0; i < array_size; i++) {
-    EXPECT_EQ (res_u16[i], (uint16_t) data_s8[i]);
+    int16_t val = (int16_t) data_f64[i];
+    EXPECT_EQ (res_u16[i], (uint16_t) val);
   }
 
   /* convert s32 */
   int32_t res_s32[array_size] = { 0, };
 
-  nns_orc_conv_s8_to_s32 (res_s32, data_s8, array_size);
+  nns_orc_conv_f64_to_s32 (res_s32, data_f64, array_size);
 
   for (i = 0; i < array_size; i++) {
-    EXPECT_EQ (res_s32[i], (int32_t) data_s8[i]);
+    EXPECT_EQ (res_s32[i], (int32_t) data_f64[i]);
   }
 
   /* convert u32 */
   uint32_t res_u32[array_size] = { 0, };
 
-  nns_orc_conv_s8_to_u32 (res_u32, data_s8, array_size);
+  nns_orc_conv_f64_to_u32 (res_u32, data_f64, array_size);
 
   for (i = 0; i < array_size; i++) {
-    EXPECT_EQ (res_u32[i], (uint32_t) data_s8[i]);
+    int32_t val = (int32_t) data_f64[i];
+    EXPECT_EQ (res_u32[i], (uint32_t) val);
   }
 
   /* convert f32 */
   float res_f32[array_size] = { 0, };
 
-  nns_orc_conv_s8_to_f32 (res_f32, data_s8, array_size);
+  nns_orc_conv_f64_to_f32 (res_f32, data_f64, array_size);
 
   for (i = 0; i < array_size; i++) {
-    EXPECT_FLOAT_EQ (res_f32[i], (float) data_s8[i]);
+    EXPECT_FLOAT_EQ (res_f32[i], (float) data_f64[i]);
   }
 
   /* convert f64 */
   double res_f64[array_size] = { 0, };
 
-  nns_orc_conv_s8_to_f64 (res_f64, data_s8, array_size);
+  nns_orc_conv_f64_to_f64 (res_f64, data_f64, array_size);
 
   for (i = 0; i < array_size; i++) {
-    EXPECT_DOUBLE_EQ (res_f64[i], (double) data_s8[i]);
+    EXPECT_DOUBLE_EQ (res_f64[i], (double) data_f64[i]);
   }
 }
 
 /**
- * @brief Test for tensor_transform orc functions (convert u8 to other type)
+ * @brief Test for tensor_transform orc functions (performance)
  */
-TEST (test_tensor_transform, orc_conv_u8)
+TEST (test_tensor_transform, orc_performance)
 {
-  const guint array_size = 10;
+  const guint array_size = 80000;
   guint i;
 
-  uint8_t data_u8[array_size] = { 0, };
+  gint64 start_ts, stop_ts, diff_loop, diff_orc;
 
-  for (i = 0; i < array_size; i++) {
-    data_u8[i] = G_MAXUINT8 - i;
+  uint8_t *data_u8 = (uint8_t *) g_malloc0 (sizeof (uint8_t) * array_size);
+  float *data_float = (float *) g_malloc0 (sizeof (float) * array_size);
+
+  /* orc add u8 */
+  start_ts = g_get_real_time ();
+  nns_orc_add_c_u8 (data_u8, 2, array_size);
+  stop_ts = g_get_real_time ();
+
+  diff_orc = stop_ts - start_ts;
+  _print_log ("add u8 orc: %" G_GINT64_FORMAT, diff_orc);
+
+  for (i = 0; i < array_size; ++i) {
+    EXPECT_EQ (data_u8[i], 2);
   }
 
-  /* convert s8 */
-  int8_t res_s8[array_size] = { 0, };
+  /* loop */
+  start_ts = g_get_real_time ();
+  for (i = 0; i < array_size; ++i) {
+    data_u8[i] += 2;
+  }
+  stop_ts = g_get_real_time ();
 
-  nns_orc_conv_u8_to_s8 (res_s8, data_u8, array_size);
+  diff_loop = stop_ts - start_ts;
+  _print_log ("add u8 loop: %" G_GINT64_FORMAT, diff_loop);
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_EQ (res_s8[i], (int8_t) data_u8[i]);
+  /* orc mul u8 */
+  start_ts = g_get_real_time ();
+  nns_orc_mul_c_u8 (data_u8, 2, array_size);
+  stop_ts = g_get_real_time ();
+
+  diff_orc = stop_ts - start_ts;
+  _print_log ("mul u8 orc: %" G_GINT64_FORMAT, diff_orc);
+
+  for (i = 0; i < array_size; ++i) {
+    EXPECT_EQ (data_u8[i], 8);
   }
 
-  /* convert u8 */
-  uint8_t res_u8[array_size] = { 0, };
+  /* loop */
+  start_ts = g_get_real_time ();
+  for (i = 0; i < array_size; ++i) {
+    data_u8[i] *= 2;
+  }
+  stop_ts = g_get_real_time ();
 
-  nns_orc_conv_u8_to_u8 (res_u8, data_u8, array_size);
+  diff_loop = stop_ts - start_ts;
+  _print_log ("mul u8 loop: %" G_GINT64_FORMAT, diff_loop);
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_EQ (res_u8[i], (uint8_t) data_u8[i]);
+  /* orc typecast to float */
+  start_ts = g_get_real_time ();
+  nns_orc_conv_u8_to_f32 (data_float, data_u8, array_size);
+  stop_ts = g_get_real_time ();
+
+  diff_orc = stop_ts - start_ts;
+  _print_log ("conv u8 orc: %" G_GINT64_FORMAT, diff_orc);
+
+  for (i = 0; i < array_size; ++i) {
+    EXPECT_FLOAT_EQ (data_float[i], 16.);
   }
 
-  /* convert s16 */
-  int16_t res_s16[array_size] = { 0, };
+  /* loop */
+  start_ts = g_get_real_time ();
+  for (i = 0; i < array_size; ++i) {
+    data_float[i] = (float) data_u8[i];
+  }
+  stop_ts = g_get_real_time ();
 
-  nns_orc_conv_u8_to_s16 (res_s16, data_u8, array_size);
+  diff_loop = stop_ts - start_ts;
+  _print_log ("conv u8 loop: %" G_GINT64_FORMAT, diff_loop);
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_EQ (res_s16[i], (int16_t) data_u8[i]);
+  /* orc div f32 */
+  start_ts = g_get_real_time ();
+  nns_orc_div_c_f32 (data_float, 2., array_size);
+  stop_ts = g_get_real_time ();
+
+  diff_orc = stop_ts - start_ts;
+  _print_log ("div f32 orc: %" G_GINT64_FORMAT, diff_orc);
+
+  for (i = 0; i < array_size; ++i) {
+    EXPECT_FLOAT_EQ (data_float[i], 8.);
   }
 
-  /* convert u16 */
-  uint16_t res_u16[array_size] = { 0, };
+  /* loop */
+  start_ts = g_get_real_time ();
+  for (i = 0; i < array_size; ++i) {
+    data_float[i] /= 2.;
+  }
+  stop_ts = g_get_real_time ();
 
-  nns_orc_conv_u8_to_u16 (res_u16, data_u8, array_size);
+  diff_loop = stop_ts - start_ts;
+  _print_log ("div f32 loop: %" G_GINT64_FORMAT, diff_loop);
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_EQ (res_u16[i], (uint16_t) data_u8[i]);
+  /* orc mul f32 */
+  start_ts = g_get_real_time ();
+  nns_orc_mul_c_f32 (data_float, 2., array_size);
+  stop_ts = g_get_real_time ();
+
+  diff_orc = stop_ts - start_ts;
+  _print_log ("mul f32 orc: %" G_GINT64_FORMAT, diff_orc);
+
+  for (i = 0; i < array_size; ++i) {
+    EXPECT_FLOAT_EQ (data_float[i], 8.);
   }
 
-  /* convert s32 */
-  int32_t res_s32[array_size] = { 0, };
+  /* loop */
+  start_ts = g_get_real_time ();
+  for (i = 0; i < array_size; ++i) {
+    data_float[i] *= 2.;
+  }
+  stop_ts = g_get_real_time ();
 
-  nns_orc_conv_u8_to_s32 (res_s32, data_u8, array_size);
+  diff_loop = stop_ts - start_ts;
+  _print_log ("mul f32 loop: %" G_GINT64_FORMAT, diff_loop);
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_EQ (res_s32[i], (int32_t) data_u8[i]);
+  /* orc add f32 */
+  start_ts = g_get_real_time ();
+  nns_orc_add_c_f32 (data_float, 2., array_size);
+  stop_ts = g_get_real_time ();
+
+  diff_orc = stop_ts - start_ts;
+  _print_log ("add f32 orc: %" G_GINT64_FORMAT, diff_orc);
+
+  for (i = 0; i < array_size; ++i) {
+    EXPECT_FLOAT_EQ (data_float[i], 18.);
   }
 
-  /* convert u32 */
-  uint32_t res_u32[array_size] = { 0, };
+  /* loop */
+  start_ts = g_get_real_time ();
+  for (i = 0; i < array_size; ++i) {
+    data_float[i] += 2.;
+  }
+  stop_ts = g_get_real_time ();
 
-  nns_orc_conv_u8_to_u32 (res_u32, data_u8, array_size);
+  diff_loop = stop_ts - start_ts;
+  _print_log ("add f32 loop: %" G_GINT64_FORMAT, diff_loop);
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_EQ (res_u32[i], (uint32_t) data_u8[i]);
+  /* init data for tc combined */
+  for (i = 0; i < array_size; ++i) {
+    data_u8[i] = 1;
+  }
+
+  /* orc typecast - add - mul */
+  start_ts = g_get_real_time ();
+  nns_orc_conv_u8_to_f32 (data_float, data_u8, array_size);
+  nns_orc_add_c_f32 (data_float, .2, array_size);
+  nns_orc_mul_c_f32 (data_float, 1.2, array_size);
+  stop_ts = g_get_real_time ();
+
+  diff_orc = stop_ts - start_ts;
+  _print_log ("combined orc: %" G_GINT64_FORMAT, diff_orc);
+
+  for (i = 0; i < array_size; ++i) {
+    EXPECT_FLOAT_EQ (data_float[i], (1 + .2) * 1.2);
+  }
+
+  /* loop */
+  start_ts = g_get_real_time ();
+  for (i = 0; i < array_size; ++i) {
+    data_float[i] = (float) data_u8[i];
+    data_float[i] += .2;
+    data_float[i] *= 1.2;
   }
+  stop_ts = g_get_real_time ();
+
+  diff_loop = stop_ts - start_ts;
+  _print_log ("combined loop: %" G_GINT64_FORMAT, diff_loop);
+
+  g_free (data_u8);
+  g_free (data_float);
+}
+#endif /* HAVE_ORC */
+
+/**
+ * @brief Test for tensor_filter buffer pool (output buffers are recycled)
+ */
+TEST (test_tensor_filter, buffer_pool)
+{
+  const guint num_buffers = 10;
+  const guint min_buffers = 2;
+  const gchar *model = "./tests/libnnscustom_framecounter.so";
+
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstTensorConfig config;
+  GstMemory *mem;
+  GstMapInfo info;
+  GstMemory *out_mem[num_buffers];
+  guint i, j, b, allocated;
+  gsize data_size;
+
+  h = gst_harness_new ("tensor_filter");
+
+  g_object_set (h->element, "framework", "custom", "model", model, NULL);
+  g_object_set (h->element, "min-buffers", min_buffers, NULL);
+
+  /* input tensor info */
+  config.info.type = _NNS_UINT8;
+  get_tensor_dimension ("3:4:4:1", config.info.dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+
+  gst_harness_set_src_caps (h, gst_tensor_caps_from_config (&config));
+  data_size = gst_tensor_info_get_size (&config.info);
+
+  /* push buffers */
+  for (b = 0; b < num_buffers; b++) {
+    /* set input buffer */
+    in_buf = gst_harness_create_buffer (h, data_size);
+
+    mem = gst_buffer_peek_memory (in_buf, 0);
+    ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_WRITE));
+
+    for (i = 0; i < data_size; i++) {
+      ((uint8_t *) info.data)[i] = (uint8_t) (i + b);
+    }
+
+    gst_memory_unmap (mem, &info);
+
+    EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+
+    /* get output buffer */
+    out_buf = gst_harness_pull (h);
+
+    ASSERT_TRUE (out_buf != NULL);
+    ASSERT_EQ (gst_buffer_n_memory (out_buf), 1U);
+    ASSERT_EQ (gst_buffer_get_size (out_buf), sizeof (uint32_t));
+
+    /* the output buffer should be acquired from the pool */
+    EXPECT_TRUE (out_buf->pool != NULL);
+
+    mem = gst_buffer_peek_memory (out_buf, 0);
+    ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_READ));
 
-  /* convert f32 */
-  float res_f32[array_size] = { 0, };
+    /* frame counter */
+    EXPECT_EQ (((uint32_t *) info.data)[0], b);
 
-  nns_orc_conv_u8_to_f32 (res_f32, data_u8, array_size);
+    gst_memory_unmap (mem, &info);
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_FLOAT_EQ (res_f32[i], (float) data_u8[i]);
+    /* release the buffer to the pool */
+    out_mem[b] = mem;
+    gst_buffer_unref (out_buf);
   }
 
-  /* convert f64 */
-  double res_f64[array_size] = { 0, };
-
-  nns_orc_conv_u8_to_f64 (res_f64, data_u8, array_size);
+  /* steady state, no more memory blocks allocated than pre-allocated buffers */
+  allocated = 0;
+  for (b = 0; b < num_buffers; b++) {
+    for (j = 0; j < b; j++) {
+      if (out_mem[j] == out_mem[b])
+        break;
+    }
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_DOUBLE_EQ (res_f64[i], (double) data_u8[i]);
+    if (j == b)
+      allocated++;
   }
+
+  EXPECT_LE (allocated, min_buffers);
+  EXPECT_EQ (gst_harness_buffers_received (h), num_buffers);
+
+  gst_harness_teardown (h);
 }
 
 /**
- * @brief Test for tensor_transform orc functions (convert s16 to other type)
+ * @brief Test for tensor_filter in-place mode (the custom filter writes output into the input buffer)
  */
-TEST (test_tensor_transform, orc_conv_s16)
+TEST (test_tensor_filter, in_place)
 {
-  const guint array_size = 10;
-  guint i;
+  const guint num_buffers = 3;
+  const gchar *model =
+      "./nnstreamer_example/custom_example_passthrough/libnnstreamer_customfilter_passthrough_variable.so";
 
-  int16_t data_s16[array_size] = { 0, };
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstTensorConfig config;
+  GstMemory *mem, *in_mem;
+  GstMapInfo info;
+  guint i, b;
+  gsize data_size;
 
-  for (i = 0; i < array_size; i++) {
-    data_s16[i] = (i + 1) * -1;
-  }
+  h = gst_harness_new ("tensor_filter");
 
-  /* convert s8 */
-  int8_t res_s8[array_size] = { 0, };
+  g_object_set (h->element, "framework", "custom", "model", model, NULL);
 
-  nns_orc_conv_s16_to_s8 (res_s8, data_s16, array_size);
+  /* input tensor info */
+  config.info.type = _NNS_FLOAT32;
+  get_tensor_dimension ("10:1:1:1", config.info.dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_EQ (res_s8[i], (int8_t) data_s16[i]);
-  }
+  gst_harness_set_src_caps (h, gst_tensor_caps_from_config (&config));
+  data_size = gst_tensor_info_get_size (&config.info);
 
-  /* convert u8 */
-  uint8_t res_u8[array_size] = { 0, };
+  /* push buffers */
+  for (b = 0; b < num_buffers; b++) {
+    /* set input buffer */
+    in_buf = gst_buffer_new_allocate (NULL, data_size, NULL);
 
-  nns_orc_conv_s16_to_u8 (res_u8, data_s16, array_size);
+    in_mem = gst_buffer_peek_memory (in_buf, 0);
+    ASSERT_TRUE (gst_memory_map (in_mem, &info, GST_MAP_WRITE));
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_EQ (res_u8[i], (uint8_t) data_s16[i]);
-  }
+    for (i = 0; i < 10; i++) {
+      ((float *) info.data)[i] = (float) (i + b);
+    }
 
-  /* convert s16 */
-  int16_t res_s16[array_size] = { 0, };
+    gst_memory_unmap (in_mem, &info);
 
-  nns_orc_conv_s16_to_s16 (res_s16, data_s16, array_size);
+    EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_EQ (res_s16[i], (int16_t) data_s16[i]);
-  }
+    /* get output buffer */
+    out_buf = gst_harness_pull (h);
 
-  /* convert u16 */
-  uint16_t res_u16[array_size] = { 0, };
+    ASSERT_TRUE (out_buf != NULL);
+    ASSERT_EQ (gst_buffer_n_memory (out_buf), 1U);
+    ASSERT_EQ (gst_buffer_get_size (out_buf), data_size);
 
-  nns_orc_conv_s16_to_u16 (res_u16, data_s16, array_size);
+    /* the output tensor should be written in the input memory block */
+    mem = gst_buffer_peek_memory (out_buf, 0);
+    EXPECT_TRUE (mem == in_mem);
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_EQ (res_u16[i], (uint16_t) data_s16[i]);
+    ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_READ));
+
+    for (i = 0; i < 10; i++) {
+      EXPECT_FLOAT_EQ (((float *) info.data)[i], (float) (i + b));
+    }
+
+    gst_memory_unmap (mem, &info);
+    gst_buffer_unref (out_buf);
   }
 
-  /* convert s32 */
-  int32_t res_s32[array_size] = { 0, };
+  EXPECT_EQ (gst_harness_buffers_received (h), num_buffers);
+  gst_harness_teardown (h);
+}
 
-  nns_orc_conv_s16_to_s32 (res_s32, data_s16, array_size);
+/**
+ * @brief Test for tensor_filter batch invoke (batch-size).
+ */
+TEST (test_tensor_filter, batch_invoke)
+{
+  const guint num_buffers = 10;
+  const guint batch_size = 4;
+  const gchar *model = "./tests/libnnscustom_framecounter.so";
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_EQ (res_s32[i], (int32_t) data_s16[i]);
-  }
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstTensorConfig config;
+  GstMemory *mem;
+  GstMapInfo info;
+  guint b, received;
+  gsize data_size;
 
-  /* convert u32 */
-  uint32_t res_u32[array_size] = { 0, };
+  h = gst_harness_new ("tensor_filter");
 
-  nns_orc_conv_s16_to_u32 (res_u32, data_s16, array_size);
+  g_object_set (h->element, "framework", "custom", "model", model, NULL);
+  g_object_set (h->element, "batch-size", batch_size, NULL);
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_EQ (res_u32[i], (uint32_t) data_s16[i]);
-  }
+  /* input tensor info */
+  config.info.type = _NNS_UINT8;
+  get_tensor_dimension ("3:4:4:1", config.info.dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
 
-  /* convert f32 */
-  float res_f32[array_size] = { 0, };
+  gst_harness_set_src_caps (h, gst_tensor_caps_from_config (&config));
+  data_size = gst_tensor_info_get_size (&config.info);
 
-  nns_orc_conv_s16_to_f32 (res_f32, data_s16, array_size);
+  /* push buffers */
+  for (b = 0; b < num_buffers; b++) {
+    in_buf = gst_harness_create_buffer (h, data_size);
+    GST_BUFFER_PTS (in_buf) = b * GST_SECOND;
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_FLOAT_EQ (res_f32[i], (float) data_s16[i]);
+    EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+
+    /* the output buffers are pushed when the batch is full */
+    EXPECT_EQ (gst_harness_buffers_received (h),
+        ((b + 1) / batch_size) * batch_size);
   }
 
-  /* convert f64 */
-  double res_f64[array_size] = { 0, };
+  /* the partial batch is invoked with EOS */
+  EXPECT_TRUE (gst_harness_push_event (h, gst_event_new_eos ()));
 
-  nns_orc_conv_s16_to_f64 (res_f64, data_s16, array_size);
+  received = gst_harness_buffers_received (h);
+  EXPECT_EQ (received, num_buffers);
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_DOUBLE_EQ (res_f64[i], (double) data_s16[i]);
+  /* the output buffers in arrival order */
+  for (b = 0; b < received; b++) {
+    out_buf = gst_harness_pull (h);
+
+    ASSERT_TRUE (out_buf != NULL);
+    ASSERT_EQ (gst_buffer_get_size (out_buf), sizeof (uint32_t));
+    EXPECT_EQ (GST_BUFFER_PTS (out_buf), b * GST_SECOND);
+
+    mem = gst_buffer_peek_memory (out_buf, 0);
+    ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_READ));
+
+    /* frame counter */
+    EXPECT_EQ (((uint32_t *) info.data)[0], b);
+
+    gst_memory_unmap (mem, &info);
+    gst_buffer_unref (out_buf);
   }
+
+  gst_harness_teardown (h);
 }
 
 /**
- * @brief Test for tensor_transform orc functions (convert u16 to other type)
+ * @brief Test for tensor_filter invoke statistics.
  */
-TEST (test_tensor_transform, orc_conv_u16)
+TEST (test_tensor_filter, invoke_stats)
 {
-  const guint array_size = 10;
-  guint i;
+  const guint num_buffers = 5;
+  const guint delay_ms = 5;
+  const gchar *model = "./tests/libnnscustom_framecounter.so";
 
-  uint16_t data_u16[array_size] = { 0, };
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstTensorConfig config;
+  guint64 count;
+  guint last, avg, min, max, p50, p99;
+  gdouble rate;
+  guint b;
+  gsize data_size;
 
-  for (i = 0; i < array_size; i++) {
-    data_u16[i] = G_MAXUINT16 - i;
-  }
+  h = gst_harness_new ("tensor_filter");
 
-  /* convert s8 */
-  int8_t res_s8[array_size] = { 0, };
+  g_object_set (h->element, "framework", "custom", "model", model,
+      "custom", "delay-5", NULL);
 
-  nns_orc_conv_u16_to_s8 (res_s8, data_u16, array_size);
+  /* input tensor info */
+  config.info.type = _NNS_UINT8;
+  get_tensor_dimension ("3:4:4:1", config.info.dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_EQ (res_s8[i], (int8_t) data_u16[i]);
-  }
+  gst_harness_set_src_caps (h, gst_tensor_caps_from_config (&config));
+  data_size = gst_tensor_info_get_size (&config.info);
 
-  /* convert u8 */
-  uint8_t res_u8[array_size] = { 0, };
+  g_object_get (h->element, "invoke-count", &count, "latency-p50", &p50, NULL);
+  EXPECT_EQ (count, 0U);
+  EXPECT_EQ (p50, 0U);
 
-  nns_orc_conv_u16_to_u8 (res_u8, data_u16, array_size);
+  /* push buffers */
+  for (b = 0; b < num_buffers; b++) {
+    in_buf = gst_harness_create_buffer (h, data_size);
+    EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_EQ (res_u8[i], (uint8_t) data_u16[i]);
+    out_buf = gst_harness_pull (h);
+    ASSERT_TRUE (out_buf != NULL);
+    gst_buffer_unref (out_buf);
   }
 
-  /* convert s16 */
-  int16_t res_s16[array_size] = { 0, };
-
-  nns_orc_conv_u16_to_s16 (res_s16, data_u16, array_size);
-
-  for (i = 0; i < array_size; i++) {
-    EXPECT_EQ (res_s16[i], (int16_t) data_u16[i]);
-  }
+  g_object_get (h->element, "invoke-count", &count, "invoke-rate", &rate,
+      "latency-last", &last, "latency-avg", &avg, "latency-min", &min,
+      "latency-max", &max, "latency-p50", &p50, "latency-p99", &p99, NULL);
 
-  /* convert u16 */
-  uint16_t res_u16[array_size] = { 0, };
+  EXPECT_EQ (count, num_buffers);
+  EXPECT_GT (rate, 0.0);
 
-  nns_orc_conv_u16_to_u16 (res_u16, data_u16, array_size);
+  /* each invoke sleeps delay_ms */
+  EXPECT_GE (min, delay_ms * 1000U);
+  EXPECT_GE (last, min);
+  EXPECT_LE (last, max);
+  EXPECT_GE (avg, min);
+  EXPECT_LE (avg, max);
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_EQ (res_u16[i], (uint16_t) data_u16[i]);
-  }
+  /* the percentiles are estimated within 12.5% of the latency */
+  EXPECT_GE (p50, min - min / 8);
+  EXPECT_LE (p50, max + max / 8);
+  EXPECT_GE (p99, p50);
+  EXPECT_LE (p99, max + max / 8);
 
-  /* convert s32 */
-  int32_t res_s32[array_size] = { 0, };
+  gst_harness_teardown (h);
+}
 
-  nns_orc_conv_u16_to_s32 (res_s32, data_u16, array_size);
+/**
+ * @brief Test for tensor_filter throttle, skipping the frames arriving faster than invoke.
+ */
+TEST (test_tensor_filter, throttle)
+{
+  const guint num_buffers = 20;
+  const gchar *model = "./tests/libnnscustom_framecounter.so";
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_EQ (res_s32[i], (int32_t) data_u16[i]);
-  }
+  GstHarness *h;
+  GstBuffer *in_buf;
+  GstTensorConfig config;
+  guint64 skipped;
+  guint b, received;
+  gsize data_size;
 
-  /* convert u32 */
-  uint32_t res_u32[array_size] = { 0, };
+  h = gst_harness_new ("tensor_filter");
 
-  nns_orc_conv_u16_to_u32 (res_u32, data_u16, array_size);
+  /* invoke takes 20ms or more, frames arrive every 5ms */
+  g_object_set (h->element, "framework", "custom", "model", model,
+      "custom", "delay-20", "throttle", TRUE, NULL);
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_EQ (res_u32[i], (uint32_t) data_u16[i]);
-  }
+  /* input tensor info */
+  config.info.type = _NNS_UINT8;
+  get_tensor_dimension ("3:4:4:1", config.info.dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
 
-  /* convert f32 */
-  float res_f32[array_size] = { 0, };
+  gst_harness_set_src_caps (h, gst_tensor_caps_from_config (&config));
+  data_size = gst_tensor_info_get_size (&config.info);
 
-  nns_orc_conv_u16_to_f32 (res_f32, data_u16, array_size);
+  for (b = 0; b < num_buffers; b++) {
+    in_buf = gst_harness_create_buffer (h, data_size);
+    GST_BUFFER_PTS (in_buf) = b * 5 * GST_MSECOND;
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_FLOAT_EQ (res_f32[i], (float) data_u16[i]);
+    EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
   }
 
-  /* convert f64 */
-  double res_f64[array_size] = { 0, };
+  received = gst_harness_buffers_received (h);
+  g_object_get (h->element, "skipped-count", &skipped, NULL);
 
-  nns_orc_conv_u16_to_f64 (res_f64, data_u16, array_size);
+  /* at most one frame for each invoke time (20ms) */
+  EXPECT_GE (received, 1U);
+  EXPECT_LE (received, num_buffers / 4);
+  EXPECT_EQ (received + skipped, num_buffers);
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_DOUBLE_EQ (res_f64[i], (double) data_u16[i]);
-  }
+  gst_harness_teardown (h);
 }
 
 /**
- * @brief Test for tensor_transform orc functions (convert s32 to other type)
+ * @brief Test for tensor_filter warm-up, the model is invoked with dummy tensors before the first frame.
  */
-TEST (test_tensor_transform, orc_conv_s32)
+TEST (test_tensor_filter, warmup)
 {
-  const guint array_size = 10;
-  guint i;
+  const guint warmup = 3;
+  const gchar *model = "./tests/libnnscustom_framecounter.so";
 
-  int32_t data_s32[array_size] = { 0, };
+  GstHarness *h;
+  GstElement *filter;
+  GstBuffer *in_buf, *out_buf;
+  GstTensorConfig config;
+  GstMemory *mem;
+  GstMapInfo info;
+  guint64 warmup_time;
+  gchar *desc;
+  gsize data_size;
 
-  for (i = 0; i < array_size; i++) {
-    data_s32[i] = (i + 1) * -1;
-  }
+  /* the properties should be set before the element goes to READY */
+  desc = g_strdup_printf ("tensor_filter name=filter framework=custom "
+      "model=%s input=3:4:4:1 inputtype=uint8 warmup=%u", model, warmup);
+  h = gst_harness_new_parse (desc);
+  g_free (desc);
 
-  /* convert s8 */
-  int8_t res_s8[array_size] = { 0, };
+  filter = gst_bin_get_by_name (GST_BIN (h->element), "filter");
+  ASSERT_TRUE (filter != NULL);
 
-  nns_orc_conv_s32_to_s8 (res_s8, data_s32, array_size);
+  g_object_get (filter, "warmup-time", &warmup_time, NULL);
+  EXPECT_GT (warmup_time, 0U);
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_EQ (res_s8[i], (int8_t) data_s32[i]);
-  }
+  /* input tensor info */
+  config.info.type = _NNS_UINT8;
+  get_tensor_dimension ("3:4:4:1", config.info.dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
 
-  /* convert u8 */
-  uint8_t res_u8[array_size] = { 0, };
+  gst_harness_set_src_caps (h, gst_tensor_caps_from_config (&config));
+  data_size = gst_tensor_info_get_size (&config.info);
+
+  in_buf = gst_harness_create_buffer (h, data_size);
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
 
-  nns_orc_conv_s32_to_u8 (res_u8, data_s32, array_size);
+  out_buf = gst_harness_pull (h);
+  ASSERT_TRUE (out_buf != NULL);
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_EQ (res_u8[i], (uint8_t) data_s32[i]);
-  }
+  mem = gst_buffer_peek_memory (out_buf, 0);
+  ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_READ));
 
-  /* convert s16 */
-  int16_t res_s16[array_size] = { 0, };
+  /* the frame counter has counted the dummy invokes */
+  EXPECT_EQ (((uint32_t *) info.data)[0], warmup);
 
-  nns_orc_conv_s32_to_s16 (res_s16, data_s32, array_size);
+  gst_memory_unmap (mem, &info);
+  gst_buffer_unref (out_buf);
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_EQ (res_s16[i], (int16_t) data_s32[i]);
-  }
+  gst_object_unref (filter);
+  gst_harness_teardown (h);
+}
 
-  /* convert u16 */
-  uint16_t res_u16[array_size] = { 0, };
+/**
+ * @brief Test for tensor filter, the output tensor is released by the sub-plugin.
+ */
+TEST (test_tensor_filter, release_output)
+{
+  const gchar *model = "./tests/libnnscustom_ringbuffer.so";
 
-  nns_orc_conv_s32_to_u16 (res_u16, data_s32, array_size);
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf[3];
+  GstTensorConfig config;
+  GstMapInfo info[3];
+  guint b;
+  gsize data_size;
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_EQ (res_u16[i], (uint16_t) data_s32[i]);
-  }
+  h = gst_harness_new ("tensor_filter");
 
-  /* convert s32 */
-  int32_t res_s32[array_size] = { 0, };
+  g_object_set (h->element, "framework", "custom", "model", model, NULL);
 
-  nns_orc_conv_s32_to_s32 (res_s32, data_s32, array_size);
+  /* input tensor info */
+  config.info.type = _NNS_UINT8;
+  get_tensor_dimension ("3:4:4:1", config.info.dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_EQ (res_s32[i], (int32_t) data_s32[i]);
-  }
+  gst_harness_set_src_caps (h, gst_tensor_caps_from_config (&config));
+  data_size = gst_tensor_info_get_size (&config.info);
 
-  /* convert u32 */
-  uint32_t res_u32[array_size] = { 0, };
+  /* hold two output buffers, all slots of the ring buffer are in use */
+  for (b = 0; b < 2; b++) {
+    in_buf = gst_harness_create_buffer (h, data_size);
+    EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
 
-  nns_orc_conv_s32_to_u32 (res_u32, data_s32, array_size);
+    out_buf[b] = gst_harness_pull (h);
+    ASSERT_TRUE (out_buf[b] != NULL);
+    ASSERT_EQ (gst_buffer_get_size (out_buf[b]), sizeof (uint32_t));
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_EQ (res_u32[i], (uint32_t) data_s32[i]);
+    ASSERT_TRUE (gst_buffer_map (out_buf[b], &info[b], GST_MAP_READ));
+    EXPECT_EQ (((uint32_t *) info[b].data)[0], b);
   }
 
-  /* convert f32 */
-  float res_f32[array_size] = { 0, };
+  EXPECT_TRUE (info[0].data != info[1].data);
 
-  nns_orc_conv_s32_to_f32 (res_f32, data_s32, array_size);
+  /* release the first output, its slot should be recycled without copy */
+  gst_buffer_unmap (out_buf[0], &info[0]);
+  gst_buffer_unmap (out_buf[1], &info[1]);
+  gst_buffer_unref (out_buf[0]);
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_FLOAT_EQ (res_f32[i], (float) data_s32[i]);
-  }
+  in_buf = gst_harness_create_buffer (h, data_size);
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
 
-  /* convert f64 */
-  double res_f64[array_size] = { 0, };
+  out_buf[2] = gst_harness_pull (h);
+  ASSERT_TRUE (out_buf[2] != NULL);
 
-  nns_orc_conv_s32_to_f64 (res_f64, data_s32, array_size);
+  ASSERT_TRUE (gst_buffer_map (out_buf[2], &info[2], GST_MAP_READ));
+  EXPECT_EQ (((uint32_t *) info[2].data)[0], 2U);
+  EXPECT_TRUE (info[2].data == info[0].data);
+  gst_buffer_unmap (out_buf[2], &info[2]);
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_DOUBLE_EQ (res_f64[i], (double) data_s32[i]);
-  }
+  gst_buffer_unref (out_buf[1]);
+  gst_buffer_unref (out_buf[2]);
+
+  /* the output buffers may outlive the filter */
+  gst_harness_teardown (h);
 }
 
 /**
- * @brief Test for tensor_transform orc functions (convert u32 to other type)
+ * @brief Test for tensor filter, the input tensors given by caps are renegotiated.
  */
-TEST (test_tensor_transform, orc_conv_u32)
+TEST (test_tensor_filter, renegotiate)
 {
-  const guint array_size = 10;
-  guint i;
-
-  uint32_t data_u32[array_size] = { 0, };
+  const gchar *model =
+      "./nnstreamer_example/custom_example_passthrough/libnnstreamer_customfilter_passthrough_variable.so";
+  const gchar *dims[] = { "10:1:1:1", "20:1:1:1", "10:1:1:1" };
 
-  for (i = 0; i < array_size; i++) {
-    data_u32[i] = G_MAXUINT32 - i;
-  }
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstTensorConfig config;
+  guint i;
+  gsize data_size;
 
-  /* convert s8 */
-  int8_t res_s8[array_size] = { 0, };
+  h = gst_harness_new ("tensor_filter");
 
-  nns_orc_conv_u32_to_s8 (res_s8, data_u32, array_size);
+  g_object_set (h->element, "framework", "custom", "model", model, NULL);
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_EQ (res_s8[i], (int8_t) data_u32[i]);
-  }
+  for (i = 0; i < G_N_ELEMENTS (dims); i++) {
+    /* input tensor info */
+    config.info.type = _NNS_FLOAT32;
+    get_tensor_dimension (dims[i], config.info.dimension);
+    config.rate_n = 0;
+    config.rate_d = 1;
 
-  /* convert u8 */
-  uint8_t res_u8[array_size] = { 0, };
+    gst_harness_set_src_caps (h, gst_tensor_caps_from_config (&config));
+    data_size = gst_tensor_info_get_size (&config.info);
 
-  nns_orc_conv_u32_to_u8 (res_u8, data_u32, array_size);
+    in_buf = gst_harness_create_buffer (h, data_size);
+    EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_EQ (res_u8[i], (uint8_t) data_u32[i]);
+    /* the output tensor is reconfigured with the input tensor */
+    out_buf = gst_harness_pull (h);
+    ASSERT_TRUE (out_buf != NULL);
+    EXPECT_EQ (gst_buffer_get_size (out_buf), data_size);
+    gst_buffer_unref (out_buf);
   }
 
-  /* convert s16 */
-  int16_t res_s16[array_size] = { 0, };
+  EXPECT_EQ (gst_harness_buffers_received (h), G_N_ELEMENTS (dims));
+  gst_harness_teardown (h);
+}
 
-  nns_orc_conv_u32_to_s16 (res_s16, data_u32, array_size);
+/**
+ * @brief Test for tensor_filter batch invoke with multiple tensors (custom filter LSTM).
+ */
+TEST (test_tensor_filter, batch_invoke_lstm)
+{
+  const guint batch_size = 4;
+  const gchar *model =
+      "./nnstreamer_example/custom_example_LSTM/libdummyLSTM.so";
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_EQ (res_s16[i], (int16_t) data_u32[i]);
-  }
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstTensorsConfig config;
+  GstMemory *mem;
+  GstMapInfo info;
+  guint b, i, t;
+  gsize data_size;
+  gfloat in[3], t0, t1, c;
 
-  /* convert u16 */
-  uint16_t res_u16[array_size] = { 0, };
+  h = gst_harness_new ("tensor_filter");
 
-  nns_orc_conv_u32_to_u16 (res_u16, data_u32, array_size);
+  g_object_set (h->element, "framework", "custom", "model", model, NULL);
+  g_object_set (h->element, "batch-size", batch_size, NULL);
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_EQ (res_u16[i], (uint16_t) data_u32[i]);
+  /* input tensors info, new frame and recurring tensors */
+  gst_tensors_config_init (&config);
+  config.info.num_tensors = 3;
+  for (t = 0; t < 3; t++) {
+    config.info.info[t].type = _NNS_FLOAT32;
+    get_tensor_dimension ("4:4:4:1", config.info.info[t].dimension);
   }
+  config.rate_n = 0;
+  config.rate_d = 1;
 
-  /* convert s32 */
-  int32_t res_s32[array_size] = { 0, };
+  gst_harness_set_src_caps (h, gst_tensors_caps_from_config (&config));
+  data_size = gst_tensor_info_get_size (&config.info.info[0]);
 
-  nns_orc_conv_u32_to_s32 (res_s32, data_u32, array_size);
+  /* push buffers, each frame has its own recurring tensors */
+  for (b = 0; b < batch_size; b++) {
+    in[0] = (gfloat) (b + 1);
+    in[1] = 0.5f;
+    in[2] = 0.25f * b;
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_EQ (res_s32[i], (int32_t) data_u32[i]);
-  }
+    in_buf = gst_buffer_new ();
 
-  /* convert u32 */
-  uint32_t res_u32[array_size] = { 0, };
+    for (t = 0; t < 3; t++) {
+      mem = gst_allocator_alloc (NULL, data_size, NULL);
+      ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_WRITE));
 
-  nns_orc_conv_u32_to_u32 (res_u32, data_u32, array_size);
+      for (i = 0; i < 64; i++)
+        ((gfloat *) info.data)[i] = in[t];
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_EQ (res_u32[i], (uint32_t) data_u32[i]);
+      gst_memory_unmap (mem, &info);
+      gst_buffer_append_memory (in_buf, mem);
+    }
+
+    EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
   }
 
-  /* convert f32 */
-  float res_f32[array_size] = { 0, };
+  EXPECT_EQ (gst_harness_buffers_received (h), batch_size);
 
-  nns_orc_conv_u32_to_f32 (res_f32, data_u32, array_size);
+  for (b = 0; b < batch_size; b++) {
+    /* expected output of the frame */
+    t0 = (0.25f * b + 0.5f) / 2;
+    t1 = tanh (0.25f * b);
+    c = (gfloat) (b + 1) * t0 + t0 * t1;
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_FLOAT_EQ (res_f32[i], (float) ((int32_t) data_u32[i]));
-  }
+    out_buf = gst_harness_pull (h);
+    ASSERT_TRUE (out_buf != NULL);
+    ASSERT_EQ (gst_buffer_n_memory (out_buf), 2U);
 
-  /* convert f64 */
-  double res_f64[array_size] = { 0, };
+    mem = gst_buffer_peek_memory (out_buf, 0);
+    ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_READ));
+    for (i = 0; i < 64; i++)
+      EXPECT_FLOAT_EQ (((gfloat *) info.data)[i], c);
+    gst_memory_unmap (mem, &info);
 
-  nns_orc_conv_u32_to_f64 (res_f64, data_u32, array_size);
+    mem = gst_buffer_peek_memory (out_buf, 1);
+    ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_READ));
+    for (i = 0; i < 64; i++)
+      EXPECT_FLOAT_EQ (((gfloat *) info.data)[i], (gfloat) tanh (c) * t0);
+    gst_memory_unmap (mem, &info);
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_DOUBLE_EQ (res_f64[i], (double) ((int32_t) data_u32[i]));
+    gst_buffer_unref (out_buf);
   }
+
+  gst_harness_teardown (h);
 }
 
 /**
- * @brief Test for tensor_transform orc functions (convert f32 to other type)
+ * @brief Test for the recurrent state tensors fed back inside tensor_filter
  */
-TEST (test_tensor_transform, orc_conv_f32)
+TEST (test_tensor_filter, state_tensors_lstm)
 {
-  const guint array_size = 10;
-  guint i;
-
-  float data_f32[array_size] = { 0, };
-
-  for (i = 0; i < array_size; i++) {
-    data_f32[i] = (i + 1.) * -1.;
-  }
-
-  /* convert s8 */
-  int8_t res_s8[array_size] = { 0, };
-
-  nns_orc_conv_f32_to_s8 (res_s8, data_f32, array_size);
+  const guint num_frames = 3;
+  const gchar *model =
+      "./nnstreamer_example/custom_example_LSTM/libdummyLSTM.so";
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_EQ (res_s8[i], (int8_t) data_f32[i]);
-  }
-
-  /* convert u8 */
-  uint8_t res_u8[array_size] = { 0, };
-
-  nns_orc_conv_f32_to_u8 (res_u8, data_f32, array_size);
-
-  for (i = 0; i < array_size; i++) {
-    int8_t val = (int8_t) data_f32[i];
-    EXPECT_EQ (res_u8[i], (uint8_t) val);
-  }
-
-  /* convert s16 */
-  int16_t res_s16[array_size] = { 0, };
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf[num_frames];
+  GstTensorsConfig config;
+  GstMemory *mem;
+  GstMapInfo info;
+  guint b, i;
+  gsize data_size;
+  gfloat x, t0, c, hidden;
+  gchar *str;
 
-  nns_orc_conv_f32_to_s16 (res_s16, data_f32, array_size);
+  h = gst_harness_new ("tensor_filter");
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_EQ (res_s16[i], (int16_t) data_f32[i]);
-  }
+  /* the input tensors 0 and 1 are given by the output tensors 0 and 1 of the previous frame */
+  g_object_set (h->element, "framework", "custom", "model", model,
+      "state-inputs", "0,1", "state-outputs", "0,1", NULL);
 
-  /* convert u16 */
-  uint16_t res_u16[array_size] = { 0, };
+  g_object_get (h->element, "state-inputs", &str, NULL);
+  EXPECT_STREQ (str, "0,1");
+  g_free (str);
 
-  nns_orc_conv_f32_to_u16 (res_u16, data_f32, array_size);
+  /* input tensor info, the new frame only */
+  gst_tensors_config_init (&config);
+  config.info.num_tensors = 1;
+  config.info.info[0].type = _NNS_FLOAT32;
+  get_tensor_dimension ("4:4:4:1", config.info.info[0].dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
 
-  for (i = 0; i < array_size; i++) {
-    int16_t val = (int16_t) data_f32[i];
-    EXPECT_EQ (res_u16[i], (uint16_t) val);
-  }
+  gst_harness_set_src_caps (h, gst_tensors_caps_from_config (&config));
+  data_size = gst_tensor_info_get_size (&config.info.info[0]);
 
-  /* convert s32 */
-  int32_t res_s32[array_size] = { 0, };
+  /* the initial state tensors are zero-filled */
+  c = hidden = 0.0f;
 
-  nns_orc_conv_f32_to_s32 (res_s32, data_f32, array_size);
+  for (b = 0; b < num_frames; b++) {
+    x = 0.5f * (b + 1);
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_EQ (res_s32[i], (int32_t) data_f32[i]);
-  }
+    mem = gst_allocator_alloc (NULL, data_size, NULL);
+    ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_WRITE));
+    for (i = 0; i < 64; i++)
+      ((gfloat *) info.data)[i] = x;
+    gst_memory_unmap (mem, &info);
 
-  /* convert u32 */
-  uint32_t res_u32[array_size] = { 0, };
+    in_buf = gst_buffer_new ();
+    gst_buffer_append_memory (in_buf, mem);
 
-  nns_orc_conv_f32_to_u32 (res_u32, data_f32, array_size);
+    EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
 
-  for (i = 0; i < array_size; i++) {
-    int32_t val = (int32_t) data_f32[i];
-    EXPECT_EQ (res_u32[i], (uint32_t) val);
-  }
+    /* expected output of the frame */
+    t0 = (x + hidden) / 2;
+    c = c * t0 + t0 * (gfloat) tanh (x);
+    hidden = (gfloat) tanh (c) * t0;
 
-  /* convert f32 */
-  float res_f32[array_size] = { 0, };
+    /* keep the output buffer, the state tensor is still referred */
+    out_buf[b] = gst_harness_pull (h);
+    ASSERT_TRUE (out_buf[b] != NULL);
+    ASSERT_EQ (gst_buffer_n_memory (out_buf[b]), 2U);
 
-  nns_orc_conv_f32_to_f32 (res_f32, data_f32, array_size);
+    mem = gst_buffer_peek_memory (out_buf[b], 0);
+    ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_READ));
+    for (i = 0; i < 64; i++)
+      EXPECT_FLOAT_EQ (((gfloat *) info.data)[i], c);
+    gst_memory_unmap (mem, &info);
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_FLOAT_EQ (res_f32[i], (float) data_f32[i]);
+    mem = gst_buffer_peek_memory (out_buf[b], 1);
+    ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_READ));
+    for (i = 0; i < 64; i++)
+      EXPECT_FLOAT_EQ (((gfloat *) info.data)[i], hidden);
+    gst_memory_unmap (mem, &info);
   }
 
-  /* convert f64 */
-  double res_f64[array_size] = { 0, };
+  /* the output of the first frame is not changed by the next invokes */
+  mem = gst_buffer_peek_memory (out_buf[0], 1);
+  ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_READ));
+  EXPECT_FLOAT_EQ (((gfloat *) info.data)[0],
+      (gfloat) tanh (0.25f * tanh (0.5f)) * 0.25f);
+  gst_memory_unmap (mem, &info);
 
-  nns_orc_conv_f32_to_f64 (res_f64, data_f32, array_size);
+  for (b = 0; b < num_frames; b++)
+    gst_buffer_unref (out_buf[b]);
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_DOUBLE_EQ (res_f64[i], (double) data_f32[i]);
-  }
+  gst_harness_teardown (h);
 }
 
 /**
- * @brief Test for tensor_transform orc functions (convert f64 to other type)
+ * @brief Test for tensor_filter, the model is swapped while playing without dropping frames.
  */
-TEST (test_tensor_transform, orc_conv_f64)
+TEST (test_tensor_filter, model_swap)
 {
-  const guint array_size = 10;
-  guint i;
+  const guint max_frames = 1000;
+  const gchar *model = "./tests/libnnscustom_framecounter.so";
 
-  double data_f64[array_size] = { 0, };
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstTensorConfig config;
+  GstMemory *mem;
+  GstMapInfo info;
+  guint b, counter, last;
+  guint64 latency;
+  guint dropped;
+  gsize data_size;
 
-  for (i = 0; i < array_size; i++) {
-    data_f64[i] = (i + 1.) * -1.;
-  }
+  h = gst_harness_new ("tensor_filter");
 
-  /* convert s8 */
-  int8_t res_s8[array_size] = { 0, };
+  g_object_set (h->element, "framework", "custom", "model", model, NULL);
 
-  nns_orc_conv_f64_to_s8 (res_s8, data_f64, array_size);
+  /* input tensor info */
+  config.info.type = _NNS_UINT8;
+  get_tensor_dimension ("3:4:4:1", config.info.dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_EQ (res_s8[i], (int8_t) data_f64[i]);
-  }
+  gst_harness_set_src_caps (h, gst_tensor_caps_from_config (&config));
+  data_size = gst_tensor_info_get_size (&config.info);
+
+  last = 0;
+  for (b = 0; b < max_frames; b++) {
+    /* the new instance of the model, counting from 1 after a warm-up invoke */
+    if (b == 5)
+      g_object_set (h->element, "model", model, NULL);
+
+    in_buf = gst_harness_create_buffer (h, data_size);
+    EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+
+    /* every frame is invoked, with the old model until the new model is ready */
+    out_buf = gst_harness_pull (h);
+    ASSERT_TRUE (out_buf != NULL);
+    ASSERT_EQ (gst_buffer_get_size (out_buf), sizeof (uint32_t));
 
-  /* convert u8 */
-  uint8_t res_u8[array_size] = { 0, };
+    mem = gst_buffer_peek_memory (out_buf, 0);
+    ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_READ));
+    counter = ((uint32_t *) info.data)[0];
+    gst_memory_unmap (mem, &info);
+    gst_buffer_unref (out_buf);
 
-  nns_orc_conv_f64_to_u8 (res_u8, data_f64, array_size);
+    if (b > 0 && counter != last + 1)
+      break;
 
-  for (i = 0; i < array_size; i++) {
-    int8_t val = (int8_t) data_f64[i];
-    EXPECT_EQ (res_u8[i], (uint8_t) val);
+    last = counter;
+    g_usleep (1000);
   }
 
-  /* convert s16 */
-  int16_t res_s16[array_size] = { 0, };
+  /* swapped */
+  ASSERT_LT (b, max_frames);
+  EXPECT_GE (b, 5U);
+  EXPECT_EQ (counter, 1U);
 
-  nns_orc_conv_f64_to_s16 (res_s16, data_f64, array_size);
+  g_object_get (h->element, "swap-latency", &latency, "swap-dropped",
+      &dropped, NULL);
+  EXPECT_GT (latency, 0U);
+  EXPECT_EQ (dropped, 0U);
+  EXPECT_EQ (gst_harness_buffers_received (h), b + 1);
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_EQ (res_s16[i], (int16_t) data_f64[i]);
-  }
+  gst_harness_teardown (h);
+}
 
-  /* convert u16 */
-  uint16_t res_u16[array_size] = { 0, };
+/**
+ * @brief Test for tensor_filter, the model with other output tensors is swapped and the source pad is renegotiated.
+ */
+TEST (test_tensor_filter, model_swap_renegotiate)
+{
+  const guint max_frames = 1000;
+  const gchar *model = "./tests/libnnscustom_framecounter.so";
+  const gchar *model_next =
+      "./nnstreamer_example/custom_example_passthrough/libnnstreamer_customfilter_passthrough_variable.so";
 
-  nns_orc_conv_f64_to_u16 (res_u16, data_f64, array_size);
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstTensorConfig config;
+  GstMemory *mem;
+  GstMapInfo info;
+  guint b, i;
+  guint dropped;
+  gsize data_size, out_size;
+  gchar *str;
 
-  for (i = 0; i < array_size; i++) {
-    int16_t val = (int16_t) data_f64[i];
-    EXPECT_EQ (res_u16[i], (uint16_t) val);
-  }
+  h = gst_harness_new ("tensor_filter");
 
-  /* convert s32 */
-  int32_t res_s32[array_size] = { 0, };
+  g_object_set (h->element, "framework", "custom", "model", model, NULL);
 
-  nns_orc_conv_f64_to_s32 (res_s32, data_f64, array_size);
+  /* input tensor info */
+  config.info.type = _NNS_UINT8;
+  get_tensor_dimension ("3:4:4:1", config.info.dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_EQ (res_s32[i], (int32_t) data_f64[i]);
-  }
+  gst_harness_set_src_caps (h, gst_tensor_caps_from_config (&config));
+  data_size = gst_tensor_info_get_size (&config.info);
 
-  /* convert u32 */
-  uint32_t res_u32[array_size] = { 0, };
+  out_size = 0;
+  for (b = 0; b < max_frames; b++) {
+    if (b == 1)
+      g_object_set (h->element, "model", model_next, NULL);
 
-  nns_orc_conv_f64_to_u32 (res_u32, data_f64, array_size);
+    in_buf = gst_harness_create_buffer (h, data_size);
 
-  for (i = 0; i < array_size; i++) {
-    int32_t val = (int32_t) data_f64[i];
-    EXPECT_EQ (res_u32[i], (uint32_t) val);
-  }
+    mem = gst_buffer_peek_memory (in_buf, 0);
+    ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_WRITE));
+    for (i = 0; i < data_size; i++)
+      ((uint8_t *) info.data)[i] = (uint8_t) (i + b);
+    gst_memory_unmap (mem, &info);
 
-  /* convert f32 */
-  float res_f32[array_size] = { 0, };
+    EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
 
-  nns_orc_conv_f64_to_f32 (res_f32, data_f64, array_size);
+    out_buf = gst_harness_pull (h);
+    ASSERT_TRUE (out_buf != NULL);
+    out_size = gst_buffer_get_size (out_buf);
+
+    if (out_size == data_size) {
+      /* the new model passes the input through */
+      mem = gst_buffer_peek_memory (out_buf, 0);
+      ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_READ));
+      for (i = 0; i < data_size; i++)
+        EXPECT_EQ (((uint8_t *) info.data)[i], (uint8_t) (i + b));
+      gst_memory_unmap (mem, &info);
+      gst_buffer_unref (out_buf);
+      break;
+    }
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_FLOAT_EQ (res_f32[i], (float) data_f64[i]);
+    EXPECT_EQ (out_size, sizeof (uint32_t));
+    gst_buffer_unref (out_buf);
+    g_usleep (1000);
   }
 
-  /* convert f64 */
-  double res_f64[array_size] = { 0, };
+  /* swapped, the output tensor is renegotiated */
+  ASSERT_LT (b, max_frames);
+  EXPECT_EQ (out_size, data_size);
 
-  nns_orc_conv_f64_to_f64 (res_f64, data_f64, array_size);
+  g_object_get (h->element, "model", &str, "swap-dropped", &dropped, NULL);
+  EXPECT_STREQ (str, model_next);
+  EXPECT_EQ (dropped, 0U);
+  g_free (str);
 
-  for (i = 0; i < array_size; i++) {
-    EXPECT_DOUBLE_EQ (res_f64[i], (double) data_f64[i]);
-  }
+  EXPECT_EQ (gst_harness_buffers_received (h), b + 1);
+  gst_harness_teardown (h);
 }
 
 /**
- * @brief Test for tensor_transform orc functions (performance)
+ * @brief Test for tensor_filter, the element stops before the model given while playing is swapped.
  */
-TEST (test_tensor_transform, orc_performance)
+TEST (test_tensor_filter, model_swap_stop)
 {
-  const guint array_size = 80000;
-  guint i;
+  const gchar *model = "./tests/libnnscustom_framecounter.so";
+  const gchar *model_next =
+      "./nnstreamer_example/custom_example_passthrough/libnnstreamer_customfilter_passthrough_variable.so";
 
-  gint64 start_ts, stop_ts, diff_loop, diff_orc;
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstTensorConfig config;
+  gsize data_size;
+  gchar *str;
 
-  uint8_t *data_u8 = (uint8_t *) g_malloc0 (sizeof (uint8_t) * array_size);
-  float *data_float = (float *) g_malloc0 (sizeof (float) * array_size);
+  h = gst_harness_new ("tensor_filter");
 
-  /* orc add u8 */
-  start_ts = g_get_real_time ();
-  nns_orc_add_c_u8 (data_u8, 2, array_size);
-  stop_ts = g_get_real_time ();
+  g_object_set (h->element, "framework", "custom", "model", model, NULL);
 
-  diff_orc = stop_ts - start_ts;
-  _print_log ("add u8 orc: %" G_GINT64_FORMAT, diff_orc);
+  /* input tensor info */
+  config.info.type = _NNS_UINT8;
+  get_tensor_dimension ("3:4:4:1", config.info.dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
 
-  for (i = 0; i < array_size; ++i) {
-    EXPECT_EQ (data_u8[i], 2);
-  }
+  gst_harness_set_src_caps (h, gst_tensor_caps_from_config (&config));
+  data_size = gst_tensor_info_get_size (&config.info);
 
-  /* loop */
-  start_ts = g_get_real_time ();
-  for (i = 0; i < array_size; ++i) {
-    data_u8[i] += 2;
-  }
-  stop_ts = g_get_real_time ();
+  in_buf = gst_harness_create_buffer (h, data_size);
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+  out_buf = gst_harness_pull (h);
+  ASSERT_TRUE (out_buf != NULL);
+  EXPECT_EQ (gst_buffer_get_size (out_buf), sizeof (uint32_t));
+  gst_buffer_unref (out_buf);
 
-  diff_loop = stop_ts - start_ts;
-  _print_log ("add u8 loop: %" G_GINT64_FORMAT, diff_loop);
+  /* stopped without a frame, the new model is not opened while stopping */
+  g_object_set (h->element, "model", model_next, NULL);
+  EXPECT_EQ (gst_element_set_state (h->element, GST_STATE_NULL),
+      GST_STATE_CHANGE_SUCCESS);
 
-  /* orc mul u8 */
-  start_ts = g_get_real_time ();
-  nns_orc_mul_c_u8 (data_u8, 2, array_size);
-  stop_ts = g_get_real_time ();
+  g_object_get (h->element, "model", &str, NULL);
+  EXPECT_STREQ (str, model_next);
+  g_free (str);
 
-  diff_orc = stop_ts - start_ts;
-  _print_log ("mul u8 orc: %" G_GINT64_FORMAT, diff_orc);
+  gst_harness_teardown (h);
+}
 
-  for (i = 0; i < array_size; ++i) {
-    EXPECT_EQ (data_u8[i], 8);
-  }
+/**
+ * @brief Test for tensor_filter, the input tensors are selected and the output buffer has the input tensor passed through.
+ */
+TEST (test_tensor_filter, tensor_combination)
+{
+  const gchar *model =
+      "./nnstreamer_example/custom_example_passthrough/libnnstreamer_customfilter_passthrough_variable.so";
+  const gchar *dims[] = { "4:1:1:1", "8:1:1:1", "16:1:1:1" };
 
-  /* loop */
-  start_ts = g_get_real_time ();
-  for (i = 0; i < array_size; ++i) {
-    data_u8[i] *= 2;
-  }
-  stop_ts = g_get_real_time ();
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstTensorsConfig config;
+  GstMemory *mem, *in_mem[3];
+  GstMapInfo info;
+  gsize data_size[3];
+  guint i, t;
+  gchar *str;
 
-  diff_loop = stop_ts - start_ts;
-  _print_log ("mul u8 loop: %" G_GINT64_FORMAT, diff_loop);
+  h = gst_harness_new ("tensor_filter");
 
-  /* orc typecast to float */
-  start_ts = g_get_real_time ();
-  nns_orc_conv_u8_to_f32 (data_float, data_u8, array_size);
-  stop_ts = g_get_real_time ();
+  /* the model gets the tensors 2 and 0, the output buffer has the input tensor 1 and the output tensors */
+  g_object_set (h->element, "framework", "custom", "model", model,
+      "input-combination", "2,0", "output-combination", "i1,o0,o1", NULL);
 
-  diff_orc = stop_ts - start_ts;
-  _print_log ("conv u8 orc: %" G_GINT64_FORMAT, diff_orc);
+  g_object_get (h->element, "input-combination", &str, NULL);
+  EXPECT_STREQ (str, "2,0");
+  g_free (str);
 
-  for (i = 0; i < array_size; ++i) {
-    EXPECT_FLOAT_EQ (data_float[i], 16.);
+  g_object_get (h->element, "output-combination", &str, NULL);
+  EXPECT_STREQ (str, "i1,o0,o1");
+  g_free (str);
+
+  /* input tensor info */
+  gst_tensors_config_init (&config);
+  config.info.num_tensors = 3;
+  for (t = 0; t < 3; t++) {
+    config.info.info[t].type = _NNS_UINT8;
+    get_tensor_dimension (dims[t], config.info.info[t].dimension);
+    data_size[t] = gst_tensor_info_get_size (&config.info.info[t]);
   }
+  config.rate_n = 0;
+  config.rate_d = 1;
 
-  /* loop */
-  start_ts = g_get_real_time ();
-  for (i = 0; i < array_size; ++i) {
-    data_float[i] = (float) data_u8[i];
+  gst_harness_set_src_caps (h, gst_tensors_caps_from_config (&config));
+
+  in_buf = gst_buffer_new ();
+  for (t = 0; t < 3; t++) {
+    in_mem[t] = gst_allocator_alloc (NULL, data_size[t], NULL);
+    ASSERT_TRUE (gst_memory_map (in_mem[t], &info, GST_MAP_WRITE));
+    for (i = 0; i < data_size[t]; i++)
+      ((uint8_t *) info.data)[i] = (uint8_t) (t * 100 + i);
+    gst_memory_unmap (in_mem[t], &info);
+
+    gst_buffer_append_memory (in_buf, in_mem[t]);
   }
-  stop_ts = g_get_real_time ();
 
-  diff_loop = stop_ts - start_ts;
-  _print_log ("conv u8 loop: %" G_GINT64_FORMAT, diff_loop);
+  /* keep the input tensor to compare */
+  gst_memory_ref (in_mem[1]);
 
-  /* orc div f32 */
-  start_ts = g_get_real_time ();
-  nns_orc_div_c_f32 (data_float, 2., array_size);
-  stop_ts = g_get_real_time ();
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
 
-  diff_orc = stop_ts - start_ts;
-  _print_log ("div f32 orc: %" G_GINT64_FORMAT, diff_orc);
+  out_buf = gst_harness_pull (h);
+  ASSERT_TRUE (out_buf != NULL);
+  ASSERT_EQ (gst_buffer_n_memory (out_buf), 3U);
 
-  for (i = 0; i < array_size; ++i) {
-    EXPECT_FLOAT_EQ (data_float[i], 8.);
-  }
+  /* the input tensor 1, by reference */
+  EXPECT_TRUE (gst_buffer_peek_memory (out_buf, 0) == in_mem[1]);
 
-  /* loop */
-  start_ts = g_get_real_time ();
-  for (i = 0; i < array_size; ++i) {
-    data_float[i] /= 2.;
+  /* the output tensors 0 and 1 of the model, the input tensors 2 and 0 */
+  for (t = 1; t < 3; t++) {
+    guint k = (t == 1) ? 2 : 0;
+
+    mem = gst_buffer_peek_memory (out_buf, t);
+    ASSERT_EQ (gst_memory_get_sizes (mem, NULL, NULL), data_size[k]);
+    ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_READ));
+    for (i = 0; i < data_size[k]; i++)
+      EXPECT_EQ (((uint8_t *) info.data)[i], (uint8_t) (k * 100 + i));
+    gst_memory_unmap (mem, &info);
   }
-  stop_ts = g_get_real_time ();
 
-  diff_loop = stop_ts - start_ts;
-  _print_log ("div f32 loop: %" G_GINT64_FORMAT, diff_loop);
+  gst_buffer_unref (out_buf);
+  gst_memory_unref (in_mem[1]);
 
-  /* orc mul f32 */
-  start_ts = g_get_real_time ();
-  nns_orc_mul_c_f32 (data_float, 2., array_size);
-  stop_ts = g_get_real_time ();
+  EXPECT_EQ (gst_harness_buffers_received (h), 1U);
+  gst_harness_teardown (h);
+}
 
-  diff_orc = stop_ts - start_ts;
-  _print_log ("mul f32 orc: %" G_GINT64_FORMAT, diff_orc);
+#ifdef __linux__
+/**
+ * @brief Test for tensor filter, the invoke thread is pinned with cpu-affinity.
+ */
+TEST (test_tensor_filter, cpu_affinity)
+{
+  const gchar *model = "./tests/libnnscustom_framecounter.so";
 
-  for (i = 0; i < array_size; ++i) {
-    EXPECT_FLOAT_EQ (data_float[i], 8.);
-  }
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstTensorConfig config;
+  cpu_set_t saved, set;
+  gchar *cpus, *str;
+  gint cpu, priority;
+  gsize data_size;
 
-  /* loop */
-  start_ts = g_get_real_time ();
-  for (i = 0; i < array_size; ++i) {
-    data_float[i] *= 2.;
+  /* the harness pushes the buffer in this thread, pin it to the first CPU allowed */
+  ASSERT_EQ (sched_getaffinity (0, sizeof (cpu_set_t), &saved), 0);
+  for (cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+    if (CPU_ISSET (cpu, &saved))
+      break;
   }
-  stop_ts = g_get_real_time ();
+  ASSERT_LT (cpu, CPU_SETSIZE);
 
-  diff_loop = stop_ts - start_ts;
-  _print_log ("mul f32 loop: %" G_GINT64_FORMAT, diff_loop);
+  h = gst_harness_new ("tensor_filter");
 
-  /* orc add f32 */
-  start_ts = g_get_real_time ();
-  nns_orc_add_c_f32 (data_float, 2., array_size);
-  stop_ts = g_get_real_time ();
+  cpus = g_strdup_printf ("%d", cpu);
+  g_object_set (h->element, "framework", "custom", "model", model,
+      "cpu-affinity", cpus, NULL);
 
-  diff_orc = stop_ts - start_ts;
-  _print_log ("add f32 orc: %" G_GINT64_FORMAT, diff_orc);
+  g_object_get (h->element, "cpu-affinity", &str, "thread-priority",
+      &priority, NULL);
+  EXPECT_STREQ (str, cpus);
+  EXPECT_EQ (priority, 0);
+  g_free (str);
+  g_free (cpus);
 
-  for (i = 0; i < array_size; ++i) {
-    EXPECT_FLOAT_EQ (data_float[i], 18.);
-  }
+  /* input tensor info */
+  config.info.type = _NNS_UINT8;
+  get_tensor_dimension ("3:4:4:1", config.info.dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
 
-  /* loop */
-  start_ts = g_get_real_time ();
-  for (i = 0; i < array_size; ++i) {
-    data_float[i] += 2.;
-  }
-  stop_ts = g_get_real_time ();
+  gst_harness_set_src_caps (h, gst_tensor_caps_from_config (&config));
+  data_size = gst_tensor_info_get_size (&config.info);
 
-  diff_loop = stop_ts - start_ts;
-  _print_log ("add f32 loop: %" G_GINT64_FORMAT, diff_loop);
+  in_buf = gst_harness_create_buffer (h, data_size);
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
 
-  /* init data for tc combined */
-  for (i = 0; i < array_size; ++i) {
-    data_u8[i] = 1;
-  }
+  out_buf = gst_harness_pull (h);
+  ASSERT_TRUE (out_buf != NULL);
+  gst_buffer_unref (out_buf);
 
-  /* orc typecast - add - mul */
-  start_ts = g_get_real_time ();
-  nns_orc_conv_u8_to_f32 (data_float, data_u8, array_size);
-  nns_orc_add_c_f32 (data_float, .2, array_size);
-  nns_orc_mul_c_f32 (data_float, 1.2, array_size);
-  stop_ts = g_get_real_time ();
+  /* the invoke thread runs on the CPU only */
+  ASSERT_EQ (sched_getaffinity (0, sizeof (cpu_set_t), &set), 0);
+  EXPECT_EQ (CPU_COUNT (&set), 1);
+  EXPECT_TRUE (CPU_ISSET (cpu, &set));
 
-  diff_orc = stop_ts - start_ts;
-  _print_log ("combined orc: %" G_GINT64_FORMAT, diff_orc);
+  gst_harness_teardown (h);
 
-  for (i = 0; i < array_size; ++i) {
-    EXPECT_FLOAT_EQ (data_float[i], (1 + .2) * 1.2);
-  }
+  /* invalid list, the thread is not pinned and the stream continues */
+  EXPECT_TRUE (sched_setaffinity (0, sizeof (cpu_set_t), &saved) == 0);
 
-  /* loop */
-  start_ts = g_get_real_time ();
-  for (i = 0; i < array_size; ++i) {
-    data_float[i] = (float) data_u8[i];
-    data_float[i] += .2;
-    data_float[i] *= 1.2;
-  }
-  stop_ts = g_get_real_time ();
+  h = gst_harness_new ("tensor_filter");
+  g_object_set (h->element, "framework", "custom", "model", model,
+      "cpu-affinity", "3-1", NULL);
+  gst_harness_set_src_caps (h, gst_tensor_caps_from_config (&config));
 
-  diff_loop = stop_ts - start_ts;
-  _print_log ("combined loop: %" G_GINT64_FORMAT, diff_loop);
+  in_buf = gst_harness_create_buffer (h, data_size);
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
 
-  g_free (data_u8);
-  g_free (data_float);
+  out_buf = gst_harness_pull (h);
+  ASSERT_TRUE (out_buf != NULL);
+  gst_buffer_unref (out_buf);
+
+  ASSERT_EQ (sched_getaffinity (0, sizeof (cpu_set_t), &set), 0);
+  EXPECT_TRUE (CPU_EQUAL (&set, &saved));
+
+  gst_harness_teardown (h);
 }
-#endif /* HAVE_ORC */
+#endif
 
 /**
  * @brief Main function for unit test.
@@ -42,4 +42,9 @@ gstTest "--gst-plugin-path=../../build tensor_mux name=mux ! tensor_filter frame
 
 callCompareTest lstm.golden out_9.log 1-1 "Compare 1-1" 1 0
 
+# The state tensors fed back inside tensor_filter, without the repository
+gstTest "--gst-plugin-path=../../build filesrc location=\"video_4x4xBGRx.xraw\" ! application/octet-stream ! tensor_converter input-dim=4:4:4:1 input-type=float32 ! tensor_filter framework=custom model=../../build/nnstreamer_example/custom_example_LSTM/libdummyLSTM.so state-inputs=0,1 state-outputs=0,1 ! tensor_demux name=demux demux.src_0 ! queue ! fakesink demux.src_1 ! queue ! multifilesink location=\"state_%1d.log\"" 2 0 0 $PERFORMANCE
+
+callCompareTest lstm.golden state_9.log 2-1 "Compare 2-1" 1 0
+
 report
@@ -28,6 +28,9 @@
  * - custom=stderr:delay-1000
  *     Do fprintf(stderr) and add 1000ms sleep for each invoke.
  *
+ * With batch-size of tensor_filter, the frames of a batch are counted at
+ * once and the delay is added once for each batch.
+ *
  * @bug  No known bugs
  */
 
@@ -154,14 +157,15 @@ set_inputDim (void *_data, const GstTensorFilterProperties * prop,
 }
 
 /**
- * @brief nnstreamer custom filter standard vmethod
- * Refer tensor_filter_custom.h
+ * @brief internal function to count a frame and fill its output tensor
+ * @param[in] data The internal data structure of this custom filter.
+ * @param[in] input The input tensors of the frame
+ * @param[out] output The output tensor of the frame
  */
-static int
-invoke (void *_data, const GstTensorFilterProperties * prop,
-    const GstTensorMemory * input, GstTensorMemory * output)
+static void
+count_frame (pt_data * data, const GstTensorMemory * input,
+    GstTensorMemory * output)
 {
-  pt_data *data = _data;
   uint32_t *counter = (uint32_t *) output[0].data;
 
   if (data->copy == 1) {
@@ -180,12 +184,49 @@ invoke (void *_data, const GstTensorFilterProperties * prop,
       fprintf (data->outf, "[%u] Counter: %u / Output: %u\n", data->id, data->counter, *counter);       /* The last counter value */
     }
   }
+}
+
+/**
+ * @brief nnstreamer custom filter standard vmethod
+ * Refer tensor_filter_custom.h
+ */
+static int
+invoke (void *_data, const GstTensorFilterProperties * prop,
+    const GstTensorMemory * input, GstTensorMemory * output)
+{
+  pt_data *data = _data;
+
+  count_frame (data, input, output);
 
   if (data->delay > 0)
     g_usleep (data->delay * 1000U);
   return 0;
 }
 
+/**
+ * @brief nnstreamer custom filter optional vmethod
+ * Refer tensor_filter_custom.h
+ */
+static int
+invoke_batch (void *_data, const GstTensorFilterProperties * prop,
+    const GstTensorMemory * input, GstTensorMemory * output,
+    unsigned int batch)
+{
+  pt_data *data = _data;
+  unsigned int b;
+
+  if (data->outf)
+    fprintf (data->outf, "[%u] Batch: %u frames\n", data->id, batch);
+
+  for (b = 0; b < batch; b++)
+    count_frame (data, &input[b * data->inputn], &output[b]);
+
+  /* the delay is added once for the batch */
+  if (data->delay > 0)
+    g_usleep (data->delay * 1000U);
+  return 0;
+}
+
 static NNStreamer_custom_class NNStreamer_custom_body = {
   .initfunc = pt_init,
   .exitfunc = pt_exit,
@@ -195,3 +236,11 @@ static NNStreamer_custom_class NNStreamer_custom_body = {
 
 /* The dyn-loaded object */
 NNStreamer_custom_class *NNStreamer_custom = &NNStreamer_custom_body;
+
+static NNStreamer_custom_ext_class NNStreamer_custom_ext_body = {
+  .size = sizeof (NNStreamer_custom_ext_class),
+  .invoke_batch = invoke_batch,
+};
+
+/* The optional callbacks */
+NNStreamer_custom_ext_class *NNStreamer_custom_ext = &NNStreamer_custom_ext_body;
@@ -105,6 +105,8 @@ typedef enum
   TEST_TYPE_ISSUE739_MERGE_PARALLEL_2, /**< pipeline to test Merge/Parallel case in #739 */
   TEST_TYPE_ISSUE739_MERGE_PARALLEL_3, /**< pipeline to test Merge/Parallel case in #739 */
   TEST_TYPE_ISSUE739_MERGE_PARALLEL_4, /**< pipeline to test Merge/Parallel case in #739 */
+  TEST_TYPE_FILTER_SYNC_INVOKE, /**< pipeline to test tensor_filter, synchronous invoke */
+  TEST_TYPE_FILTER_ASYNC_INVOKE, /**< pipeline to test tensor_filter, asynchronous invoke with in-flight frames */
   TEST_TYPE_UNKNOWN /**< unknonwn */
 } TestType;
 
@@ -800,6 +802,22 @@ _setup_pipeline (TestOption & option)
           "tensor_merge mode=linear option=3 sync_mode=basepad sync_option=1:0 name=mux ! tensor_filter framework=custom model=./tests/libnnscustom_framecounter.so ! tee name=t ! queue ! tensor_sink sync=true name=test_sink t. ! queue ! filesink location=%s",
           option.num_buffers * 10, option.num_buffers * 25, option.tmpfile);
       break;
+    case TEST_TYPE_FILTER_SYNC_INVOKE:
+    case TEST_TYPE_FILTER_ASYNC_INVOKE:
+      /** 4x4 tensor stream, two filters with 10ms delay per invoke */
+      {
+        guint max_inflight;
+
+        max_inflight = (option.test_type == TEST_TYPE_FILTER_ASYNC_INVOKE) ? 4 : 0;
+        str_pipeline =
+            g_strdup_printf
+            ("videotestsrc pattern=snow num-buffers=%d ! video/x-raw,format=BGRx,height=4,width=4,framerate=30/1 ! tensor_converter ! "
+            "tensor_filter framework=custom model=./tests/libnnscustom_framecounter.so custom=delay-10 max-inflight=%u ! "
+            "tensor_filter framework=custom model=./tests/libnnscustom_framecounter.so custom=delay-10 max-inflight=%u ! "
+            "tee name=t ! queue ! tensor_sink sync=false name=test_sink t. ! queue ! filesink location=%s",
+            option.num_buffers, max_inflight, max_inflight, option.tmpfile);
+      }
+      break;
     /** @todo Add tensor_mux policy = more policies! */
     default:
       goto error;
@@ -3812,6 +3830,73 @@ TEST (tensor_stream_test, issue739_merge_parallel_3)
   _free_test_data ();
 }
 
+/**
+ * @brief Test for asynchronous invoke of tensor_filter, compare the elapsed time with synchronous invoke.
+ */
+TEST (tensor_stream_test, filter_async_invoke)
+{
+  const guint num_buffers = 30;
+  TestOption option = { num_buffers, TEST_TYPE_FILTER_SYNC_INVOKE };
+  gint64 start_ts, stop_ts, diff[2];
+  guint t;
+
+  for (t = 0; t < 2; t++) {
+    option.test_type = (t == 0) ?
+        TEST_TYPE_FILTER_SYNC_INVOKE : TEST_TYPE_FILTER_ASYNC_INVOKE;
+    option.tmpfile = _get_temp_filename ();
+    EXPECT_TRUE (option.tmpfile != NULL);
+
+    ASSERT_TRUE (_setup_pipeline (option));
+
+    start_ts = g_get_real_time ();
+    gst_element_set_state (g_test_data.pipeline, GST_STATE_PLAYING);
+    g_main_loop_run (g_test_data.loop);
+    stop_ts = g_get_real_time ();
+    gst_element_set_state (g_test_data.pipeline, GST_STATE_NULL);
+
+    diff[t] = stop_ts - start_ts;
+    _print_log ("%s invoke: %" G_GINT64_FORMAT, (t == 0) ? "sync" : "async",
+        diff[t]);
+
+    /** check eos message */
+    EXPECT_EQ (g_test_data.status, TEST_EOS);
+
+    /** check received buffers */
+    EXPECT_EQ (g_test_data.received, num_buffers);
+    EXPECT_EQ (g_test_data.mem_blocks, 1);
+    EXPECT_EQ (g_test_data.received_size, 4);   /* uint32_t, 1:1:1:1 */
+
+    /** check timestamp */
+    EXPECT_FALSE (g_test_data.invalid_timestamp);
+
+    /** check the frames are pushed in arrival order */
+    if (option.tmpfile) {
+      gchar *data;
+      gsize read, i;
+
+      if (g_file_get_contents (option.tmpfile, &data, &read, NULL)) {
+        read /= 4;
+        EXPECT_EQ (read, num_buffers);
+        for (i = 0; i < read; i++)
+          EXPECT_EQ (((uint32_t *) data)[i], i);
+
+        g_free (data);
+      }
+
+      /* remove temp file */
+      if (g_remove (option.tmpfile) != 0) {
+        _print_log ("failed to remove temp file %s", option.tmpfile);
+      }
+      g_free (option.tmpfile);
+    }
+
+    EXPECT_FALSE (g_test_data.test_failed);
+    _free_test_data ();
+  }
+
+  _print_log ("async invoke speed-up: %.2f", (double) diff[0] / diff[1]);
+}
+
 /**
  * @brief Main function for unit test.
  */
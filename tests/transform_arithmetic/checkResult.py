@@ -42,6 +42,10 @@ def testArithmetic (fna, fnb, typeasize, typebsize,typeapack, typebpack, mode, v
       diff = (vala + float(value1)) * float(value2) - valb
       if diff > 0.01 or diff < -0.01:
         return 20
+    elif (mode == 'add-div'):
+      diff = (vala + float(value1)) / float(value2) - valb
+      if diff > 0.01 or diff < -0.01:
+        return 20
     elif (mode == 'mul-add'):
       diff = (vala * float(value1)) + float(value2) - valb
       if diff > 0.01 or diff < -0.01:
@@ -80,4 +80,25 @@ gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} multifilesrc location=\"testsequenc
 testResult $? 6 "Golden test comparison" 0 1
 python checkResult.py arithmetic testcase06.direct.log testcase06.arithmetic.log 8 8 d d add-mul -50.0987e+003 15.3
 
+# Test for typecast,add,div of uint8 to normalized float32, with and without acceleration
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} multifilesrc location=\"testsequence_%1d.png\" index=0 caps=\"image/png,framerate=\(fraction\)30/1\" ! pngdec ! videoconvert ! video/x-raw, format=RGB ! tensor_converter ! tee name=t ! queue ! tensor_transform mode=arithmetic option=typecast:float32,add:-127.5,div:127.5 acceleration=false ! filesink location=\"testcase07.arithmetic.log\" sync=true t. ! queue ! tensor_transform mode=arithmetic option=typecast:float32,add:-127.5,div:127.5 acceleration=true ! filesink location=\"testcase07.arithmetic.accel.log\" sync=true t. ! queue ! filesink location=\"testcase07.direct.log\" sync=true" 7 0 0 $PERFORMANCE
+
+python checkResult.py arithmetic testcase07.direct.log testcase07.arithmetic.log 1 4 B f add-div -127.5 127.5
+testResult $? 7 "Golden test comparison" 0 1
+python checkResult.py arithmetic testcase07.direct.log testcase07.arithmetic.accel.log 1 4 B f add-div -127.5 127.5
+testResult $? 7-2 "Golden test comparison with acceleration" 0 1
+
+# Benchmark of uint8 to normalized float32 with 100 frames of 1920x1080 RGB
+for ACCEL in true false; do
+	if [ "$ACCEL" == "true" ]; then
+		TEST_ID=8
+	else
+		TEST_ID=9
+	fi
+	START_TIME=$(date +%s%N)
+	gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} videotestsrc num-buffers=100 ! video/x-raw,format=RGB,width=1920,height=1080,framerate=0/1 ! tensor_converter ! tensor_transform mode=arithmetic option=typecast:float32,add:-127.5,div:127.5 acceleration=${ACCEL} ! fakesink" ${TEST_ID} 0 0 $PERFORMANCE
+	STOP_TIME=$(date +%s%N)
+	printf "Acceleration:${ACCEL}, 100 frames: $(( (STOP_TIME - START_TIME) / 1000000 )) ms\n"
+done
+
 report
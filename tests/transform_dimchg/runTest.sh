@@ -47,4 +47,37 @@ gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} multifilesrc location=\"testsequenc
 python checkResult.py dimchg0:b testcase02.direct.log testcase02.dimchg02.log 4 1024 1
 testResult $? 2 "Golden test comparison" 0 1
 
+# Test the larger dim to the smaller dim (3, 4), the round trip is the same with the input
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} multifilesrc location=\"testsequence_%1d.png\" index=0 caps=\"image/png,framerate=\(fraction\)30/1\" ! pngdec ! videoconvert ! video/x-raw, format=RGB ! tensor_converter ! tee name=t ! queue ! tensor_transform mode=dimchg option=0:2 ! tensor_transform mode=dimchg option=2:0 ! filesink location=\"testcase03.dimchg20.log\" sync=true t. ! queue ! filesink location=\"testcase03.direct.log\" sync=true" 3 0 0 $PERFORMANCE
+callCompareTest testcase03.direct.log testcase03.dimchg20.log 3 "Compare the round trip of RGB" 1 0
+
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} multifilesrc location=\"testsequence_%1d.png\" index=0 caps=\"image/png,framerate=\(fraction\)30/1\" ! pngdec ! videoconvert ! video/x-raw, format=BGRx ! tensor_converter ! tensor_transform mode=typecast option=float32 ! tee name=t ! queue ! tensor_transform mode=dimchg option=0:2 ! tensor_transform mode=dimchg option=2:0 ! filesink location=\"testcase04.dimchg20.log\" sync=true t. ! queue ! filesink location=\"testcase04.direct.log\" sync=true" 4 0 0 $PERFORMANCE
+callCompareTest testcase04.direct.log testcase04.dimchg20.log 4 "Compare the round trip of BGRx in float32" 1 0
+
+# Benchmark of NHWC -> NCHW -> NHWC (0:2 and 2:0) with RGB in uint8 and float32
+TEST_ID=5
+for SIZE in 224x224 1920x1080; do
+	WIDTH=${SIZE%x*}
+	HEIGHT=${SIZE#*x}
+	if [ "$SIZE" == "224x224" ]; then
+		FRAMES=300
+	else
+		FRAMES=30
+	fi
+	for TYPE in uint8 float32; do
+		for DIMCHG in true false; do
+			if [ "$DIMCHG" == "true" ]; then
+				DIMCHG_ELEMENTS="tensor_transform mode=dimchg option=0:2 ! tensor_transform mode=dimchg option=2:0 !"
+			else
+				DIMCHG_ELEMENTS=""
+			fi
+			START_TIME=$(date +%s%N)
+			gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} videotestsrc num-buffers=${FRAMES} ! video/x-raw,format=RGB,width=${WIDTH},height=${HEIGHT},framerate=0/1 ! tensor_converter ! tensor_transform mode=typecast option=${TYPE} ! ${DIMCHG_ELEMENTS} fakesink" ${TEST_ID} 0 0 $PERFORMANCE
+			STOP_TIME=$(date +%s%N)
+			printf "${SIZE}x3 ${TYPE}, dimchg:${DIMCHG}, ${FRAMES} frames: $(( (STOP_TIME - START_TIME) / 1000000 )) ms\n"
+			TEST_ID=$(( TEST_ID + 1 ))
+		done
+	done
+done
+
 report
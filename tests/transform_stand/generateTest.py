@@ -16,7 +16,7 @@ import random
 
 import numpy as np
 
-def saveTestData(filename, width, height):
+def saveTestData(filename, width, height, mode='default', per_channel=False):
     string = b''
     data = []
 
@@ -32,9 +32,22 @@ def saveTestData(filename, width, height):
     file.close()
 
     a=np.array(data)
-    mean = np.mean(a)
-    standard = np.std(a)
-    result=abs((a-np.mean(a)) / (np.std(a)+1e-10))
+    if per_channel:
+        # statistics of each channel, the innermost dimension (height)
+        b=a.reshape(width, height)
+        mean = np.mean(b, axis=0)
+        standard = np.std(b, axis=0, ddof=1)
+        if mode == 'dc-average':
+            result=(b-mean).flatten()
+        else:
+            result=abs((b-mean) / (standard+1e-10)).flatten()
+    else:
+        mean = np.mean(a)
+        standard = np.std(a)
+        if mode == 'dc-average':
+            result=a-mean
+        else:
+            result=abs((a-np.mean(a)) / (np.std(a)+1e-10))
 
     s = ''
     for w in range(0,width):
@@ -47,3 +60,5 @@ def saveTestData(filename, width, height):
     return result, mean, standard
 
 buf = saveTestData("test_00.dat", 100, 50)
+buf = saveTestData("test_01.dat", 100, 50, 'dc-average')
+buf = saveTestData("test_02.dat", 100, 50, 'default', True)
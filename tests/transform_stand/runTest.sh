@@ -37,4 +37,28 @@ python checkResult.py standardization test_00.dat.golden result_00.log 4 4 f f d
 
 testResult $? 1 "Golden test comparison" 0 1
 
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} filesrc location=\"test_01.dat\" ! application/octet-stream ! tensor_converter input-dim=50:100:1:1 input-type=float32 ! tensor_transform mode=stand option=dc-average ! filesink location=\"./result_01.log\" sync=true" 2 0 0 $PERFORMANCE
+
+python checkResult.py standardization test_01.dat.golden result_01.log 4 4 f f dc-average
+
+testResult $? 2 "Golden test comparison of dc-average" 0 1
+
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} filesrc location=\"test_02.dat\" ! application/octet-stream ! tensor_converter input-dim=50:100:1:1 input-type=float32 ! tensor_transform mode=stand option=\"default;axis:0\" ! filesink location=\"./result_02.log\" sync=true" 3 0 0 $PERFORMANCE
+
+python checkResult.py standardization test_02.dat.golden result_02.log 4 4 f f default
+
+testResult $? 3 "Golden test comparison of each channel" 0 1
+
+# Benchmark of 100 frames of 1920x1080 RGB, typecast to float32 and standardized for each channel
+START_TIME=$(date +%s%N)
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} videotestsrc num-buffers=100 ! video/x-raw,format=RGB,width=1920,height=1080,framerate=0/1 ! tensor_converter ! tensor_transform mode=stand option=\"default;typecast:float32;axis:0\" ! fakesink" 4 0 0 $PERFORMANCE
+STOP_TIME=$(date +%s%N)
+printf "stand default of each channel, 100 frames: $(( (STOP_TIME - START_TIME) / 1000000 )) ms\n"
+
+# Benchmark of 100 frames of 1920x1080 RGB in float32, standardized with the average and std of the tensor
+START_TIME=$(date +%s%N)
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} videotestsrc num-buffers=100 ! video/x-raw,format=RGB,width=1920,height=1080,framerate=0/1 ! tensor_converter ! tensor_transform mode=typecast option=float32 ! tensor_transform mode=stand option=default ! fakesink" 5 0 0 $PERFORMANCE
+STOP_TIME=$(date +%s%N)
+printf "stand default, 100 frames: $(( (STOP_TIME - START_TIME) / 1000000 )) ms\n"
+
 report
@@ -56,3 +56,7 @@ buf = saveTestData("test01_00.dat", 3, 50, 100, 1, 0, 2, 3, 1)
 buf = saveTestData("test02_00.dat", 3, 100, 200, 1, 0, 2, 3, 1)
 
 buf = saveTestData("test03_00.dat", 3, 100, 200, 1, 0, 1, 3, 2)
+
+buf = saveTestData("test04_00.dat", 3, 4, 5, 2, 3, 2, 1, 0)
+
+buf = saveTestData("test05_00.dat", 3, 4, 5, 2, 1, 2, 0, 3)
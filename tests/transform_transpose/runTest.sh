@@ -43,4 +43,29 @@ gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} multifilesrc location=\"test03_%02d
 
 callCompareTest test03_00.dat.golden result03_00.log 3 "Compare 3" 1 0
 
+# The batch axis is moved (all axes reversed)
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} multifilesrc location=\"test04_%02d.dat\" caps=\"application/octet-stream\" ! tensor_converter input-dim=5:4:3:2 input-type=float32 ! tensor_transform mode=transpose option=3:2:1:0 ! multifilesink location=\"./result04_%02d.log\" sync=true" 4 0 0 $PERFORMANCE
+
+callCompareTest test04_00.dat.golden result04_00.log 4 "Compare 4" 1 0
+
+# The batch axis is moved, the innermost axis is not moved
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} multifilesrc location=\"test05_%02d.dat\" caps=\"application/octet-stream\" ! tensor_converter input-dim=5:4:3:2 input-type=float32 ! tensor_transform mode=transpose option=0:3:1:2 ! multifilesink location=\"./result05_%02d.log\" sync=true" 5 0 0 $PERFORMANCE
+
+callCompareTest test05_00.dat.golden result05_00.log 5 "Compare 5" 1 0
+
+# Benchmark of NHWC -> NCHW -> NHWC with 30 frames of 1920x1080 RGB in float32, and the pipeline without transpose
+for TRANSPOSE in true false; do
+	if [ "$TRANSPOSE" == "true" ]; then
+		TEST_ID=6
+		TRANSPOSE_ELEMENTS="tensor_transform mode=transpose option=1:2:0:3 ! tensor_transform mode=transpose option=2:0:1:3 !"
+	else
+		TEST_ID=7
+		TRANSPOSE_ELEMENTS=""
+	fi
+	START_TIME=$(date +%s%N)
+	gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} videotestsrc num-buffers=30 ! video/x-raw,format=RGB,width=1920,height=1080,framerate=0/1 ! tensor_converter ! tensor_transform mode=typecast option=float32 ! ${TRANSPOSE_ELEMENTS} fakesink" ${TEST_ID} 0 0 $PERFORMANCE
+	STOP_TIME=$(date +%s%N)
+	printf "Transpose:${TRANSPOSE}, 30 frames: $(( (STOP_TIME - START_TIME) / 1000000 )) ms\n"
+done
+
 report